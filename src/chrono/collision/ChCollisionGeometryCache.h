@@ -0,0 +1,168 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Cache of immutable collision geometry data, shared across collision models
+// and systems.
+//
+// =============================================================================
+
+#ifndef CH_COLLISION_GEOMETRY_CACHE_H
+#define CH_COLLISION_GEOMETRY_CACHE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "chrono/core/ChVector3.h"
+#include "chrono/geometry/ChTriangleMesh.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_collision
+/// @{
+
+/// Content key for collision geometry.
+/// A key is built by appending a tag (identifying the type of data and the algorithm used to build it), any build
+/// parameters (e.g., margins), and the geometric input data (points, triangles, connectivity). Two keys compare equal
+/// only if all appended data is bitwise identical. A 64-bit FNV-1a hash of the data is accumulated as data is appended;
+/// the full data is only compared for keys with equal hash and size.
+class ChCollisionGeometryKey {
+  public:
+    ChCollisionGeometryKey(const std::string& tag) : m_hash(14695981039346656037ULL) {
+        Append(tag.c_str(), tag.size() + 1);
+    }
+
+    void Add(int val) { Append(&val, sizeof(val)); }
+    void Add(double val) { Append(&val, sizeof(val)); }
+    void Add(const ChVector3d& v) { Append(v.data(), 3 * sizeof(double)); }
+    void Add(const ChVector3i& v) { Append(v.data(), 3 * sizeof(int)); }
+
+    void Add(const std::vector<ChVector3d>& points) {
+        Add((int)points.size());
+        for (const auto& p : points)
+            Add(p);
+    }
+
+    void Add(const std::vector<ChVector3i>& indices) {
+        Add((int)indices.size());
+        for (const auto& i : indices)
+            Add(i);
+    }
+
+    void Add(ChTriangleMesh& mesh) {
+        Add((int)mesh.GetNumTriangles());
+        for (unsigned int i = 0; i < mesh.GetNumTriangles(); i++) {
+            auto tri = mesh.GetTriangle(i);
+            Add(tri.p1);
+            Add(tri.p2);
+            Add(tri.p3);
+        }
+    }
+
+    /// Return the 64-bit FNV-1a hash of the key data.
+    std::uint64_t Hash() const { return m_hash; }
+
+    /// Return the size (in bytes) of the key data.
+    size_t Size() const { return m_data.size(); }
+
+    bool operator==(const ChCollisionGeometryKey& other) const {
+        return m_hash == other.m_hash && m_data.size() == other.m_data.size() && m_data == other.m_data;
+    }
+
+    struct Hasher {
+        size_t operator()(const ChCollisionGeometryKey& key) const { return (size_t)key.Hash(); }
+    };
+
+  private:
+    void Append(const void* data, size_t size) {
+        auto bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            m_hash ^= bytes[i];
+            m_hash *= 1099511628211ULL;
+        }
+        m_data.append(reinterpret_cast<const char*>(bytes), size);
+    }
+
+    std::uint64_t m_hash;  ///< FNV-1a hash of the key data
+    std::string m_data;    ///< key data
+};
+
+/// Thread-safe cache of immutable collision geometry data.
+/// Data built from identical input (see ChCollisionGeometryKey) is built once and shared by all collision models, in
+/// all systems of the process. The cache only holds weak references, so that data is released as soon as it is no
+/// longer used by any collision model. Shared data must not be modified by its users.
+template <typename T>
+class ChCollisionGeometryCache {
+  public:
+    typedef std::function<std::shared_ptr<T>()> Builder;
+
+    /// Return the data with given key, invoking the builder if no such data is currently in use.
+    /// The builder is invoked outside the cache lock; if the same data is built concurrently, only one copy is kept.
+    /// An entry found for data no longer in use is dropped.
+    std::shared_ptr<T> Get(const ChCollisionGeometryKey& key, Builder builder) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_data.find(key);
+            if (it != m_data.end()) {
+                if (auto data = it->second.lock())
+                    return data;
+                m_data.erase(it);
+            }
+        }
+
+        auto data = builder();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& entry = m_data[key];
+        if (auto other = entry.lock())
+            return other;
+        entry = data;
+
+        // Purge entries for data no longer in use
+        if (m_data.size() > 2 * m_purge_size) {
+            for (auto it = m_data.begin(); it != m_data.end();) {
+                if (it->second.expired())
+                    it = m_data.erase(it);
+                else
+                    ++it;
+            }
+            m_purge_size = std::max(m_data.size(), (size_t)8);
+        }
+
+        return data;
+    }
+
+    /// Return the number of cached data entries currently in use.
+    size_t Size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t n = 0;
+        for (const auto& entry : m_data)
+            n += entry.second.expired() ? 0 : 1;
+        return n;
+    }
+
+  private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<ChCollisionGeometryKey, std::weak_ptr<T>, ChCollisionGeometryKey::Hasher> m_data;
+    size_t m_purge_size = 8;
+};
+
+/// @} chrono_collision
+
+}  // end namespace chrono
+
+#endif
@@ -24,6 +24,7 @@ namespace chrono {
 
 static double default_model_envelope = 0.03;
 static double default_safe_margin = 0.01;
+static bool geometry_sharing = true;
 
 ChCollisionModel::ChCollisionModel() : contactable(nullptr), family_group(1), family_mask(0x7FFF), impl(nullptr) {
     model_envelope = (float)default_model_envelope;
@@ -104,6 +105,16 @@ double ChCollisionModel::GetDefaultSuggestedMargin() {
     return default_safe_margin;
 }
 
+// static
+void ChCollisionModel::EnableGeometrySharing(bool val) {
+    geometry_sharing = val;
+}
+
+// static
+bool ChCollisionModel::IsGeometrySharingEnabled() {
+    return geometry_sharing;
+}
+
 // Set family_group to a power of 2, with the set bit in position 'family'.
 void ChCollisionModel::SetFamily(int family) {
     assert(family >= 0 && family < 15);
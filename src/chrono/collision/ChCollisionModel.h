@@ -154,6 +154,16 @@ class ChApi ChCollisionModel {
     static double GetDefaultSuggestedEnvelope();
     static double GetDefaultSuggestedMargin();
 
+    /// Enable/disable sharing of collision geometry data (default: true).
+    /// If enabled, the data built by the collision system for triangle mesh and convex hull shapes (e.g., BVH trees,
+    /// convex decompositions, hull point sets) is interned by content and shared among all collision models with
+    /// identical geometry, across all systems in the process. This affects collision models created after the call to
+    /// this function.
+    static void EnableGeometrySharing(bool val);
+
+    /// Return true if sharing of collision geometry data is enabled.
+    static bool IsGeometrySharingEnabled();
+
     /// Return the axis aligned bounding box (AABB) of the collision model.
     /// If local=true, return the AABB expressed in the local frame of the owner contactable. Otherwise, return the
     /// AABB expressed in the absolute coordinate frame (in this case, SyncPosition() should be invoked first).
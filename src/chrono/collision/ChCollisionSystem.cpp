@@ -12,8 +12,12 @@
 // Radu Serban
 // =============================================================================
 
+#include <algorithm>
+#include <tuple>
+
 #include "chrono/collision/ChCollisionSystem.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChContactContainer.h"
 #include "chrono/physics/ChAssembly.h"
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChParticleCloud.h"
@@ -22,7 +26,7 @@
 
 namespace chrono {
 
-ChCollisionSystem::ChCollisionSystem() : m_system(nullptr), m_initialized(false) {}
+ChCollisionSystem::ChCollisionSystem() : m_system(nullptr), m_initialized(false), m_deterministic(false) {}
 
 ChCollisionSystem::~ChCollisionSystem() {}
 
@@ -51,6 +55,50 @@ void ChCollisionSystem::UnbindItem(std::shared_ptr<ChPhysicsItem> item) {
     item->RemoveCollisionModelsFromSystem(this);
 }
 
+int ChCollisionSystem::RayHitBatch(const std::vector<ChRay>& rays, std::vector<ChRayhitResult>& results) const {
+    results.resize(rays.size());
+    int num_hits = 0;
+    for (size_t i = 0; i < rays.size(); i++) {
+        if (RayHit(rays[i].from, rays[i].to, results[i]))
+            num_hits++;
+    }
+    return num_hits;
+}
+
+// Identifier of the physics item owning the given collision model (-1 if none).
+static int GetModelIdentifier(ChCollisionModel* model) {
+    auto contactable = model ? model->GetContactable() : nullptr;
+    auto item = contactable ? contactable->GetPhysicsItem() : nullptr;
+    return item ? item->GetIdentifier() : -1;
+}
+
+void ChCollisionSystem::SortContacts(std::vector<ChCollisionInfo>& contacts) {
+    auto key = [](const ChCollisionInfo& c) {
+        return std::make_tuple(GetModelIdentifier(c.modelA), GetModelIdentifier(c.modelB),  //
+                               c.vpA.x(), c.vpA.y(), c.vpA.z(),                             //
+                               c.vpB.x(), c.vpB.y(), c.vpB.z(),                             //
+                               c.vN.x(), c.vN.y(), c.vN.z(), c.distance);
+    };
+    std::stable_sort(contacts.begin(), contacts.end(),
+                     [&key](const ChCollisionInfo& a, const ChCollisionInfo& b) { return key(a) < key(b); });
+}
+
+void ChCollisionSystem::AddSortedContacts(ChContactContainer* container) {
+    SortContacts(m_contact_buffer);
+
+    for (auto& cinfo : m_contact_buffer) {
+        // Execute user custom callback, if any
+        bool add_contact = true;
+        if (narrow_callback)
+            add_contact = narrow_callback->OnNarrowphase(cinfo);
+
+        if (add_contact)
+            container->AddContact(cinfo);
+    }
+
+    m_contact_buffer.clear();
+}
+
 void ChCollisionSystem::ArchiveOut(ChArchiveOut& archive_out) {
     // version number
     archive_out.VersionWrite<ChCollisionSystem>();
@@ -103,6 +103,16 @@ class ChApi ChCollisionSystem {
     /// The default implementation does nothing. Derived classes implement this function as applicable.
     virtual void SetNumThreads(int nthreads) {}
 
+    /// Enable/disable the deterministic mode (default: false).
+    /// If enabled, the collision pairs processed by the broadphase are sorted and the contacts passed to the contact
+    /// container in ReportContacts() are sorted in a canonical order (see SortContacts), so that the list of contacts
+    /// does not depend on the number of threads used for collision detection or on thread scheduling.
+    /// When the collision system is attached to a ChSystem, this is set automatically to ChSystem::IsDeterministic().
+    virtual void SetDeterministic(bool val) { m_deterministic = val; }
+
+    /// Return true if the deterministic mode is enabled.
+    bool IsDeterministic() const { return m_deterministic; }
+
     /// After the Run() has completed, you can call this function to
     /// fill a 'contact container', that is an object inherited from class
     /// ChContactContainer. For instance ChSystem, after each Run()
@@ -186,6 +196,19 @@ class ChApi ChCollisionSystem {
                         ChCollisionModel* model,
                         ChRayhitResult& result) const = 0;
 
+    /// Definition of a ray (segment) for batched ray-hit tests.
+    struct ChRay {
+        ChVector3d from;  ///< ray start point, in absolute frame
+        ChVector3d to;    ///< ray end point, in absolute frame
+    };
+
+    /// Perform ray-hit tests for a batch of rays with the collision models.
+    /// On return, 'results' has the same size as 'rays' and contains the closest hit (if any) for each ray. The return
+    /// value is the number of rays with a hit. Derived classes may process the rays concurrently and may exploit
+    /// coherence of consecutive rays in the batch; this function must not be called concurrently with Run().
+    /// The default implementation calls RayHit() for each ray, in sequence.
+    virtual int RayHitBatch(const std::vector<ChRay>& rays, std::vector<ChRayhitResult>& results) const;
+
     /// Class to be used as a callback interface for user-defined visualization of collision shapes.
     class ChApi VisualizationCallback {
       public:
@@ -230,7 +253,21 @@ class ChApi ChCollisionSystem {
   protected:
     ChCollisionSystem();
 
+    /// Sort the given collision pairs in a canonical order.
+    /// Contacts are ordered by the identifiers of the physics items owning the two collision models, then by the
+    /// coordinates of the contact points and normal, and finally by the penetration distance. This order depends only
+    /// on the geometry of the contacts, not on the order in which they were generated.
+    static void SortContacts(std::vector<ChCollisionInfo>& contacts);
+
+    /// Sort the contacts collected in m_contact_buffer and add them to the given contact container.
+    /// The narrowphase callback, if any, is invoked for each contact in canonical order. Used by derived classes in
+    /// deterministic mode; must be called between BeginAddContact() and EndAddContact().
+    void AddSortedContacts(ChContactContainer* container);
+
     bool m_initialized;
+    bool m_deterministic;  ///< report contacts in a canonical order
+
+    std::vector<ChCollisionInfo> m_contact_buffer;  ///< contacts collected before sorting (deterministic mode)
 
     ChSystem* m_system;  ///< associated Chrono system
 
@@ -24,6 +24,7 @@ subject to the following restrictions:
 #include "LinearMath/cbtPoolAllocator.h"
 #include "BulletCollision/CollisionDispatch/cbtCollisionConfiguration.h"
 #include "BulletCollision/CollisionDispatch/cbtCollisionObjectWrapper.h"
+#include "chrono/utils/ChTraceProfiler.h"  // ***CHRONO***
 
 cbtCollisionDispatcherMt::cbtCollisionDispatcherMt(cbtCollisionConfiguration* config, int grainSize)
 	: cbtCollisionDispatcher(config)
@@ -111,6 +112,7 @@ struct CollisionDispatcherUpdater : public cbtIParallelForBody
 	}
 	void forLoop(int iBegin, int iEnd) const
 	{
+		CH_TRACE_ZONE("Narrow-phase (batch)");  // ***CHRONO***
 		for (int i = iBegin; i < iEnd; ++i)
 		{
 			cbtBroadphasePair* pair = &mPairArray[i];
@@ -232,6 +232,7 @@ void cbtCollisionWorld::performDiscreteCollisionDetection()
         /* ***CHRONO*** Add Chrono-specific timers */
 		BT_PROFILE("computeOverlappingPairs");
         CH_PROFILE("Broad-phase");
+        CH_TRACE_ZONE("Broad-phase");
         timer_collision_broad.start();
 		computeOverlappingPairs();
         timer_collision_broad.stop();
@@ -242,6 +243,7 @@ void cbtCollisionWorld::performDiscreteCollisionDetection()
         /* ***CHRONO*** Add Chrono-specific timers */
         BT_PROFILE("dispatchAllCollisionPairs");
 		CH_PROFILE("Narrow-phase");
+        CH_TRACE_ZONE("Narrow-phase");
         timer_collision_narrow.start();
 		if (dispatcher)
 			dispatcher->dispatchAllCollisionPairs(m_broadphasePairCache->getOverlappingPairCache(), dispatchInfo, m_dispatcher1);
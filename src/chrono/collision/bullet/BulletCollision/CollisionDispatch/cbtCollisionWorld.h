@@ -83,6 +83,7 @@ class cbtSerializer;
 
 #include "chrono/core/ChTimer.h"      // ***CHRONO***
 #include "chrono/utils/ChProfiler.h"  // ***CHRONO***
+#include "chrono/utils/ChTraceProfiler.h"  // ***CHRONO***
 
 ///CollisionWorld is interface and container for the collision detection
 class cbtCollisionWorld
@@ -27,6 +27,7 @@
 #include "chrono/collision/bullet/cbtBulletCollisionCommon.h"
 #include "chrono/collision/gimpact/GIMPACT/Bullet/cbtGImpactCollisionAlgorithm.h"
 #include "chrono/collision/gimpact/GIMPACTUtils/cbtGImpactConvexDecompositionShape.h"
+#include "chrono/collision/ChCollisionGeometryCache.h"
 #include "chrono/collision/ChConvexDecomposition.h"
 #include "chrono/geometry/ChLineArc.h"
 #include "chrono/geometry/ChLineSegment.h"
@@ -54,6 +55,7 @@ ChCollisionModelBullet::ChCollisionModelBullet(ChCollisionModel* collision_model
 ChCollisionModelBullet::~ChCollisionModelBullet() {
     m_shapes.clear();
     m_bt_shapes.clear();
+    m_shared_data.clear();
 }
 
 // -----------------------------------------------------------------------------
@@ -228,13 +230,16 @@ void ChCollisionModelBullet::Populate() {
 
 void ChCollisionModelBullet::injectShape(std::shared_ptr<ChCollisionShape> shape,
                                          std::shared_ptr<cbtCollisionShape> bt_shape,
-                                         const ChFrame<>& frame) {
+                                         const ChFrame<>& frame,
+                                         bool shared) {
     auto full_margin = GetSuggestedFullMargin();
 
     bool centered = (frame.GetPos().IsNull() && frame.GetRot().IsIdentity());
 
-    // This is needed so one can later access the model's GetSafeMargin() and GetEnvelope()
-    bt_shape->setUserPointer(this);
+    // This is needed so one can later access the model's GetSafeMargin() and GetEnvelope().
+    // Shapes shared with other collision models are never modified.
+    if (!shared)
+        bt_shape->setUserPointer(this);
 
     if (m_bt_shapes.size() == 0) {  // ----------------------------------- this is the first shape added to the model
 
@@ -353,6 +358,130 @@ void ChCollisionModelBullet::injectPath2D(std::shared_ptr<ChCollisionShapePath2D
     }
 }
 
+// -----------------------------------------------------------------------------
+
+// Process-wide caches of collision geometry data shared across collision models (see
+// ChCollisionModel::EnableGeometrySharing). Bullet shapes cached here are never modified after creation.
+static ChCollisionGeometryCache<cbtCollisionShape>& GetShapeCache() {
+    static ChCollisionGeometryCache<cbtCollisionShape> cache;
+    return cache;
+}
+
+static ChCollisionGeometryCache<std::vector<std::vector<ChVector3d>>>& GetDecompositionCache() {
+    static ChCollisionGeometryCache<std::vector<std::vector<ChVector3d>>> cache;
+    return cache;
+}
+
+// Connectivity information for the triangle proxies of a connected mesh.
+// For each triangle: indices of the 3 face vertices and of the 3 edge (wing) vertices, and flags indicating whether
+// the triangle owns its vertices and edges.
+struct TriangleProxyTopology {
+    std::vector<std::array<int, 6>> vertices;
+    std::vector<std::array<bool, 6>> owns;
+};
+
+static ChCollisionGeometryCache<TriangleProxyTopology>& GetTopologyCache() {
+    static ChCollisionGeometryCache<TriangleProxyTopology> cache;
+    return cache;
+}
+
+static std::shared_ptr<TriangleProxyTopology> ComputeTriangleProxyTopology(ChTriangleMeshConnected& mesh) {
+    auto topology = chrono_types::make_shared<TriangleProxyTopology>();
+    topology->vertices.resize(mesh.m_face_v_indices.size());
+    topology->owns.resize(mesh.m_face_v_indices.size());
+
+    std::vector<std::array<int, 4>> trimap;
+    mesh.ComputeNeighbouringTriangleMap(trimap);
+
+    std::map<std::pair<int, int>, std::pair<int, int>> winged_edges;
+    mesh.ComputeWingedEdges(winged_edges, true);
+
+    std::vector<bool> added_vertexes(mesh.m_vertices.size());
+
+    // iterate on triangles
+    for (int it = 0; it < mesh.m_face_v_indices.size(); ++it) {
+        const auto& face = mesh.m_face_v_indices[it];
+
+        // edges = pairs of vertexes indexes
+        std::pair<int, int> medgeA(face.x(), face.y());
+        std::pair<int, int> medgeB(face.y(), face.z());
+        std::pair<int, int> medgeC(face.z(), face.x());
+        // vertex indexes in edges: always in increasing order to avoid ambiguous duplicated edges
+        if (medgeA.first > medgeA.second)
+            medgeA = std::pair<int, int>(medgeA.second, medgeA.first);
+        if (medgeB.first > medgeB.second)
+            medgeB = std::pair<int, int>(medgeB.second, medgeB.first);
+        if (medgeC.first > medgeC.second)
+            medgeC = std::pair<int, int>(medgeC.second, medgeC.first);
+        auto wingedgeA = winged_edges.find(medgeA);
+        auto wingedgeB = winged_edges.find(medgeB);
+        auto wingedgeC = winged_edges.find(medgeC);
+
+        int i_wingvertex_A = -1;
+        int i_wingvertex_B = -1;
+        int i_wingvertex_C = -1;
+
+        if (trimap[it][1] != -1) {
+            i_wingvertex_A = mesh.m_face_v_indices[trimap[it][1]].x();
+            if (mesh.m_face_v_indices[trimap[it][1]].y() != wingedgeA->first.first &&
+                mesh.m_face_v_indices[trimap[it][1]].y() != wingedgeA->first.second)
+                i_wingvertex_A = mesh.m_face_v_indices[trimap[it][1]].y();
+            if (mesh.m_face_v_indices[trimap[it][1]].z() != wingedgeA->first.first &&
+                mesh.m_face_v_indices[trimap[it][1]].z() != wingedgeA->first.second)
+                i_wingvertex_A = mesh.m_face_v_indices[trimap[it][1]].z();
+        }
+
+        if (trimap[it][2] != -1) {
+            i_wingvertex_B = mesh.m_face_v_indices[trimap[it][2]].x();
+            if (mesh.m_face_v_indices[trimap[it][2]].y() != wingedgeB->first.first &&
+                mesh.m_face_v_indices[trimap[it][2]].y() != wingedgeB->first.second)
+                i_wingvertex_B = mesh.m_face_v_indices[trimap[it][2]].y();
+            if (mesh.m_face_v_indices[trimap[it][2]].z() != wingedgeB->first.first &&
+                mesh.m_face_v_indices[trimap[it][2]].z() != wingedgeB->first.second)
+                i_wingvertex_B = mesh.m_face_v_indices[trimap[it][2]].z();
+        }
+
+        if (trimap[it][3] != -1) {
+            i_wingvertex_C = mesh.m_face_v_indices[trimap[it][3]].x();
+            if (mesh.m_face_v_indices[trimap[it][3]].y() != wingedgeC->first.first &&
+                mesh.m_face_v_indices[trimap[it][3]].y() != wingedgeC->first.second)
+                i_wingvertex_C = mesh.m_face_v_indices[trimap[it][3]].y();
+            if (mesh.m_face_v_indices[trimap[it][3]].z() != wingedgeC->first.first &&
+                mesh.m_face_v_indices[trimap[it][3]].z() != wingedgeC->first.second)
+                i_wingvertex_C = mesh.m_face_v_indices[trimap[it][3]].z();
+        }
+
+        // For a non-wing vertex (i.e. 'free' edge), point to opposite vertex, that is the vertex in triangle not
+        // belonging to edge. Indicate is an edge is owned by this triangle. Otherwise, they belong to a neighboring
+        // triangle.
+        topology->vertices[it] = {face.x(),                                                    // face nodes
+                                  face.y(),                                                    //
+                                  face.z(),                                                    //
+                                  wingedgeA->second.second != -1 ? i_wingvertex_A : face.z(),  // edge node 1
+                                  wingedgeB->second.second != -1 ? i_wingvertex_B : face.x(),  // edge node 2
+                                  wingedgeC->second.second != -1 ? i_wingvertex_C : face.y()};  // edge node 3
+        topology->owns[it] = {!added_vertexes[face.x()],      // face owns nodes?
+                              !added_vertexes[face.y()],      //
+                              !added_vertexes[face.z()],      //
+                              wingedgeA->second.first != -1,  // face owns edges?
+                              wingedgeB->second.first != -1,  //
+                              wingedgeC->second.first != -1};
+
+        // Mark added vertexes
+        added_vertexes[face.x()] = true;
+        added_vertexes[face.y()] = true;
+        added_vertexes[face.z()] = true;
+        // Mark added edges, setting to -1 the 'ti' id of 1st triangle in winged edge {{vi,vj}{ti,tj}}
+        wingedgeA->second.first = -1;
+        wingedgeB->second.first = -1;
+        wingedgeC->second.first = -1;
+    }
+
+    return topology;
+}
+
+// -----------------------------------------------------------------------------
+
 void ChCollisionModelBullet::injectConvexHull(std::shared_ptr<ChCollisionShapeConvexHull> shape_hull,
                                               const ChFrame<>& frame) {
     const auto& points = shape_hull->GetPoints();
@@ -372,21 +501,32 @@ void ChCollisionModelBullet::injectConvexHull(std::shared_ptr<ChCollisionShapeCo
     // override the inward margin if larger than 0.2 chord:
     model->SetSafeMargin((cbtScalar)std::min((double)safe_margin, approx_chord * 0.2));
 
-    // shrink the convex hull by GetSafeMargin()
-    bt_utils::ChConvexHullLibraryWrapper lh;
-    ChTriangleMeshConnected mmesh;
-    lh.ComputeHull(points, mmesh);
-    mmesh.MakeOffset(-safe_margin);
-
-    auto bt_shape = chrono_types::make_shared<cbtConvexHullShape>();
-    for (unsigned int i = 0; i < mmesh.m_vertices.size(); i++) {
-        bt_shape->addPoint(cbtVector3((cbtScalar)mmesh.m_vertices[i].x(), (cbtScalar)mmesh.m_vertices[i].y(),
-                                      (cbtScalar)mmesh.m_vertices[i].z()));
+    auto create_shape = [&]() -> std::shared_ptr<cbtCollisionShape> {
+        // shrink the convex hull by GetSafeMargin()
+        bt_utils::ChConvexHullLibraryWrapper lh;
+        ChTriangleMeshConnected mmesh;
+        lh.ComputeHull(points, mmesh);
+        mmesh.MakeOffset(-safe_margin);
+
+        auto bt_shape = chrono_types::make_shared<cbtConvexHullShape>();
+        for (unsigned int i = 0; i < mmesh.m_vertices.size(); i++) {
+            bt_shape->addPoint(cbtVector3((cbtScalar)mmesh.m_vertices[i].x(), (cbtScalar)mmesh.m_vertices[i].y(),
+                                          (cbtScalar)mmesh.m_vertices[i].z()));
+        }
+        bt_shape->setMargin((cbtScalar)full_margin);
+        bt_shape->recalcLocalAabb();
+        return bt_shape;
+    };
+
+    if (ChCollisionModel::IsGeometrySharingEnabled()) {
+        ChCollisionGeometryKey key("bullet_convex_hull");
+        key.Add((double)safe_margin);
+        key.Add((double)full_margin);
+        key.Add(points);
+        injectShape(shape_hull, GetShapeCache().Get(key, create_shape), frame, true);
+    } else {
+        injectShape(shape_hull, create_shape(), frame);
     }
-    bt_shape->setMargin((cbtScalar)full_margin);
-    bt_shape->recalcLocalAabb();
-
-    injectShape(shape_hull, bt_shape, frame);
 }
 
 // -----------------------------------------------------------------------------
@@ -454,168 +594,144 @@ void ChCollisionModelBullet::injectTriangleMesh(std::shared_ptr<ChCollisionShape
     if (!trimesh->GetNumTriangles())
         return;
 
-    if (auto mesh = std::dynamic_pointer_cast<ChTriangleMeshConnected>(trimesh)) {
-        std::vector<std::array<int, 4>> trimap;
-        mesh->ComputeNeighbouringTriangleMap(trimap);
-
-        std::map<std::pair<int, int>, std::pair<int, int>> winged_edges;
-        mesh->ComputeWingedEdges(winged_edges, true);
+    bool sharing = ChCollisionModel::IsGeometrySharingEnabled();
 
-        std::vector<bool> added_vertexes(mesh->m_vertices.size());
+    if (auto mesh = std::dynamic_pointer_cast<ChTriangleMeshConnected>(trimesh)) {
+        // The connectivity of the triangle proxies depends only on the mesh topology and can be shared
+        std::shared_ptr<TriangleProxyTopology> topology;
+        if (sharing) {
+            ChCollisionGeometryKey key("bullet_triangle_proxies");
+            key.Add((int)mesh->m_vertices.size());
+            key.Add(mesh->m_face_v_indices);
+            topology = GetTopologyCache().Get(key, [&]() { return ComputeTriangleProxyTopology(*mesh); });
+            m_shared_data.push_back(topology);
+        } else {
+            topology = ComputeTriangleProxyTopology(*mesh);
+        }
 
         // iterate on triangles
         for (int it = 0; it < mesh->m_face_v_indices.size(); ++it) {
-            // edges = pairs of vertexes indexes
-            std::pair<int, int> medgeA(mesh->m_face_v_indices[it].x(), mesh->m_face_v_indices[it].y());
-            std::pair<int, int> medgeB(mesh->m_face_v_indices[it].y(), mesh->m_face_v_indices[it].z());
-            std::pair<int, int> medgeC(mesh->m_face_v_indices[it].z(), mesh->m_face_v_indices[it].x());
-            // vertex indexes in edges: always in increasing order to avoid ambiguous duplicated edges
-            if (medgeA.first > medgeA.second)
-                medgeA = std::pair<int, int>(medgeA.second, medgeA.first);
-            if (medgeB.first > medgeB.second)
-                medgeB = std::pair<int, int>(medgeB.second, medgeB.first);
-            if (medgeC.first > medgeC.second)
-                medgeC = std::pair<int, int>(medgeC.second, medgeC.first);
-            auto wingedgeA = winged_edges.find(medgeA);
-            auto wingedgeB = winged_edges.find(medgeB);
-            auto wingedgeC = winged_edges.find(medgeC);
-
-            int i_wingvertex_A = -1;
-            int i_wingvertex_B = -1;
-            int i_wingvertex_C = -1;
-
-            if (trimap[it][1] != -1) {
-                i_wingvertex_A = mesh->m_face_v_indices[trimap[it][1]].x();
-                if (mesh->m_face_v_indices[trimap[it][1]].y() != wingedgeA->first.first &&
-                    mesh->m_face_v_indices[trimap[it][1]].y() != wingedgeA->first.second)
-                    i_wingvertex_A = mesh->m_face_v_indices[trimap[it][1]].y();
-                if (mesh->m_face_v_indices[trimap[it][1]].z() != wingedgeA->first.first &&
-                    mesh->m_face_v_indices[trimap[it][1]].z() != wingedgeA->first.second)
-                    i_wingvertex_A = mesh->m_face_v_indices[trimap[it][1]].z();
-            }
-
-            if (trimap[it][2] != -1) {
-                i_wingvertex_B = mesh->m_face_v_indices[trimap[it][2]].x();
-                if (mesh->m_face_v_indices[trimap[it][2]].y() != wingedgeB->first.first &&
-                    mesh->m_face_v_indices[trimap[it][2]].y() != wingedgeB->first.second)
-                    i_wingvertex_B = mesh->m_face_v_indices[trimap[it][2]].y();
-                if (mesh->m_face_v_indices[trimap[it][2]].z() != wingedgeB->first.first &&
-                    mesh->m_face_v_indices[trimap[it][2]].z() != wingedgeB->first.second)
-                    i_wingvertex_B = mesh->m_face_v_indices[trimap[it][2]].z();
-            }
-
-            if (trimap[it][3] != -1) {
-                i_wingvertex_C = mesh->m_face_v_indices[trimap[it][3]].x();
-                if (mesh->m_face_v_indices[trimap[it][3]].y() != wingedgeC->first.first &&
-                    mesh->m_face_v_indices[trimap[it][3]].y() != wingedgeC->first.second)
-                    i_wingvertex_C = mesh->m_face_v_indices[trimap[it][3]].y();
-                if (mesh->m_face_v_indices[trimap[it][3]].z() != wingedgeC->first.first &&
-                    mesh->m_face_v_indices[trimap[it][3]].z() != wingedgeC->first.second)
-                    i_wingvertex_C = mesh->m_face_v_indices[trimap[it][3]].z();
-            }
+            const auto& v = topology->vertices[it];
+            const auto& owns = topology->owns[it];
 
             // Add a mesh triangle collision shape (triangle with connectivity information).
-            // For a non-wing vertex (i.e. 'free' edge), point to opposite vertex, that is the vertex in triangle not
-            // belonging to edge. Indicate is an edge is owned by this triangle. Otherwise, they belong to a neighboring
-            // triangle.
             auto shape_triangle = chrono_types::make_shared<ChCollisionShapeMeshTriangle>(
-                shape_trimesh->GetMaterial(),                                                        // contact material
-                &mesh->m_vertices[mesh->m_face_v_indices[it].x()],                                   // face nodes
-                &mesh->m_vertices[mesh->m_face_v_indices[it].y()],                                   //
-                &mesh->m_vertices[mesh->m_face_v_indices[it].z()],                                   //
-                wingedgeA->second.second != -1 ? &mesh->m_vertices[i_wingvertex_A]                   // edge node 1
-                                               : &mesh->m_vertices[mesh->m_face_v_indices[it].z()],  //
-                wingedgeB->second.second != -1 ? &mesh->m_vertices[i_wingvertex_B]                   // edge node 2
-                                               : &mesh->m_vertices[mesh->m_face_v_indices[it].x()],  //
-                wingedgeC->second.second != -1 ? &mesh->m_vertices[i_wingvertex_C]                   // edge node 3
-                                               : &mesh->m_vertices[mesh->m_face_v_indices[it].y()],  //
-                !added_vertexes[mesh->m_face_v_indices[it].x()],                                     // face owns nodes?
-                !added_vertexes[mesh->m_face_v_indices[it].y()],                                     //
-                !added_vertexes[mesh->m_face_v_indices[it].z()],                                     //
-                wingedgeA->second.first != -1,                                                       // face owns edges?
-                wingedgeB->second.first != -1,                                                       //
-                wingedgeC->second.first != -1,                                                       //
-                radius                                                                               // thickness
+                shape_trimesh->GetMaterial(),                                                // contact material
+                &mesh->m_vertices[v[0]], &mesh->m_vertices[v[1]], &mesh->m_vertices[v[2]],  // face nodes
+                &mesh->m_vertices[v[3]], &mesh->m_vertices[v[4]], &mesh->m_vertices[v[5]],  // edge nodes
+                owns[0], owns[1], owns[2],                                                   // face owns nodes?
+                owns[3], owns[4], owns[5],                                                   // face owns edges?
+                radius                                                                       // thickness
             );
 
             injectTriangleProxy(shape_triangle);
-
-            // Mark added vertexes
-            added_vertexes[mesh->m_face_v_indices[it].x()] = true;
-            added_vertexes[mesh->m_face_v_indices[it].y()] = true;
-            added_vertexes[mesh->m_face_v_indices[it].z()] = true;
-            // Mark added edges, setting to -1 the 'ti' id of 1st triangle in winged edge {{vi,vj}{ti,tj}}
-            wingedgeA->second.first = -1;
-            wingedgeB->second.first = -1;
-            wingedgeC->second.first = -1;
         }
         return;
     }
 
-    cbtTriangleMesh* bulletMesh = new cbtTriangleMesh;
-    for (auto i = 0; i < trimesh->GetNumTriangles(); i++) {
-        bulletMesh->addTriangle(cbtVector3CH(trimesh->GetTriangle(i).p1),  //
-                                cbtVector3CH(trimesh->GetTriangle(i).p2),  //
-                                cbtVector3CH(trimesh->GetTriangle(i).p3),  //
-                                true                                       // try to remove duplicate vertices
-        );
-    }
+    // Create the Bullet triangle mesh interface (owned by the Bullet shape)
+    auto create_bullet_mesh = [&]() {
+        cbtTriangleMesh* bulletMesh = new cbtTriangleMesh;
+        for (auto i = 0; i < trimesh->GetNumTriangles(); i++) {
+            bulletMesh->addTriangle(cbtVector3CH(trimesh->GetTriangle(i).p1),  //
+                                    cbtVector3CH(trimesh->GetTriangle(i).p2),  //
+                                    cbtVector3CH(trimesh->GetTriangle(i).p3),  //
+                                    true                                       // try to remove duplicate vertices
+            );
+        }
+        return bulletMesh;
+    };
 
     if (is_static) {
         // Here a static cbtBvhTriangleMeshShape suffices, but cbtGImpactMeshShape might work better?
-        auto bt_shape = chrono_types::make_shared<cbtBvhTriangleMeshShape_handlemesh>(bulletMesh);
-        bt_shape->setMargin((cbtScalar)safe_margin);
-        injectShape(shape_trimesh, bt_shape, frame);
+        auto create_shape = [&]() -> std::shared_ptr<cbtCollisionShape> {
+            auto bt_shape = chrono_types::make_shared<cbtBvhTriangleMeshShape_handlemesh>(create_bullet_mesh());
+            bt_shape->setMargin((cbtScalar)safe_margin);
+            return bt_shape;
+        };
+        if (sharing) {
+            ChCollisionGeometryKey key("bullet_bvh_mesh");
+            key.Add((double)safe_margin);
+            key.Add(*trimesh);
+            injectShape(shape_trimesh, GetShapeCache().Get(key, create_shape), frame, true);
+        } else {
+            injectShape(shape_trimesh, create_shape(), frame);
+        }
         return;
     }
 
     if (is_convex) {
-        auto bt_shape = chrono_types::make_shared<cbtConvexTriangleMeshShape_handlemesh>(bulletMesh);
-        bt_shape->setMargin((cbtScalar)envelope);
-        injectShape(shape_trimesh, bt_shape, frame);
+        auto create_shape = [&]() -> std::shared_ptr<cbtCollisionShape> {
+            auto bt_shape = chrono_types::make_shared<cbtConvexTriangleMeshShape_handlemesh>(create_bullet_mesh());
+            bt_shape->setMargin((cbtScalar)envelope);
+            return bt_shape;
+        };
+        if (sharing) {
+            ChCollisionGeometryKey key("bullet_convex_mesh");
+            key.Add((double)envelope);
+            key.Add(*trimesh);
+            injectShape(shape_trimesh, GetShapeCache().Get(key, create_shape), frame, true);
+        } else {
+            injectShape(shape_trimesh, create_shape(), frame);
+        }
     } else {
         // Note: currently there's no 'perfect' convex decomposition method, so code here is a bit experimental...
+        auto decompose = [&]() {
+            /*
+            // using the HACD convex decomposition
+            auto decomposition = chrono_types::make_shared<ChConvexDecompositionHACD>();
+            decomposition->AddTriangleMesh(*trimesh);
+            decomposition->SetParameters(2,      // clusters
+                                         0,      // no decimation
+                                         0.0,    // small cluster threshold
+                                         false,  // add faces points
+                                         false,  // add extra dist points
+                                         100.0,  // max concavity
+                                         30,     // cc connect dist
+                                         0.0,    // volume weight beta
+                                         0.0,    // compacity alpha
+                                         50      // vertices per cc
+            );
+            */
+
+            // using HACDv2 convex decomposition
+            auto decomposition = chrono_types::make_shared<ChConvexDecompositionHACDv2>();
+            decomposition->Reset();
+            decomposition->AddTriangleMesh(*trimesh);
+            decomposition->SetParameters(512,   // max hull count
+                                         256,   // max hull merge
+                                         64,    // max hull vettices
+                                         0.2f,  // concavity
+                                         0.0f,  // small cluster threshold
+                                         1e-9f  // fuse tolerance
+            );
 
-        /*
-        // using the HACD convex decomposition
-        auto decomposition = chrono_types::make_shared<ChConvexDecompositionHACD>();
-        decomposition->AddTriangleMesh(*trimesh);
-        decomposition->SetParameters(2,      // clusters
-                                     0,      // no decimation
-                                     0.0,    // small cluster threshold
-                                     false,  // add faces points
-                                     false,  // add extra dist points
-                                     100.0,  // max concavity
-                                     30,     // cc connect dist
-                                     0.0,    // volume weight beta
-                                     0.0,    // compacity alpha
-                                     50      // vertices per cc
-        );
-        */
-
-        // using HACDv2 convex decomposition
-        auto decomposition = chrono_types::make_shared<ChConvexDecompositionHACDv2>();
-        decomposition->Reset();
-        decomposition->AddTriangleMesh(*trimesh);
-        decomposition->SetParameters(512,   // max hull count
-                                     256,   // max hull merge
-                                     64,    // max hull vettices
-                                     0.2f,  // concavity
-                                     0.0f,  // small cluster threshold
-                                     1e-9f  // fuse tolerance
-        );
-
-        decomposition->ComputeConvexDecomposition();
+            decomposition->ComputeConvexDecomposition();
 
-        model->SetSafeMargin(0);
-        for (unsigned int j = 0; j < decomposition->GetHullCount(); j++) {
-            std::vector<ChVector3d> ptlist;
-            decomposition->GetConvexHullResult(j, ptlist);
-            if (ptlist.size() > 0) {
-                auto shape_hull =
-                    chrono_types::make_shared<ChCollisionShapeConvexHull>(shape_trimesh->GetMaterial(), ptlist);
-                injectConvexHull(shape_hull, frame);
+            auto hulls = chrono_types::make_shared<std::vector<std::vector<ChVector3d>>>();
+            for (unsigned int j = 0; j < decomposition->GetHullCount(); j++) {
+                std::vector<ChVector3d> ptlist;
+                decomposition->GetConvexHullResult(j, ptlist);
+                if (ptlist.size() > 0)
+                    hulls->push_back(ptlist);
             }
+            return hulls;
+        };
+
+        std::shared_ptr<std::vector<std::vector<ChVector3d>>> hulls;
+        if (sharing) {
+            ChCollisionGeometryKey key("hacdv2_decomposition");
+            key.Add(*trimesh);
+            hulls = GetDecompositionCache().Get(key, decompose);
+            m_shared_data.push_back(hulls);
+        } else {
+            hulls = decompose();
+        }
+
+        model->SetSafeMargin(0);
+        for (const auto& ptlist : *hulls) {
+            auto shape_hull = chrono_types::make_shared<ChCollisionShapeConvexHull>(shape_trimesh->GetMaterial(), ptlist);
+            injectConvexHull(shape_hull, frame);
         }
     }
 }
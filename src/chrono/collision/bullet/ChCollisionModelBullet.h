@@ -69,9 +69,12 @@ class ChApi ChCollisionModelBullet : public ChCollisionModelImpl {
     /// Additional operations to be performed on a change in collision family.
     virtual void OnFamilyChange(short int family_group, short int family_mask) override;
 
+    /// Add the given Bullet shape to this model.
+    /// If shared=true, the Bullet shape is shared with other collision models (see EnableGeometrySharing).
     void injectShape(std::shared_ptr<ChCollisionShape> shape,
                      std::shared_ptr<cbtCollisionShape> bt_shape,
-                     const ChFrame<>& frame);
+                     const ChFrame<>& frame,
+                     bool shared = false);
 
     void injectPath2D(std::shared_ptr<ChCollisionShapePath2D> shape_path, const ChFrame<>& frame);
     void injectConvexHull(std::shared_ptr<ChCollisionShapeConvexHull> shape_hull, const ChFrame<>& frame);
@@ -88,6 +91,7 @@ class ChApi ChCollisionModelBullet : public ChCollisionModelImpl {
 
     std::vector<std::shared_ptr<cbtCollisionShape>> m_bt_shapes;  ///< list of Bullet collision shapes in model
     std::vector<std::shared_ptr<ChCollisionShape>> m_shapes;      ///< extended list of collision shapes
+    std::vector<std::shared_ptr<void>> m_shared_data;             ///< shared geometry data used by this model
 
     friend class ChCollisionSystemBullet;
     friend class ChCollisionSystemBulletMulticore;
@@ -20,12 +20,15 @@
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChParticleCloud.h"
 #include "chrono/fea/ChMesh.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 #include "chrono/collision/bullet/ChCollisionSystemBullet.h"
 #include "chrono/collision/bullet/ChCollisionModelBullet.h"
 #include "chrono/collision/bullet/ChCollisionAlgorithmsBullet.h"
 #include "chrono/collision/gimpact/GIMPACT/Bullet/cbtGImpactCollisionAlgorithm.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionDispatch/cbtCollisionDispatcherMt.h"
+#include "chrono/collision/bullet/BulletCollision/BroadphaseCollision/cbtDbvtBroadphase.h"
+#include "chrono/collision/bullet/LinearMath/cbtAabbUtil2.h"
 #include "chrono/collision/bullet/LinearMath/cbtIDebugDraw.h"
 
 extern cbtScalar gContactBreakingThreshold;
@@ -184,6 +187,12 @@ void ChCollisionSystemBullet::Remove(ChCollisionModelBullet* bt_model, bool eras
     }
 }
 
+void ChCollisionSystemBullet::SetDeterministic(bool val) {
+    ChCollisionSystem::SetDeterministic(val);
+    // process overlapping pairs (and hence create contact manifolds) in the order of the broadphase proxy IDs
+    bt_collision_world->getDispatchInfo().m_deterministicOverlappingPairs = val;
+}
+
 void ChCollisionSystemBullet::Run() {
     if (bt_collision_world) {
         bt_collision_world->performDiscreteCollisionDetection();
@@ -279,6 +288,12 @@ void ChCollisionSystemBullet::ReportContacts(ChContactContainer* mcontactcontain
                     icontact.shapeA = bt_modelA->m_shapes[indexA].get();
                     icontact.shapeB = bt_modelB->m_shapes[indexB].get();
 
+                    // In deterministic mode, collect the contacts and report them in canonical order
+                    if (m_deterministic) {
+                        m_contact_buffer.push_back(icontact);
+                        continue;
+                    }
+
                     // Execute some user custom callback, if any
                     bool add_contact = true;
                     if (this->narrow_callback)
@@ -299,6 +314,10 @@ void ChCollisionSystemBullet::ReportContacts(ChContactContainer* mcontactcontain
         // Uncomment this line to remove all points
         ////contactManifold->clearManifold();
     }
+
+    if (m_deterministic)
+        AddSortedContacts(mcontactcontainer);
+
     mcontactcontainer->EndAddContact();
 }
 
@@ -415,6 +434,113 @@ bool ChCollisionSystemBullet::RayHit(const ChVector3d& from,
     return true;
 }
 
+// Number of consecutive rays processed together in RayHitBatch
+static const int ray_packet_size = 32;
+
+// Collect the collision objects associated with the broadphase tree leaves overlapping a given volume
+struct BroadphaseLeafCollector : cbtDbvt::ICollide {
+    BroadphaseLeafCollector(std::vector<cbtCollisionObject*>& objects) : objects(objects) {}
+    virtual void Process(const cbtDbvtNode* leaf) override {
+        auto proxy = static_cast<cbtBroadphaseProxy*>(leaf->data);
+        objects.push_back(static_cast<cbtCollisionObject*>(proxy->m_clientObject));
+    }
+    std::vector<cbtCollisionObject*>& objects;
+};
+
+int ChCollisionSystemBullet::RayHitBatch(const std::vector<ChRay>& rays, std::vector<ChRayhitResult>& results) const {
+    CH_TRACE_ZONE("RayHitBatch");
+
+    int num_rays = (int)rays.size();
+    int num_packets = (num_rays + ray_packet_size - 1) / ray_packet_size;
+    int nthreads = m_system ? m_system->GetNumThreadsCollision() : 1;
+    int num_hits = 0;
+
+    results.resize(rays.size());
+
+    // Note: the dynamic and static broadphase trees are only queried through the re-entrant collideTV (which uses a
+    // local traversal stack), so that packets can be processed concurrently.
+    auto broadphase = static_cast<cbtDbvtBroadphase*>(bt_broadphase);
+
+#pragma omp parallel num_threads(nthreads) reduction(+ : num_hits)
+    {
+        CH_TRACE_ZONE("RayHitBatch (thread)");
+        std::vector<cbtCollisionObject*> candidates;
+        BroadphaseLeafCollector collector(candidates);
+
+#pragma omp for schedule(dynamic)
+        for (int ip = 0; ip < num_packets; ip++) {
+            int start = ip * ray_packet_size;
+            int end = std::min(start + ray_packet_size, num_rays);
+
+            // Bounding box of all rays in this packet
+            cbtVector3 aabb_min(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+            cbtVector3 aabb_max(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+            for (int i = start; i < end; i++) {
+                cbtVector3 from((cbtScalar)rays[i].from.x(), (cbtScalar)rays[i].from.y(), (cbtScalar)rays[i].from.z());
+                cbtVector3 to((cbtScalar)rays[i].to.x(), (cbtScalar)rays[i].to.y(), (cbtScalar)rays[i].to.z());
+                aabb_min.setMin(from);
+                aabb_min.setMin(to);
+                aabb_max.setMax(from);
+                aabb_max.setMax(to);
+            }
+
+            // Single traversal of the broadphase trees for the entire packet
+            candidates.clear();
+            auto volume = cbtDbvtVolume::FromMM(aabb_min, aabb_max);
+            broadphase->m_sets[0].collideTV(broadphase->m_sets[0].m_root, volume, collector);
+            broadphase->m_sets[1].collideTV(broadphase->m_sets[1].m_root, volume, collector);
+
+            // Test each ray in the packet against the candidate objects
+            for (int i = start; i < end; i++) {
+                auto& result = results[i];
+                result.hit = false;
+
+                cbtVector3 from((cbtScalar)rays[i].from.x(), (cbtScalar)rays[i].from.y(), (cbtScalar)rays[i].from.z());
+                cbtVector3 to((cbtScalar)rays[i].to.x(), (cbtScalar)rays[i].to.y(), (cbtScalar)rays[i].to.z());
+                cbtTransform from_trans(cbtQuaternion::getIdentity(), from);
+                cbtTransform to_trans(cbtQuaternion::getIdentity(), to);
+
+                cbtCollisionWorld::ClosestRayResultCallback rayCallback(from, to);
+                rayCallback.m_collisionFilterGroup = cbtBroadphaseProxy::DefaultFilter;
+                rayCallback.m_collisionFilterMask = cbtBroadphaseProxy::AllFilter;
+
+                for (auto object : candidates) {
+                    if (rayCallback.m_closestHitFraction == cbtScalar(0))
+                        break;
+                    auto proxy = object->getBroadphaseHandle();
+                    if (!rayCallback.needsCollision(proxy))
+                        continue;
+                    // Quick rejection (ray vs. object AABB, up to the current closest hit)
+                    cbtScalar param = rayCallback.m_closestHitFraction;
+                    cbtVector3 normal;
+                    if (!cbtRayAabb(from, to, proxy->m_aabbMin, proxy->m_aabbMax, param, normal))
+                        continue;
+                    cbtCollisionWorld::rayTestSingle(from_trans, to_trans, object, object->getCollisionShape(),
+                                                     object->getWorldTransform(), rayCallback);
+                }
+
+                if (!rayCallback.hasHit())
+                    continue;
+                auto bt_model = static_cast<ChCollisionModelBullet*>(rayCallback.m_collisionObject->getUserPointer());
+                result.hitModel = bt_model->model;
+                if (!result.hitModel)
+                    continue;
+                result.hit = true;
+                result.abs_hitPoint.Set(rayCallback.m_hitPointWorld.x(), rayCallback.m_hitPointWorld.y(),
+                                        rayCallback.m_hitPointWorld.z());
+                result.abs_hitNormal.Set(rayCallback.m_hitNormalWorld.x(), rayCallback.m_hitNormalWorld.y(),
+                                         rayCallback.m_hitNormalWorld.z());
+                result.abs_hitNormal.Normalize();
+                result.dist_factor = rayCallback.m_closestHitFraction;
+                result.abs_hitPoint = result.abs_hitPoint - result.abs_hitNormal * result.hitModel->GetEnvelope();
+                num_hits++;
+            }
+        }
+    }
+
+    return num_hits;
+}
+
 void ChCollisionSystemBullet::SetContactBreakingThreshold(double threshold) {
     gContactBreakingThreshold = (cbtScalar)threshold;
 }
@@ -52,6 +52,11 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// Set the number of OpenMP threads for collision detection.
     virtual void SetNumThreads(int nthreads) override;
 
+    /// Enable/disable the deterministic mode.
+    /// If enabled, overlapping broadphase pairs are processed in sorted order and contacts are reported in canonical
+    /// order.
+    virtual void SetDeterministic(bool val) override;
+
     /// Run the algorithm and finds all the contacts.
     /// (Contacts will be managed by the Bullet persistent contact cache).
     virtual void Run() override;
@@ -95,6 +100,13 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
                         ChCollisionModel* model,
                         ChRayhitResult& result) const override;
 
+    /// Perform ray-hit tests for a batch of rays with all collision models.
+    /// Rays are processed concurrently, in packets of consecutive rays, using ChSystem::GetNumThreadsCollision()
+    /// threads. For each packet, the broadphase tree is traversed only once to collect the collision objects overlapping
+    /// the packet bounding box; these candidates are then tested against each ray in the packet. Best performance is
+    /// obtained if consecutive rays in the batch are spatially coherent.
+    virtual int RayHitBatch(const std::vector<ChRay>& rays, std::vector<ChRayhitResult>& results) const override;
+
     /// Specify a callback object to be used for debug rendering of collision shapes.
     virtual void RegisterVisualizationCallback(std::shared_ptr<VisualizationCallback> callback) override;
 
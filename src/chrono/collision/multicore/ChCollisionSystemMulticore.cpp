@@ -21,6 +21,7 @@
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChParticleCloud.h"
 #include "chrono/utils/ChProfiler.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 #include "chrono/collision/multicore/ChCollisionSystemMulticore.h"
 #include "chrono/collision/multicore/ChRayTest.h"
@@ -90,13 +91,8 @@ void ChCollisionSystemMulticore::Add(std::shared_ptr<ChCollisionModel> model) {
     auto body_id = ct_model->GetBody()->GetIndex();
     short2 fam = S2(ct_model->model->GetFamilyGroup(), ct_model->model->GetFamilyMask());
 
-    // The offset for this shape will the current total number of points in the convex data list
     auto& shape_data = cd_data->shape_data;
-    int convex_data_offset = (int)shape_data.convex_rigid.size();
-
-    // Insert the points into the global convex list
-    shape_data.convex_rigid.insert(shape_data.convex_rigid.end(), ct_model->local_convex_data.begin(),
-                                   ct_model->local_convex_data.end());
+    bool sharing = ChCollisionModel::IsGeometrySharingEnabled();
 
     // Shape index in the collision model
     int local_shape_index = 0;
@@ -153,10 +149,24 @@ void ChCollisionSystemMulticore::Add(std::shared_ptr<ChCollisionModel> model) {
                 start = (int)shape_data.rbox_like_rigid.size();
                 shape_data.rbox_like_rigid.push_back(real4(obB, obC.x));
                 break;
-            case ChCollisionShape::Type::CONVEXHULL:
-                start = (int)(obB.y + convex_data_offset);
+            case ChCollisionShape::Type::CONVEXHULL: {
+                // Insert the points into the global convex list, unless an identical point set already exists
                 length = (int)obB.x;
+                auto first = ct_model->local_convex_data.begin() + (int)obB.y;
+                start = (int)shape_data.convex_rigid.size();
+                if (sharing) {
+                    ChCollisionGeometryKey key("multicore_convex_hull");
+                    for (auto p = first; p != first + length; ++p)
+                        key.Add(ChVector3d(p->x, p->y, p->z));
+                    auto found = convex_offsets.emplace(key, start);
+                    if (!found.second) {
+                        start = found.first->second;
+                        break;
+                    }
+                }
+                shape_data.convex_rigid.insert(shape_data.convex_rigid.end(), first, first + length);
                 break;
+            }
             case ChCollisionShape::Type::TRIANGLE:
                 start = (int)shape_data.triangle_rigid.size();
                 shape_data.triangle_rigid.push_back(obA);
@@ -304,6 +314,7 @@ void ChCollisionSystemMulticore::Run() {
     // Broadphase
     {
         CH_PROFILE("Broad-phase");
+        CH_TRACE_ZONE("Broad-phase");
         m_timer_broad.start();
         GenerateAABB();
         broadphase.Process();
@@ -313,6 +324,7 @@ void ChCollisionSystemMulticore::Run() {
     // Narrowphase
     {
         CH_PROFILE("Narrow-phase");
+        CH_TRACE_ZONE("Narrow-phase");
         m_timer_narrow.start();
         narrowphase.Process();
         m_timer_narrow.stop();
@@ -357,6 +369,12 @@ void ChCollisionSystemMulticore::ReportContacts(ChContactContainer* container) {
         cinfo.distance = cd_data->dpth_rigid_rigid[i];
         cinfo.eff_radius = cd_data->erad_rigid_rigid[i];
 
+        // In deterministic mode, collect the contacts and report them in canonical order
+        if (m_deterministic) {
+            m_contact_buffer.push_back(cinfo);
+            continue;
+        }
+
         // Execute user custom callback, if any
         bool add_contact = true;
         if (this->narrow_callback)
@@ -366,6 +384,9 @@ void ChCollisionSystemMulticore::ReportContacts(ChContactContainer* container) {
             container->AddContact(cinfo);
     }
 
+    if (m_deterministic)
+        AddSortedContacts(container);
+
     container->EndAddContact();
 }
 
@@ -605,6 +626,44 @@ bool ChCollisionSystemMulticore::RayHit(const ChVector3d& from,
     return false;
 }
 
+int ChCollisionSystemMulticore::RayHitBatch(const std::vector<ChRay>& rays,
+                                            std::vector<ChRayhitResult>& results) const {
+    int num_rays = (int)rays.size();
+    int nthreads = m_system ? m_system->GetNumThreadsCollision() : 1;
+    int num_hits = 0;
+
+    results.resize(rays.size());
+
+    if (cd_data->num_active_bins == 0) {
+        for (auto& result : results)
+            result.hit = false;
+        return 0;
+    }
+
+    // Each thread uses its own ray tester (which records traversal statistics); the broadphase grid is shared.
+#pragma omp parallel num_threads(nthreads) reduction(+ : num_hits)
+    {
+        ChRayTest tester(cd_data);
+        ChRayTest::RayHitInfo info;
+
+#pragma omp for schedule(dynamic, 64)
+        for (int i = 0; i < num_rays; i++) {
+            auto& result = results[i];
+            result.hit = tester.Check(FromChVector(rays[i].from), FromChVector(rays[i].to), info);
+            if (!result.hit)
+                continue;
+            result.abs_hitNormal = ToChVector(info.normal);
+            result.abs_hitPoint = ToChVector(info.point);
+            result.dist_factor = info.t;
+            uint bid = cd_data->shape_data.id_rigid[info.shapeID];
+            result.hitModel = m_system->GetBodies()[bid]->GetCollisionModel().get();
+            num_hits++;
+        }
+    }
+
+    return num_hits;
+}
+
 // -----------------------------------------------------------------------------
 
 void DrawHemisphere(ChCollisionSystem::VisualizationCallback* vis,
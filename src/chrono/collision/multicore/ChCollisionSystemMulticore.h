@@ -23,6 +23,7 @@
 #include "chrono/core/ChTimer.h"
 
 #include "chrono/collision/ChCollisionSystem.h"
+#include "chrono/collision/ChCollisionGeometryCache.h"
 #include "chrono/collision/multicore/ChCollisionModelMulticore.h"
 #include "chrono/collision/multicore/ChCollisionData.h"
 #include "chrono/collision/multicore/ChBroadphase.h"
@@ -136,6 +137,10 @@ class ChApi ChCollisionSystemMulticore : public ChCollisionSystem {
                         ChCollisionModel* model,
                         ChRayhitResult& result) const override;
 
+    /// Perform ray-hit tests for a batch of rays with all collision models.
+    /// Rays are processed concurrently, using ChSystem::GetNumThreadsCollision() threads.
+    virtual int RayHitBatch(const std::vector<ChRay>& rays, std::vector<ChRayhitResult>& results) const override;
+
     /// Method to trigger debug visualization of collision shapes.
     /// The 'flags' argument can be any of the VisualizationModes enums, or a combination thereof (using bit-wise
     /// operators). The calling program must invoke this function from within the simulation loop. No-op if a
@@ -171,6 +176,10 @@ class ChApi ChCollisionSystemMulticore : public ChCollisionSystem {
 
     std::shared_ptr<ChCollisionData> cd_data;
 
+    /// Offsets in the global convex data list of the point sets of all convex hulls added so far.
+    /// Convex hulls with identical point sets share the same data (see ChCollisionModel::EnableGeometrySharing).
+    std::unordered_map<ChCollisionGeometryKey, int, ChCollisionGeometryKey::Hasher> convex_offsets;
+
     ChBroadphase broadphase;    ///< methods for broad-phase collision detection
     ChNarrowphase narrowphase;  ///< methods for narrow-phase collision detection
 
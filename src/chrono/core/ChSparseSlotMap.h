@@ -0,0 +1,120 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2024 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#ifndef CHSPARSESLOTMAP_H
+#define CHSPARSESLOTMAP_H
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "chrono/core/ChMatrix.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_linalg
+/// @{
+
+/// Utility class for refilling the values of a compressed sparse matrix with a fixed sparsity pattern.
+/// Derived from ChSparseMatrix, ChSparseSlotMap does not store any elements. Instead, calls to SetElement are
+/// redirected to a target compressed matrix. The position in the target value array of each element set through
+/// SetElement is cached, in the order of the calls, so that subsequent passes issuing the same sequence of calls (e.g.,
+/// ChSystemDescriptor::BuildSystemMatrix with unchanged KRM blocks and constraints) write directly to the proper slots,
+/// without any search or insertion.
+///
+/// If the sequence of calls changes, slots are searched for and the cache updated. If an element does not exist in
+/// the sparsity pattern of the target matrix, it is ignored and the pass is flagged as failed (see End).
+class ChSparseSlotMap : public Eigen::SparseMatrix<double, Eigen::RowMajor, int> {
+  public:
+    ChSparseSlotMap() : m_target(nullptr), m_cursor(0), m_missing(false) {}
+
+    ~ChSparseSlotMap() {}
+
+    /// Start a new pass over the specified target matrix.
+    /// The target matrix must be in compressed mode. All its values are set to zero.
+    void Begin(ChSparseMatrix& mat) {
+        assert(mat.isCompressed());
+        resize(mat.rows(), mat.cols());
+        m_target = &mat;
+        std::fill_n(m_target->valuePtr(), m_target->nonZeros(), 0.0);
+        m_cursor = 0;
+        m_missing = false;
+    }
+
+    /// Finish the current pass.
+    /// Return false if any of the elements set during this pass was not found in the target sparsity pattern.
+    bool End() {
+        m_slots.resize(m_cursor);
+        m_target = nullptr;
+        return !m_missing;
+    }
+
+    /// Discard all cached slots.
+    void Reset() { m_slots.clear(); }
+
+    /// Return the number of cached slots.
+    size_t GetNumSlots() const { return m_slots.size(); }
+
+    virtual void SetElement(int row, int col, double val, bool overwrite = true) override {
+        assert(m_target);
+
+        int slot;
+        if (m_cursor < m_slots.size() && IsSlot(m_slots[m_cursor], row, col)) {
+            slot = m_slots[m_cursor];
+        } else {
+            slot = FindSlot(row, col);
+            if (slot < 0) {
+                m_missing = true;
+                return;
+            }
+            if (m_cursor < m_slots.size())
+                m_slots[m_cursor] = slot;
+            else
+                m_slots.push_back(slot);
+        }
+        m_cursor++;
+
+        double& el = m_target->valuePtr()[slot];
+        overwrite ? el = val : el += val;
+    }
+
+  private:
+    /// Check whether the given slot in the target matrix corresponds to element (row,col).
+    bool IsSlot(int slot, int row, int col) const {
+        const int* outer = m_target->outerIndexPtr();
+        return slot >= outer[row] && slot < outer[row + 1] && m_target->innerIndexPtr()[slot] == col;
+    }
+
+    /// Find the slot of element (row,col) in the target matrix; return -1 if not in the sparsity pattern.
+    int FindSlot(int row, int col) const {
+        const int* outer = m_target->outerIndexPtr();
+        const int* first = m_target->innerIndexPtr() + outer[row];
+        const int* last = m_target->innerIndexPtr() + outer[row + 1];
+        const int* it = std::lower_bound(first, last, col);
+        if (it == last || *it != col)
+            return -1;
+        return (int)(it - m_target->innerIndexPtr());
+    }
+
+    ChSparseMatrix* m_target;  ///< matrix being filled
+    std::vector<int> m_slots;  ///< cached positions in the target value array, in order of SetElement calls
+    size_t m_cursor;           ///< index of the next SetElement call in the current pass
+    bool m_missing;            ///< was an element not found in the target sparsity pattern?
+};
+
+/// @} chrono_linalg
+
+};  // end namespace chrono
+
+#endif
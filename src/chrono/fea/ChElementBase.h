@@ -15,6 +15,8 @@
 #ifndef CHELEMENTBASE_H
 #define CHELEMENTBASE_H
 
+#include <limits>
+
 #include "chrono/physics/ChLoadable.h"
 #include "chrono/core/ChFrame.h"
 #include "chrono/solver/ChSystemDescriptor.h"
@@ -102,8 +104,28 @@ class ChApi ChElementBase {
     /// Add the internal forces (pasted at global nodes offsets) into
     /// a global vector R, multiplied by a scaling factor c, as
     ///   R += forces * c
+    /// ChMesh calls this function concurrently only for elements that do not share nodes.
     virtual void EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c) {}
 
+    /// Return a tag identifying elements whose internal forces can be evaluated together, in a batch.
+    /// ChMesh groups elements of the same type with the same (non-null) tag (e.g., the material) and evaluates their
+    /// internal forces with EleIntLoadResidual_F_Batch. The default (nullptr) disables batched evaluation.
+    /// Batching only applies to internal forces; the KRM matrices are loaded per element (see LoadKRMMatrices).
+    virtual const void* GetBatchTag() const { return nullptr; }
+
+    /// Add the internal forces of a batch of elements (pasted at global nodes offsets) into a global vector R,
+    /// multiplied by a scaling factor c. This function is invoked on the first element of the batch; all elements in
+    /// the batch are of the same type as this element and were assigned the same tag (see GetBatchTag).
+    /// ChMesh calls this function concurrently only for batches of elements that do not share nodes.
+    /// The default implementation evaluates each element in turn.
+    virtual void EleIntLoadResidual_F_Batch(ChElementBase* const* elements,
+                                            int num_elements,
+                                            ChVectorDynamic<>& R,
+                                            const double c) {
+        for (int i = 0; i < num_elements; i++)
+            elements[i]->EleIntLoadResidual_F(R, c);
+    }
+
     /// Add the product of element mass M by a vector w (pasted at global nodes offsets) into
     /// a global vector R, multiplied by a scaling factor c, as
     ///   R += M * w * c
@@ -114,12 +136,22 @@ class ChApi ChElementBase {
     ///    Md += c*diag(M)    or   Md += c*HRZ(M)    or other lumping heuristics
     virtual void EleIntLoadLumpedMass_Md(ChVectorDynamic<>& Md, double& error, const double c){};
 
+    /// Estimate the critical time step of an explicit integrator (central difference) for this element alone, i.e.
+    /// 2/omega_max, with omega_max the highest natural frequency of the unconstrained element with lumped mass, reduced
+    /// by the element damping, if any (the penalty stiffness of constraints is accounted for by
+    /// ChTimestepperCentralDifference).
+    /// With lumped masses, the critical step of a mesh is not smaller than the smallest critical step of its elements.
+    /// The default implementation returns infinity (no estimate available).
+    /// ChMesh calls this function concurrently for different elements.
+    virtual double GetCriticalStepSize() { return std::numeric_limits<double>::infinity(); }
+
     /// Add the contribution of gravity loads, multiplied by a scaling factor c, as:
     ///   R += M * g * c
     /// Note that it is up to the element implementation to build a proper g vector that
     /// contains G_acc values in the proper stride (ex. tetahedrons have 4x copies of G_acc in g).
     /// Note that elements can provide fast implementations that do not need to build any internal M matrix,
     /// and not even the g vector, for instance if using lumped masses.
+    /// ChMesh calls this function concurrently only for elements that do not share nodes.
     virtual void EleIntLoadResidual_F_gravity(ChVectorDynamic<>& R, const ChVector3d& G_acc, const double c) = 0;
 
     // Functions for interfacing to the solver
@@ -132,6 +164,25 @@ class ChApi ChElementBase {
     /// coefficients Kfactor, Rfactor,and Mfactor, respectively.
     virtual void LoadKRMMatrices(double Kfactor, double Rfactor, double Mfactor) = 0;
 
+    /// Add the product of the current KRM matrix (the linear combination of the K, R, and M matrices with coefficients
+    /// Kfactor, Rfactor, and Mfactor, as in LoadKRMMatrices) by a given vector into 'result', without storing the matrix
+    /// in the encapsulated ChKRMBlock objects. 'result' and 'vect' are system descriptor vectors, indexed with the
+    /// offsets of the element variables. Used in the matrix-free KRM mode (see ChSystemDescriptor::EnableMatrixFreeKRM).
+    /// ChMesh calls this function concurrently only for elements that do not share nodes.
+    virtual void AddKRMProductInto(ChVectorDynamic<>& result,
+                                   const ChVectorDynamic<>& vect,
+                                   double Kfactor,
+                                   double Rfactor,
+                                   double Mfactor) = 0;
+
+    /// Add the diagonal of the current KRM matrix (see AddKRMProductInto) into 'result', a system descriptor vector.
+    /// ChMesh calls this function concurrently only for elements that do not share nodes.
+    virtual void AddKRMDiagonalInto(ChVectorDynamic<>& result, double Kfactor, double Rfactor, double Mfactor) = 0;
+
+    /// Release the memory used by the encapsulated ChKRMBlock objects, if any.
+    /// Called by ChMesh in the matrix-free KRM mode; the KRM blocks are reallocated as needed by LoadKRMMatrices.
+    virtual void ReleaseKRMMatrices() {}
+
     /// Add the internal forces, expressed as nodal forces, into the encapsulated ChVariables.
     /// Update the 'fb' part: qf+=forces*factor
     /// WILL BE DEPRECATED - see EleIntLoadResidual_F
@@ -22,22 +22,21 @@ namespace fea {
 void ChElementGeneric::EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c) {
     ChVectorDynamic<> Fi(GetNumCoordsPosLevel());
     ComputeInternalForces(Fi);
-    Fi *= c;
+    LoadResidual(Fi, R, c);
+    // std::cout << "EleIntLoadResidual_F , R=" << R << std::endl;
+}
 
+void ChElementGeneric::LoadResidual(ChVectorConstRef Fi, ChVectorDynamic<>& R, const double c) {
     //// Attention: this is called from within a parallel OMP for loop.
-    //// Must use atomic increment when updating the global vector R.
+    //// ChMesh only processes concurrently elements that do not share nodes, so R can be updated without atomics.
 
     unsigned int stride = 0;
     for (unsigned int in = 0; in < GetNumNodes(); in++) {
         unsigned int node_dofs = GetNodeNumCoordsPosLevelActive(in);
-        if (!GetNode(in)->IsFixed()) {
-            for (unsigned int j = 0; j < node_dofs; j++)
-#pragma omp atomic
-                R(GetNode(in)->NodeGetOffsetVelLevel() + j) += Fi(stride + j);
-        }
+        if (!GetNode(in)->IsFixed())
+            R.segment(GetNode(in)->NodeGetOffsetVelLevel(), node_dofs) += c * Fi.segment(stride, node_dofs);
         stride += GetNodeNumCoordsPosLevel(in);
     }
-    // std::cout << "EleIntLoadResidual_F , R=" << R << std::endl;
 }
 
 void ChElementGeneric::EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c) {
@@ -83,22 +82,56 @@ void ChElementGeneric::EleIntLoadLumpedMass_Md(ChVectorDynamic<>& Md, double& er
     }
 }
 
+double ChElementGeneric::GetCriticalStepSize() {
+    unsigned int n = GetNumCoordsPosLevel();
+    ChMatrixDynamic<> Mi(n, n);
+    ChMatrixDynamic<> Ki(n, n);
+    ChMatrixDynamic<> Ri(n, n);
+    ComputeMmatrixGlobal(Mi);
+    ComputeKRMmatricesGlobal(Ki, 1.0, 0.0, 0.0);
+    ComputeKRMmatricesGlobal(Ri, 0.0, 1.0, 0.0);
+
+    // Symmetric form of the generalized eigenvalue problem with lumped mass:  Md^-1/2 * K * Md^-1/2
+    // (coordinates without mass, if any, are not considered)
+    ChVectorDynamic<> s = Mi.diagonal();
+    for (unsigned int i = 0; i < n; i++)
+        s(i) = (s(i) > 0) ? 1.0 / std::sqrt(s(i)) : 0.0;
+    ChMatrixDynamic<> Ks = s.asDiagonal() * (0.5 * (Ki + Ki.transpose())) * s.asDiagonal();
+
+    Eigen::SelfAdjointEigenSolver<ChMatrixDynamic<>> eigensolver(Ks, Eigen::EigenvaluesOnly);
+    if (eigensolver.info() != Eigen::Success)
+        return std::numeric_limits<double>::infinity();
+
+    double omega2_max = eigensolver.eigenvalues().maxCoeff();
+    if (omega2_max <= 0)
+        return std::numeric_limits<double>::infinity();
+
+    // For a mode with frequency omega and damping c = 2*zeta*omega, the critical step is 2/(sqrt(omega^2+c^2/4)+c/2).
+    // Using the largest eigenvalue of the damping matrix as a bound on c gives a conservative estimate.
+    double c_max = 0;
+    if (!Ri.isZero()) {
+        ChMatrixDynamic<> Rs = s.asDiagonal() * (0.5 * (Ri + Ri.transpose())) * s.asDiagonal();
+        eigensolver.compute(Rs, Eigen::EigenvaluesOnly);
+        if (eigensolver.info() == Eigen::Success)
+            c_max = std::max(0.0, eigensolver.eigenvalues().maxCoeff());
+    }
+
+    return 2.0 / (std::sqrt(omega2_max + 0.25 * c_max * c_max) + 0.5 * c_max);
+}
+
 void ChElementGeneric::EleIntLoadResidual_F_gravity(ChVectorDynamic<>& R, const ChVector3d& G_acc, const double c) {
     ChVectorDynamic<> Fg(GetNumCoordsPosLevel());
     ComputeGravityForces(Fg, G_acc);
     Fg *= c;
 
     //// Attention: this is called from within a parallel OMP for loop.
-    //// Must use atomic increment when updating the global vector R.
+    //// ChMesh only processes concurrently elements that do not share nodes, so R can be updated without atomics.
 
     unsigned int stride = 0;
     for (unsigned int in = 0; in < GetNumNodes(); in++) {
         unsigned int node_dofs = GetNodeNumCoordsPosLevelActive(in);
-        if (!GetNode(in)->IsFixed()) {
-            for (unsigned int j = 0; j < node_dofs; j++)
-#pragma omp atomic
-                R(GetNode(in)->NodeGetOffsetVelLevel() + j) += Fg(stride + j);
-        }
+        if (!GetNode(in)->IsFixed())
+            R.segment(GetNode(in)->NodeGetOffsetVelLevel(), node_dofs) += Fg.segment(stride, node_dofs);
         stride += GetNodeNumCoordsPosLevel(in);
     }
 }
@@ -138,6 +171,22 @@ void ChElementGeneric::LoadKRMMatrices(double Kfactor, double Rfactor, double Mf
     ComputeKRMmatricesGlobal(Kmatr.GetMatrix(), Kfactor, Rfactor, Mfactor);
 }
 
+void ChElementGeneric::AddKRMProductInto(ChVectorDynamic<>& result,
+                                         const ChVectorDynamic<>& vect,
+                                         double Kfactor,
+                                         double Rfactor,
+                                         double Mfactor) {
+    ChMatrixDynamic<> H(GetNumCoordsPosLevel(), GetNumCoordsPosLevel());
+    ComputeKRMmatricesGlobal(H, Kfactor, Rfactor, Mfactor);
+    Kmatr.AddMatrixTimesVectorInto(result, vect, H);
+}
+
+void ChElementGeneric::AddKRMDiagonalInto(ChVectorDynamic<>& result, double Kfactor, double Rfactor, double Mfactor) {
+    ChMatrixDynamic<> H(GetNumCoordsPosLevel(), GetNumCoordsPosLevel());
+    ComputeKRMmatricesGlobal(H, Kfactor, Rfactor, Mfactor);
+    Kmatr.DiagonalAdd(result, H);
+}
+
 void ChElementGeneric::VariablesFbLoadInternalForces(double factor) {
     throw(std::runtime_error("ChElementGeneric::VariablesFbLoadInternalForces is deprecated"));
 }
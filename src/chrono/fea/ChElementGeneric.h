@@ -56,6 +56,13 @@ class ChApi ChElementGeneric : public ChElementBase {
     /// This default implementation is VERY INEFFICIENT.
     virtual void EleIntLoadLumpedMass_Md(ChVectorDynamic<>& Md, double& error, const double c) override;
 
+    /// Estimate the critical time step of an explicit integrator for this element alone.
+    /// This default implementation solves the eigenvalue problem for the element tangent stiffness matrix and the
+    /// element lumped mass diag(M) (as in EleIntLoadLumpedMass_Md), and bounds the reduction due to the element damping
+    /// matrix. It is exact for undamped or stiffness-proportional damped elements but VERY INEFFICIENT, and derived
+    /// classes may provide a cheaper estimate (e.g., based on a characteristic length and the material wave speed).
+    virtual double GetCriticalStepSize() override;
+
     /// Add the contribution of gravity loads, multiplied by a scaling factor c, as:
     ///   R += M * g * c
     /// This default implementation is VERY INEFFICIENT.
@@ -85,6 +92,22 @@ class ChApi ChElementGeneric : public ChElementBase {
     /// coefficients Kfactor, Rfactor,and Mfactor, respectively.
     virtual void LoadKRMMatrices(double Kfactor, double Rfactor, double Mfactor) override;
 
+    /// Add the product of the current KRM matrix by a given vector into 'result', without storing the matrix.
+    /// This default implementation evaluates the element KRM matrix in a temporary (see ComputeKRMmatricesGlobal) at
+    /// each call and is therefore INEFFICIENT. Derived classes should provide products based on cached element data.
+    virtual void AddKRMProductInto(ChVectorDynamic<>& result,
+                                   const ChVectorDynamic<>& vect,
+                                   double Kfactor,
+                                   double Rfactor,
+                                   double Mfactor) override;
+
+    /// Add the diagonal of the current KRM matrix into 'result'.
+    /// This default implementation evaluates the element KRM matrix in a temporary and is therefore INEFFICIENT.
+    virtual void AddKRMDiagonalInto(ChVectorDynamic<>& result, double Kfactor, double Rfactor, double Mfactor) override;
+
+    /// Release the memory used by the encapsulated ChKRMBlock.
+    virtual void ReleaseKRMMatrices() override { Kmatr.ReleaseMatrix(); }
+
     /// Add the internal forces, expressed as nodal forces, into the encapsulated ChVariables.
     virtual void VariablesFbLoadInternalForces(double factor = 1.) override;
 
@@ -92,6 +115,10 @@ class ChApi ChElementGeneric : public ChElementBase {
     virtual void VariablesFbIncrementMq() override;
 
   protected:
+    /// Add the given element force vector (pasted at global nodes offsets) into a global vector R, as
+    ///   R += Fi * c
+    void LoadResidual(ChVectorConstRef Fi, ChVectorDynamic<>& R, const double c);
+
     ChKRMBlock Kmatr;
 };
 
@@ -492,6 +492,40 @@ void ChElementHexaANCF_3843::ComputeInternalForces(ChVectorDynamic<>& Fi) {
     }
 }
 
+const void* ChElementHexaANCF_3843::GetBatchTag() const {
+    if (m_method == IntFrcMethod::ContInt && !m_damping_enabled)
+        return m_material.get();
+    return nullptr;
+}
+
+void ChElementHexaANCF_3843::EleIntLoadResidual_F_Batch(ChElementBase* const* elements,
+                                                        int num_elements,
+                                                        ChVectorDynamic<>& R,
+                                                        const double c) {
+    // Elements may have changed calculation method or material since the batches were formed.
+    // Such elements are evaluated individually.
+    const void* tag = GetBatchTag();
+
+    ChElementHexaANCF_3843* batch[NB];
+    int num_batch = 0;
+
+    for (int i = 0; i < num_elements; i++) {
+        auto element = static_cast<ChElementHexaANCF_3843*>(elements[i]);
+        if (!tag || element->GetBatchTag() != tag) {
+            element->EleIntLoadResidual_F(R, c);
+            continue;
+        }
+        batch[num_batch++] = element;
+        if (num_batch == NB) {
+            ComputeInternalForcesContIntNoDampingBatch(batch, num_batch, R, c);
+            num_batch = 0;
+        }
+    }
+
+    if (num_batch > 0)
+        ComputeInternalForcesContIntNoDampingBatch(batch, num_batch, R, c);
+}
+
 // Calculate the global matrix H as a linear combination of K, R, and M:
 //   H = Mfactor * [M] + Kfactor * [K] + Rfactor * [R]
 
@@ -1387,6 +1421,106 @@ void ChElementHexaANCF_3843::ComputeInternalForcesContIntNoDamping(ChVectorDynam
     Fi = QiReshaped;
 }
 
+void ChElementHexaANCF_3843::ComputeInternalForcesContIntNoDampingBatch(ChElementHexaANCF_3843* const* elements,
+                                                                        int num_elements,
+                                                                        ChVectorDynamic<>& R,
+                                                                        const double c) {
+    // Batched version of ComputeInternalForcesContIntNoDamping for elements sharing the same material.
+    // The deformation gradients of all elements in the batch are stored side by side, such that the strains, stresses,
+    // and 1st Piola-Kirchoff stresses are calculated component by component across all the Gauss quadrature points of
+    // all the elements at a time (i.e., on NIP x NB arrays).  Each column of such arrays corresponds to one element.
+    // Unused columns (for batches with fewer than NB elements) are set to zero.
+    assert(num_elements > 0 && num_elements <= NB);
+
+    using ArrayNIPxNB = Eigen::Array<double, NIP, NB>;
+
+    // =============================================================================
+    // Calculate the deformation gradients, element by element, ordered as in ComputeInternalForcesContIntNoDamping.
+    // The deformation gradient component (i,j) of all elements in the batch is stored in the block
+    // FC.block<NIP, NB>(i * NIP, j * NB).
+    // =============================================================================
+
+    ChMatrixNM_col<double, 3 * NIP, 3 * NB> FC;
+    ArrayNIPxNB kGQ;
+    FC.setZero();
+    kGQ.setZero();
+
+    for (int k = 0; k < num_elements; k++) {
+        Matrix3xN e_bar;
+        elements[k]->CalcCoordMatrix(e_bar);
+        ChMatrixNM_col<double, 3 * NIP, 3> FC_k = elements[k]->m_SD.transpose() * e_bar.transpose();
+        for (int j = 0; j < 3; j++)
+            FC.col(j * NB + k) = FC_k.col(j);
+        kGQ.col(k) = elements[k]->m_kGQ.col(0).array();
+    }
+
+    auto F = [&FC](int i, int j) { return FC.template block<NIP, NB>(i * NIP, j * NB).array(); };
+
+    // =============================================================================
+    // Calculate the Green-Lagrange strain components scaled by kGQ, in Voigt notation
+    // =============================================================================
+
+    ArrayNIPxNB E1 = F(0, 0) * F(0, 0) + F(0, 1) * F(0, 1) + F(0, 2) * F(0, 2);
+    E1 -= 1;
+    E1 *= 0.5 * kGQ;
+
+    ArrayNIPxNB E2 = F(1, 0) * F(1, 0) + F(1, 1) * F(1, 1) + F(1, 2) * F(1, 2);
+    E2 -= 1;
+    E2 *= 0.5 * kGQ;
+
+    ArrayNIPxNB E3 = F(2, 0) * F(2, 0) + F(2, 1) * F(2, 1) + F(2, 2) * F(2, 2);
+    E3 -= 1;
+    E3 *= 0.5 * kGQ;
+
+    ArrayNIPxNB E4 = F(1, 0) * F(2, 0) + F(1, 1) * F(2, 1) + F(1, 2) * F(2, 2);
+    E4 *= kGQ;
+
+    ArrayNIPxNB E5 = F(0, 0) * F(2, 0) + F(0, 1) * F(2, 1) + F(0, 2) * F(2, 2);
+    E5 *= kGQ;
+
+    ArrayNIPxNB E6 = F(0, 0) * F(1, 0) + F(0, 1) * F(1, 1) + F(0, 2) * F(1, 2);
+    E6 *= kGQ;
+
+    // =============================================================================
+    // Calculate the 2nd Piola-Kirchoff stresses (scaled by kGQ), using the common material stiffness tensor
+    // =============================================================================
+
+    const ChMatrixNM<double, 6, 6>& D = elements[0]->GetMaterial()->Get_D();
+
+    ArrayNIPxNB S1 = D(0, 0) * E1 + D(0, 1) * E2 + D(0, 2) * E3 + D(0, 3) * E4 + D(0, 4) * E5 + D(0, 5) * E6;
+    ArrayNIPxNB S2 = D(1, 0) * E1 + D(1, 1) * E2 + D(1, 2) * E3 + D(1, 3) * E4 + D(1, 4) * E5 + D(1, 5) * E6;
+    ArrayNIPxNB S3 = D(2, 0) * E1 + D(2, 1) * E2 + D(2, 2) * E3 + D(2, 3) * E4 + D(2, 4) * E5 + D(2, 5) * E6;
+    ArrayNIPxNB S4 = D(3, 0) * E1 + D(3, 1) * E2 + D(3, 2) * E3 + D(3, 3) * E4 + D(3, 4) * E5 + D(3, 5) * E6;
+    ArrayNIPxNB S5 = D(4, 0) * E1 + D(4, 1) * E2 + D(4, 2) * E3 + D(4, 3) * E4 + D(4, 4) * E5 + D(4, 5) * E6;
+    ArrayNIPxNB S6 = D(5, 0) * E1 + D(5, 1) * E2 + D(5, 2) * E3 + D(5, 3) * E4 + D(5, 4) * E5 + D(5, 5) * E6;
+
+    // =============================================================================
+    // Calculate the transpose of the 1st Piola-Kirchoff stresses (scaled by kGQ), with the same layout as FC
+    // =============================================================================
+
+    ChMatrixNM_col<double, 3 * NIP, 3 * NB> P;
+
+    for (int j = 0; j < 3; j++) {
+        P.template block<NIP, NB>(0, j * NB).array() = F(0, j) * S1 + F(1, j) * S6 + F(2, j) * S5;
+        P.template block<NIP, NB>(NIP, j * NB).array() = F(0, j) * S6 + F(1, j) * S2 + F(2, j) * S4;
+        P.template block<NIP, NB>(2 * NIP, j * NB).array() = F(0, j) * S5 + F(1, j) * S4 + F(2, j) * S3;
+    }
+
+    // =============================================================================
+    // Calculate the generalized internal force vector of each element and load it into the global vector
+    // =============================================================================
+
+    for (int k = 0; k < num_elements; k++) {
+        ChMatrixNM_col<double, 3 * NIP, 3> P_k;
+        for (int j = 0; j < 3; j++)
+            P_k.col(j) = P.col(j * NB + k);
+
+        MatrixNx3 QiCompact = elements[k]->m_SD * P_k;
+        Eigen::Map<Vector3N> QiReshaped(QiCompact.data(), QiCompact.size());
+        elements[k]->LoadResidual(QiReshaped, R, c);
+    }
+}
+
 void ChElementHexaANCF_3843::ComputeInternalForcesContIntPreInt(ChVectorDynamic<>& Fi) {
     // Calculate the generalize internal force vector using the "Pre-Integration" style of method assuming a
     // linear viscoelastic material model (single term damping model).  For this style of method, the components of the
@@ -83,6 +83,7 @@ class ChApi ChElementHexaANCF_3843 : public ChElementANCF,
     static const int NP = 4;              ///< number of Gauss quadrature along beam axis
     static const int NIP = NP * NP * NP;  ///< number of Gauss quadrature points
     static const int NSF = 32;            ///< number of shape functions
+    static const int NB = 4;              ///< number of elements in batched internal force evaluation
 
     using VectorN = ChVectorN<double, NSF>;
     using Vector3N = ChVectorN<double, 3 * NSF>;
@@ -225,6 +226,18 @@ class ChApi ChElementHexaANCF_3843 : public ChElementANCF,
     /// vector.
     virtual void ComputeInternalForces(ChVectorDynamic<>& Fi) override;
 
+    /// Return a tag for batched internal force evaluation (see ChMesh).
+    /// Batched evaluation is supported for the "Continuous Integration" style method without damping; elements using
+    /// the same material are evaluated together. The Jacobian (see ComputeKRMmatricesGlobal) is always evaluated per
+    /// element.
+    virtual const void* GetBatchTag() const override;
+
+    /// Add the internal forces of a batch of elements, scaled by c, into the global vector R.
+    virtual void EleIntLoadResidual_F_Batch(ChElementBase* const* elements,
+                                            int num_elements,
+                                            ChVectorDynamic<>& R,
+                                            const double c) override;
+
     /// Set H as a linear combination of M, K, and R.
     ///   H = Mfactor * [M] + Kfactor * [K] + Rfactor * [R],
     /// where [M] is the mass matrix, [K] is the stiffness matrix, and [R] is the damping matrix.
@@ -355,6 +368,14 @@ class ChApi ChElementHexaANCF_3843 : public ChElementANCF,
     /// of the nodal coordinates using the "Continuous Integration" style method assuming no damping
     void ComputeInternalForcesContIntNoDamping(ChVectorDynamic<>& Fi);
 
+    /// Calculate the generalized internal forces for a batch of up to NB elements with the same material, using the
+    /// "Continuous Integration" style method assuming no damping, and load them (scaled by c) into the vector R.
+    /// The material law is evaluated for the Gauss quadrature points of all elements in the batch at once.
+    static void ComputeInternalForcesContIntNoDampingBatch(ChElementHexaANCF_3843* const* elements,
+                                                           int num_elements,
+                                                           ChVectorDynamic<>& R,
+                                                           const double c);
+
     /// Calculate the generalized internal force for the element at the current nodal coordinates and time derivatives
     /// of the nodal coordinates using the "Pre-Integration" style method assuming damping (works well for the case of
     /// no damping as well)
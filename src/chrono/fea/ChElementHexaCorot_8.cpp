@@ -339,6 +339,57 @@ void ChElementHexaCorot_8::ComputeKRMmatricesGlobal(ChMatrixRef H, double Kfacto
     //// TODO  better per-node lumping, or 12x12 consistent mass matrix.
 }
 
+void ChElementHexaCorot_8::AddKRMProductInto(ChVectorDynamic<>& result,
+                                             const ChVectorDynamic<>& vect,
+                                             double Kfactor,
+                                             double Rfactor,
+                                             double Mfactor) {
+    // H*v = mkfactor * C*K*Ct*v + amfactor * lumped_node_mass * v, with C block-diagonal rotations A
+    double mkfactor = Kfactor + Rfactor * this->GetMaterial()->GetRayleighDampingBeta();
+    double amfactor = Mfactor ? Mfactor + Rfactor * this->GetMaterial()->GetRayleighDampingAlpha() : 0.0;
+    double lumped_node_mass = (this->Volume * this->Material->GetDensity()) / 8.0;
+
+    // Nodal values of the vector (zero for inactive nodes), rotated to the local element frame
+    ChVectorN<double, 24> vect_local;
+    for (int in = 0; in < 8; ++in) {
+        const auto& var = nodes[in]->Variables();
+        if (var.IsActive())
+            vect_local.segment(in * 3, 3) = A.transpose() * vect.segment(var.GetOffset(), 3);
+        else
+            vect_local.segment(in * 3, 3).setZero();
+    }
+
+    ChVectorN<double, 24> prod_local = mkfactor * (StiffnessMatrix * vect_local);
+
+    for (int in = 0; in < 8; ++in) {
+        const auto& var = nodes[in]->Variables();
+        if (var.IsActive()) {
+            result.segment(var.GetOffset(), 3) += A * prod_local.segment(in * 3, 3);
+            if (amfactor)
+                result.segment(var.GetOffset(), 3) += (amfactor * lumped_node_mass) * vect.segment(var.GetOffset(), 3);
+        }
+    }
+}
+
+void ChElementHexaCorot_8::AddKRMDiagonalInto(ChVectorDynamic<>& result,
+                                              double Kfactor,
+                                              double Rfactor,
+                                              double Mfactor) {
+    double mkfactor = Kfactor + Rfactor * this->GetMaterial()->GetRayleighDampingBeta();
+    double amfactor = Mfactor ? Mfactor + Rfactor * this->GetMaterial()->GetRayleighDampingAlpha() : 0.0;
+    double lumped_node_mass = (this->Volume * this->Material->GetDensity()) / 8.0;
+
+    for (int in = 0; in < 8; ++in) {
+        const auto& var = nodes[in]->Variables();
+        if (!var.IsActive())
+            continue;
+        // diagonal of the corotated nodal block A*K_ii*At
+        ChMatrix33<> AK = A * StiffnessMatrix.block<3, 3>(in * 3, in * 3);
+        for (int r = 0; r < 3; r++)
+            result(var.GetOffset() + r) += mkfactor * AK.row(r).dot(A.row(r)) + amfactor * lumped_node_mass;
+    }
+}
+
 void ChElementHexaCorot_8::ComputeInternalForces(ChVectorDynamic<>& Fi) {
     assert(Fi.size() == GetNumCoordsPosLevel());
 
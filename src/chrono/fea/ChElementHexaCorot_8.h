@@ -124,6 +124,17 @@ class ChApi ChElementHexaCorot_8 : public ChElementHexahedron,
                                           double Rfactor = 0,
                                           double Mfactor = 0) override;
 
+    /// Add the product of the current KRM matrix by a given vector into 'result', without storing the matrix.
+    /// The product is evaluated with the cached local stiffness matrix and the current corotational rotation.
+    virtual void AddKRMProductInto(ChVectorDynamic<>& result,
+                                   const ChVectorDynamic<>& vect,
+                                   double Kfactor,
+                                   double Rfactor,
+                                   double Mfactor) override;
+
+    /// Add the diagonal of the current KRM matrix into 'result'.
+    virtual void AddKRMDiagonalInto(ChVectorDynamic<>& result, double Kfactor, double Rfactor, double Mfactor) override;
+
     /// Computes the internal forces (ex. the actual position of nodes is not in relaxed reference position) and set
     /// values in the Fi vector.
     virtual void ComputeInternalForces(ChVectorDynamic<>& Fi) override;
@@ -13,11 +13,16 @@
 // =============================================================================
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <sstream>
 #include <string>
+#include <typeindex>
+#include <unordered_map>
 
 #include "chrono/core/ChFrame.h"
 #include "chrono/physics/ChLoad.h"
@@ -28,11 +33,12 @@
 #include "chrono/fea/ChMesh.h"
 #include "chrono/fea/ChNodeFEAxyz.h"
 #include "chrono/fea/ChNodeFEAxyzrot.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 namespace chrono {
 namespace fea {
 
-ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
+ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other), krm_operator(this), krm_matrix_free(false) {
     vnodes = other.vnodes;
     velements = other.velements;
 
@@ -47,6 +53,10 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
 
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
+
+    element_colors_valid = false;
+
+    mass_scaling = other.mass_scaling;
 }
 
 void ChMesh::SetupInitial() {
@@ -67,6 +77,9 @@ void ChMesh::SetupInitial() {
         // precompute matrices, such as the [Kl] local stiffness of each element, if needed, etc.
         velements[i]->SetupInitial(GetSystem());
     }
+
+    // Force a new element coloring (element connectivity is final at this point)
+    element_colors_valid = false;
 }
 
 void ChMesh::Relax() {
@@ -96,6 +109,7 @@ void ChMesh::AddNode(std::shared_ptr<ChNodeFEAbase> node) {
 
 void ChMesh::AddElement(std::shared_ptr<ChElementBase> elem) {
     velements.push_back(elem);
+    element_colors_valid = false;
 
     // If the mesh is already added to a system, mark the system uninitialized and out-of-date
     if (system) {
@@ -106,6 +120,8 @@ void ChMesh::AddElement(std::shared_ptr<ChElementBase> elem) {
 
 void ChMesh::ClearElements() {
     velements.clear();
+    element_colors_valid = false;
+    mass_scaling.clear();
     vcontactsurfaces.clear();
 
     // If the mesh is already added to a system, mark the system out-of-date
@@ -116,6 +132,8 @@ void ChMesh::ClearElements() {
 
 void ChMesh::ClearNodes() {
     velements.clear();
+    element_colors_valid = false;
+    mass_scaling.clear();
     vnodes.clear();
     vcontactsurfaces.clear();
 
@@ -155,11 +173,78 @@ void ChMesh::Setup() {
             n_dofs_w += vnodes[i]->GetNumCoordsVelLevelActive();
         }
     }
+
+    if (!element_colors_valid)
+        ColorElements();
+}
+
+void ChMesh::ColorElements() {
+    // Greedy coloring of the element graph (two elements are adjacent if they share a node).
+    // Elements are visited in order, so that elements with the same color are also stored in increasing order.
+    std::unordered_map<ChNodeFEAbase*, std::vector<unsigned int>> node_colors;  // colors of elements sharing a node
+    std::vector<unsigned int> used;  // colors already used by neighbors (last element index + 1)
+
+    element_colors.clear();
+
+    for (unsigned int ie = 0; ie < velements.size(); ie++) {
+        const auto& element = velements[ie];
+        unsigned int num_nodes = element->GetNumNodes();
+
+        for (unsigned int in = 0; in < num_nodes; in++) {
+            for (auto color : node_colors[element->GetNode(in).get()])
+                used[color] = ie + 1;
+        }
+
+        unsigned int color = 0;
+        while (color < used.size() && used[color] == ie + 1)
+            color++;
+        if (color == element_colors.size()) {
+            element_colors.push_back(std::vector<unsigned int>());
+            used.push_back(0);
+        }
+        element_colors[color].push_back(ie);
+
+        for (unsigned int in = 0; in < num_nodes; in++)
+            node_colors[element->GetNode(in).get()].push_back(color);
+    }
+
+    // Within each color, group elements of the same type and batch tag, and split the groups in batches.
+    // Elements which do not support batched evaluation are placed in batches of one element.
+    const size_t max_batch_size = 8;
+    element_batches.clear();
+    element_batches.resize(element_colors.size());
+
+    for (size_t ic = 0; ic < element_colors.size(); ic++) {
+        auto& batches = element_batches[ic];
+        std::map<std::pair<std::type_index, const void*>, size_t> open_batches;  // batches currently being filled
+
+        for (auto ie : element_colors[ic]) {
+            auto element = velements[ie].get();
+            auto tag = element->GetBatchTag();
+            if (!tag) {
+                batches.push_back({element});
+                continue;
+            }
+
+            auto key = std::make_pair(std::type_index(typeid(*element)), tag);
+            auto it = open_batches.find(key);
+            if (it == open_batches.end() || batches[it->second].size() == max_batch_size) {
+                open_batches[key] = batches.size();
+                batches.push_back({element});
+            } else {
+                batches[it->second].push_back(element);
+            }
+        }
+    }
+
+    element_colors_valid = true;
 }
 
 // Updates all time-dependant variables, if any...
 // Ex: maybe the elasticity can increase in time, etc.
 void ChMesh::Update(double m_time, bool update_assets) {
+    CH_TRACE_ZONE("ChMesh::Update");
+
     // Parent class update
     ChIndexedNodes::Update(m_time, update_assets);
 
@@ -290,22 +375,41 @@ void ChMesh::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, con
 
     int nthreads = GetSystem()->nthreads_chrono;
 
+    if (!element_colors_valid)
+        ColorElements();
+
     // elements internal forces
     timer_internal_forces.start();
-    //// PARALLEL FOR, must use omp atomic to avoid race condition in writing to R
-#pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
+    CH_TRACE_BEGIN("ChMesh internal forces");
+    //// PARALLEL FOR over element batches of the same color (no race condition in writing to R, since they share no
+    //// nodes)
+    for (const auto& batches : element_batches) {
+#pragma omp parallel num_threads(nthreads)
+        {
+            CH_TRACE_ZONE("ChMesh internal forces (color)");
+#pragma omp for schedule(dynamic, 4)
+            for (int k = 0; k < (int)batches.size(); k++) {
+                const auto& batch = batches[k];
+                if (batch.size() == 1)
+                    batch[0]->EleIntLoadResidual_F(R, c);
+                else
+                    batch[0]->EleIntLoadResidual_F_Batch(batch.data(), (int)batch.size(), R, c);
+            }
+        }
     }
+    CH_TRACE_END();
     timer_internal_forces.stop();
     ncalls_internal_forces++;
 
     // elements gravity forces
     if (automatic_gravity_load) {
-        //// PARALLEL FOR, must use omp atomic to avoid race condition in writing to R
+        const ChVector3d& G_acc = GetSystem()->GetGravitationalAcceleration();
+        //// PARALLEL FOR over elements of the same color (no race condition in writing to R)
+        for (const auto& color : element_colors) {
 #pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
-        for (int ie = 0; ie < velements.size(); ie++) {
-            velements[ie]->EleIntLoadResidual_F_gravity(R, GetSystem()->GetGravitationalAcceleration(), c);
+            for (int k = 0; k < (int)color.size(); k++) {
+                velements[color[k]]->EleIntLoadResidual_F_gravity(R, G_acc, c);
+            }
         }
     }
 
@@ -431,10 +535,69 @@ void ChMesh::IntLoadLumpedMass_Md(const unsigned int off, ChVectorDynamic<>& Md,
         }
     }
 
-    // internal masses
-    for (unsigned int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadLumpedMass_Md(Md, err, c);
+    int nthreads = GetSystem() ? GetSystem()->nthreads_chrono : 1;
+
+    if (!element_colors_valid)
+        ColorElements();
+
+    // internal masses (scaled, if mass scaling is enabled)
+    //// PARALLEL FOR over elements of the same color (no race condition in writing to Md)
+    for (const auto& color : element_colors) {
+        double color_err = 0;
+#pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads) reduction(+ : color_err)
+        for (int k = 0; k < (int)color.size(); k++) {
+            double ele_err = 0;
+            velements[color[k]]->EleIntLoadLumpedMass_Md(Md, ele_err, c * GetMassScaling(color[k]));
+            color_err += ele_err;
+        }
+        err += color_err;
+    }
+}
+
+void ChMesh::ComputeElementCriticalSteps(std::vector<double>& steps) {
+    int nthreads = GetSystem() ? GetSystem()->nthreads_chrono : 1;
+
+    steps.resize(velements.size());
+
+    //// PARALLEL FOR, (no shared data is written)
+#pragma omp parallel for schedule(dynamic, 4) num_threads(nthreads)
+    for (int ie = 0; ie < (int)velements.size(); ie++) {
+        steps[ie] = velements[ie]->GetCriticalStepSize();
+    }
+}
+
+double ChMesh::GetCriticalStepSize() {
+    CH_TRACE_ZONE("ChMesh critical step");
+
+    std::vector<double> steps;
+    ComputeElementCriticalSteps(steps);
+
+    // a lumped mass scaled by s increases the element critical step by sqrt(s) (by more, for damped elements)
+    double step = std::numeric_limits<double>::infinity();
+    for (unsigned int ie = 0; ie < (unsigned int)steps.size(); ie++)
+        step = std::min(step, steps[ie] * std::sqrt(GetMassScaling(ie)));
+
+    return step;
+}
+
+unsigned int ChMesh::SetMassScaling(double target_step) {
+    mass_scaling.clear();
+    if (target_step <= 0)
+        return 0;
+
+    std::vector<double> steps;
+    ComputeElementCriticalSteps(steps);
+
+    unsigned int num_scaled = 0;
+    mass_scaling.resize(velements.size(), 1.0);
+    for (unsigned int ie = 0; ie < (unsigned int)steps.size(); ie++) {
+        if (steps[ie] < target_step) {
+            mass_scaling[ie] = (target_step / steps[ie]) * (target_step / steps[ie]);
+            num_scaled++;
+        }
     }
+
+    return num_scaled;
 }
 
 void ChMesh::IntToDescriptor(const unsigned int off_v,
@@ -468,21 +631,76 @@ void ChMesh::IntFromDescriptor(const unsigned int off_v,
 //// SOLVER FUNCTIONS
 
 void ChMesh::InjectKRMMatrices(ChSystemDescriptor& descriptor) {
+    krm_matrix_free = descriptor.IsMatrixFreeKRM();
+
+    if (krm_matrix_free) {
+        descriptor.InsertKRMOperator(&krm_operator);
+        for (unsigned int ie = 0; ie < velements.size(); ie++)
+            velements[ie]->ReleaseKRMMatrices();
+        return;
+    }
+
     for (unsigned int ie = 0; ie < velements.size(); ie++)
         velements[ie]->InjectKRMMatrices(descriptor);
 }
 
 void ChMesh::LoadKRMMatrices(double Kfactor, double Rfactor, double Mfactor) {
+    if (krm_matrix_free) {
+        krm_operator.SetFactors(Kfactor, Rfactor, Mfactor);
+        return;
+    }
+
     int nthreads = GetSystem()->nthreads_chrono;
 
     timer_KRMload.start();
-#pragma omp parallel for num_threads(nthreads)
-    for (int ie = 0; ie < velements.size(); ie++)
-        velements[ie]->LoadKRMMatrices(Kfactor, Rfactor, Mfactor);
+    CH_TRACE_BEGIN("ChMesh KRM load");
+    //// PARALLEL FOR over all elements (each element only writes to its own KRM block)
+#pragma omp parallel num_threads(nthreads)
+    {
+        CH_TRACE_ZONE("ChMesh KRM load (thread)");
+#pragma omp for schedule(dynamic, 4)
+        for (int ie = 0; ie < (int)velements.size(); ie++)
+            velements[ie]->LoadKRMMatrices(Kfactor, Rfactor, Mfactor);
+    }
+    CH_TRACE_END();
     timer_KRMload.stop();
     ncalls_KRMload++;
 }
 
+void ChMesh::MatrixFreeKRM::SetFactors(double Kfactor, double Rfactor, double Mfactor) {
+    m_Kfactor = Kfactor;
+    m_Rfactor = Rfactor;
+    m_Mfactor = Mfactor;
+}
+
+void ChMesh::MatrixFreeKRM::AddMatrixTimesVectorInto(ChVectorDynamic<>& result, const ChVectorDynamic<>& vect) {
+    int nthreads = m_mesh->GetSystem()->nthreads_chrono;
+
+    if (!m_mesh->element_colors_valid)
+        m_mesh->ColorElements();
+
+    CH_TRACE_ZONE("ChMesh KRM product");
+    //// PARALLEL FOR over elements of the same color (elements sharing nodes are never processed concurrently)
+    for (const auto& color : m_mesh->element_colors) {
+#pragma omp parallel for num_threads(nthreads)
+        for (int k = 0; k < (int)color.size(); k++)
+            m_mesh->velements[color[k]]->AddKRMProductInto(result, vect, m_Kfactor, m_Rfactor, m_Mfactor);
+    }
+}
+
+void ChMesh::MatrixFreeKRM::DiagonalAdd(ChVectorDynamic<>& result) {
+    int nthreads = m_mesh->GetSystem()->nthreads_chrono;
+
+    if (!m_mesh->element_colors_valid)
+        m_mesh->ColorElements();
+
+    for (const auto& color : m_mesh->element_colors) {
+#pragma omp parallel for num_threads(nthreads)
+        for (int k = 0; k < (int)color.size(); k++)
+            m_mesh->velements[color[k]]->AddKRMDiagonalInto(result, m_Kfactor, m_Rfactor, m_Mfactor);
+    }
+}
+
 void ChMesh::VariablesFbReset() {
     for (unsigned int ie = 0; ie < vnodes.size(); ie++)
         vnodes[ie]->VariablesFbReset();
@@ -44,7 +44,10 @@ class ChApi ChMesh : public ChIndexedNodes {
           automatic_gravity_load(true),
           num_points_gravity(1),
           ncalls_internal_forces(0),
-          ncalls_KRMload(0) {}
+          ncalls_KRMload(0),
+          element_colors_valid(false),
+          krm_operator(this),
+          krm_matrix_free(false) {}
     ChMesh(const ChMesh& other);
     ~ChMesh() {}
 
@@ -78,6 +81,15 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// Get the number of elements in the mesh.
     unsigned int GetNumElements() { return (unsigned int)velements.size(); }
 
+    /// Get the number of element colors.
+    /// Elements are partitioned in colors (sets of elements that do not share any node) which are processed in
+    /// parallel, without atomic operations, when loading internal forces, gravity forces, and lumped masses, and when
+    /// evaluating matrix-free KRM products.
+    unsigned int GetNumElementColors() const { return (unsigned int)element_colors.size(); }
+
+    /// Get the indices of the elements with the given color.
+    const std::vector<unsigned int>& GetElementColor(unsigned int color) const { return element_colors[color]; }
+
     virtual unsigned int GetNumCoordsPosLevel() override { return n_dofs; }
     virtual unsigned int GetNumCoordsVelLevel() override { return n_dofs_w; }
 
@@ -174,6 +186,21 @@ class ChApi ChMesh : public ChIndexedNodes {
                                ChMatrix33<>& inertia  ///< ChMesh inertia tensor
     );
 
+    /// Estimate the critical time step of explicit integrators (e.g., ChTimestepperCentralDifference) for this mesh.
+    /// This is the smallest critical step of the mesh elements (see ChElementBase::GetCriticalStepSize), accounting for
+    /// mass scaling, if any. Element estimates are evaluated in parallel. Return infinity if no estimate is available.
+    /// Constraints (and their penalty stiffness in explicit integrators) are not accounted for here.
+    double GetCriticalStepSize();
+
+    /// Apply selective mass scaling to all elements with a critical time step smaller than the specified target step.
+    /// The lumped mass of such elements (as loaded with IntLoadLumpedMass_Md) is scaled such that their critical step
+    /// matches the target. The consistent mass matrix, as used by implicit integrators, is not affected.
+    /// A non-positive target step removes mass scaling. Return the number of scaled elements.
+    unsigned int SetMassScaling(double target_step);
+
+    /// Return the lumped mass scaling factor of the N-th element (1 if not scaled).
+    double GetMassScaling(unsigned int n) const { return n < mass_scaling.size() ? mass_scaling[n] : 1.0; }
+
     // STATE FUNCTIONS
 
     // (override/implement interfaces for global state vectors, see ChPhysicsItem for comments.)
@@ -223,11 +250,15 @@ class ChApi ChMesh : public ChIndexedNodes {
     // SYSTEM FUNCTIONS (for interfacing all elements with solver)
 
     /// Register with the given system descriptor any ChKRMBlock objects associated with this item.
+    /// In the matrix-free KRM mode of the descriptor, a single KRM operator is registered instead, which evaluates
+    /// products with the element KRM matrices on the fly (see ChElementBase::AddKRMProductInto), and the memory of the
+    /// element KRM blocks is released.
     virtual void InjectKRMMatrices(ChSystemDescriptor& descriptor) override;
 
     /// Compute and load current stiffnes (K), damping (R), and mass (M) matrices in encapsulated ChKRMBlock objects.
     /// The resulting KRM blocks represent linear combinations of the K, R, and M matrices, with the specified
     /// coefficients Kfactor, Rfactor,and Mfactor, respectively.
+    /// In the matrix-free KRM mode, only the coefficients are recorded.
     virtual void LoadKRMMatrices(double Kfactor, double Rfactor, double Mfactor) override;
 
     /// Sets the 'fb' part (the known term) of the encapsulated ChVariables to zero.
@@ -276,6 +307,32 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// </pre>
     virtual void SetupInitial() override;
 
+    /// Partition the elements in colors, such that elements with the same color do not share nodes.
+    /// The elements of each color are further grouped in batches for the evaluation of internal forces
+    /// (see ChElementBase::GetBatchTag).
+    void ColorElements();
+
+    /// Evaluate in parallel the (unscaled) critical time step of all elements.
+    void ComputeElementCriticalSteps(std::vector<double>& steps);
+
+    /// Matrix-free representation of the KRM blocks of all mesh elements.
+    /// Products are evaluated element by element, in parallel over elements of the same color.
+    class MatrixFreeKRM : public ChSystemDescriptor::KRMOperator {
+      public:
+        MatrixFreeKRM(ChMesh* mesh) : m_mesh(mesh), m_Kfactor(0), m_Rfactor(0), m_Mfactor(0) {}
+
+        void SetFactors(double Kfactor, double Rfactor, double Mfactor);
+
+        virtual void AddMatrixTimesVectorInto(ChVectorDynamic<>& result, const ChVectorDynamic<>& vect) override;
+        virtual void DiagonalAdd(ChVectorDynamic<>& result) override;
+
+      private:
+        ChMesh* m_mesh;
+        double m_Kfactor;
+        double m_Rfactor;
+        double m_Mfactor;
+    };
+
     std::vector<std::shared_ptr<ChNodeFEAbase>> vnodes;     ///<  nodes
     std::vector<std::shared_ptr<ChElementBase>> velements;  ///<  elements
 
@@ -293,6 +350,15 @@ class ChApi ChMesh : public ChIndexedNodes {
     unsigned int ncalls_internal_forces;
     unsigned int ncalls_KRMload;
 
+    std::vector<std::vector<unsigned int>> element_colors;  ///< indices of elements, grouped by color
+    std::vector<std::vector<std::vector<ChElementBase*>>> element_batches;  ///< element batches, grouped by color
+    bool element_colors_valid;                               ///< false if elements must be colored again
+
+    MatrixFreeKRM krm_operator;  ///< matrix-free KRM operator
+    bool krm_matrix_free;        ///< true if the KRM operator was injected in place of the element KRM blocks
+
+    std::vector<double> mass_scaling;  ///< lumped mass scaling factors, per element (empty if no mass scaling)
+
     friend class chrono::ChSystem;
     friend class chrono::ChAssembly;
     friend class chrono::modal::ChModalAssembly;
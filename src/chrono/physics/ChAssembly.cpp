@@ -14,9 +14,11 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <unordered_map>
 
 #include "chrono/core/ChGlobal.h"
 #include "chrono/physics/ChAssembly.h"
+#include "chrono/physics/ChLinkMarkers.h"
 #include "chrono/physics/ChSystem.h"
 
 namespace chrono {
@@ -40,7 +42,11 @@ ChAssembly::ChAssembly()
       m_num_coords_vel(0),
       m_num_constr(0),
       m_num_constr_bil(0),
-      m_num_constr_uni(0) {}
+      m_num_constr_uni(0),
+      m_parallel_traversal(false),
+      m_parallel_min_items(256),
+      m_link_colors_valid(false),
+      m_substructure(false) {}
 
 ChAssembly::ChAssembly(const ChAssembly& other) : ChPhysicsItem(other) {
     m_num_bodies_active = other.m_num_bodies_active;
@@ -58,6 +64,12 @@ ChAssembly::ChAssembly(const ChAssembly& other) : ChPhysicsItem(other) {
     m_num_constr_bil = other.m_num_constr_bil;
     m_num_constr_uni = other.m_num_constr_uni;
 
+    m_parallel_traversal = other.m_parallel_traversal;
+    m_parallel_min_items = other.m_parallel_min_items;
+    m_link_colors_valid = false;
+
+    m_substructure = other.m_substructure;
+
     //// RADU
     //// TODO:  deep copy of the object lists (bodylist, shaftlist, linklist, meshlist,  otherphysicslist)
 }
@@ -94,6 +106,12 @@ void swap(ChAssembly& first, ChAssembly& second) {
     swap(first.m_num_constr, second.m_num_constr);
     swap(first.m_num_constr_bil, second.m_num_constr_bil);
     swap(first.m_num_constr_uni, second.m_num_constr_uni);
+    swap(first.m_parallel_traversal, second.m_parallel_traversal);
+    swap(first.m_parallel_min_items, second.m_parallel_min_items);
+    swap(first.m_link_colors, second.m_link_colors);
+    swap(first.m_links_uncolored, second.m_links_uncolored);
+    swap(first.m_link_colors_valid, second.m_link_colors_valid);
+    swap(first.m_substructure, second.m_substructure);
 
     //// RADU
     //// TODO: deal with all other member variables...
@@ -174,6 +192,7 @@ void ChAssembly::AddLink(std::shared_ptr<ChLinkBase> link) {
 
     link->SetSystem(system);
     linklist.push_back(link);
+    m_link_colors_valid = false;
 
     ////system->is_initialized = false;  // Not needed, unless/until ChLink::SetupInitial does something
     system->is_updated = false;
@@ -185,6 +204,7 @@ void ChAssembly::RemoveLink(std::shared_ptr<ChLinkBase> link) {
 
     linklist.erase(itr);
     link->SetSystem(nullptr);
+    m_link_colors_valid = false;
 
     system->is_updated = false;
 }
@@ -322,6 +342,7 @@ void ChAssembly::RemoveAllLinks() {
         link->SetSystem(nullptr);
     }
     linklist.clear();
+    m_link_colors_valid = false;
 
     if (system)
         system->is_updated = false;
@@ -500,6 +521,8 @@ void ChAssembly::SyncCollisionModels() {
 // UPDATING ROUTINES
 
 void ChAssembly::SetupInitial() {
+    m_link_colors_valid = false;
+
     for (auto& body : bodylist) {
         body->SetupInitial();
     }
@@ -648,12 +671,18 @@ void ChAssembly::Update(double mytime, bool update_assets) {
 // Updates all forces (automatic, as children of bodies)
 // Updates all markers (automatic, as children of bodies).
 void ChAssembly::Update(bool update_assets) {
-    //// NOTE: do not switch these to range for loops (may want to use OMP for)
-    for (auto& body : bodylist) {
-        body->Update(ChTime, update_assets);
+    int nthreads_bodies = GetTraversalThreads(bodylist.size());
+    int nthreads_shafts = GetTraversalThreads(shaftlist.size());
+    int nthreads_links = GetTraversalThreads(linklist.size());
+
+    //// PARALLEL FOR (each item updates its own data; visual models are updated sequentially below)
+#pragma omp parallel for num_threads(nthreads_bodies) if (nthreads_bodies > 1)
+    for (int ib = 0; ib < (int)bodylist.size(); ib++) {
+        bodylist[ib]->Update(ChTime, update_assets && nthreads_bodies == 1);
     }
-    for (auto& shaft : shaftlist) {
-        shaft->Update(ChTime, update_assets);
+#pragma omp parallel for num_threads(nthreads_shafts) if (nthreads_shafts > 1)
+    for (int is = 0; is < (int)shaftlist.size(); is++) {
+        shaftlist[is]->Update(ChTime, update_assets && nthreads_shafts == 1);
     }
     for (auto& mesh : meshlist) {
         mesh->Update(ChTime, update_assets);
@@ -663,9 +692,103 @@ void ChAssembly::Update(bool update_assets) {
     }
     // The state of links depends on the bodylist,shaftlist,meshlist,otherphysicslist,
     // thus the update of linklist must be at the end.
-    for (auto& link : linklist) {
-        link->Update(ChTime, update_assets);
+    if (nthreads_links > 1) {
+        // links may also modify their markers (e.g., imposed marker motion)
+        if (!m_link_colors_valid)
+            ColorLinks();
+        //// PARALLEL FOR over links of the same color (no shared bodies or markers)
+        for (const auto& color : m_link_colors) {
+#pragma omp parallel for num_threads(nthreads_links)
+            for (int k = 0; k < (int)color.size(); k++) {
+                linklist[color[k]]->Update(ChTime, false);
+            }
+        }
+        for (auto il : m_links_uncolored) {
+            linklist[il]->Update(ChTime, false);
+        }
+    } else {
+        for (auto& link : linklist) {
+            link->Update(ChTime, update_assets);
+        }
     }
+
+    if (update_assets)
+        UpdateVisualModels(nthreads_bodies > 1, nthreads_shafts > 1, nthreads_links > 1);
+}
+
+int ChAssembly::GetTraversalThreads(size_t num_items) const {
+    if (!m_parallel_traversal || !system || num_items < m_parallel_min_items)
+        return 1;
+    return std::max(1, (int)system->GetNumThreadsChrono());
+}
+
+bool ChAssembly::UseLinkColors(int nthreads_links) const {
+    if (nthreads_links > 1)
+        return true;
+    return m_parallel_traversal && system && system->IsDeterministic() && linklist.size() >= m_parallel_min_items;
+}
+
+void ChAssembly::UpdateVisualModels(bool bodies, bool shafts, bool links) {
+    // Only update the visual models (and cameras) of items that were updated concurrently.
+    // Markers and forces owned by the bodies carry no visual models; their frames are updated in the parallel pass.
+    if (bodies) {
+        for (auto& body : bodylist)
+            body->ChPhysicsItem::Update(body->GetChTime(), true);
+    }
+    if (shafts) {
+        for (auto& shaft : shaftlist)
+            shaft->ChPhysicsItem::Update(shaft->GetChTime(), true);
+    }
+    if (links) {
+        for (auto& link : linklist)
+            link->ChPhysicsItem::Update(link->GetChTime(), true);
+    }
+}
+
+void ChAssembly::ColorLinks() {
+    // Greedy coloring of the link graph (two links are adjacent if they share a connected body or marker).
+    std::unordered_map<const void*, std::vector<unsigned int>> shared_colors;  // colors of links sharing an object
+    std::vector<unsigned int> used;  // colors already used by neighbors (last link index + 1)
+
+    m_link_colors.clear();
+    m_links_uncolored.clear();
+
+    for (unsigned int il = 0; il < linklist.size(); il++) {
+        // Links with their own coordinates (e.g., motors with inner shafts) may be coupled to other items
+        auto link = dynamic_cast<ChLink*>(linklist[il].get());
+        if (!link || link->GetNumCoordsVelLevel() > 0) {
+            m_links_uncolored.push_back(il);
+            continue;
+        }
+        const void* objects[4] = {link->GetBody1(), link->GetBody2(), nullptr, nullptr};
+        if (auto link_markers = dynamic_cast<ChLinkMarkers*>(link)) {
+            objects[2] = link_markers->GetMarker1();
+            objects[3] = link_markers->GetMarker2();
+        }
+
+        for (auto object : objects) {
+            if (!object)
+                continue;
+            for (auto color : shared_colors[object])
+                used[color] = il + 1;
+        }
+
+        unsigned int color = 0;
+        while (color < used.size() && used[color] == il + 1)
+            color++;
+        if (color == m_link_colors.size()) {
+            m_link_colors.push_back(std::vector<unsigned int>());
+            used.push_back(0);
+        }
+        m_link_colors[color].push_back(il);
+
+        for (auto object : objects) {
+            if (object)
+                shared_colors[object].push_back(color);
+        }
+    }
+
+    m_link_colors_valid = true;
 }
 
 void ChAssembly::ForceToRest() {
@@ -694,17 +817,31 @@ void ChAssembly::IntStateGather(const unsigned int off_x,
     int displ_x = off_x - this->offset_x;
     int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    int nthreads_bodies = GetTraversalThreads(bodylist.size());
+    int nthreads_shafts = GetTraversalThreads(shaftlist.size());
+    int nthreads_links = GetTraversalThreads(linklist.size());
+
+    // Note: the time gathered by each item is discarded (set at the end from the assembly time)
+#pragma omp parallel for num_threads(nthreads_bodies) if (nthreads_bodies > 1)
+    for (int ib = 0; ib < (int)bodylist.size(); ib++) {
+        auto& body = bodylist[ib];
+        double T_item;
         if (body->IsActive())
-            body->IntStateGather(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T);
+            body->IntStateGather(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T_item);
     }
-    for (auto& shaft : shaftlist) {
+#pragma omp parallel for num_threads(nthreads_shafts) if (nthreads_shafts > 1)
+    for (int is = 0; is < (int)shaftlist.size(); is++) {
+        auto& shaft = shaftlist[is];
+        double T_item;
         if (shaft->IsActive())
-            shaft->IntStateGather(displ_x + shaft->GetOffset_x(), x, displ_v + shaft->GetOffset_w(), v, T);
+            shaft->IntStateGather(displ_x + shaft->GetOffset_x(), x, displ_v + shaft->GetOffset_w(), v, T_item);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(nthreads_links) if (nthreads_links > 1)
+    for (int il = 0; il < (int)linklist.size(); il++) {
+        auto& link = linklist[il];
+        double T_item;
         if (link->IsActive())
-            link->IntStateGather(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T);
+            link->IntStateGather(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T_item);
     }
     for (auto& mesh : meshlist) {
         mesh->IntStateGather(displ_x + mesh->GetOffset_x(), x, displ_v + mesh->GetOffset_w(), v, T);
@@ -733,18 +870,28 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
     int displ_x = off_x - this->offset_x;
     int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    int nthreads_bodies = GetTraversalThreads(bodylist.size());
+    int nthreads_shafts = GetTraversalThreads(shaftlist.size());
+    int nthreads_links = GetTraversalThreads(linklist.size());
+
+    // With parallel traversal, visual models are updated sequentially at the end
+#pragma omp parallel for num_threads(nthreads_bodies) if (nthreads_bodies > 1)
+    for (int ib = 0; ib < (int)bodylist.size(); ib++) {
+        auto& body = bodylist[ib];
+        bool update = full_update && nthreads_bodies == 1;
         if (body->IsActive())
-            body->IntStateScatter(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T, full_update);
+            body->IntStateScatter(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T, update);
         else
-            body->Update(T, full_update);
+            body->Update(T, update);
     }
-    for (auto& shaft : shaftlist) {
+#pragma omp parallel for num_threads(nthreads_shafts) if (nthreads_shafts > 1)
+    for (int is = 0; is < (int)shaftlist.size(); is++) {
+        auto& shaft = shaftlist[is];
+        bool update = full_update && nthreads_shafts == 1;
         if (shaft->IsActive())
-            shaft->IntStateScatter(displ_x + shaft->GetOffset_x(), x, displ_v + shaft->GetOffset_w(), v, T,
-                                   full_update);
+            shaft->IntStateScatter(displ_x + shaft->GetOffset_x(), x, displ_v + shaft->GetOffset_w(), v, T, update);
         else
-            shaft->Update(T, full_update);
+            shaft->Update(T, update);
     }
     for (auto& mesh : meshlist) {
         mesh->IntStateScatter(displ_x + mesh->GetOffset_x(), x, displ_v + mesh->GetOffset_w(), v, T, full_update);
@@ -759,13 +906,19 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
     // must be behind of bodylist,shaftlist,meshlist,otherphysicslist; otherwise, the Update() of ChLink() would
     // use the old (un-updated) status of bodylist,shaftlist,meshlist, resulting in a delay of Update() of ChLink()
     // for one time step, then the simulation might diverge!
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(nthreads_links) if (nthreads_links > 1)
+    for (int il = 0; il < (int)linklist.size(); il++) {
+        auto& link = linklist[il];
+        bool update = full_update && nthreads_links == 1;
         if (link->IsActive())
-            link->IntStateScatter(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T, full_update);
+            link->IntStateScatter(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T, update);
         else
-            link->Update(T, full_update);
+            link->Update(T, update);
     }
 
+    if (full_update)
+        UpdateVisualModels(nthreads_bodies > 1, nthreads_shafts > 1, nthreads_links > 1);
+
     SetChTime(T);
 }
 
@@ -877,17 +1030,27 @@ void ChAssembly::IntStateIncrement(const unsigned int off_x,
     int displ_x = off_x - this->offset_x;
     int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    int nthreads_bodies = GetTraversalThreads(bodylist.size());
+    int nthreads_shafts = GetTraversalThreads(shaftlist.size());
+    int nthreads_links = GetTraversalThreads(linklist.size());
+
+#pragma omp parallel for num_threads(nthreads_bodies) if (nthreads_bodies > 1)
+    for (int ib = 0; ib < (int)bodylist.size(); ib++) {
+        auto& body = bodylist[ib];
         if (body->IsActive())
             body->IntStateIncrement(displ_x + body->GetOffset_x(), x_new, x, displ_v + body->GetOffset_w(), Dv);
     }
 
-    for (auto& shaft : shaftlist) {
+#pragma omp parallel for num_threads(nthreads_shafts) if (nthreads_shafts > 1)
+    for (int is = 0; is < (int)shaftlist.size(); is++) {
+        auto& shaft = shaftlist[is];
         if (shaft->IsActive())
             shaft->IntStateIncrement(displ_x + shaft->GetOffset_x(), x_new, x, displ_v + shaft->GetOffset_w(), Dv);
     }
 
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(nthreads_links) if (nthreads_links > 1)
+    for (int il = 0; il < (int)linklist.size(); il++) {
+        auto& link = linklist[il];
         if (link->IsActive())
             link->IntStateIncrement(displ_x + link->GetOffset_x(), x_new, x, displ_v + link->GetOffset_w(), Dv);
     }
@@ -910,17 +1073,27 @@ void ChAssembly::IntStateGetIncrement(const unsigned int off_x,
     int displ_x = off_x - this->offset_x;
     int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+    int nthreads_bodies = GetTraversalThreads(bodylist.size());
+    int nthreads_shafts = GetTraversalThreads(shaftlist.size());
+    int nthreads_links = GetTraversalThreads(linklist.size());
+
+#pragma omp parallel for num_threads(nthreads_bodies) if (nthreads_bodies > 1)
+    for (int ib = 0; ib < (int)bodylist.size(); ib++) {
+        auto& body = bodylist[ib];
         if (body->IsActive())
             body->IntStateGetIncrement(displ_x + body->GetOffset_x(), x_new, x, displ_v + body->GetOffset_w(), Dv);
     }
 
-    for (auto& shaft : shaftlist) {
+#pragma omp parallel for num_threads(nthreads_shafts) if (nthreads_shafts > 1)
+    for (int is = 0; is < (int)shaftlist.size(); is++) {
+        auto& shaft = shaftlist[is];
         if (shaft->IsActive())
             shaft->IntStateGetIncrement(displ_x + shaft->GetOffset_x(), x_new, x, displ_v + shaft->GetOffset_w(), Dv);
     }
 
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(nthreads_links) if (nthreads_links > 1)
+    for (int il = 0; il < (int)linklist.size(); il++) {
+        auto& link = linklist[il];
         if (link->IsActive())
             link->IntStateGetIncrement(displ_x + link->GetOffset_x(), x_new, x, displ_v + link->GetOffset_w(), Dv);
     }
@@ -941,17 +1114,45 @@ void ChAssembly::IntLoadResidual_F(const unsigned int off,  ///< offset in R res
 {
     int displ_v = off - this->offset_w;
 
-    for (auto& body : bodylist) {
+    int nthreads_bodies = GetTraversalThreads(bodylist.size());
+    int nthreads_shafts = GetTraversalThreads(shaftlist.size());
+    int nthreads_links = GetTraversalThreads(linklist.size());
+
+#pragma omp parallel for num_threads(nthreads_bodies) if (nthreads_bodies > 1)
+    for (int ib = 0; ib < (int)bodylist.size(); ib++) {
+        auto& body = bodylist[ib];
         if (body->IsActive())
             body->IntLoadResidual_F(displ_v + body->GetOffset_w(), R, c);
     }
-    for (auto& shaft : shaftlist) {
+#pragma omp parallel for num_threads(nthreads_shafts) if (nthreads_shafts > 1)
+    for (int is = 0; is < (int)shaftlist.size(); is++) {
+        auto& shaft = shaftlist[is];
         if (shaft->IsActive())
             shaft->IntLoadResidual_F(displ_v + shaft->GetOffset_w(), R, c);
     }
-    for (auto& link : linklist) {
-        if (link->IsActive())
-            link->IntLoadResidual_F(displ_v + link->GetOffset_w(), R, c);
+    if (UseLinkColors(nthreads_links)) {
+        // links may also write to the entries of the connected bodies
+        if (!m_link_colors_valid)
+            ColorLinks();
+        //// PARALLEL FOR over links of the same color (no race condition in writing to R)
+        for (const auto& color : m_link_colors) {
+#pragma omp parallel for num_threads(nthreads_links)
+            for (int k = 0; k < (int)color.size(); k++) {
+                auto& link = linklist[color[k]];
+                if (link->IsActive())
+                    link->IntLoadResidual_F(displ_v + link->GetOffset_w(), R, c);
+            }
+        }
+        for (auto il : m_links_uncolored) {
+            auto& link = linklist[il];
+            if (link->IsActive())
+                link->IntLoadResidual_F(displ_v + link->GetOffset_w(), R, c);
+        }
+    } else {
+        for (auto& link : linklist) {
+            if (link->IsActive())
+                link->IntLoadResidual_F(displ_v + link->GetOffset_w(), R, c);
+        }
     }
     for (auto& mesh : meshlist) {
         mesh->IntLoadResidual_F(displ_v + mesh->GetOffset_w(), R, c);
@@ -969,17 +1170,45 @@ void ChAssembly::IntLoadResidual_Mv(const unsigned int off,      ///< offset in
 ) {
     int displ_v = off - this->offset_w;
 
-    for (auto& body : bodylist) {
+    int nthreads_bodies = GetTraversalThreads(bodylist.size());
+    int nthreads_shafts = GetTraversalThreads(shaftlist.size());
+    int nthreads_links = GetTraversalThreads(linklist.size());
+
+#pragma omp parallel for num_threads(nthreads_bodies) if (nthreads_bodies > 1)
+    for (int ib = 0; ib < (int)bodylist.size(); ib++) {
+        auto& body = bodylist[ib];
         if (body->IsActive())
             body->IntLoadResidual_Mv(displ_v + body->GetOffset_w(), R, w, c);
     }
-    for (auto& shaft : shaftlist) {
+#pragma omp parallel for num_threads(nthreads_shafts) if (nthreads_shafts > 1)
+    for (int is = 0; is < (int)shaftlist.size(); is++) {
+        auto& shaft = shaftlist[is];
         if (shaft->IsActive())
             shaft->IntLoadResidual_Mv(displ_v + shaft->GetOffset_w(), R, w, c);
     }
-    for (auto& link : linklist) {
-        if (link->IsActive())
-            link->IntLoadResidual_Mv(displ_v + link->GetOffset_w(), R, w, c);
+    if (UseLinkColors(nthreads_links)) {
+        // links may also write to the entries of the connected bodies
+        if (!m_link_colors_valid)
+            ColorLinks();
+        //// PARALLEL FOR over links of the same color (no race condition in writing to R)
+        for (const auto& color : m_link_colors) {
+#pragma omp parallel for num_threads(nthreads_links)
+            for (int k = 0; k < (int)color.size(); k++) {
+                auto& link = linklist[color[k]];
+                if (link->IsActive())
+                    link->IntLoadResidual_Mv(displ_v + link->GetOffset_w(), R, w, c);
+            }
+        }
+        for (auto il : m_links_uncolored) {
+            auto& link = linklist[il];
+            if (link->IsActive())
+                link->IntLoadResidual_Mv(displ_v + link->GetOffset_w(), R, w, c);
+        }
+    } else {
+        for (auto& link : linklist) {
+            if (link->IsActive())
+                link->IntLoadResidual_Mv(displ_v + link->GetOffset_w(), R, w, c);
+        }
     }
     for (auto& mesh : meshlist) {
         mesh->IntLoadResidual_Mv(displ_v + mesh->GetOffset_w(), R, w, c);
@@ -1167,6 +1396,9 @@ void ChAssembly::IntFromDescriptor(const unsigned int off_v,
 // -----------------------------------------------------------------------------
 
 void ChAssembly::InjectVariables(ChSystemDescriptor& descriptor) {
+    if (m_substructure)
+        descriptor.BeginSubstructure(GetIdentifier());
+
     for (auto& body : bodylist) {
         body->InjectVariables(descriptor);
     }
@@ -1182,6 +1414,9 @@ void ChAssembly::InjectVariables(ChSystemDescriptor& descriptor) {
     for (auto& item : otherphysicslist) {
         item->InjectVariables(descriptor);
     }
+
+    if (m_substructure)
+        descriptor.EndSubstructure();
 }
 
 void ChAssembly::VariablesFbReset() {
@@ -1293,6 +1528,9 @@ void ChAssembly::VariablesQbIncrementPosition(double dt_step) {
 }
 
 void ChAssembly::InjectConstraints(ChSystemDescriptor& descriptor) {
+    if (m_substructure)
+        descriptor.BeginSubstructure(GetIdentifier());
+
     for (auto& body : bodylist) {
         body->InjectConstraints(descriptor);
     }
@@ -1308,6 +1546,9 @@ void ChAssembly::InjectConstraints(ChSystemDescriptor& descriptor) {
     for (auto& item : otherphysicslist) {
         item->InjectConstraints(descriptor);
     }
+
+    if (m_substructure)
+        descriptor.EndSubstructure();
 }
 
 void ChAssembly::ConstraintsBiReset() {
@@ -1532,6 +1773,32 @@ void ChAssembly::ShowHierarchy(std::ostream& outstream, int level) const {
     outstream << std::endl;
 }
 
+void ChAssembly::SnapshotOut(ChStateSnapshot& snapshot) {
+    for (auto& body : bodylist)
+        body->SnapshotOut(snapshot);
+    for (auto& shaft : shaftlist)
+        shaft->SnapshotOut(snapshot);
+    for (auto& link : linklist)
+        link->SnapshotOut(snapshot);
+    for (auto& mesh : meshlist)
+        mesh->SnapshotOut(snapshot);
+    for (auto& item : otherphysicslist)
+        item->SnapshotOut(snapshot);
+}
+
+void ChAssembly::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    for (auto& body : bodylist)
+        body->SnapshotIn(reader);
+    for (auto& shaft : shaftlist)
+        shaft->SnapshotIn(reader);
+    for (auto& link : linklist)
+        link->SnapshotIn(reader);
+    for (auto& mesh : meshlist)
+        mesh->SnapshotIn(reader);
+    for (auto& item : otherphysicslist)
+        item->SnapshotIn(reader);
+}
+
 void ChAssembly::ArchiveOut(ChArchiveOut& archive_out) {
     // version number
     archive_out.VersionWrite<ChAssembly>();
@@ -105,6 +105,32 @@ class ChApi ChAssembly : public ChPhysicsItem {
     /// Remove all physics items  not in the body, link, or mesh lists.
     void RemoveAllOtherPhysicsItems();
 
+    /// Enable/disable parallel traversal of the lists of bodies, shafts, and links (default: false).
+    /// If enabled, state gather/scatter/increment, loading of F and M*v residuals, and Update process the items of
+    /// each list with at least 'min_items' items concurrently, using the number of threads set for Chrono (see
+    /// ChSystem::SetNumThreads). Each item writes its own portion of the state vectors; links, which apply forces to the
+    /// connected bodies and may modify their markers, are partitioned in colors (sets of links that do not share a body
+    /// or a marker) and only links of the same color are processed concurrently. Meshes (which are parallelized internally) and other physics items are always
+    /// processed sequentially. Visual models are updated sequentially, after the parallel update of the items.
+    /// Note that, when enabled, the Update functions of (custom) bodies, shafts, and links must be thread-safe.
+    void SetParallelTraversal(bool val, unsigned int min_items = 256) {
+        m_parallel_traversal = val;
+        m_parallel_min_items = min_items;
+    }
+
+    /// Return true if parallel traversal of the item lists is enabled.
+    bool IsParallelTraversal() const { return m_parallel_traversal; }
+
+    /// Mark this assembly as a substructure (default: false).
+    /// If enabled, the variables and constraints of all items in this assembly are tagged as belonging to a
+    /// substructure in the system descriptor (see ChSystemDescriptor::BeginSubstructure). Solvers which exploit such a
+    /// partition (e.g., ChSolverStaticCondensation) eliminate the unknowns of the substructure that are not coupled to
+    /// the rest of the system (typically, the interior nodes of a flexible body) separately and concurrently.
+    void SetSubstructure(bool val) { m_substructure = val; }
+
+    /// Return true if this assembly is marked as a substructure.
+    bool IsSubstructure() const { return m_substructure; }
+
     /// Get the list of bodies.
     virtual const std::vector<std::shared_ptr<ChBody>>& GetBodies() const { return bodylist; }
     /// Get the list of shafts.
@@ -315,6 +341,14 @@ class ChApi ChAssembly : public ChPhysicsItem {
     /// Method to allow deserialization of transient data from archives.
     virtual void ArchiveIn(ChArchiveIn& archive_in) override;
 
+    // STATE SNAPSHOTS
+
+    /// Append the internal state of all contained items to the given snapshot.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Restore the internal state of all contained items from the given snapshot.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
     // SWAP FUNCTION
 
     /// Swap the contents of the two provided ChAssembly objects.
@@ -325,6 +359,24 @@ class ChApi ChAssembly : public ChPhysicsItem {
   protected:
     virtual void SetupInitial() override;
 
+    /// Return the number of threads for traversing a list with the given number of items (1 for sequential traversal).
+    int GetTraversalThreads(size_t num_items) const;
+
+    /// Return true if link residuals must be accumulated over link colors.
+    /// This is the case for a parallel traversal of the links and, in deterministic mode (see
+    /// ChSystem::SetDeterministic), whenever parallel traversal is enabled, so that the summation order into the body
+    /// entries does not depend on the number of threads.
+    bool UseLinkColors(int nthreads_links) const;
+
+    /// Partition the links in colors, such that links with the same color do not share a connected body or marker.
+    /// Links not derived from ChLink (whose connected objects are unknown) and links with their own coordinates (which
+    /// may be coupled to other items) are not colored and are always processed sequentially.
+    void ColorLinks();
+
+    /// Update the visual models of the items in the specified lists.
+    /// Used after a parallel traversal, during which visual models are not updated.
+    void UpdateVisualModels(bool bodies, bool shafts, bool links);
+
     std::vector<std::shared_ptr<ChBody>> bodylist;                 ///< list of rigid bodies
     std::vector<std::shared_ptr<ChShaft>> shaftlist;               ///< list of 1-D shafts
     std::vector<std::shared_ptr<ChLinkBase>> linklist;             ///< list of joints (links)
@@ -349,6 +401,14 @@ class ChApi ChAssembly : public ChPhysicsItem {
     unsigned int m_num_constr_bil;  ///< number of scalar bilateral constraints
     unsigned int m_num_constr_uni;  ///< number of scalar unilateral constraints
 
+    bool m_parallel_traversal;                             ///< process item lists concurrently?
+    unsigned int m_parallel_min_items;                     ///< minimum list size for concurrent processing
+    std::vector<std::vector<unsigned int>> m_link_colors;  ///< indices of links, grouped by color
+    std::vector<unsigned int> m_links_uncolored;           ///< indices of links processed sequentially
+    bool m_link_colors_valid;                              ///< false if links must be colored again
+
+    bool m_substructure;  ///< tag variables and constraints as a substructure in the system descriptor?
+
     friend class ChSystem;
     friend class ChSystemMulticore;
 };
@@ -951,6 +951,19 @@ void ChBody::ComputeNF(
     detJ = 1;  // not needed because not used in quadrature.
 }
 
+// ---------------------------------------------------------------------------
+// STATE SNAPSHOTS
+
+void ChBody::SnapshotOut(ChStateSnapshot& snapshot) {
+    snapshot.Write(m_csys_dt);
+    snapshot.Write(m_csys_dtdt);
+}
+
+void ChBody::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    reader.Read(m_csys_dt);
+    reader.Read(m_csys_dtdt);
+}
+
 // ---------------------------------------------------------------------------
 // FILE I/O
 
@@ -360,6 +360,16 @@ class ChApi ChBody : public ChPhysicsItem, public ChBodyFrame, public ChContacta
     /// This is only for backward compatibility
     virtual ChPhysicsItem* GetPhysicsItem() override { return this; }
 
+    // STATE SNAPSHOTS
+
+    /// Append the time derivatives of the body coordinates to the given snapshot.
+    /// The velocity and acceleration vectors hold angular velocities and accelerations, from which the derivatives of
+    /// the rotation quaternion are only recovered up to round-off.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Restore the time derivatives of the body coordinates from the given snapshot.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
     // SERIALIZATION
 
     /// Method to allow serialization of transient data to archives.
@@ -25,6 +25,7 @@
 
 #include "chrono/collision/ChCollisionInfo.h"
 #include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactable.h"
 #include "chrono/physics/ChContactMaterial.h"
 
@@ -147,7 +148,7 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     /// of contacts) to cache information used for reporting through GetContactableForce and
     /// GetContactableTorque.
     template <class Tcont>
-    void SumAllContactForces(std::list<Tcont*>& contactlist,
+    void SumAllContactForces(ChContactPool<Tcont>& contactlist,
                              std::unordered_map<ChContactable*, ForceTorque>& contactforces) {
         for (auto contact = contactlist.begin(); contact != contactlist.end(); ++contact) {
             // Extract information for current contact (expressed in global frame)
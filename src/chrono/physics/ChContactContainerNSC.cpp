@@ -12,6 +12,8 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/physics/ChContactContainerNSC.h"
 #include "chrono/physics/ChSystem.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
@@ -43,7 +45,10 @@ ChContactContainerNSC::ChContactContainerNSC()
       n_added_66_666(0),
       n_added_66_33(0),
       n_added_66_66(0),
-      n_added_6_6_rolling(0) {}
+      n_added_6_6_rolling(0),
+      m_cache_enabled(false),
+      m_cache_restored(false),
+      m_cache_tol(0.01) {}
 
 ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other)
     : ChContactContainer(other),
@@ -68,7 +73,10 @@ ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other)
       n_added_66_666(0),
       n_added_66_33(0),
       n_added_66_66(0),
-      n_added_6_6_rolling(0) {}
+      n_added_6_6_rolling(0),
+      m_cache_enabled(other.m_cache_enabled),
+      m_cache_restored(false),
+      m_cache_tol(other.m_cache_tol) {}
 
 ChContactContainerNSC::~ChContactContainerNSC() {
     RemoveAllContacts();
@@ -79,204 +87,140 @@ void ChContactContainerNSC::Update(double mytime, bool update_assets) {
     ChContactContainer::Update(mytime, update_assets);
 }
 
-template <class Tcont, class Titer>
-void _RemoveAllContacts(std::list<Tcont*>& contactlist, Titer& lastcontact, int& n_added) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        delete (*itercontact);
-        (*itercontact) = 0;
-        ++itercontact;
-    }
-    contactlist.clear();
-    lastcontact = contactlist.begin();
+template <class Tcont>
+void _RemoveAllContacts(ChContactPool<Tcont>& contactlist, int& n_added) {
+    contactlist.Clear();
     n_added = 0;
 }
 
 void ChContactContainerNSC::RemoveAllContacts() {
-    _RemoveAllContacts(contactlist_3_3, lastcontact_3_3, n_added_3_3);
-
-    _RemoveAllContacts(contactlist_6_6, lastcontact_6_6, n_added_6_6);
-    _RemoveAllContacts(contactlist_6_3, lastcontact_6_3, n_added_6_3);
-
-    _RemoveAllContacts(contactlist_333_3, lastcontact_333_3, n_added_333_3);
-    _RemoveAllContacts(contactlist_333_6, lastcontact_333_6, n_added_333_6);
-    _RemoveAllContacts(contactlist_333_333, lastcontact_333_333, n_added_333_333);
-
-    _RemoveAllContacts(contactlist_666_3, lastcontact_666_3, n_added_666_3);
-    _RemoveAllContacts(contactlist_666_6, lastcontact_666_6, n_added_666_6);
-    _RemoveAllContacts(contactlist_666_333, lastcontact_666_333, n_added_666_333);
-    _RemoveAllContacts(contactlist_666_666, lastcontact_666_666, n_added_666_666);
-
-    _RemoveAllContacts(contactlist_33_3, lastcontact_33_3, n_added_33_3);
-    _RemoveAllContacts(contactlist_33_6, lastcontact_33_6, n_added_33_6);
-    _RemoveAllContacts(contactlist_33_333, lastcontact_33_333, n_added_33_333);
-    _RemoveAllContacts(contactlist_33_666, lastcontact_33_666, n_added_33_666);
-    _RemoveAllContacts(contactlist_33_33, lastcontact_33_33, n_added_33_33);
-
-    _RemoveAllContacts(contactlist_66_3, lastcontact_66_3, n_added_66_3);
-    _RemoveAllContacts(contactlist_66_6, lastcontact_66_6, n_added_66_6);
-    _RemoveAllContacts(contactlist_66_333, lastcontact_66_333, n_added_66_333);
-    _RemoveAllContacts(contactlist_66_666, lastcontact_66_666, n_added_66_666);
-    _RemoveAllContacts(contactlist_66_33, lastcontact_66_33, n_added_66_33);
-    _RemoveAllContacts(contactlist_66_66, lastcontact_66_66, n_added_66_66);
-
-    _RemoveAllContacts(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling);
+    _RemoveAllContacts(contactlist_3_3, n_added_3_3);
+
+    _RemoveAllContacts(contactlist_6_6, n_added_6_6);
+    _RemoveAllContacts(contactlist_6_3, n_added_6_3);
+
+    _RemoveAllContacts(contactlist_333_3, n_added_333_3);
+    _RemoveAllContacts(contactlist_333_6, n_added_333_6);
+    _RemoveAllContacts(contactlist_333_333, n_added_333_333);
+
+    _RemoveAllContacts(contactlist_666_3, n_added_666_3);
+    _RemoveAllContacts(contactlist_666_6, n_added_666_6);
+    _RemoveAllContacts(contactlist_666_333, n_added_666_333);
+    _RemoveAllContacts(contactlist_666_666, n_added_666_666);
+
+    _RemoveAllContacts(contactlist_33_3, n_added_33_3);
+    _RemoveAllContacts(contactlist_33_6, n_added_33_6);
+    _RemoveAllContacts(contactlist_33_333, n_added_33_333);
+    _RemoveAllContacts(contactlist_33_666, n_added_33_666);
+    _RemoveAllContacts(contactlist_33_33, n_added_33_33);
+
+    _RemoveAllContacts(contactlist_66_3, n_added_66_3);
+    _RemoveAllContacts(contactlist_66_6, n_added_66_6);
+    _RemoveAllContacts(contactlist_66_333, n_added_66_333);
+    _RemoveAllContacts(contactlist_66_666, n_added_66_666);
+    _RemoveAllContacts(contactlist_66_33, n_added_66_33);
+    _RemoveAllContacts(contactlist_66_66, n_added_66_66);
+
+    _RemoveAllContacts(contactlist_6_6_rolling, n_added_6_6_rolling);
 }
 
 void ChContactContainerNSC::BeginAddContact() {
-    lastcontact_3_3 = contactlist_3_3.begin();
+    // Cache the reactions of the current contacts, before recycling them (unless a cache was restored)
+    if (m_cache_enabled && !m_cache_restored)
+        CacheContacts(m_cache);
+    m_cache_restored = false;
+
+    contactlist_3_3.Rewind();
     n_added_3_3 = 0;
 
-    lastcontact_6_6 = contactlist_6_6.begin();
+    contactlist_6_6.Rewind();
     n_added_6_6 = 0;
-    lastcontact_6_3 = contactlist_6_3.begin();
+    contactlist_6_3.Rewind();
     n_added_6_3 = 0;
 
-    lastcontact_333_3 = contactlist_333_3.begin();
+    contactlist_333_3.Rewind();
     n_added_333_3 = 0;
-    lastcontact_333_6 = contactlist_333_6.begin();
+    contactlist_333_6.Rewind();
     n_added_333_6 = 0;
-    lastcontact_333_333 = contactlist_333_333.begin();
+    contactlist_333_333.Rewind();
     n_added_333_333 = 0;
 
-    lastcontact_666_3 = contactlist_666_3.begin();
+    contactlist_666_3.Rewind();
     n_added_666_3 = 0;
-    lastcontact_666_6 = contactlist_666_6.begin();
+    contactlist_666_6.Rewind();
     n_added_666_6 = 0;
-    lastcontact_666_333 = contactlist_666_333.begin();
+    contactlist_666_333.Rewind();
     n_added_666_333 = 0;
-    lastcontact_666_666 = contactlist_666_666.begin();
+    contactlist_666_666.Rewind();
     n_added_666_666 = 0;
 
-    lastcontact_33_3 = contactlist_33_3.begin();
+    contactlist_33_3.Rewind();
     n_added_33_3 = 0;
-    lastcontact_33_6 = contactlist_33_6.begin();
+    contactlist_33_6.Rewind();
     n_added_33_6 = 0;
-    lastcontact_33_333 = contactlist_33_333.begin();
+    contactlist_33_333.Rewind();
     n_added_33_333 = 0;
-    lastcontact_33_666 = contactlist_33_666.begin();
+    contactlist_33_666.Rewind();
     n_added_33_666 = 0;
-    lastcontact_33_33 = contactlist_33_33.begin();
+    contactlist_33_33.Rewind();
     n_added_33_33 = 0;
 
-    lastcontact_66_3 = contactlist_66_3.begin();
+    contactlist_66_3.Rewind();
     n_added_66_3 = 0;
-    lastcontact_66_6 = contactlist_66_6.begin();
+    contactlist_66_6.Rewind();
     n_added_66_6 = 0;
-    lastcontact_66_333 = contactlist_66_333.begin();
+    contactlist_66_333.Rewind();
     n_added_66_333 = 0;
-    lastcontact_66_666 = contactlist_66_666.begin();
+    contactlist_66_666.Rewind();
     n_added_66_666 = 0;
-    lastcontact_66_33 = contactlist_66_33.begin();
+    contactlist_66_33.Rewind();
     n_added_66_33 = 0;
-    lastcontact_66_66 = contactlist_66_66.begin();
+    contactlist_66_66.Rewind();
     n_added_66_66 = 0;
 
-    lastcontact_6_6_rolling = contactlist_6_6_rolling.begin();
+    contactlist_6_6_rolling.Rewind();
     n_added_6_6_rolling = 0;
 }
 
-void ChContactContainerNSC::EndAddContact() {
-    // remove contacts that are beyond last contact
-    while (lastcontact_3_3 != contactlist_3_3.end()) {
-        delete (*lastcontact_3_3);
-        lastcontact_3_3 = contactlist_3_3.erase(lastcontact_3_3);
-    }
-
-    while (lastcontact_6_6 != contactlist_6_6.end()) {
-        delete (*lastcontact_6_6);
-        lastcontact_6_6 = contactlist_6_6.erase(lastcontact_6_6);
-    }
-    while (lastcontact_6_3 != contactlist_6_3.end()) {
-        delete (*lastcontact_6_3);
-        lastcontact_6_3 = contactlist_6_3.erase(lastcontact_6_3);
-    }
-
-    while (lastcontact_333_3 != contactlist_333_3.end()) {
-        delete (*lastcontact_333_3);
-        lastcontact_333_3 = contactlist_333_3.erase(lastcontact_333_3);
-    }
-    while (lastcontact_333_6 != contactlist_333_6.end()) {
-        delete (*lastcontact_333_6);
-        lastcontact_333_6 = contactlist_333_6.erase(lastcontact_333_6);
-    }
-    while (lastcontact_333_333 != contactlist_333_333.end()) {
-        delete (*lastcontact_333_333);
-        lastcontact_333_333 = contactlist_333_333.erase(lastcontact_333_333);
-    }
-
-    while (lastcontact_666_3 != contactlist_666_3.end()) {
-        delete (*lastcontact_666_3);
-        lastcontact_666_3 = contactlist_666_3.erase(lastcontact_666_3);
-    }
-    while (lastcontact_666_6 != contactlist_666_6.end()) {
-        delete (*lastcontact_666_6);
-        lastcontact_666_6 = contactlist_666_6.erase(lastcontact_666_6);
-    }
-    while (lastcontact_666_333 != contactlist_666_333.end()) {
-        delete (*lastcontact_666_333);
-        lastcontact_666_333 = contactlist_666_333.erase(lastcontact_666_333);
-    }
-    while (lastcontact_666_666 != contactlist_666_666.end()) {
-        delete (*lastcontact_666_666);
-        lastcontact_666_666 = contactlist_666_666.erase(lastcontact_666_666);
-    }
-
-    while (lastcontact_33_3 != contactlist_33_3.end()) {
-        delete (*lastcontact_33_3);
-        lastcontact_33_3 = contactlist_33_3.erase(lastcontact_33_3);
-    }
-    while (lastcontact_33_6 != contactlist_33_6.end()) {
-        delete (*lastcontact_33_6);
-        lastcontact_33_6 = contactlist_33_6.erase(lastcontact_33_6);
-    }
-    while (lastcontact_33_333 != contactlist_33_333.end()) {
-        delete (*lastcontact_33_333);
-        lastcontact_33_333 = contactlist_33_333.erase(lastcontact_33_333);
-    }
-    while (lastcontact_33_666 != contactlist_33_666.end()) {
-        delete (*lastcontact_33_666);
-        lastcontact_33_666 = contactlist_33_666.erase(lastcontact_33_666);
-    }
-    while (lastcontact_33_33 != contactlist_33_33.end()) {
-        delete (*lastcontact_33_33);
-        lastcontact_33_33 = contactlist_33_33.erase(lastcontact_33_33);
-    }
-
-    while (lastcontact_66_3 != contactlist_66_3.end()) {
-        delete (*lastcontact_66_3);
-        lastcontact_66_3 = contactlist_66_3.erase(lastcontact_66_3);
-    }
-    while (lastcontact_66_6 != contactlist_66_6.end()) {
-        delete (*lastcontact_66_6);
-        lastcontact_66_6 = contactlist_66_6.erase(lastcontact_66_6);
-    }
-    while (lastcontact_66_333 != contactlist_66_333.end()) {
-        delete (*lastcontact_66_333);
-        lastcontact_66_333 = contactlist_66_333.erase(lastcontact_66_333);
-    }
-    while (lastcontact_66_666 != contactlist_66_666.end()) {
-        delete (*lastcontact_66_666);
-        lastcontact_66_666 = contactlist_66_666.erase(lastcontact_66_666);
-    }
-    while (lastcontact_66_33 != contactlist_66_33.end()) {
-        delete (*lastcontact_66_33);
-        lastcontact_66_33 = contactlist_66_33.erase(lastcontact_66_33);
-    }
-    while (lastcontact_66_66 != contactlist_66_66.end()) {
-        delete (*lastcontact_66_66);
-        lastcontact_66_66 = contactlist_66_66.erase(lastcontact_66_66);
-    }
+template <class Tcont>
+void _ReleaseContacts(ChContactPool<Tcont>& contactlist) {
+    // Keep the contacts that were not reused for later reuse, unless the pool grew well beyond the current needs
+    contactlist.Release(std::max(4 * contactlist.size(), (size_t)256));
+}
 
-    while (lastcontact_6_6_rolling != contactlist_6_6_rolling.end()) {
-        delete (*lastcontact_6_6_rolling);
-        lastcontact_6_6_rolling = contactlist_6_6_rolling.erase(lastcontact_6_6_rolling);
-    }
+void ChContactContainerNSC::EndAddContact() {
+    _ReleaseContacts(contactlist_3_3);
+
+    _ReleaseContacts(contactlist_6_6);
+    _ReleaseContacts(contactlist_6_3);
+
+    _ReleaseContacts(contactlist_333_3);
+    _ReleaseContacts(contactlist_333_6);
+    _ReleaseContacts(contactlist_333_333);
+
+    _ReleaseContacts(contactlist_666_3);
+    _ReleaseContacts(contactlist_666_6);
+    _ReleaseContacts(contactlist_666_333);
+    _ReleaseContacts(contactlist_666_666);
+
+    _ReleaseContacts(contactlist_33_3);
+    _ReleaseContacts(contactlist_33_6);
+    _ReleaseContacts(contactlist_33_333);
+    _ReleaseContacts(contactlist_33_666);
+    _ReleaseContacts(contactlist_33_33);
+
+    _ReleaseContacts(contactlist_66_3);
+    _ReleaseContacts(contactlist_66_6);
+    _ReleaseContacts(contactlist_66_333);
+    _ReleaseContacts(contactlist_66_666);
+    _ReleaseContacts(contactlist_66_33);
+    _ReleaseContacts(contactlist_66_66);
+
+    _ReleaseContacts(contactlist_6_6_rolling);
 }
 
-template <class Tcont, class Titer, class Ta, class Tb>
-void _OptimalContactInsert(std::list<Tcont*>& contactlist,            // contact list
-                           Titer& lastcontact,                        // last contact acquired
+template <class Tcont, class Ta, class Tb>
+void _OptimalContactInsert(ChContactPool<Tcont>& contactlist,         // contact list
                            int& n_added,                              // number of contacts inserted
                            ChContactContainerNSC* container,          // contact container
                            Ta* objA,                                  // collidable object A
@@ -284,17 +228,24 @@ void _OptimalContactInsert(std::list<Tcont*>& contactlist,            // contact
                            const ChCollisionInfo& cinfo,              // collision information
                            const ChContactMaterialCompositeNSC& cmat  // composite material
 ) {
-    if (lastcontact != contactlist.end()) {
+    Tcont* contact = contactlist.Reuse();
+    if (contact) {
         // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo, cmat, container->GetMinBounceSpeed());
-        lastcontact++;
+        contact->Reset(objA, objB, cinfo, cmat, container->GetMinBounceSpeed());
     } else {
         // add new contact
-        Tcont* mc = new Tcont(container, objA, objB, cinfo, cmat, container->GetMinBounceSpeed());
-        contactlist.push_back(mc);
-        lastcontact = contactlist.end();
+        contact = contactlist.Emplace(container, objA, objB, cinfo, cmat, container->GetMinBounceSpeed());
     }
     n_added++;
+
+    // warm start from the persistent contact cache
+    if (container->IsWarmStartCacheEnabled()) {
+        ChVector3d force;
+        ChVector3d torque;
+        if (container->FindCachedReactions(objA, objB, cinfo.shapeA, cinfo.shapeB, 0.5 * (cinfo.vpA + cinfo.vpB),
+                                            force, torque))
+            contact->SetWarmStartReactions(force, torque);
+    }
 }
 
 void ChContactContainerNSC::AddContact(const ChCollisionInfo& cinfo,
@@ -375,37 +326,32 @@ void ChContactContainerNSC::InsertContact(const ChCollisionInfo& cinfo, const Ch
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 3_3
-                _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_3_3, n_added_3_3, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 3_6 -> 6_3
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, objB, objA, swapped_cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_6_3, n_added_6_3, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 3_333 -> 333_3
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, objB, objA,
-                                      swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_333_3, n_added_333_3, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 3_666 -> 666_3
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, objB, objA,
-                                      swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_3, n_added_666_3, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_33) {
                 auto objB = static_cast<ChContactable_2vars<3, 3>*>(contactableB);
                 // 3_33 -> 33_3
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_33_3, lastcontact_33_3, n_added_33_3, this, objB, objA, swapped_cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_33_3, n_added_33_3, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_66) {
                 auto objB = static_cast<ChContactable_2vars<6, 6>*>(contactableB);
                 // 3_66 -> 66_3
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_66_3, lastcontact_66_3, n_added_66_3, this, objB, objA, swapped_cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_66_3, n_added_66_3, this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -415,40 +361,35 @@ void ChContactContainerNSC::InsertContact(const ChCollisionInfo& cinfo, const Ch
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 6_3
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_6_3, n_added_6_3, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 6_6    ***NOTE: for body-body one could have rolling friction: ***
                 if (cmat.rolling_friction || cmat.spinning_friction) {
-                    _OptimalContactInsert(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, this,
-                                          objA, objB, cinfo, cmat);
+                    _OptimalContactInsert(contactlist_6_6_rolling, n_added_6_6_rolling, this, objA, objB, cinfo, cmat);
                 } else {
-                    _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, objA, objB, cinfo, cmat);
+                    _OptimalContactInsert(contactlist_6_6, n_added_6_6, this, objA, objB, cinfo, cmat);
                 }
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 6_333 -> 333_6
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, objB, objA,
-                                      swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_333_6, n_added_333_6, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 6_666 -> 666_6
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, objB, objA,
-                                      swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_6, n_added_666_6, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_33) {
                 auto objB = static_cast<ChContactable_2vars<3, 3>*>(contactableB);
                 // 6_33 -> 33_6
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_33_6, lastcontact_33_6, n_added_33_6, this, objB, objA, swapped_cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_33_6, n_added_33_6, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_66) {
                 auto objB = static_cast<ChContactable_2vars<6, 6>*>(contactableB);
                 // 6_66 -> 66_6
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_66_6, lastcontact_66_6, n_added_66_6, this, objB, objA, swapped_cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_66_6, n_added_66_6, this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -458,36 +399,30 @@ void ChContactContainerNSC::InsertContact(const ChCollisionInfo& cinfo, const Ch
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 333_3
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_333_3, n_added_333_3, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 333_6
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_333_6, n_added_333_6, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 333_333
-                _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, objA, objB,
-                                      cinfo, cmat);
+                _OptimalContactInsert(contactlist_333_333, n_added_333_333, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 333_666 -> 666_333
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, objB, objA,
-                                      swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_333, n_added_666_333, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_33) {
                 auto objB = static_cast<ChContactable_2vars<3, 3>*>(contactableB);
                 // 333_33 -> 33_333
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_33_333, lastcontact_33_333, n_added_33_333, this, objB, objA,
-                                      swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_33_333, n_added_33_333, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_66) {
                 auto objB = static_cast<ChContactable_2vars<6, 6>*>(contactableB);
                 // 333_66 -> 66_333
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_66_333, lastcontact_66_333, n_added_66_333, this, objB, objA,
-                                      swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_66_333, n_added_66_333, this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -497,35 +432,29 @@ void ChContactContainerNSC::InsertContact(const ChCollisionInfo& cinfo, const Ch
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 666_3
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_666_3, n_added_666_3, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 666_6
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_666_6, n_added_666_6, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 666_333
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, objA, objB,
-                                      cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_333, n_added_666_333, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 666_666
-                _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, objA, objB,
-                                      cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_666, n_added_666_666, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_33) {
                 auto objB = static_cast<ChContactable_2vars<3, 3>*>(contactableB);
                 // 666_33 -> 33_666
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_33_666, lastcontact_33_666, n_added_33_666, this, objB, objA,
-                                      swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_33_666, n_added_33_666, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_66) {
                 auto objB = static_cast<ChContactable_2vars<6, 6>*>(contactableB);
                 // 666_66 -> 66_666
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_66_666, lastcontact_66_666, n_added_66_666, this, objB, objA,
-                                      swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_66_666, n_added_66_666, this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -535,32 +464,28 @@ void ChContactContainerNSC::InsertContact(const ChCollisionInfo& cinfo, const Ch
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 33_3
-                _OptimalContactInsert(contactlist_33_3, lastcontact_33_3, n_added_33_3, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_33_3, n_added_33_3, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 33_6
-                _OptimalContactInsert(contactlist_33_6, lastcontact_33_6, n_added_33_6, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_33_6, n_added_33_6, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 33_333
-                _OptimalContactInsert(contactlist_33_333, lastcontact_33_333, n_added_33_333, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_33_333, n_added_33_333, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 33_666
-                _OptimalContactInsert(contactlist_33_666, lastcontact_33_666, n_added_33_666, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_33_666, n_added_33_666, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_33) {
                 auto objB = static_cast<ChContactable_2vars<3, 3>*>(contactableB);
                 // 33_33
-                _OptimalContactInsert(contactlist_33_33, lastcontact_33_33, n_added_33_33, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_33_33, n_added_33_33, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_66) {
                 auto objB = static_cast<ChContactable_2vars<6, 6>*>(contactableB);
                 // 33_66 -> 66_33
                 ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_66_33, lastcontact_66_33, n_added_66_33, this, objB, objA,
-                                      swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_66_33, n_added_66_33, this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -570,31 +495,27 @@ void ChContactContainerNSC::InsertContact(const ChCollisionInfo& cinfo, const Ch
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 66_3
-                _OptimalContactInsert(contactlist_66_3, lastcontact_66_3, n_added_66_3, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_66_3, n_added_66_3, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 66_6
-                _OptimalContactInsert(contactlist_66_6, lastcontact_66_6, n_added_66_6, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_66_6, n_added_66_6, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 66_333
-                _OptimalContactInsert(contactlist_66_333, lastcontact_66_333, n_added_66_333, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_66_333, n_added_66_333, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 66_666
-                _OptimalContactInsert(contactlist_66_666, lastcontact_66_666, n_added_66_666, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_66_666, n_added_66_666, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_33) {
                 auto objB = static_cast<ChContactable_2vars<3, 3>*>(contactableB);
                 // 66_33
-                _OptimalContactInsert(contactlist_66_33, lastcontact_66_33, n_added_66_33, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_66_33, n_added_66_33, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_66) {
                 auto objB = static_cast<ChContactable_2vars<6, 6>*>(contactableB);
                 // 66_66
-                _OptimalContactInsert(contactlist_66_66, lastcontact_66_66, n_added_66_66, this, objA, objB, cinfo,
-                                      cmat);
+                _OptimalContactInsert(contactlist_66_66, n_added_66_66, this, objA, objB, cinfo, cmat);
             }
         } break;
 
@@ -655,8 +576,8 @@ ChVector3d ChContactContainerNSC::GetContactableTorque(ChContactable* contactabl
 }
 
 template <class Tcont>
-void _ReportAllContacts(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ReportAllContacts(ChContactPool<Tcont>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         bool proceed = mcallback->OnReportContact(
             (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
@@ -669,8 +590,9 @@ void _ReportAllContacts(std::list<Tcont*>& contactlist, ChContactContainer::Repo
 }
 
 template <class Tcont>
-void _ReportAllContactsRolling(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ReportAllContactsRolling(ChContactPool<Tcont>& contactlist,
+                               ChContactContainer::ReportContactCallback* mcallback) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         bool proceed = mcallback->OnReportContact(
             (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
@@ -715,8 +637,9 @@ void ChContactContainerNSC::ReportAllContacts(std::shared_ptr<ReportContactCallb
 }
 
 template <class Tcont>
-void _ReportAllContactsNSC(std::list<Tcont*>& contactlist, ChContactContainerNSC::ReportContactCallbackNSC* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ReportAllContactsNSC(ChContactPool<Tcont>& contactlist,
+                           ChContactContainerNSC::ReportContactCallbackNSC* mcallback) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         bool proceed = mcallback->OnReportContact(
             (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
@@ -730,9 +653,9 @@ void _ReportAllContactsNSC(std::list<Tcont*>& contactlist, ChContactContainerNSC
 }
 
 template <class Tcont>
-void _ReportAllContactsRollingNSC(std::list<Tcont*>& contactlist,
+void _ReportAllContactsRollingNSC(ChContactPool<Tcont>& contactlist,
                                   ChContactContainerNSC::ReportContactCallbackNSC* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         bool proceed = mcallback->OnReportContact(
             (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
@@ -780,11 +703,11 @@ void ChContactContainerNSC::ReportAllContactsNSC(std::shared_ptr<ReportContactCa
 
 template <class Tcont>
 void _IntStateGatherReactions(unsigned int& coffset,
-                              std::list<Tcont*>& contactlist,
+                              ChContactPool<Tcont>& contactlist,
                               const unsigned int off_L,
                               ChVectorDynamic<>& L,
                               const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntStateGatherReactions(off_L + coffset, L);
         coffset += stride;
@@ -827,11 +750,11 @@ void ChContactContainerNSC::IntStateGatherReactions(const unsigned int off_L, Ch
 
 template <class Tcont>
 void _IntStateScatterReactions(unsigned int& coffset,
-                               std::list<Tcont*>& contactlist,
+                               ChContactPool<Tcont>& contactlist,
                                const unsigned int off_L,
                                const ChVectorDynamic<>& L,
                                const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntStateScatterReactions(off_L + coffset, L);
         coffset += stride;
@@ -873,15 +796,15 @@ void ChContactContainerNSC::IntStateScatterReactions(const unsigned int off_L, c
 }
 
 template <class Tcont>
-void _IntLoadResidual_CqL(unsigned int& coffset,           // offset of the contacts
-                          std::list<Tcont*>& contactlist,  // list of contacts
-                          const unsigned int off_L,        // offset in L multipliers
-                          ChVectorDynamic<>& R,            // result: the R residual, R += c*Cq'*L
-                          const ChVectorDynamic<>& L,      // the L vector
-                          const double c,                  // a scaling factor
-                          const int stride                 // stride
+void _IntLoadResidual_CqL(unsigned int& coffset,              // offset of the contacts
+                          ChContactPool<Tcont>& contactlist,  // list of contacts
+                          const unsigned int off_L,           // offset in L multipliers
+                          ChVectorDynamic<>& R,               // result: the R residual, R += c*Cq'*L
+                          const ChVectorDynamic<>& L,         // the L vector
+                          const double c,                     // a scaling factor
+                          const int stride                    // stride
 ) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
         coffset += stride;
@@ -926,16 +849,16 @@ void ChContactContainerNSC::IntLoadResidual_CqL(const unsigned int off_L,
 }
 
 template <class Tcont>
-void _IntLoadConstraint_C(unsigned int& coffset,           // contact offset
-                          std::list<Tcont*>& contactlist,  // contact list
-                          const unsigned int off,          // offset in Qc residual
-                          ChVectorDynamic<>& Qc,           // result: the Qc residual, Qc += c*C
-                          const double c,                  // a scaling factor
-                          bool do_clamp,                   // apply clamping to c*C?
-                          double recovery_clamp,           // value for min/max clamping of c*C
-                          const int stride                 // stride
+void _IntLoadConstraint_C(unsigned int& coffset,              // contact offset
+                          ChContactPool<Tcont>& contactlist,  // contact list
+                          const unsigned int off,             // offset in Qc residual
+                          ChVectorDynamic<>& Qc,              // result: the Qc residual, Qc += c*C
+                          const double c,                     // a scaling factor
+                          bool do_clamp,                      // apply clamping to c*C?
+                          double recovery_clamp,              // value for min/max clamping of c*C
+                          const int stride                    // stride
 ) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
         coffset += stride;
@@ -982,7 +905,7 @@ void ChContactContainerNSC::IntLoadConstraint_C(const unsigned int off,
 
 template <class Tcont>
 void _IntToDescriptor(unsigned int& coffset,
-                      std::list<Tcont*>& contactlist,
+                      ChContactPool<Tcont>& contactlist,
                       const unsigned int off_v,
                       const ChStateDelta& v,
                       const ChVectorDynamic<>& R,
@@ -990,7 +913,7 @@ void _IntToDescriptor(unsigned int& coffset,
                       const ChVectorDynamic<>& L,
                       const ChVectorDynamic<>& Qc,
                       const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntToDescriptor(off_L + coffset, L, Qc);
         coffset += stride;
@@ -1038,13 +961,13 @@ void ChContactContainerNSC::IntToDescriptor(const unsigned int off_v,
 
 template <class Tcont>
 void _IntFromDescriptor(unsigned int& coffset,
-                        std::list<Tcont*>& contactlist,
+                        ChContactPool<Tcont>& contactlist,
                         const unsigned int off_v,
                         ChStateDelta& v,
                         const unsigned int off_L,
                         ChVectorDynamic<>& L,
                         const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContIntFromDescriptor(off_L + coffset, L);
         coffset += stride;
@@ -1091,8 +1014,8 @@ void ChContactContainerNSC::IntFromDescriptor(const unsigned int off_v,
 // SOLVER INTERFACES
 
 template <class Tcont>
-void _InjectConstraints(std::list<Tcont*>& contactlist, ChSystemDescriptor& descriptor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _InjectConstraints(ChContactPool<Tcont>& contactlist, ChSystemDescriptor& descriptor) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->InjectConstraints(descriptor);
         ++itercontact;
@@ -1131,8 +1054,8 @@ void ChContactContainerNSC::InjectConstraints(ChSystemDescriptor& descriptor) {
 }
 
 template <class Tcont>
-void _ConstraintsBiReset(std::list<Tcont*>& contactlist) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ConstraintsBiReset(ChContactPool<Tcont>& contactlist) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ConstraintsBiReset();
         ++itercontact;
@@ -1171,8 +1094,8 @@ void ChContactContainerNSC::ConstraintsBiReset() {
 }
 
 template <class Tcont>
-void _ConstraintsBiLoad_C(std::list<Tcont*>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+void _ConstraintsBiLoad_C(ChContactPool<Tcont>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
         ++itercontact;
@@ -1215,9 +1138,9 @@ void ChContactContainerNSC::LoadConstraintJacobians() {
 }
 
 template <class Tcont>
-void _ConstraintsFetch_react(std::list<Tcont*>& contactlist, double factor) {
+void _ConstraintsFetch_react(ChContactPool<Tcont>& contactlist, double factor) {
     // From constraints to react vector:
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
+    typename ChContactPool<Tcont>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ConstraintsFetch_react(factor);
         ++itercontact;
@@ -1255,6 +1178,166 @@ void ChContactContainerNSC::ConstraintsFetch_react(double factor) {
     _ConstraintsFetch_react(contactlist_6_6_rolling, factor);
 }
 
+// -----------------------------------------------------------------------------
+// Persistent contact cache
+
+// Lexicographic order of (objA, objB, shapeA, shapeB) keys.
+static bool CompareCachedPairs(ChContactable* a1,
+                               ChContactable* b1,
+                               ChCollisionShape* sa1,
+                               ChCollisionShape* sb1,
+                               ChContactable* a2,
+                               ChContactable* b2,
+                               ChCollisionShape* sa2,
+                               ChCollisionShape* sb2) {
+    std::less<ChContactable*> less;
+    std::less<ChCollisionShape*> less_shape;
+    if (a1 != a2)
+        return less(a1, a2);
+    if (b1 != b2)
+        return less(b1, b2);
+    if (sa1 != sa2)
+        return less_shape(sa1, sa2);
+    return less_shape(sb1, sb2);
+}
+
+template <class Tcont, class F>
+void _ForEachContactReaction(ChContactPool<Tcont>& contactlist, F f) {
+    for (auto contact : contactlist) {
+        const auto& plane = contact->GetContactPlane();
+        f(contact->GetObjA(), contact->GetObjB(), contact->GetShapeA(), contact->GetShapeB(),
+          0.5 * (contact->GetContactP1() + contact->GetContactP2()), plane * contact->GetContactForce(),
+          plane * contact->GetContactTorque());
+    }
+}
+
+void ChContactContainerNSC::CacheContacts(std::vector<CachedContact>& cache) {
+    cache.clear();
+
+    auto add = [&cache](ChContactable* objA, ChContactable* objB, ChCollisionShape* shapeA, ChCollisionShape* shapeB,
+                        const ChVector3d& point, const ChVector3d& force, const ChVector3d& torque) {
+        // store the pair of objects in canonical order (reactions act on the second object)
+        if (std::less<ChContactable*>()(objB, objA))
+            cache.push_back({objB, objA, shapeB, shapeA, point, -force, -torque});
+        else
+            cache.push_back({objA, objB, shapeA, shapeB, point, force, torque});
+    };
+
+    _ForEachContactReaction(contactlist_3_3, add);
+
+    _ForEachContactReaction(contactlist_6_6, add);
+    _ForEachContactReaction(contactlist_6_3, add);
+
+    _ForEachContactReaction(contactlist_333_3, add);
+    _ForEachContactReaction(contactlist_333_6, add);
+    _ForEachContactReaction(contactlist_333_333, add);
+
+    _ForEachContactReaction(contactlist_666_3, add);
+    _ForEachContactReaction(contactlist_666_6, add);
+    _ForEachContactReaction(contactlist_666_333, add);
+    _ForEachContactReaction(contactlist_666_666, add);
+
+    _ForEachContactReaction(contactlist_33_3, add);
+    _ForEachContactReaction(contactlist_33_6, add);
+    _ForEachContactReaction(contactlist_33_333, add);
+    _ForEachContactReaction(contactlist_33_666, add);
+    _ForEachContactReaction(contactlist_33_33, add);
+
+    _ForEachContactReaction(contactlist_66_3, add);
+    _ForEachContactReaction(contactlist_66_6, add);
+    _ForEachContactReaction(contactlist_66_333, add);
+    _ForEachContactReaction(contactlist_66_666, add);
+    _ForEachContactReaction(contactlist_66_33, add);
+    _ForEachContactReaction(contactlist_66_66, add);
+
+    _ForEachContactReaction(contactlist_6_6_rolling, add);
+
+    // Sort by pairs of objects and shapes (stable, so that the order of contacts within a pair is deterministic)
+    std::stable_sort(cache.begin(), cache.end(), [](const CachedContact& c1, const CachedContact& c2) {
+        return CompareCachedPairs(c1.objA, c1.objB, c1.shapeA, c1.shapeB, c2.objA, c2.objB, c2.shapeA, c2.shapeB);
+    });
+}
+
+bool ChContactContainerNSC::FindCachedReactions(ChContactable* objA,
+                                                ChContactable* objB,
+                                                ChCollisionShape* shapeA,
+                                                ChCollisionShape* shapeB,
+                                                const ChVector3d& point,
+                                                ChVector3d& force,
+                                                ChVector3d& torque) const {
+    bool swapped = std::less<ChContactable*>()(objB, objA);
+    if (swapped) {
+        std::swap(objA, objB);
+        std::swap(shapeA, shapeB);
+    }
+
+    // Find the range of cached contacts between the two shapes of the two objects
+    auto first = std::lower_bound(m_cache.begin(), m_cache.end(), 0, [&](const CachedContact& c, int) {
+        return CompareCachedPairs(c.objA, c.objB, c.shapeA, c.shapeB, objA, objB, shapeA, shapeB);
+    });
+
+    // Identify the closest cached contact within tolerance
+    const CachedContact* match = nullptr;
+    double min_dist2 = m_cache_tol * m_cache_tol;
+    for (auto c = first; c != m_cache.end(); ++c) {
+        if (c->objA != objA || c->objB != objB || c->shapeA != shapeA || c->shapeB != shapeB)
+            break;
+        double dist2 = (c->point - point).Length2();
+        if (dist2 <= min_dist2) {
+            min_dist2 = dist2;
+            match = &(*c);
+        }
+    }
+
+    if (!match)
+        return false;
+
+    force = swapped ? -match->force : match->force;
+    torque = swapped ? -match->torque : match->torque;
+    return true;
+}
+
+void ChContactContainerNSC::SnapshotOut(ChStateSnapshot& snapshot) {
+    // Save the cache that would be used at the next collision detection pass
+    if (!m_cache_enabled)
+        m_cache_work.clear();
+    else if (m_cache_restored)
+        m_cache_work = m_cache;
+    else
+        CacheContacts(m_cache_work);
+
+    snapshot.Write(m_cache_work.size());
+    for (const auto& entry : m_cache_work) {
+        snapshot.Write(entry.objA);
+        snapshot.Write(entry.objB);
+        snapshot.Write(entry.shapeA);
+        snapshot.Write(entry.shapeB);
+        snapshot.Write(entry.point);
+        snapshot.Write(entry.force);
+        snapshot.Write(entry.torque);
+    }
+}
+
+void ChContactContainerNSC::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    size_t num_entries;
+    reader.Read(num_entries);
+    m_cache.clear();
+    for (size_t i = 0; i < num_entries; i++) {
+        CachedContact entry;
+        reader.Read(entry.objA);
+        reader.Read(entry.objB);
+        reader.Read(entry.shapeA);
+        reader.Read(entry.shapeB);
+        reader.Read(entry.point);
+        reader.Read(entry.force);
+        reader.Read(entry.torque);
+        m_cache.push_back(entry);
+    }
+    m_cache_restored = m_cache_enabled;
+}
+
+// -----------------------------------------------------------------------------
+
 void ChContactContainerNSC::ArchiveOut(ChArchiveOut& archive_out) {
     // version number
     archive_out.VersionWrite<ChContactContainerNSC>();
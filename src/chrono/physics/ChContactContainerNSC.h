@@ -15,9 +15,8 @@
 #ifndef CH_CONTACTCONTAINER_NSC_H
 #define CH_CONTACTCONTAINER_NSC_H
 
-#include <list>
-
 #include "chrono/physics/ChContactContainer.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactNSC.h"
 #include "chrono/physics/ChContactNSCrolling.h"
 #include "chrono/physics/ChContactable.h"
@@ -25,9 +24,10 @@
 namespace chrono {
 
 /// Class representing a container of many non-smooth contacts.
-/// Implemented using linked lists of ChContactNSC objects (that is, contacts between two ChContactable objects, with 3
-/// reactions). It might also contain ChContactNSCrolling objects (extended versions of ChContactNSC, with 6 reactions,
-/// that account also for rolling and spinning resistance), but also for '6dof vs 6dof' contactables.
+/// Implemented using pooled, contiguous storage of ChContactNSC objects (that is, contacts between two ChContactable
+/// objects, with 3 reactions). It might also contain ChContactNSCrolling objects (extended versions of ChContactNSC,
+/// with 6 reactions, that account also for rolling and spinning resistance), but also for '6dof vs 6dof' contactables.
+/// Contact objects are recycled from one collision detection pass to the next (see ChContactPool).
 class ChApi ChContactContainerNSC : public ChContactContainer {
   public:
     typedef ChContactNSC<ChContactable_1vars<3>, ChContactable_1vars<3> > ChContactNSC_3_3;
@@ -82,9 +82,8 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     virtual void RemoveAllContacts() override;
 
     /// The collision system will call BeginAddContact() before adding all contacts (for example with AddContact() or
-    /// similar). Instead of simply deleting all list of the previous contacts, this optimized implementation rewinds
-    /// the link iterator to begin and tries to reuse previous contact objects until possible, to avoid too much
-    /// allocation/deallocation.
+    /// similar). Instead of deleting the previous contacts, this optimized implementation rewinds the contact pools so
+    /// that previous contact objects are reused as much as possible, avoiding allocation/deallocation.
     virtual void BeginAddContact() override;
 
     /// Add a contact between two collision shapes, storing it into this container.
@@ -100,7 +99,9 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     virtual void AddContact(const ChCollisionInfo& cinfo) override;
 
     /// The collision system will call BeginAddContact() after adding all contacts (for example with AddContact() or
-    /// similar). This optimized version purges the end of the list of contacts that were not reused (if any).
+    /// similar). Contact objects that were not reused (if any) are kept in the pools for subsequent steps, with their
+    /// references to the contactable objects cleared; pools much larger than the current number of contacts are trimmed
+    /// (see ChContactPool::Release).
     virtual void EndAddContact() override;
 
     /// Scan all the contacts and for each contact executes the OnReportContact() function of the provided callback
@@ -154,6 +155,33 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     /// Objects will rebounce only if their relative colliding speed is above this threshold.
     double GetMinBounceSpeed() const { return min_bounce_speed; }
 
+    /// Enable/disable the persistent contact cache used to warm start the solver (default: false).
+    /// When enabled, the reactions of all contacts are cached at the beginning of each collision detection pass, keyed
+    /// by the pair of contactable objects and by the contact location. A new contact between the same pair of objects
+    /// and within the cache tolerance of a cached contact (the closest one, if several) is initialized with the cached
+    /// reactions, projected onto its contact coordinate system. Other contacts are initialized as usual (with zero
+    /// reactions, unless the collision system provides its own persistent reaction cache).
+    /// This is only useful with solvers that support warm starting (see ChIterativeSolver::EnableWarmStart).
+    void EnableWarmStartCache(bool val) { m_cache_enabled = val; }
+
+    /// Return true if the persistent contact cache is enabled.
+    bool IsWarmStartCacheEnabled() const { return m_cache_enabled; }
+
+    /// Set the maximum distance between the locations of a new contact and a cached contact for the two to be
+    /// identified (default: 0.01).
+    void SetWarmStartCacheTolerance(double tol) { m_cache_tol = tol; }
+
+    /// Get the cached reactions (force and torque, in absolute frame, acting on objB) for a contact between the two
+    /// given collision shapes of the two objects at the specified location. Return false if no matching contact exists
+    /// in the cache.
+    bool FindCachedReactions(ChContactable* objA,
+                             ChContactable* objB,
+                             ChCollisionShape* shapeA,
+                             ChCollisionShape* shapeB,
+                             const ChVector3d& point,
+                             ChVector3d& force,
+                             ChVector3d& torque) const;
+
     /// Update state of this contact container: compute jacobians, violations, etc.
     /// and store results in inner structures of contacts.
     virtual void Update(double mtime, bool update_assets = true) override;
@@ -208,35 +236,59 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     /// Method to allow de-serialization of transient data from archives.
     virtual void ArchiveIn(ChArchiveIn& archive_in) override;
 
+    // STATE SNAPSHOTS
+
+    /// Append the persistent contact cache (if enabled) to the given snapshot.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Restore the persistent contact cache from the given snapshot.
+    /// The restored cache is used at the next collision detection pass.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
   protected:
-    std::list<ChContactNSC_3_3*> contactlist_3_3;
+    /// Entry in the persistent contact cache.
+    struct CachedContact {
+        ChContactable* objA;  ///< first contactable object (lower address)
+        ChContactable* objB;      ///< second contactable object (higher address)
+        ChCollisionShape* shapeA;  ///< collision shape of objA
+        ChCollisionShape* shapeB;  ///< collision shape of objB
+        ChVector3d point;         ///< contact location (absolute frame)
+        ChVector3d force;         ///< contact force acting on objB (absolute frame)
+        ChVector3d torque;        ///< contact torque acting on objB (absolute frame)
+    };
+
+    /// Collect the current reactions of all contacts in the given cache, sorted by pairs of contactable objects and
+    /// pairs of collision shapes.
+    void CacheContacts(std::vector<CachedContact>& cache);
+
+    ChContactPool<ChContactNSC_3_3> contactlist_3_3;
 
-    std::list<ChContactNSC_6_6*> contactlist_6_6;
-    std::list<ChContactNSC_6_3*> contactlist_6_3;
+    ChContactPool<ChContactNSC_6_6> contactlist_6_6;
+    ChContactPool<ChContactNSC_6_3> contactlist_6_3;
 
-    std::list<ChContactNSC_333_3*> contactlist_333_3;
-    std::list<ChContactNSC_333_6*> contactlist_333_6;
-    std::list<ChContactNSC_333_333*> contactlist_333_333;
+    ChContactPool<ChContactNSC_333_3> contactlist_333_3;
+    ChContactPool<ChContactNSC_333_6> contactlist_333_6;
+    ChContactPool<ChContactNSC_333_333> contactlist_333_333;
 
-    std::list<ChContactNSC_666_3*> contactlist_666_3;
-    std::list<ChContactNSC_666_6*> contactlist_666_6;
-    std::list<ChContactNSC_666_333*> contactlist_666_333;
-    std::list<ChContactNSC_666_666*> contactlist_666_666;
+    ChContactPool<ChContactNSC_666_3> contactlist_666_3;
+    ChContactPool<ChContactNSC_666_6> contactlist_666_6;
+    ChContactPool<ChContactNSC_666_333> contactlist_666_333;
+    ChContactPool<ChContactNSC_666_666> contactlist_666_666;
 
-    std::list<ChContactNSC_33_3*> contactlist_33_3;
-    std::list<ChContactNSC_33_6*> contactlist_33_6;
-    std::list<ChContactNSC_33_333*> contactlist_33_333;
-    std::list<ChContactNSC_33_666*> contactlist_33_666;
-    std::list<ChContactNSC_33_33*> contactlist_33_33;
+    ChContactPool<ChContactNSC_33_3> contactlist_33_3;
+    ChContactPool<ChContactNSC_33_6> contactlist_33_6;
+    ChContactPool<ChContactNSC_33_333> contactlist_33_333;
+    ChContactPool<ChContactNSC_33_666> contactlist_33_666;
+    ChContactPool<ChContactNSC_33_33> contactlist_33_33;
 
-    std::list<ChContactNSC_66_3*> contactlist_66_3;
-    std::list<ChContactNSC_66_6*> contactlist_66_6;
-    std::list<ChContactNSC_66_333*> contactlist_66_333;
-    std::list<ChContactNSC_66_666*> contactlist_66_666;
-    std::list<ChContactNSC_66_33*> contactlist_66_33;
-    std::list<ChContactNSC_66_66*> contactlist_66_66;
+    ChContactPool<ChContactNSC_66_3> contactlist_66_3;
+    ChContactPool<ChContactNSC_66_6> contactlist_66_6;
+    ChContactPool<ChContactNSC_66_333> contactlist_66_333;
+    ChContactPool<ChContactNSC_66_666> contactlist_66_666;
+    ChContactPool<ChContactNSC_66_33> contactlist_66_33;
+    ChContactPool<ChContactNSC_66_66> contactlist_66_66;
 
-    std::list<ChContactNSCrolling_6_6*> contactlist_6_6_rolling;
+    ChContactPool<ChContactNSCrolling_6_6> contactlist_6_6_rolling;
 
     int n_added_3_3;
 
@@ -267,35 +319,6 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
     int n_added_6_6_rolling;
 
-    std::list<ChContactNSC_3_3*>::iterator lastcontact_3_3;
-
-    std::list<ChContactNSC_6_6*>::iterator lastcontact_6_6;
-    std::list<ChContactNSC_6_3*>::iterator lastcontact_6_3;
-
-    std::list<ChContactNSC_333_3*>::iterator lastcontact_333_3;
-    std::list<ChContactNSC_333_6*>::iterator lastcontact_333_6;
-    std::list<ChContactNSC_333_333*>::iterator lastcontact_333_333;
-
-    std::list<ChContactNSC_666_3*>::iterator lastcontact_666_3;
-    std::list<ChContactNSC_666_6*>::iterator lastcontact_666_6;
-    std::list<ChContactNSC_666_333*>::iterator lastcontact_666_333;
-    std::list<ChContactNSC_666_666*>::iterator lastcontact_666_666;
-
-    std::list<ChContactNSC_33_3*>::iterator lastcontact_33_3;
-    std::list<ChContactNSC_33_6*>::iterator lastcontact_33_6;
-    std::list<ChContactNSC_33_333*>::iterator lastcontact_33_333;
-    std::list<ChContactNSC_33_666*>::iterator lastcontact_33_666;
-    std::list<ChContactNSC_33_33*>::iterator lastcontact_33_33;
-
-    std::list<ChContactNSC_66_3*>::iterator lastcontact_66_3;
-    std::list<ChContactNSC_66_6*>::iterator lastcontact_66_6;
-    std::list<ChContactNSC_66_333*>::iterator lastcontact_66_333;
-    std::list<ChContactNSC_66_666*>::iterator lastcontact_66_666;
-    std::list<ChContactNSC_66_33*>::iterator lastcontact_66_33;
-    std::list<ChContactNSC_66_66*>::iterator lastcontact_66_66;
-
-    std::list<ChContactNSCrolling_6_6*>::iterator lastcontact_6_6_rolling;
-
     std::unordered_map<ChContactable*, ForceTorque> contact_forces;
 
   private:
@@ -303,6 +326,12 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
     double min_bounce_speed;  ///< minimum speed for rebounce after impacts. Lower speeds are clamped to 0
 
+    bool m_cache_enabled;                     ///< use the persistent contact cache for warm starting?
+    bool m_cache_restored;                    ///< was the cache restored from a snapshot?
+    double m_cache_tol;                       ///< distance tolerance for identifying cached contacts
+    std::vector<CachedContact> m_cache;       ///< persistent contact cache
+    std::vector<CachedContact> m_cache_work;  ///< work cache (for snapshots)
+
     friend class ChSystemNSC;
 };
 
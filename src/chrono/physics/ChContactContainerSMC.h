@@ -17,16 +17,17 @@
 
 #include <algorithm>
 #include <cmath>
-#include <list>
 
 #include "chrono/physics/ChContactContainer.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactSMC.h"
 #include "chrono/physics/ChContactable.h"
 
 namespace chrono {
 
 /// Class representing a container of many smooth (penalty) contacts.
-/// Implemented using linked lists of ChContactSMC objects (that is, contacts between two ChContactable objects).
+/// Implemented using pooled, contiguous storage of ChContactSMC objects (that is, contacts between two ChContactable
+/// objects). Contact objects are recycled from one collision detection pass to the next (see ChContactPool).
 class ChApi ChContactContainerSMC : public ChContactContainer {
   public:
     typedef ChContactSMC<ChContactable_1vars<3>, ChContactable_1vars<3> > ChContactSMC_3_3;
@@ -57,32 +58,32 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     typedef ChContactSMC<ChContactable_2vars<6, 6>, ChContactable_2vars<6, 6> > ChContactSMC_66_66;
 
   protected:
-    std::list<ChContactSMC_3_3*> contactlist_3_3;
+    ChContactPool<ChContactSMC_3_3> contactlist_3_3;
 
-    std::list<ChContactSMC_6_3*> contactlist_6_3;
-    std::list<ChContactSMC_6_6*> contactlist_6_6;
+    ChContactPool<ChContactSMC_6_3> contactlist_6_3;
+    ChContactPool<ChContactSMC_6_6> contactlist_6_6;
 
-    std::list<ChContactSMC_333_3*> contactlist_333_3;
-    std::list<ChContactSMC_333_6*> contactlist_333_6;
-    std::list<ChContactSMC_333_333*> contactlist_333_333;
+    ChContactPool<ChContactSMC_333_3> contactlist_333_3;
+    ChContactPool<ChContactSMC_333_6> contactlist_333_6;
+    ChContactPool<ChContactSMC_333_333> contactlist_333_333;
 
-    std::list<ChContactSMC_666_3*> contactlist_666_3;
-    std::list<ChContactSMC_666_6*> contactlist_666_6;
-    std::list<ChContactSMC_666_333*> contactlist_666_333;
-    std::list<ChContactSMC_666_666*> contactlist_666_666;
+    ChContactPool<ChContactSMC_666_3> contactlist_666_3;
+    ChContactPool<ChContactSMC_666_6> contactlist_666_6;
+    ChContactPool<ChContactSMC_666_333> contactlist_666_333;
+    ChContactPool<ChContactSMC_666_666> contactlist_666_666;
 
-    std::list<ChContactSMC_33_3*> contactlist_33_3;
-    std::list<ChContactSMC_33_6*> contactlist_33_6;
-    std::list<ChContactSMC_33_333*> contactlist_33_333;
-    std::list<ChContactSMC_33_666*> contactlist_33_666;
-    std::list<ChContactSMC_33_33*> contactlist_33_33;
+    ChContactPool<ChContactSMC_33_3> contactlist_33_3;
+    ChContactPool<ChContactSMC_33_6> contactlist_33_6;
+    ChContactPool<ChContactSMC_33_333> contactlist_33_333;
+    ChContactPool<ChContactSMC_33_666> contactlist_33_666;
+    ChContactPool<ChContactSMC_33_33> contactlist_33_33;
 
-    std::list<ChContactSMC_66_3*> contactlist_66_3;
-    std::list<ChContactSMC_66_6*> contactlist_66_6;
-    std::list<ChContactSMC_66_333*> contactlist_66_333;
-    std::list<ChContactSMC_66_666*> contactlist_66_666;
-    std::list<ChContactSMC_66_33*> contactlist_66_33;
-    std::list<ChContactSMC_66_66*> contactlist_66_66;
+    ChContactPool<ChContactSMC_66_3> contactlist_66_3;
+    ChContactPool<ChContactSMC_66_6> contactlist_66_6;
+    ChContactPool<ChContactSMC_66_333> contactlist_66_333;
+    ChContactPool<ChContactSMC_66_666> contactlist_66_666;
+    ChContactPool<ChContactSMC_66_33> contactlist_66_33;
+    ChContactPool<ChContactSMC_66_66> contactlist_66_66;
 
     int n_added_3_3;
 
@@ -111,33 +112,6 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     int n_added_66_33;
     int n_added_66_66;
 
-    std::list<ChContactSMC_3_3*>::iterator lastcontact_3_3;
-
-    std::list<ChContactSMC_6_3*>::iterator lastcontact_6_3;
-    std::list<ChContactSMC_6_6*>::iterator lastcontact_6_6;
-
-    std::list<ChContactSMC_333_3*>::iterator lastcontact_333_3;
-    std::list<ChContactSMC_333_6*>::iterator lastcontact_333_6;
-    std::list<ChContactSMC_333_333*>::iterator lastcontact_333_333;
-
-    std::list<ChContactSMC_666_3*>::iterator lastcontact_666_3;
-    std::list<ChContactSMC_666_6*>::iterator lastcontact_666_6;
-    std::list<ChContactSMC_666_333*>::iterator lastcontact_666_333;
-    std::list<ChContactSMC_666_666*>::iterator lastcontact_666_666;
-
-    std::list<ChContactSMC_33_3*>::iterator lastcontact_33_3;
-    std::list<ChContactSMC_33_6*>::iterator lastcontact_33_6;
-    std::list<ChContactSMC_33_333*>::iterator lastcontact_33_333;
-    std::list<ChContactSMC_33_666*>::iterator lastcontact_33_666;
-    std::list<ChContactSMC_33_33*>::iterator lastcontact_33_33;
-
-    std::list<ChContactSMC_66_3*>::iterator lastcontact_66_3;
-    std::list<ChContactSMC_66_6*>::iterator lastcontact_66_6;
-    std::list<ChContactSMC_66_333*>::iterator lastcontact_66_333;
-    std::list<ChContactSMC_66_666*>::iterator lastcontact_66_666;
-    std::list<ChContactSMC_66_33*>::iterator lastcontact_66_33;
-    std::list<ChContactSMC_66_66*>::iterator lastcontact_66_66;
-
     std::unordered_map<ChContactable*, ForceTorque> contact_forces;
 
   public:
@@ -162,9 +136,8 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     virtual void RemoveAllContacts() override;
 
     /// The collision system will call BeginAddContact() before adding all contacts (for example with AddContact() or
-    /// similar). Instead of simply deleting all list of the previous contacts, this optimized implementation rewinds
-    /// the link iterator to begin and tries to reuse previous contact objects until possible, to avoid too much
-    /// allocation/deallocation.
+    /// similar). Instead of deleting the previous contacts, this optimized implementation rewinds the contact pools so
+    /// that previous contact objects are reused as much as possible, avoiding allocation/deallocation.
     virtual void BeginAddContact() override;
 
     /// Add a contact between two collision shapes, storing it into this container.
@@ -180,7 +153,9 @@ class ChApi ChContactContainerSMC : public ChContactContainer {
     virtual void AddContact(const ChCollisionInfo& cinfo) override;
 
     /// The collision system will call BeginAddContact() after adding all contacts (for example with AddContact() or
-    /// similar). This optimized version purges the end of the list of contacts that were not reused (if any).
+    /// similar). Contact objects that were not reused (if any) are kept in the pools for subsequent steps, with their
+    /// references to the contactable objects cleared; pools much larger than the current number of contacts are trimmed
+    /// (see ChContactPool::Release).
     virtual void EndAddContact() override;
 
     /// Scan all the contacts and for each contact executes the OnReportContact() function of the provided callback
@@ -128,6 +128,12 @@ class ChContactNSC : public ChContactTuple<Ta, Tb> {
     /// Get the contact force, if computed, in contact coordinate system
     virtual ChVector3d GetContactForce() const override { return react_force; }
 
+    /// Set the contact reactions used to warm start the solver, from a force and torque given in the absolute frame.
+    /// The reactions are projected onto the current contact coordinate system.
+    virtual void SetWarmStartReactions(const ChVector3d& force, const ChVector3d& torque) {
+        react_force = this->contact_plane.transpose() * force;
+    }
+
     /// Get the contact friction coefficient
     virtual double GetFriction() { return Nx.GetFrictionCoefficient(); }
 
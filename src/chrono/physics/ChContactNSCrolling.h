@@ -109,6 +109,12 @@ class ChContactNSCrolling : public ChContactNSC<Ta, Tb> {
     /// Get the contact force, if computed, in contact coordinate system
     virtual ChVector3d GetContactTorque() { return react_torque; }
 
+    /// Set the contact reactions used to warm start the solver, from a force and torque given in the absolute frame.
+    virtual void SetWarmStartReactions(const ChVector3d& force, const ChVector3d& torque) override {
+        ChContactNSC<Ta, Tb>::SetWarmStartReactions(force, torque);
+        react_torque = this->contact_plane.transpose() * torque;
+    }
+
     /// Get the contact rolling friction coefficient
     virtual float GetRollingFriction() { return Rx.GetRollingFrictionCoefficient(); }
     /// Set the contact rolling friction coefficient
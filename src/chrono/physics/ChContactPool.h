@@ -0,0 +1,155 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2024 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#ifndef CH_CONTACT_POOL_H
+#define CH_CONTACT_POOL_H
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "chrono/core/ChMatrix.h"
+
+namespace chrono {
+
+/// Pooled storage for contact objects of a given type.
+/// Contact objects are constructed in contiguous slabs of memory and are recycled across calls to
+/// ChContactContainer::BeginAddContact / EndAddContact, so that no allocation or deallocation takes place once the
+/// pool has grown to the peak number of contacts. The active contacts are exposed as a contiguous range of pointers
+/// (see begin() and end()), ordered as they were added. Objects beyond the active range are kept alive for reuse.
+template <class Tcont>
+class ChContactPool {
+  public:
+    typedef typename std::vector<Tcont*>::iterator iterator;
+    typedef typename std::vector<Tcont*>::const_iterator const_iterator;
+
+    ChContactPool() : m_num_active(0), m_next(nullptr), m_last(nullptr) {}
+
+    ChContactPool(const ChContactPool&) = delete;
+    ChContactPool& operator=(const ChContactPool&) = delete;
+
+    ~ChContactPool() { Clear(); }
+
+    /// Iterator to the first active contact.
+    iterator begin() { return m_contacts.begin(); }
+    const_iterator begin() const { return m_contacts.begin(); }
+
+    /// Iterator past the last active contact.
+    iterator end() { return m_contacts.begin() + m_num_active; }
+    const_iterator end() const { return m_contacts.begin() + m_num_active; }
+
+    /// Return the number of active contacts.
+    size_t size() const { return m_num_active; }
+
+    /// Return true if there are no active contacts.
+    bool empty() const { return m_num_active == 0; }
+
+    /// Return the number of contact objects constructed in the pool (active or available for reuse).
+    size_t capacity() const { return m_contacts.size(); }
+
+    /// Access the i-th active contact.
+    Tcont* operator[](size_t i) const {
+        assert(i < m_num_active);
+        return m_contacts[i];
+    }
+
+    /// Mark all contacts as inactive. The contact objects are kept alive and are recycled by Reuse().
+    void Rewind() { m_num_active = 0; }
+
+    /// Activate and return the next recycled contact object, or nullptr if none is available.
+    /// The caller is responsible for reinitializing the returned contact.
+    Tcont* Reuse() {
+        if (m_num_active == m_contacts.size())
+            return nullptr;
+        return m_contacts[m_num_active++];
+    }
+
+    /// Construct a new active contact in the pool storage, forwarding the given arguments to the contact constructor.
+    /// Must be called only if Reuse() returned nullptr.
+    template <typename... Args>
+    Tcont* Emplace(Args&&... args) {
+        assert(m_num_active == m_contacts.size());
+        if (m_next == m_last)
+            AllocateSlab();
+        Tcont* contact = new (m_next) Tcont(std::forward<Args>(args)...);
+        ++m_next;
+        m_contacts.push_back(contact);
+        m_num_active++;
+        return contact;
+    }
+
+    /// Release the inactive contact objects, to be called once all contacts were added.
+    /// The references of the inactive contacts to their contactable objects are cleared. If the number of contact
+    /// objects in the pool exceeds the given high-water mark, the inactive contacts beyond half of it are destroyed and
+    /// the storage slabs left unused are freed.
+    void Release(size_t high_water) {
+        for (size_t i = m_num_active; i < m_contacts.size(); i++)
+            m_contacts[i]->Release();
+
+        if (m_contacts.size() <= high_water)
+            return;
+
+        size_t keep = std::max(m_num_active, high_water / 2);
+        for (size_t i = keep; i < m_contacts.size(); i++)
+            m_contacts[i]->~Tcont();
+        m_contacts.resize(keep);
+
+        // Contacts are constructed sequentially across slabs: find the slab holding the next slot
+        size_t islab = 0;
+        size_t first = 0;
+        while (first + m_slabs[islab].second < keep)
+            first += m_slabs[islab++].second;
+        for (size_t i = islab + 1; i < m_slabs.size(); i++)
+            m_allocator.deallocate(m_slabs[i].first, m_slabs[i].second);
+        m_slabs.resize(islab + 1);
+        m_next = m_slabs[islab].first + (keep - first);
+        m_last = m_slabs[islab].first + m_slabs[islab].second;
+    }
+
+    /// Destroy all contact objects and release the pool storage.
+    void Clear() {
+        for (auto contact : m_contacts)
+            contact->~Tcont();
+        for (auto& slab : m_slabs)
+            m_allocator.deallocate(slab.first, slab.second);
+        m_contacts.clear();
+        m_slabs.clear();
+        m_num_active = 0;
+        m_next = nullptr;
+        m_last = nullptr;
+    }
+
+  private:
+    /// Allocate a new slab, doubling the pool capacity.
+    void AllocateSlab() {
+        size_t n = std::max(m_contacts.size(), (size_t)16);
+        Tcont* slab = m_allocator.allocate(n);
+        m_slabs.push_back(std::make_pair(slab, n));
+        m_next = slab;
+        m_last = slab + n;
+    }
+
+    std::vector<Tcont*> m_contacts;                  ///< constructed contacts (active ones first)
+    std::vector<std::pair<Tcont*, size_t>> m_slabs;  ///< allocated slabs (storage and size)
+    size_t m_num_active;                             ///< number of active contacts
+    Tcont* m_next;                                   ///< next free slot in the current slab
+    Tcont* m_last;                                   ///< end of the current slab
+    Eigen::aligned_allocator<Tcont> m_allocator;     ///< slab allocator
+};
+
+}  // end namespace chrono
+
+#endif
@@ -37,6 +37,9 @@ class ChContactTuple {
     Ta* objA;  ///< first ChContactable object in the pair
     Tb* objB;  ///< second ChContactable object in the pair
 
+    ChCollisionShape* shapeA;  ///< collision shape of object A (may be null)
+    ChCollisionShape* shapeB;  ///< collision shape of object B (may be null)
+
     ChVector3d p1;      ///< max penetration point on geo1, after refining, in abs space
     ChVector3d p2;      ///< max penetration point on geo2, after refining, in abs space
     ChVector3d normal;  ///< normal, on surface of master reference (geo1)
@@ -47,10 +50,10 @@ class ChContactTuple {
     double eff_radius;  ///< effective radius of curvature at contact
 
   public:
-    ChContactTuple() {}
+    ChContactTuple() : shapeA(nullptr), shapeB(nullptr) {}
 
     ChContactTuple(ChContactContainer* contact_container, Ta* obj_A, Tb* obj_B)
-        : container(contact_container), objA(obj_A), objB(obj_B) {
+        : container(contact_container), objA(obj_A), objB(obj_B), shapeA(nullptr), shapeB(nullptr) {
         assert(contact_container);
         assert(obj_A);
         assert(obj_B);
@@ -68,6 +71,8 @@ class ChContactTuple {
 
         this->objA = obj_A;
         this->objB = obj_B;
+        this->shapeA = cinfo.shapeA;
+        this->shapeB = cinfo.shapeB;
 
         this->p1 = cinfo.vpA;
         this->p2 = cinfo.vpB;
@@ -79,12 +84,26 @@ class ChContactTuple {
         contact_plane.SetFromAxisX(normal, VECT_Y);
     }
 
+    /// Clear the references to the contactable objects (for a contact kept in a pool for later reuse).
+    void Release() {
+        this->objA = nullptr;
+        this->objB = nullptr;
+        this->shapeA = nullptr;
+        this->shapeB = nullptr;
+    }
+
     /// Get the colliding object A, with point P1
     Ta* GetObjA() { return this->objA; }
 
     /// Get the colliding object B, with point P2
     Tb* GetObjB() { return this->objB; }
 
+    /// Get the collision shape of object A (null if not provided by the collision system).
+    ChCollisionShape* GetShapeA() const { return this->shapeA; }
+
+    /// Get the collision shape of object B (null if not provided by the collision system).
+    ChCollisionShape* GetShapeB() const { return this->shapeB; }
+
     /// Get the contact coordinate system, expressed in absolute frame.
     /// This represents the 'main' reference of the link: reaction forces
     /// are expressed in this coordinate system. Its origin is point P2.
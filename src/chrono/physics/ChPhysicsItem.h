@@ -24,6 +24,7 @@
 #include "chrono/assets/ChVisualModel.h"
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/timestepper/ChState.h"
+#include "chrono/timestepper/ChStateSnapshot.h"
 
 namespace chrono {
 
@@ -38,7 +39,7 @@ class ChModalAssembly;
 /// Such items (e.g., rigid bodies, joints, FEM meshes, etc.) can contain ChVariables or ChConstraints objects.
 class ChApi ChPhysicsItem : public ChObj {
   public:
-    ChPhysicsItem() : system(NULL), offset_x(0), offset_w(0), offset_L(0) {}
+    ChPhysicsItem() : system(NULL), offset_x(0), offset_w(0), offset_L(0), multirate_fast(false) {}
     ChPhysicsItem(const ChPhysicsItem& other);
     virtual ~ChPhysicsItem();
 
@@ -102,6 +103,14 @@ class ChApi ChPhysicsItem : public ChObj {
     /// Return true if the object is active and included in dynamics.
     virtual bool IsActive() const { return true; }
 
+    /// Assign this item to the fast partition of a multirate integrator (default: false).
+    /// With a ChTimestepperMultirate, the states of items in the fast partition are advanced with several substeps
+    /// within each step of the rest of the system. Flagging a ChAssembly assigns all its contents.
+    void SetMultirateFast(bool val) { multirate_fast = val; }
+
+    /// Return true if this item is assigned to the fast partition of a multirate integrator.
+    bool IsMultirateFast() const { return multirate_fast; }
+
     // Collisions - override these in child classes if needed
 
     /// Tell if the object is subject to collision.
@@ -405,6 +414,16 @@ class ChApi ChPhysicsItem : public ChObj {
     /// from link space to intuitive react_force and react_torque.
     virtual void ConstraintsFetch_react(double factor = 1) {}
 
+    // STATE SNAPSHOTS
+
+    /// Append to the snapshot any internal state of this item that is not part of the state, acceleration, and
+    /// reaction vectors (e.g. internal variables updated at each step). Used by ChSystem::SaveState.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) {}
+
+    /// Restore the internal state of this item from the snapshot, reading the data written by SnapshotOut.
+    /// Used by ChSystem::RestoreState.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) {}
+
     // SERIALIZATION
 
     /// Method to allow serialization of transient data to archives.
@@ -423,6 +442,8 @@ class ChApi ChPhysicsItem : public ChObj {
     unsigned int offset_w;  ///< offset in vector of state (speed part)
     unsigned int offset_L;  ///< offset in vector of lagrangian multipliers
 
+    bool multirate_fast;  ///< item in the fast partition of a multirate integrator
+
   private:
     virtual void SetupInitial() {}
 
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <iomanip>
 #include <fstream>
+#include <limits>
 
 #include "chrono/collision/bullet/ChCollisionSystemBullet.h"
 #ifdef CHRONO_COLLISION
@@ -33,10 +34,116 @@
 #include "chrono/solver/ChDirectSolverLS.h"
 #include "chrono/core/ChMatrix.h"
 #include "chrono/utils/ChProfiler.h"
+#include "chrono/utils/ChTraceProfiler.h"
 #include "chrono/physics/ChLinkMate.h"
 
 namespace chrono {
 
+// -----------------------------------------------------------------------------
+// MATRIX-FREE NEWTON OPERATOR
+// -----------------------------------------------------------------------------
+
+// Products with the Newton matrix H = c_a*M + c_v*dF/dv + c_x*dF/dx, evaluated as
+//    H*w = c_a*M*w + [F(x + eps*c_x*w, v + eps*c_v*w) - F(x,v)] / eps
+// at the state (x,v) captured by Prepare. Descriptor vectors are mapped to/from state vectors through the offsets of
+// the descriptor variables.
+class ChSystem::JacobianFreeOperator : public ChSystemDescriptor::MatrixFreeOperator {
+  public:
+    JacobianFreeOperator(ChSystem* sys) : system(sys), c_a(1), c_v(0), c_x(0), T0(0), norm0(0) {}
+
+    // Capture the current system state and set the coefficients of the Newton matrix.
+    void Prepare(double ca, double cv, double cx) {
+        c_a = ca;
+        c_v = cv;
+        c_x = cx;
+
+        int nv = system->GetNumCoordsVelLevel();
+        x0.setZero(system->GetNumCoordsPosLevel(), system);
+        v0.setZero(nv, system);
+        xp.setZero(system->GetNumCoordsPosLevel(), system);
+        vp.setZero(nv, system);
+        system->StateGather(x0, v0, T0);
+        norm0 = std::sqrt(x0.squaredNorm() + v0.squaredNorm());
+
+        F0.setZero(nv);
+        system->LoadResidual_F(F0, 1.0);
+
+        double err = 0;
+        Md.setZero(nv);
+        system->LoadLumpedMass_Md(Md, err, 1.0);
+
+        // Map state entries to descriptor entries, by loading each active variable with its own indices
+        for (auto var : system->descriptor->GetVariables()) {
+            auto q = var->State();
+            for (int j = 0; j < (int)var->GetDOF(); j++)
+                q(j) = var->IsActive() ? var->GetOffset() + j : -1;
+        }
+        w.setZero(nv, system);
+        w.setConstant(-1);
+        ChVectorDynamic<> L(system->GetNumConstraints());
+        system->IntFromDescriptor(0, w, 0, L);
+        map.resize(nv);
+        for (int i = 0; i < nv; i++)
+            map[i] = (int)w(i);
+    }
+
+    // Restore the system state captured by Prepare.
+    void Restore() { system->StateScatter(x0, v0, T0, false); }
+
+    virtual void AddProductInto(ChVectorDynamic<>& result, const ChVectorDynamic<>& x) override {
+        CH_TRACE_ZONE("JFNK product");
+
+        int nv = (int)map.size();
+        for (int i = 0; i < nv; i++)
+            w(i) = map[i] < 0 ? 0.0 : x(map[i]);
+
+        Hw.setZero(nv);
+        system->LoadResidual_Mv(Hw, w, c_a);
+
+        double w_norm = w.norm();
+        if (w_norm > 0 && (c_v != 0 || c_x != 0)) {
+            // Forward difference step (scaled with the magnitude of the state and of the direction)
+            double eps = 1e-8 * (1 + norm0) / w_norm;
+            system->StateIncrementX(xp, x0, w * (eps * c_x));
+            vp.noalias() = v0 + w * (eps * c_v);
+            system->StateScatter(xp, vp, T0, false);
+            Fp.setZero(nv);
+            system->LoadResidual_F(Fp, 1.0);
+            Hw += (Fp - F0) * (1 / eps);
+        }
+
+        for (int i = 0; i < nv; i++) {
+            if (map[i] >= 0)
+                result(map[i]) += Hw(i);
+        }
+    }
+
+    virtual void AddDiagonalInto(ChVectorDynamic<>& diag) override {
+        for (int i = 0; i < (int)map.size(); i++) {
+            if (map[i] >= 0)
+                diag(map[i]) += c_a * Md(i);
+        }
+    }
+
+  private:
+    ChSystem* system;      // owner system
+    double c_a;            // mass coefficient
+    double c_v;            // dF/dv coefficient
+    double c_x;            // dF/dx coefficient
+    ChState x0;            // captured positions
+    ChStateDelta v0;       // captured velocities
+    double T0;             // captured time
+    double norm0;          // norm of captured state
+    ChVectorDynamic<> F0;  // applied forces at captured state
+    ChVectorDynamic<> Md;  // lumped masses
+    std::vector<int> map;  // descriptor index of each state entry (-1 if not an active variable)
+    ChStateDelta w;        // product direction (in state ordering)
+    ChState xp;            // perturbed positions
+    ChStateDelta vp;       // perturbed velocities
+    ChVectorDynamic<> Fp;  // applied forces at perturbed state
+    ChVectorDynamic<> Hw;  // product (in state ordering)
+};
+
 // -----------------------------------------------------------------------------
 // CLASS FOR PHYSICAL SYSTEM
 // -----------------------------------------------------------------------------
@@ -54,6 +161,10 @@ ChSystem::ChSystem()
       m_RTF(0),
       step(0.04),
       use_sleeping(false),
+      solve_islands(false),
+      num_islands(0),
+      deterministic(false),
+      use_jfnk(false),
       max_penetration_recovery_speed(0.6),
       stepcount(0),
       setupcount(0),
@@ -106,6 +217,10 @@ ChSystem::ChSystem(const ChSystem& other) : m_RTF(0), collision_system(nullptr),
     max_penetration_recovery_speed = other.max_penetration_recovery_speed;
     SetSolverType(other.GetSolverType());
     use_sleeping = other.use_sleeping;
+    solve_islands = other.solve_islands;
+    num_islands = 0;
+    deterministic = other.deterministic;
+    use_jfnk = other.use_jfnk;
 
     ncontacts = other.ncontacts;
 
@@ -284,6 +399,9 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
         case ChSolver::Type::SPARSE_QR:
             solver = chrono_types::make_shared<ChSolverSparseQR>();
             break;
+        case ChSolver::Type::SPARSE_CHOLESKY:
+            solver = chrono_types::make_shared<ChSolverSparseCholesky>();
+            break;
         default:
             std::cout << "Unknown solver type. No solver was set." << std::endl;
             std::cout << "Use SetSolver()." << std::endl;
@@ -311,6 +429,127 @@ void ChSystem::UnregisterCustomCollisionCallback(std::shared_ptr<CustomCollision
 
 // -----------------------------------------------------------------------------
 
+void ChSystem::SaveState(ChStateSnapshot& snapshot) {
+    snapshot.Clear();
+
+    snapshot.Write(ch_time);
+    snapshot.Write(step);
+    snapshot.Write(stepcount);
+
+    // Timestepper type (validated before anything is restored)
+    bool has_timestepper = (timestepper != nullptr);
+    snapshot.Write(has_timestepper);
+    if (has_timestepper)
+        snapshot.Write(timestepper->GetType());
+
+    // State, acceleration and reaction vectors (the work vectors are only reallocated if the system size changes)
+    double T;
+    StateSetup(snapshot_x, snapshot_v, snapshot_a);
+    snapshot_L.resize(GetNumConstraints());
+    StateGather(snapshot_x, snapshot_v, T);
+    StateGatherAcceleration(snapshot_a);
+    StateGatherReactions(snapshot_L);
+
+    snapshot.WriteVector(snapshot_x);
+    snapshot.WriteVector(snapshot_v);
+    snapshot.WriteVector(snapshot_a);
+    snapshot.Write(contact_container->GetNumConstraints());
+    snapshot.WriteVector(snapshot_L);
+
+    // Internal states of physics items
+    assembly.SnapshotOut(snapshot);
+    contact_container->SnapshotOut(snapshot);
+
+    // Timestepper history
+    if (has_timestepper)
+        timestepper->SnapshotOut(snapshot);
+
+    // User-provided data
+    for (auto& callback : snapshot_callbacks)
+        callback->OnSave(snapshot);
+}
+
+void ChSystem::RestoreState(const ChStateSnapshot& snapshot) {
+    // Keep the current state, to roll back if the item data in the snapshot cannot be read
+    SaveState(snapshot_backup);
+    try {
+        LoadState(snapshot);
+    } catch (...) {
+        LoadState(snapshot_backup);
+        throw;
+    }
+}
+
+void ChSystem::LoadState(const ChStateSnapshot& snapshot) {
+    ChStateSnapshot::Reader reader(snapshot);
+
+    // Parse and validate the fixed part of the snapshot before modifying the system
+    double time;
+    double snapshot_step;
+    size_t snapshot_stepcount;
+    reader.Read(time);
+    reader.Read(snapshot_step);
+    reader.Read(snapshot_stepcount);
+
+    bool has_timestepper;
+    ChTimestepper::Type type = ChTimestepper::Type::CUSTOM;
+    reader.Read(has_timestepper);
+    if (has_timestepper)
+        reader.Read(type);
+
+    reader.ReadVector(snapshot_x);
+    reader.ReadVector(snapshot_v);
+    reader.ReadVector(snapshot_a);
+    unsigned int num_contact_constr;
+    reader.Read(num_contact_constr);
+    reader.ReadVector(snapshot_L);
+
+    if (snapshot_x.size() != GetNumCoordsPosLevel() || snapshot_v.size() != GetNumCoordsVelLevel() ||
+        snapshot_a.size() != snapshot_v.size() ||
+        snapshot_L.size() != assembly.GetNumConstraints() + num_contact_constr)
+        throw std::invalid_argument("RestoreState: snapshot incompatible with the current system configuration.");
+    if (has_timestepper && (!timestepper || timestepper->GetType() != type))
+        throw std::invalid_argument("RestoreState: snapshot taken with a different timestepper.");
+
+    // Apply the snapshot
+    step = snapshot_step;
+    stepcount = snapshot_stepcount;
+
+    StateScatter(snapshot_x, snapshot_v, time, true);
+    StateScatterAcceleration(snapshot_a);
+
+    // Contact reactions can only be restored if the current contacts are consistent with those in the snapshot
+    if (contact_container->GetNumConstraints() == num_contact_constr)
+        StateScatterReactions(snapshot_L);
+    else
+        assembly.IntStateScatterReactions(0, snapshot_L);
+
+    assembly.SnapshotIn(reader);
+    contact_container->SnapshotIn(reader);
+
+    if (has_timestepper)
+        timestepper->SnapshotIn(reader);
+
+    for (auto& callback : snapshot_callbacks)
+        callback->OnRestore(reader);
+
+    is_updated = false;
+    applied_forces_current = false;
+}
+
+void ChSystem::RegisterStateSnapshotCallback(std::shared_ptr<StateSnapshotCallback> callback) {
+    snapshot_callbacks.push_back(callback);
+}
+
+void ChSystem::UnregisterStateSnapshotCallback(std::shared_ptr<StateSnapshotCallback> callback) {
+    auto itr = std::find(std::begin(snapshot_callbacks), std::end(snapshot_callbacks), callback);
+    if (itr != snapshot_callbacks.end()) {
+        snapshot_callbacks.erase(itr);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 void ChSystem::SetSystemDescriptor(std::shared_ptr<ChSystemDescriptor> newdescriptor) {
     assert(newdescriptor);
     descriptor = newdescriptor;
@@ -350,6 +589,7 @@ void ChSystem::SetCollisionSystemType(ChCollisionSystem::Type type) {
     }
 
     collision_system->SetNumThreads(nthreads_collision);
+    collision_system->SetDeterministic(deterministic);
     collision_system->SetSystem(this);
 }
 
@@ -357,6 +597,7 @@ void ChSystem::SetCollisionSystem(std::shared_ptr<ChCollisionSystem> coll_system
     assert(coll_system);
     collision_system = coll_system;
     collision_system->SetNumThreads(nthreads_collision);
+    collision_system->SetDeterministic(deterministic);
     collision_system->SetSystem(this);
 }
 
@@ -379,6 +620,13 @@ void ChSystem::SetNumThreads(int num_threads_chrono, int num_threads_collision,
         collision_system->SetNumThreads(nthreads_collision);
 }
 
+void ChSystem::SetDeterministic(bool val) {
+    deterministic = val;
+
+    if (collision_system)
+        collision_system->SetDeterministic(deterministic);
+}
+
 // -----------------------------------------------------------------------------
 
 // Initial system setup before analysis. Must be called once the system construction is completed.
@@ -458,6 +706,12 @@ void ChSystem::SetTimestepperType(ChTimestepper::Type type) {
         case ChTimestepper::Type::NEWMARK:
             timestepper = chrono_types::make_shared<ChTimestepperNewmark>(this);
             break;
+        case ChTimestepper::Type::MULTIRATE:
+            timestepper = chrono_types::make_shared<ChTimestepperMultirate>(this);
+            break;
+        case ChTimestepper::Type::CENTRAL_DIFFERENCE:
+            timestepper = chrono_types::make_shared<ChTimestepperCentralDifference>(this);
+            break;
         default:
             throw std::invalid_argument("SetTimestepperType: timestepper not supported");
     }
@@ -607,6 +861,9 @@ void ChSystem::DescriptorPrepareInject(ChSystemDescriptor& sys_descriptor) {
     InjectKRMMatrices(sys_descriptor);
 
     sys_descriptor.EndInsertion();
+
+    sys_descriptor.SetNumThreads(nthreads_chrono);
+    sys_descriptor.SetDeterministic(deterministic);
 }
 
 // -----------------------------------------------------------------------------
@@ -622,6 +879,7 @@ void ChSystem::Setup() {
         assembly.SetupInitial();
 
     CH_PROFILE("Setup");
+    CH_TRACE_ZONE("Setup");
 
     timer_setup.start();
 
@@ -702,6 +960,7 @@ void ChSystem::Update(double mytime, bool update_assets) {
 
 void ChSystem::Update(bool update_assets) {
     CH_PROFILE("Update");
+    CH_TRACE_ZONE("Update");
 
     Initialize();
 
@@ -1023,31 +1282,49 @@ bool ChSystem::StateSolveCorrection(
     bool force_setup              // if true, call the solver's Setup() function
 ) {
     CH_PROFILE("StateSolveCorrection");
+    CH_TRACE_ZONE("StateSolveCorrection");
 
     if (force_state_scatter)
         StateScatter(x, v, T, full_update);
 
+    // In Jacobian-free mode, capture the current state (before the descriptor variables are loaded)
+    bool jfnk = use_jfnk && std::dynamic_pointer_cast<ChIterativeSolverLS>(solver);
+    if (jfnk) {
+        if (!jfnk_operator)
+            jfnk_operator.reset(new JacobianFreeOperator(this));
+        jfnk_operator->Prepare(c_a, c_v, c_x);
+    }
+
     // R and Qc vectors  --> solver sparse solver structures  (also sets Dl and Dv to warmstart)
     IntToDescriptor(0, Dv, R, 0, Dl, Qc);
 
+    // If restricted to the fast partition of a multirate step, account for the prescribed slow velocities
+    for (const auto& interface : multirate_interface)
+        interface.first->SetRightHandSide(interface.first->GetRightHandSide() + interface.second);
+    FreezeSlowPartition(true);
+
     // If the solver's Setup() must be called or if the solver's Solve() requires it,
     // fill the sparse system structures with information in G and Cq.
     if (force_setup || GetSolver()->SolveRequiresMatrix()) {
         timer_jacobian.start();
+        CH_TRACE_BEGIN("LoadJacobians");
 
         // Cq  matrix
         LoadConstraintJacobians();
 
-        // G matrix: M, K, R components
-        if (c_a || c_v || c_x)
+        // G matrix: M, K, R components (not needed in Jacobian-free mode)
+        if (!jfnk && (c_a || c_v || c_x))
             LoadKRMMatrices(-c_x, -c_v, c_a);
 
         // For ChVariable objects without a ChKRMBlock, just use the 'a' coefficient
         descriptor->SetMassFactor(c_a);
 
+        CH_TRACE_END();
         timer_jacobian.stop();
     }
 
+    descriptor->SetMatrixFreeOperator(jfnk ? jfnk_operator.get() : nullptr);
+
     // Diagnostics:
     if (write_matrix) {
         std::string prefix = "solve_" + std::to_string(stepcount) + "_" + std::to_string(solvecount);
@@ -1074,22 +1351,41 @@ bool ChSystem::StateSolveCorrection(
     // Return 'false' if the setup phase fails.
     if (force_setup) {
         timer_ls_setup.start();
+        CH_TRACE_BEGIN("LS setup");
         bool success = GetSolver()->Setup(*descriptor);
+        CH_TRACE_END();
         timer_ls_setup.stop();
         setupcount++;
-        if (!success)
+        if (!success) {
+            FreezeSlowPartition(false);
+            if (jfnk) {
+                descriptor->SetMatrixFreeOperator(nullptr);
+                jfnk_operator->Restore();
+            }
             return false;
+        }
     }
 
     // Solve the problem
     // The solution is scattered in the provided system descriptor
     timer_ls_solve.start();
-    GetSolver()->Solve(*descriptor);
+    CH_TRACE_BEGIN("LS solve");
+    if (!solve_islands || !SolveIslands())
+        GetSolver()->Solve(*descriptor);
+    CH_TRACE_END();
     timer_ls_solve.stop();
 
+    FreezeSlowPartition(false);
+
     // Dv and Dl vectors  <-- sparse solver structures
     IntFromDescriptor(0, Dv, 0, Dl);
 
+    // Restore the state perturbed by the matrix-free products
+    if (jfnk) {
+        descriptor->SetMatrixFreeOperator(nullptr);
+        jfnk_operator->Restore();
+    }
+
     // Diagnostics:
     if (write_matrix) {
         std::string prefix = "solve_" + std::to_string(stepcount) + "_" + std::to_string(solvecount) + "_";
@@ -1117,6 +1413,43 @@ bool ChSystem::StateSolveCorrection(
     return true;
 }
 
+bool ChSystem::SolveIslands() {
+    num_islands = 0;
+
+    std::unique_ptr<ChSolver> base_solver(GetSolver()->Clone());
+    if (!base_solver) {
+        std::cerr << "WARNING: the current solver cannot be cloned. Solver islands disabled." << std::endl;
+        solve_islands = false;
+        return false;
+    }
+
+    if (!descriptor->ComputeIslands())
+        return false;
+
+    auto& islands = descriptor->GetIslands();
+    int num = (int)islands.size();
+    int nthreads = std::max(1, std::min(nthreads_chrono, num));
+
+    // Each thread solves its islands with its own copy of the solver.
+    // Islands do not share variables or constraints, so the solutions can be written concurrently.
+#pragma omp parallel num_threads(nthreads)
+    {
+        std::unique_ptr<ChSolver> island_solver(base_solver->Clone());
+#pragma omp for schedule(dynamic, 1)
+        for (int i = 0; i < num; i++) {
+            CH_TRACE_ZONE("Island solve");
+            islands[i]->EndInsertion();
+            island_solver->Solve(*islands[i]);
+        }
+    }
+
+    // Restore the offsets of all variables and constraints in the global descriptor
+    descriptor->UpdateCountsAndOffsets();
+
+    num_islands = (unsigned int)num;
+    return true;
+}
+
 ChVector3d ChSystem::GetBodyAppliedForce(ChBody* body) {
     if (!is_initialized)
         return ChVector3d(0, 0, 0);
@@ -1224,6 +1557,162 @@ void ChSystem::LoadConstraint_Ct(ChVectorDynamic<>& Qc, const double c) {
     contact_container->IntLoadConstraint_Ct(displ_L + contact_container->GetOffset_L(), Qc, c);
 }
 
+// -----------------------------------------------------------------------------
+//   MULTIRATE PARTITIONING
+// -----------------------------------------------------------------------------
+
+// Inject in the given descriptor the variables of all items flagged as fast.
+// Sub-assemblies which are not flagged themselves are searched recursively.
+static void CollectFastVariables(ChPhysicsItem* item, ChSystemDescriptor& fast_descriptor) {
+    if (item->IsMultirateFast()) {
+        item->InjectVariables(fast_descriptor);
+        return;
+    }
+
+    auto assembly = dynamic_cast<ChAssembly*>(item);
+    if (!assembly)
+        return;
+
+    for (const auto& body : assembly->GetBodies())
+        CollectFastVariables(body.get(), fast_descriptor);
+    for (const auto& shaft : assembly->GetShafts())
+        CollectFastVariables(shaft.get(), fast_descriptor);
+    for (const auto& link : assembly->GetLinks())
+        CollectFastVariables(link.get(), fast_descriptor);
+    for (const auto& mesh : assembly->GetMeshes())
+        CollectFastVariables(mesh.get(), fast_descriptor);
+    for (const auto& other : assembly->GetOtherPhysicsItems())
+        CollectFastVariables(other.get(), fast_descriptor);
+}
+
+bool ChSystem::StateGetFastPartition(std::vector<bool>& fast) {
+    ChSystemDescriptor fast_descriptor;
+    CollectFastVariables(&assembly, fast_descriptor);
+
+    multirate_fast_vars.clear();
+    for (auto var : fast_descriptor.GetVariables()) {
+        if (var->IsActive())
+            multirate_fast_vars.insert(var);
+    }
+    if (multirate_fast_vars.empty())
+        return false;
+
+    // Flag the fast variables in the descriptor and map them to the state vector
+    for (auto var : descriptor->GetVariables())
+        var->State().setConstant(multirate_fast_vars.count(var) ? 1.0 : 0.0);
+
+    ChStateDelta probe(GetNumCoordsVelLevel(), this);
+    ChVectorDynamic<> L(GetNumConstraints());
+    IntFromDescriptor(0, probe, 0, L);
+
+    fast.resize(probe.size());
+    for (int i = 0; i < probe.size(); i++)
+        fast[i] = (probe(i) != 0);
+
+    return true;
+}
+
+void ChSystem::StateRestrictToFastPartition(const ChStateDelta& v) {
+    assert(multirate_frozen_vars.empty() && multirate_frozen_constraints.empty());
+
+    // Load the slow velocities in the descriptor variables (fast velocities set to zero)
+    ChVectorDynamic<> R(GetNumCoordsVelLevel());
+    ChVectorDynamic<> L(GetNumConstraints());
+    R.setZero();
+    L.setZero();
+    IntToDescriptor(0, v, R, 0, L, L);
+
+    unsigned int n_q = descriptor->CountActiveVariables();
+    std::vector<bool> fast_col(n_q, false);
+    for (auto var : descriptor->GetVariables()) {
+        if (!var->IsActive())
+            continue;
+        if (multirate_fast_vars.count(var)) {
+            var->State().setZero();
+            std::fill_n(fast_col.begin() + var->GetOffset(), var->GetDOF(), true);
+        } else {
+            multirate_frozen_vars.push_back(var);
+        }
+    }
+
+    // Classify the active constraints, based on the variables their Jacobians act on.
+    // For coupling constraints, the Jacobian-times-state product provides the slow velocity contribution.
+    ChSparseMatrix row_buffer(1, n_q);
+    for (auto constr : descriptor->GetConstraints()) {
+        if (!constr->IsActive())
+            continue;
+
+        row_buffer.setZero();
+        constr->PasteJacobianInto(row_buffer, 0, 0);
+
+        bool acts_on_fast = false;
+        for (ChSparseMatrix::InnerIterator it(row_buffer, 0); it && !acts_on_fast; ++it)
+            acts_on_fast = fast_col[it.col()];
+
+        if (!acts_on_fast) {
+            multirate_frozen_constraints.push_back(constr);
+            continue;
+        }
+
+        double bias = constr->ComputeJacobianTimesState();
+        if (bias != 0)
+            multirate_interface.push_back(std::make_pair(constr, bias));
+    }
+}
+
+void ChSystem::StateReleaseFastPartition() {
+    multirate_frozen_vars.clear();
+    multirate_frozen_constraints.clear();
+    multirate_interface.clear();
+}
+
+void ChSystem::FreezeSlowPartition(bool freeze) {
+    if (multirate_frozen_vars.empty() && multirate_frozen_constraints.empty())
+        return;
+
+    for (auto var : multirate_frozen_vars)
+        var->SetDisabled(freeze);
+    for (auto constr : multirate_frozen_constraints)
+        constr->SetDisabled(freeze);
+
+    descriptor->UpdateCountsAndOffsets();
+}
+
+// -----------------------------------------------------------------------------
+//   EXPLICIT INTEGRATION
+// -----------------------------------------------------------------------------
+
+// Collect all FEA meshes in the given assembly and, recursively, in its sub-assemblies.
+static void CollectMeshes(ChAssembly* assembly, std::vector<fea::ChMesh*>& meshes) {
+    for (const auto& mesh : assembly->GetMeshes())
+        meshes.push_back(mesh.get());
+    for (const auto& other : assembly->GetOtherPhysicsItems()) {
+        if (auto sub_assembly = dynamic_cast<ChAssembly*>(other.get()))
+            CollectMeshes(sub_assembly, meshes);
+    }
+}
+
+double ChSystem::GetCriticalStepSize() {
+    std::vector<fea::ChMesh*> meshes;
+    CollectMeshes(&assembly, meshes);
+
+    double step = std::numeric_limits<double>::infinity();
+    for (auto mesh : meshes) {
+        if (mesh->IsActive())
+            step = std::min(step, mesh->GetCriticalStepSize());
+    }
+
+    return step;
+}
+
+void ChSystem::SetMassScaling(double target_step) {
+    std::vector<fea::ChMesh*> meshes;
+    CollectMeshes(&assembly, meshes);
+
+    for (auto mesh : meshes)
+        mesh->SetMassScaling(target_step);
+}
+
 // -----------------------------------------------------------------------------
 //   COLLISION OPERATIONS
 // -----------------------------------------------------------------------------
@@ -1234,24 +1723,32 @@ unsigned int ChSystem::GetNumContacts() {
 
 double ChSystem::ComputeCollisions() {
     CH_PROFILE("ComputeCollisions");
+    CH_TRACE_ZONE("ComputeCollisions");
 
     double mretC = 0.0;
 
     timer_collision.start();
 
     // Update all positions of collision models: delegate this to the ChAssembly
-    assembly.SyncCollisionModels();
+    {
+        CH_TRACE_ZONE("SyncCollisionModels");
+        assembly.SyncCollisionModels();
+    }
 
     // Perform the collision detection ( broadphase and narrowphase )
-    collision_system->PreProcess();
-    collision_system->Run();
-    collision_system->PostProcess();
+    {
+        CH_TRACE_ZONE("CollisionDetection");
+        collision_system->PreProcess();
+        collision_system->Run();
+        collision_system->PostProcess();
+    }
 
     // Report and store contacts and/or proximities, if there are some
     // containers in the physic system. The default contact container
     // for ChBody and ChParticles is used always.
     {
         CH_PROFILE("ReportContacts");
+        CH_TRACE_ZONE("ReportContacts");
 
         collision_system->ReportContacts(contact_container.get());
 
@@ -1555,6 +2052,8 @@ unsigned int ChSystem::RemoveRedundantConstraints(bool remove_links, double qr_t
 
 bool ChSystem::AdvanceDynamics() {
     CH_PROFILE("AdvanceDynamics");
+    CH_TRACE_STEP();
+    CH_TRACE_ZONE("AdvanceDynamics");
 
     ResetTimers();
 
@@ -1598,7 +2097,8 @@ bool ChSystem::AdvanceDynamics() {
     ////descriptor->UpdateCountsAndOffsets();
 
     // Set some settings in timestepper object
-    if (timestepper->GetType() == ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED) {
+    if (timestepper->GetType() == ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED ||
+        timestepper->GetType() == ChTimestepper::Type::MULTIRATE) {
         timestepper->Qc_do_clamp = true;
         timestepper->Qc_clamping = max_penetration_recovery_speed;
     } else {
@@ -1608,6 +2108,7 @@ bool ChSystem::AdvanceDynamics() {
     // Advance system state by one step
     {
         CH_PROFILE("Advance");
+        CH_TRACE_ZONE("Advance");
         timer_advance.start();
         timestepper->Advance(step);
         timer_advance.stop();
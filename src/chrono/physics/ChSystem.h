@@ -22,6 +22,7 @@
 #include <cstring>
 #include <iostream>
 #include <list>
+#include <unordered_set>
 
 #include "chrono/core/ChGlobal.h"
 #include "chrono/core/ChFrame.h"
@@ -37,6 +38,7 @@
 #include "chrono/timestepper/ChIntegrable.h"
 #include "chrono/timestepper/ChTimestepper.h"
 #include "chrono/timestepper/ChTimestepperHHT.h"
+#include "chrono/timestepper/ChTimestepperMultirate.h"
 #include "chrono/timestepper/ChStaticAnalysis.h"
 
 namespace chrono {
@@ -144,6 +146,50 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     /// Access directly the 'system descriptor'.
     std::shared_ptr<ChSystemDescriptor> GetSystemDescriptor() { return descriptor; }
 
+    /// Enable/disable the decomposition of the problem in independent islands (default: false).
+    /// If enabled, at each solver invocation the active variables and constraints are partitioned in islands (groups
+    /// of bodies and nodes coupled through links, contacts, or stiffness blocks; see ChSystemDescriptor::ComputeIslands)
+    /// and each island is solved with a separate copy of the current solver. Islands are solved concurrently, using
+    /// GetNumThreadsChrono() threads. This is only supported by solvers that can be cloned (see ChSolver::Clone), i.e.
+    /// the iterative VI solvers other than ADMM; for all other solvers, a warning is issued at the first solver
+    /// invocation, island decomposition is disabled, and the full problem is solved.
+    void EnableSolverIslands(bool val) {
+        solve_islands = val;
+        num_islands = 0;
+    }
+
+    /// Return the number of islands processed at the last solver invocation (0 if the problem was not decomposed).
+    unsigned int GetNumIslands() const { return num_islands; }
+
+    /// Enable/disable the Jacobian-free Newton-Krylov mode (default: false).
+    /// This mode is only used with the Krylov linear solvers (ChSolverGMRES, ChSolverBiCGSTAB, ChSolverMINRES) and is
+    /// ignored with all other solvers. If enabled, the stiffness and damping matrices are not evaluated in
+    /// StateSolveCorrection. Instead, products with the Newton matrix H = c_a*M + c_v*dF/dv + c_x*dF/dx are evaluated
+    /// matrix-free, as c_a*M*w plus a forward difference of the applied forces F in the direction of w, and the Krylov
+    /// solver is preconditioned with the lumped masses. Each product requires one update of the system and one
+    /// evaluation of the applied forces. This applies to all implicit integrators (HHT, Newmark, Euler implicit).
+    void EnableJacobianFreeNewton(bool val) { use_jfnk = val; }
+
+    /// Return true if the Jacobian-free Newton-Krylov mode is enabled.
+    bool IsJacobianFreeNewton() const { return use_jfnk; }
+
+    /// Enable/disable the deterministic mode (default: false).
+    /// If enabled, simulation results are bit-identical for any number of threads (see SetNumThreads), including
+    /// runs with a single thread. For this purpose:
+    /// - the collision system reports contacts in a canonical order (see ChCollisionSystem::SetDeterministic);
+    /// - the multithreaded products of the system descriptor use a fixed partition of the constraints and a fixed
+    ///   summation order (see ChSystemDescriptor::SetDeterministic);
+    /// - with parallel traversal enabled, link forces are always accumulated over link colors, even with one thread.
+    /// Results generally differ from those obtained with the deterministic mode disabled.
+    void SetDeterministic(bool val);
+
+    /// Return true if the deterministic mode is enabled.
+    bool IsDeterministic() const { return deterministic; }
+
+    /// Enable/disable parallel traversal of the bodies, shafts, and links of the system (default: false).
+    /// See ChAssembly::SetParallelTraversal. This is beneficial for models with many thousands of bodies and links.
+    void SetParallelTraversal(bool val, unsigned int min_items = 256) { assembly.SetParallelTraversal(val, min_items); }
+
     /// Set the gravitational acceleration vector.
     void SetGravitationalAcceleration(const ChVector3d& gacc) { G_acc = gacc; }
 
@@ -177,6 +223,47 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     /// Integration proceeds with the specified time step size which may be adjusted to exactly reach the frame time.
     bool DoFrameDynamics(double frame_time, double step_size);
 
+    // ---- STATE SNAPSHOTS
+
+    /// Save the dynamic state of the system in the given snapshot.
+    /// The snapshot captures only the data needed to continue the simulation from the current state: time, state,
+    /// acceleration and reaction vectors (including the contact multipliers used for warm starting), the internal
+    /// states of physics items (see ChPhysicsItem::SnapshotOut), the timestepper history, and the data of any
+    /// registered StateSnapshotCallback. It does not capture the system topology or the model parameters, and it does
+    /// not capture the persistent contact data cached by the collision system. The snapshot storage and internal work
+    /// vectors are reused, so that repeated saves do not allocate memory. This function must be called after the
+    /// system was initialized (e.g., after a call to DoStepDynamics).
+    void SaveState(ChStateSnapshot& snapshot);
+
+    /// Restore the dynamic state of the system from a snapshot created with SaveState.
+    /// The system must have the same topology (same items and number of coordinates) as when the snapshot was taken,
+    /// otherwise an exception is thrown. Contact multipliers are restored only if the current number of contact
+    /// constraints matches that in the snapshot (otherwise, contacts are warm started as usual at the next step).
+    /// The sizes and the timestepper type are validated before the system is modified; if the data of the physics
+    /// items or of the callbacks cannot be read, the state at the time of the call is restored and the exception is
+    /// rethrown (the current state is saved for this purpose, which also invokes StateSnapshotCallback::OnSave).
+    void RestoreState(const ChStateSnapshot& snapshot);
+
+    /// Class to be used as a callback interface for saving and restoring, in system snapshots, the internal state of
+    /// objects which are not physics items of this system (e.g. tire models). See SaveState and RestoreState.
+    class ChApi StateSnapshotCallback {
+      public:
+        virtual ~StateSnapshotCallback() {}
+
+        /// Append the internal state of the object to the snapshot.
+        virtual void OnSave(ChStateSnapshot& snapshot) = 0;
+
+        /// Restore the internal state of the object, reading the data written by OnSave.
+        virtual void OnRestore(ChStateSnapshot::Reader& reader) = 0;
+    };
+
+    /// Specify a callback object to be invoked when saving and restoring system snapshots.
+    /// Multiple such callback objects can be registered with a system; they are invoked in order of registration.
+    void RegisterStateSnapshotCallback(std::shared_ptr<StateSnapshotCallback> callback);
+
+    /// Remove the given snapshot callback from this system.
+    void UnregisterStateSnapshotCallback(std::shared_ptr<StateSnapshotCallback> callback);
+
     // ---- KINEMATICS
 
     /// Advance the kinematics simulation for a single step of given length.
@@ -621,7 +708,7 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     void InjectConstraints(ChSystemDescriptor& sys_descriptor);
 
     /// Compute and load current Jacobians in encapsulated ChConstraint objects.
-    void LoadConstraintJacobians();
+    virtual void LoadConstraintJacobians() override;
 
     /// Register with the given system descriptor any ChKRMBlock objects associated with items in the system.
     void InjectKRMMatrices(ChSystemDescriptor& sys_descriptor);
@@ -762,6 +849,26 @@ class ChApi ChSystem : public ChIntegrableIIorder {
                                    const double c          ///< a scaling factor
                                    ) override;
 
+    /// Flag the velocity-level coordinates of all items in the fast partition of a multirate integrator.
+    /// The fast partition consists of the variables of all physics items flagged with SetMultirateFast.
+    virtual bool StateGetFastPartition(std::vector<bool>& fast) override;
+
+    /// Restrict subsequent calls to StateSolveCorrection to the fast partition.
+    /// Variables of slow items and constraints acting only on slow variables are disabled during the solves. For constraints
+    /// coupling the two partitions, the contribution of the prescribed slow velocities in v is added to the constraint
+    /// right-hand side.
+    virtual void StateRestrictToFastPartition(const ChStateDelta& v) override;
+
+    /// Release the restriction set by StateRestrictToFastPartition.
+    virtual void StateReleaseFastPartition() override;
+
+    /// Estimate the critical time step of explicit integrators with lumped mass.
+    /// This is the smallest critical step of all FEA meshes in the system (see ChMesh::GetCriticalStepSize).
+    virtual double GetCriticalStepSize() override;
+
+    /// Apply selective mass scaling to all FEA meshes in the system (see ChMesh::SetMassScaling).
+    virtual void SetMassScaling(double target_step) override;
+
   protected:
     /// Pushes all ChConstraints and ChVariables contained in links, bodies, etc. into the system descriptor.
     virtual void DescriptorPrepareInject(ChSystemDescriptor& sys_descriptor);
@@ -794,6 +901,20 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     /// Performs a single dynamics simulation step, advancing the system state by the current step size.
     virtual bool AdvanceDynamics();
 
+    /// Solve the independent islands of the current problem concurrently.
+    /// Returns false (without solving) if the solver cannot be cloned or the problem cannot be decomposed.
+    bool SolveIslands();
+
+    /// Disable (or re-enable) the slow variables and constraints recorded by StateRestrictToFastPartition.
+    /// The descriptor offsets are compacted only while solving, since the residuals are indexed with the full offsets.
+    void FreezeSlowPartition(bool freeze);
+
+    /// Restore the dynamic state of the system from a snapshot (see RestoreState), without rollback on failure.
+    void LoadState(const ChStateSnapshot& snapshot);
+
+    /// Matrix-free Newton operator, based on finite differences of the applied forces.
+    class JacobianFreeOperator;
+
     ChAssembly assembly;  ///< underlying mechanical assembly
 
     std::shared_ptr<ChContactContainer> contact_container;  ///< the container of contacts
@@ -817,6 +938,14 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     std::shared_ptr<ChSystemDescriptor> descriptor;  ///< system descriptor
     std::shared_ptr<ChSolver> solver;                ///< solver for DVI or DAE problem
 
+    bool solve_islands;        ///< if true, solve independent islands concurrently
+    unsigned int num_islands;  ///< number of islands at last solver invocation
+
+    bool deterministic;  ///< if true, results do not depend on the number of threads
+
+    bool use_jfnk;                                        ///< if true, use matrix-free Newton matrix with Krylov solvers
+    std::unique_ptr<JacobianFreeOperator> jfnk_operator;  ///< matrix-free Newton operator
+
     double max_penetration_recovery_speed;  ///< limit for speed of penetration recovery (positive)
 
     size_t stepcount;  ///< internal counter for steps
@@ -829,10 +958,22 @@ class ChApi ChSystem : public ChIntegrableIIorder {
 
     unsigned int ncontacts;  ///< total number of contacts
 
+    std::unordered_set<ChVariables*> multirate_fast_vars;               ///< variables in the fast partition
+    std::vector<ChVariables*> multirate_frozen_vars;                    ///< slow variables disabled during substeps
+    std::vector<ChConstraint*> multirate_frozen_constraints;            ///< slow constraints disabled during substeps
+    std::vector<std::pair<ChConstraint*, double>> multirate_interface;  ///< coupling constraints and RHS corrections
+
     std::shared_ptr<ChCollisionSystem> collision_system;                         ///< collision engine
     std::vector<std::shared_ptr<CustomCollisionCallback>> collision_callbacks;   ///< user-defined collision callbacks
     std::unique_ptr<ChContactMaterialCompositionStrategy> composition_strategy;  /// material composition strategy
 
+    std::vector<std::shared_ptr<StateSnapshotCallback>> snapshot_callbacks;  ///< callbacks for system snapshots
+    ChState snapshot_x;                                                      ///< work vector for snapshots (state)
+    ChStateDelta snapshot_v;                                                 ///< work vector for snapshots (speeds)
+    ChStateDelta snapshot_a;                                                 ///< work vector for snapshots (accel.)
+    ChVectorDynamic<> snapshot_L;                                            ///< work vector for snapshots (reactions)
+    ChStateSnapshot snapshot_backup;                                         ///< state before a restore (for rollback)
+
     ChVisualSystem* visual_system;  ///< run-time visualization engine
 
     // OpenMP
@@ -15,12 +15,16 @@
 #ifndef CHCONSTRAINT_H
 #define CHCONSTRAINT_H
 
+#include <vector>
+
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChClassFactory.h"
 #include "chrono/core/ChMatrix.h"
 
 namespace chrono {
 
+class ChVariables;
+
 /// Base class for representing constraints (bilateral or unilateral).
 /// These constraints are used with variational inequality or DAE solvers for problems including equalities,
 /// inequalities, nonlinearities, etc.
@@ -214,6 +218,12 @@ class ChApi ChConstraint {
     ///   For boxed constraints and similar, inherited class *should* override this implementation.
     virtual double Violation(double mc_i);
 
+    /// Append to the given list the variables referenced by this constraint.
+    /// This connectivity information is used by solvers that need to know which constraints share variables (e.g.,
+    /// for graph coloring). The default implementation does not report any variable; solvers must then assume that
+    /// such a constraint may conflict with any other constraint.
+    virtual void GetVariablesList(std::vector<ChVariables*>& vars) const {}
+
     /// Write the constraint Jacobian into the specified global matrix at the offsets of the associated variables.
     /// The (start_row, start_col) pair specifies the top-left corner of the system-level constraint Jacobian in the
     /// provided matrix.
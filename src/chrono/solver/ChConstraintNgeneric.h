@@ -48,6 +48,11 @@ class ChApi ChConstraintNgeneric : public ChConstraint {
     /// Set references to the constrained ChVariables objects,automatically creating/resizing Jacobians as needed.
     void SetVariables(std::vector<ChVariables*> mvars);
 
+    /// Append to the given list the variables referenced by this constraint.
+    virtual void GetVariablesList(std::vector<ChVariables*>& vars) const override {
+        vars.insert(vars.end(), variables.begin(), variables.end());
+    }
+
     /// This function updates the following auxiliary data:
     ///  - the Eq_a and Eq_b matrices
     ///  - the g_i product
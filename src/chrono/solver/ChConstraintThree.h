@@ -73,6 +73,13 @@ class ChApi ChConstraintThree : public ChConstraint {
     /// automatically creating/resizing jacobians if needed.
     virtual void SetVariables(ChVariables* mvariables_a, ChVariables* mvariables_b, ChVariables* mvariables_c) = 0;
 
+    /// Append to the given list the three variables referenced by this constraint.
+    virtual void GetVariablesList(std::vector<ChVariables*>& vars) const override {
+        vars.push_back(variables_a);
+        vars.push_back(variables_b);
+        vars.push_back(variables_c);
+    }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& archive_out) override;
 
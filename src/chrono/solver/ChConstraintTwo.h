@@ -65,6 +65,12 @@ class ChApi ChConstraintTwo : public ChConstraint {
     /// automatically creating/resizing jacobians if needed.
     virtual void SetVariables(ChVariables* mvariables_a, ChVariables* mvariables_b) = 0;
 
+    /// Append to the given list the two variables referenced by this constraint.
+    virtual void GetVariablesList(std::vector<ChVariables*>& vars) const override {
+        vars.push_back(variables_a);
+        vars.push_back(variables_b);
+    }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& archive_out) override;
 
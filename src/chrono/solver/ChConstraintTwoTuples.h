@@ -103,6 +103,12 @@ class ChConstraintTwoTuples : public ChConstraint {
         tuple_b.AddJacobianTransposedTimesScalarInto(result, l);
     }
 
+    /// Append to the given list the variables referenced by this constraint.
+    virtual void GetVariablesList(std::vector<ChVariables*>& vars) const override {
+        tuple_a.GetVariablesList(vars);
+        tuple_b.GetVariablesList(vars);
+    }
+
     /// Write the constraint Jacobian into the specified global matrix at the offsets of the associated variables.
     /// The (start_row, start_col) pair specifies the top-left corner of the system-level constraint Jacobian in the
     /// provided matrix.
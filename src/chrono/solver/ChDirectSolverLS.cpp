@@ -12,11 +12,15 @@
 // Authors: Radu Serban
 // =============================================================================
 
+#include <cmath>
+#include <functional>
 #include <iomanip>
+#include <limits>
 
 #include "chrono/core/ChSparsityPatternLearner.h"
 
 #include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 #define SPM_DEF_SPARSITY 0.9  ///< default predicted sparsity (in [0,1])
 
@@ -26,6 +30,14 @@ ChDirectSolverLS::ChDirectSolverLS()
     : m_lock(false),
       m_use_learner(true),
       m_force_update(true),
+      m_reuse_analysis(false),
+      m_pattern_changed(true),
+      m_pattern_hash(0),
+      m_analyze_call(0),
+      m_mixed_precision(false),
+      m_refine_steps(-1),
+      m_refine_tol(1e-12),
+      m_refine_count(0),
       m_null_pivot_detection(false),
       m_use_rhs_sparsity(false),
       m_use_perm(false),
@@ -42,6 +54,28 @@ void ChDirectSolverLS::ResetTimers() {
     m_timer_solve_solvercall.reset();
 }
 
+void ChDirectSolverLS::ReuseSymbolicAnalysis(bool val) {
+    m_reuse_analysis = val;
+    m_pattern_hash = 0;
+    m_slot_map.Reset();
+}
+
+void ChDirectSolverLS::EnableMixedPrecision(bool val) {
+    if (val == m_mixed_precision)
+        return;
+    m_mixed_precision = val;
+    // Force a new symbolic analysis, as the single- and double-precision factorizations are separate
+    // (the matrix is not refilled in place, so that the pattern hash is re-evaluated at the next setup)
+    m_pattern_hash = 0;
+    m_pattern_changed = true;
+    m_force_update = true;
+}
+
+void ChDirectSolverLS::SetIterativeRefinement(int max_steps, double tolerance) {
+    m_refine_steps = std::max(max_steps, 0);
+    m_refine_tol = tolerance;
+}
+
 bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
     m_timer_setup_assembly.start();
 
@@ -49,42 +83,64 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
     // Note that ChSystemDescriptor::UpdateCountsAndOffsets was already called at the beginning of the step.
     m_dim = sysd.CountActiveVariables() + sysd.CountActiveConstraints();
 
+    // If reuse of the symbolic analysis is enabled, attempt to refill the current matrix in place.
+    // This succeeds only if the problem size is unchanged and all elements fit in the current sparsity pattern.
+    bool refilled = m_reuse_analysis && !m_force_update && m_setup_call > 0 && m_mat.rows() == m_dim &&
+                    m_mat.isCompressed() && RefillMatrix(sysd);
+
     // If use of the sparsity pattern learner is enabled, call it if:
     // (a) an explicit update was requested (by default this is true at the first call), or
-    // (b) the sparsity pattern is not locked and so has to be re-evaluated at each call
-    bool call_learner = m_use_learner && (m_force_update || !m_lock);
+    // (b) the sparsity pattern is not locked and so has to be re-evaluated at each call, or
+    // (c) the matrix could not be refilled in place
+    bool call_learner = !refilled && m_use_learner && (m_force_update || !m_lock || m_reuse_analysis);
 
     // If use of the sparsity pattern learner is disabled, reserve space for nonzeros,
     // using the current sparsity level estimate, if:
     // (a) this is the first call to setup, or
-    // (b) the sparsity pattern is not locked and so has to be re-evaluated at each call
-    bool call_reserve = !m_use_learner && (m_setup_call == 0 || !m_lock);
+    // (b) the sparsity pattern is not locked and so has to be re-evaluated at each call, or
+    // (c) the matrix could not be refilled in place
+    bool call_reserve = !refilled && !m_use_learner && (m_setup_call == 0 || !m_lock || m_reuse_analysis);
 
     if (verbose) {
         std::cout << "Solver setup" << std::endl;
         std::cout << "  call number:    " << m_setup_call << std::endl;
         std::cout << "  use learner?    " << m_use_learner << std::endl;
         std::cout << "  pattern locked? " << m_lock << std::endl;
+        std::cout << "  reuse analysis? " << m_reuse_analysis << std::endl;
+        std::cout << "  matrix refill:  " << refilled << std::endl;
         std::cout << "  CALL learner:   " << call_learner << std::endl;
         std::cout << "  CALL reserve:   " << call_reserve << std::endl;
     }
 
-    if (call_learner) {
-        ChSparsityPatternLearner sparsity_pattern(m_dim, m_dim);
-        sysd.BuildSystemMatrix(&sparsity_pattern, nullptr);
-        sparsity_pattern.Apply(m_mat);
-        m_force_update = false;
-    } else if (call_reserve) {
-        double density = (m_sparsity > 0) ? 1 - m_sparsity : 1 - SPM_DEF_SPARSITY;
-        m_mat.resize(m_dim, m_dim);
-        m_mat.reserve(Eigen::VectorXi::Constant(m_dim, static_cast<int>(m_dim * density)));
-    }
+    if (refilled) {
+        // Same sparsity pattern as at the previous call
+        m_pattern_changed = false;
+    } else {
+        if (call_learner) {
+            ChSparsityPatternLearner sparsity_pattern(m_dim, m_dim);
+            sysd.BuildSystemMatrix(&sparsity_pattern, nullptr);
+            sparsity_pattern.Apply(m_mat);
+            m_force_update = false;
+        } else if (call_reserve) {
+            double density = (m_sparsity > 0) ? 1 - m_sparsity : 1 - SPM_DEF_SPARSITY;
+            m_mat.resize(m_dim, m_dim);
+            m_mat.reserve(Eigen::VectorXi::Constant(m_dim, static_cast<int>(m_dim * density)));
+        }
 
-    // Let the system descriptor load the current matrix
-    sysd.BuildSystemMatrix(&m_mat, nullptr);
+        // Let the system descriptor load the current matrix
+        sysd.BuildSystemMatrix(&m_mat, nullptr);
 
-    // Allow the matrix to be compressed
-    m_mat.makeCompressed();
+        // Allow the matrix to be compressed
+        m_mat.makeCompressed();
+
+        // Element positions are cached at the next in-place refill
+        m_slot_map.Reset();
+
+        UpdatePatternHash();
+    }
+
+    if (m_pattern_changed)
+        m_analyze_call++;
 
     m_timer_setup_assembly.stop();
 
@@ -93,7 +149,9 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
 
     // Let the concrete solver perform the facorization
     m_timer_setup_solvercall.start();
+    CH_TRACE_BEGIN("FactorizeMatrix");
     bool result = FactorizeMatrix();
+    CH_TRACE_END();
     m_timer_setup_solvercall.stop();
 
     if (write_matrix)
@@ -103,7 +161,8 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
         std::cout << " Solver setup [" << m_setup_call << "] n = " << m_dim << "  nnz = " << (int)m_mat.nonZeros()
                   << std::endl;
         std::cout << "  assembly matrix:   " << m_timer_setup_assembly.GetTimeSeconds() << "s\n"
-                  << "  analyze+factorize: " << m_timer_setup_solvercall.GetTimeSeconds() << "s"
+                  << (m_pattern_changed ? "  analyze+factorize: " : "  factorize:         ")
+                  << m_timer_setup_solvercall.GetTimeSeconds() << "s"
                   << std::endl;
     }
 
@@ -130,7 +189,9 @@ double ChDirectSolverLS::Solve(ChSystemDescriptor& sysd) {
 
     // Let the concrete solver compute the solution
     m_timer_solve_solvercall.start();
-    bool result = SolveSystem();
+    CH_TRACE_BEGIN("SolveSystem");
+    bool result = SolveSystem() && RefineSolution();
+    CH_TRACE_END();
     m_timer_solve_solvercall.stop();
 
     if (write_matrix)
@@ -143,7 +204,10 @@ double ChDirectSolverLS::Solve(ChSystemDescriptor& sysd) {
 
     if (verbose) {
         double res_norm = (m_rhs - m_mat * m_sol).norm();
-        std::cout << " Solver solve [" << m_solve_call << "]  |residual| = " << res_norm << std::endl << std::endl;
+        std::cout << " Solver solve [" << m_solve_call << "]  |residual| = " << res_norm;
+        if (m_refine_count > 0)
+            std::cout << "  refinement steps = " << m_refine_count;
+        std::cout << std::endl << std::endl;
         std::cout << "  assembly rhs+sol:  " << m_timer_solve_assembly.GetTimeSeconds() << "s\n"
                   << "  solve:             " << m_timer_solve_solvercall.GetTimeSeconds() << std::endl;
     }
@@ -164,12 +228,19 @@ bool ChDirectSolverLS::SetupCurrent() {
 
     // Allow the matrix to be compressed, if not yet compressed
     m_mat.makeCompressed();
+    m_dim = (int)m_mat.rows();
+
+    UpdatePatternHash();
+    if (m_pattern_changed)
+        m_analyze_call++;
 
     m_timer_setup_assembly.stop();
 
     // Let the concrete solver perform the factorization
     m_timer_setup_solvercall.start();
+    CH_TRACE_BEGIN("FactorizeMatrix");
     bool result = FactorizeMatrix();
+    CH_TRACE_END();
     m_timer_setup_solvercall.stop();
 
     if (verbose) {
@@ -198,7 +269,9 @@ double ChDirectSolverLS::SolveCurrent() {
 
     // Let the concrete solver compute the solution
     m_timer_solve_solvercall.start();
-    bool result = SolveSystem();
+    CH_TRACE_BEGIN("SolveSystem");
+    bool result = SolveSystem() && RefineSolution();
+    CH_TRACE_END();
     m_timer_solve_solvercall.stop();
 
     if (verbose) {
@@ -220,6 +293,91 @@ double ChDirectSolverLS::SolveCurrent() {
     return result;
 }
 
+// Classical iterative refinement: r = b - A*x (in double precision), solve A*d = r with the current factorization,
+// and update x += d. With a single-precision factorization, each step reduces the error by a factor of roughly
+// cond(A) * eps_float, so a few steps recover a solution accurate to double precision for well-conditioned problems.
+// If cond(A) * eps_float > 1, the corrections amplify the error and the refinement diverges.
+bool ChDirectSolverLS::RefineSolution() {
+    m_refine_count = 0;
+
+    int max_steps = m_refine_steps >= 0 ? m_refine_steps : (UsesMixedPrecision() ? 10 : 0);
+    if (max_steps == 0)
+        return true;
+
+    CH_TRACE_ZONE("RefineSolution");
+
+    // SolveSystem operates on m_rhs and m_sol; save the original right-hand side and the current solution
+    ChVectorDynamic<double> rhs = m_rhs;
+    ChVectorDynamic<double> sol = m_sol;
+    double tol = m_refine_tol * rhs.norm();
+
+    bool result = true;
+    bool diverged = false;
+    double res_norm = std::numeric_limits<double>::infinity();
+    while (true) {
+        m_rhs = rhs - m_mat * sol;
+        double new_norm = m_rhs.norm();
+        if (m_refine_count > 0 && !(new_norm < res_norm)) {
+            // The last correction did not reduce the residual: discard it and stop. Stagnation (e.g., at round-off
+            // level) is tolerated; a growing or non-finite residual indicates divergence.
+            sol -= m_sol;
+            m_refine_count--;
+            diverged = !(new_norm <= 10 * res_norm);
+            break;
+        }
+        res_norm = new_norm;
+        if (res_norm <= tol || m_refine_count == max_steps)
+            break;
+        if (!(result = SolveSystem()))
+            break;
+        sol += m_sol;
+        m_refine_count++;
+    }
+
+    m_rhs = rhs;
+    m_sol = sol;
+
+    if (!result)
+        return false;
+
+    if (diverged || !std::isfinite(res_norm)) {
+        std::cerr << "Iterative refinement diverged (relative residual " << res_norm / rhs.norm() << ")" << std::endl;
+        return false;
+    }
+
+    if (res_norm > tol) {
+        std::cerr << "Iterative refinement did not converge in " << max_steps << " steps (relative residual "
+                  << res_norm / rhs.norm() << ", tolerance " << m_refine_tol << ")" << std::endl;
+    }
+
+    return true;
+}
+
+bool ChDirectSolverLS::RefillMatrix(ChSystemDescriptor& sysd) {
+    m_slot_map.Begin(m_mat);
+    sysd.BuildSystemMatrix(&m_slot_map, nullptr);
+    return m_slot_map.End();
+}
+
+void ChDirectSolverLS::UpdatePatternHash() {
+    if (!m_reuse_analysis) {
+        m_pattern_changed = true;
+        return;
+    }
+
+    // Combine the hashes of the row start indices and of the column indices of the compressed matrix
+    std::hash<int> hasher;
+    size_t hash = hasher((int)m_mat.rows());
+    auto combine = [&hash, &hasher](int v) { hash ^= hasher(v) + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+    for (int i = 0; i <= m_mat.outerSize(); i++)
+        combine(m_mat.outerIndexPtr()[i]);
+    for (int k = 0; k < m_mat.nonZeros(); k++)
+        combine(m_mat.innerIndexPtr()[k]);
+
+    m_pattern_changed = (m_analyze_call == 0 || hash != m_pattern_hash);
+    m_pattern_hash = hash;
+}
+
 // ---------------------------------------------------------------------------
 
 void ChDirectSolverLS::WriteMatrix(const std::string& filename, const ChSparseMatrix& M) {
@@ -256,6 +414,10 @@ void ChDirectSolverLS::ArchiveOut(ChArchiveOut& archive_out) {
     archive_out << CHNVP(m_use_learner);
     archive_out << CHNVP(m_use_perm);
     archive_out << CHNVP(m_use_rhs_sparsity);
+    archive_out << CHNVP(m_reuse_analysis);
+    archive_out << CHNVP(m_mixed_precision);
+    archive_out << CHNVP(m_refine_steps);
+    archive_out << CHNVP(m_refine_tol);
 }
 
 void ChDirectSolverLS::ArchiveIn(ChArchiveIn& archive_in) {
@@ -270,23 +432,42 @@ void ChDirectSolverLS::ArchiveIn(ChArchiveIn& archive_in) {
     archive_in >> CHNVP(m_use_learner);
     archive_in >> CHNVP(m_use_perm);
     archive_in >> CHNVP(m_use_rhs_sparsity);
+    archive_in >> CHNVP(m_reuse_analysis);
+    archive_in >> CHNVP(m_mixed_precision);
+    archive_in >> CHNVP(m_refine_steps);
+    archive_in >> CHNVP(m_refine_tol);
 }
 
 // ---------------------------------------------------------------------------
 
 bool ChSolverSparseLU::FactorizeMatrix() {
-    m_engine.compute(m_mat);
+    if (UsesMixedPrecision()) {
+        m_mat_f = m_mat.cast<float>();
+        if (PatternChanged())
+            m_engine_f.analyzePattern(m_mat_f);
+        m_engine_f.factorize(m_mat_f);
+        return (m_engine_f.info() == Eigen::Success);
+    }
+
+    if (PatternChanged())
+        m_engine.analyzePattern(m_mat);
+    m_engine.factorize(m_mat);
     return (m_engine.info() == Eigen::Success);
 }
 
 bool ChSolverSparseLU::SolveSystem() {
+    if (UsesMixedPrecision()) {
+        m_sol = m_engine_f.solve(m_rhs.cast<float>()).cast<double>();
+        return (m_engine_f.info() == Eigen::Success);
+    }
+
     m_sol = m_engine.solve(m_rhs);
     return (m_engine.info() == Eigen::Success);
 }
 
 void ChSolverSparseLU::PrintErrorMessage() {
     // There are only three possible return codes (see Eigen SparseLU.h)
-    switch (m_engine.info()) {
+    switch (UsesMixedPrecision() ? m_engine_f.info() : m_engine.info()) {
         case Eigen::Success:
             std::cout << "computation was successful" << std::endl;
             break;
@@ -304,18 +485,33 @@ void ChSolverSparseLU::PrintErrorMessage() {
 // ---------------------------------------------------------------------------
 
 bool ChSolverSparseQR::FactorizeMatrix() {
-    m_engine.compute(m_mat);
+    if (UsesMixedPrecision()) {
+        m_mat_f = m_mat.cast<float>();
+        if (PatternChanged())
+            m_engine_f.analyzePattern(m_mat_f);
+        m_engine_f.factorize(m_mat_f);
+        return (m_engine_f.info() == Eigen::Success);
+    }
+
+    if (PatternChanged())
+        m_engine.analyzePattern(m_mat);
+    m_engine.factorize(m_mat);
     return (m_engine.info() == Eigen::Success);
 }
 
 bool ChSolverSparseQR::SolveSystem() {
+    if (UsesMixedPrecision()) {
+        m_sol = m_engine_f.solve(m_rhs.cast<float>()).cast<double>();
+        return (m_engine_f.info() == Eigen::Success);
+    }
+
     m_sol = m_engine.solve(m_rhs);
     return (m_engine.info() == Eigen::Success);
 }
 
 void ChSolverSparseQR::PrintErrorMessage() {
     // There are only three possible return codes (see Eigen SparseLU.h)
-    switch (m_engine.info()) {
+    switch (UsesMixedPrecision() ? m_engine_f.info() : m_engine.info()) {
         case Eigen::Success:
             std::cout << "computation was successful" << std::endl;
             break;
@@ -330,4 +526,57 @@ void ChSolverSparseQR::PrintErrorMessage() {
     }
 }
 
+// ---------------------------------------------------------------------------
+
+ChSolverSparseCholesky::ChSolverSparseCholesky() : m_num_threads(0), m_num_vars(-1) {
+    m_symmetry = MatrixSymmetryType::SYMMETRIC_INDEF;
+}
+
+void ChSolverSparseCholesky::SetNumThreads(int num_threads) {
+    m_num_threads = num_threads;
+    m_engine.SetNumThreads(num_threads);
+}
+
+bool ChSolverSparseCholesky::Setup(ChSystemDescriptor& sysd) {
+    // The constraint rows follow the variables in the system matrix
+    m_num_vars = sysd.CountActiveVariables();
+    if (m_num_threads <= 0)
+        m_engine.SetNumThreads(sysd.GetNumThreads());
+
+    return ChDirectSolverLS::Setup(sysd);
+}
+
+bool ChSolverSparseCholesky::FactorizeMatrix() {
+    bool posdef = (m_symmetry == MatrixSymmetryType::SYMMETRIC_POSDEF);
+
+    // Without a system descriptor (see SetupCurrent), rows with zero diagonal are treated as constraint rows
+    int num_vars = (m_num_vars >= 0 && m_num_vars <= m_dim) ? m_num_vars : -1;
+
+    // The ordering also depends on the symmetry type and on the number of variables
+    if (PatternChanged() || !m_engine.IsAnalyzed() || m_engine.IsPositiveDefinite() != posdef ||
+        m_engine.GetNumPrimal() != num_vars) {
+        m_engine.SetPositiveDefinite(posdef);
+        m_engine.AnalyzePattern(m_mat, num_vars);
+    }
+
+    return m_engine.Factorize(m_mat);
+}
+
+bool ChSolverSparseCholesky::SolveSystem() {
+    m_engine.Solve(m_rhs, m_sol);
+    return true;
+}
+
+void ChSolverSparseCholesky::PrintErrorMessage() {
+    if (m_engine.GetFailedRow() >= 0) {
+        if (m_symmetry == MatrixSymmetryType::SYMMETRIC_POSDEF)
+            std::cout << "LDLT factorization: matrix not positive definite (row " << m_engine.GetFailedRow() << ")"
+                      << std::endl;
+        else
+            std::cout << "LDLT factorization: invalid pivot at row " << m_engine.GetFailedRow() << std::endl;
+    } else {
+        std::cout << "LDLT factorization: matrix does not match the symbolic analysis" << std::endl;
+    }
+}
+
 }  // end namespace chrono
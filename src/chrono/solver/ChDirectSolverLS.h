@@ -16,13 +16,18 @@
 #define CH_DIRECTSOLVER_LS_H
 
 #include "chrono/core/ChMatrix.h"
+#include "chrono/core/ChSparseSlotMap.h"
 #include "chrono/core/ChTimer.h"
 #include "chrono/solver/ChSolverLS.h"
+#include "chrono/solver/ChSupernodalLDLT.h"
 
 #include <Eigen/SparseLU>
 
 namespace chrono {
 
+/// Single-precision sparse matrix, used for mixed-precision factorizations.
+using ChSparseMatrixFloat = Eigen::SparseMatrix<float, Eigen::RowMajor, int>;
+
 /// @addtogroup chrono_solver
 /// @{
 
@@ -37,9 +42,10 @@ performing the actual matrix factorization and then computing the solution vecto
 See ChSolverMkl (which implements Eigen's interface to the Intel MKL Pardiso solver) and ChSolverMumps (which interfaces
 to the MUMPS solver).
 
-ChDirectSolverLS manages the detection and update of the matrix sparsity pattern, providing two main features:
+ChDirectSolverLS manages the detection and update of the matrix sparsity pattern, providing three main features:
 - sparsity pattern lock
 - sparsity pattern learning
+- reuse of the symbolic analysis
 
 The sparsity pattern \e lock skips sparsity identification or reserving memory for nonzeros on all but the first call to
 Setup. This feature is intended for problems where the system matrix sparsity pattern does not change significantly from
@@ -56,6 +62,19 @@ to a fully dense matrix). This value is used if the sparsity pattern learner is
 space for matrix indices and nonzeros.
 See #SetSparsityEstimate();
 
+The symbolic analysis \e reuse mode assembles the matrix only once. On subsequent calls to Setup, the matrix values are
+refilled in place, using the cached position of each element contributed by the variables, KRM blocks and constraints
+(see ChSparseSlotMap). The matrix is rebuilt only if an element falls outside the current sparsity pattern and the
+concrete solver repeats its symbolic analysis only if the sparsity pattern changed (as detected through a hash of the
+matrix indices); otherwise, only the numeric factorization is performed.\n
+See #ReuseSymbolicAnalysis();
+
+The \e mixed-precision mode factorizes a single-precision copy of the matrix (if supported by the concrete solver; see
+ChSolverSparseLU and ChSolverSparseQR), roughly halving the memory traffic of the factorization and of the triangular
+solves. The accuracy of the solution is then recovered by iterative refinement, with residuals evaluated in double
+precision against the original matrix. Iterative refinement can also be used on its own, with any concrete solver.\n
+See #EnableMixedPrecision(); #SetIterativeRefinement();
+
 <br>
 
 <div class="ce-warning">
@@ -92,6 +111,37 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     /// or structure occurred. This function has no effect if the sparsity pattern learner is disabled.
     void ForceSparsityPatternUpdate() { m_force_update = true; }
 
+    /// Enable/disable reuse of the matrix sparsity pattern and symbolic analysis (default: false).\n
+    /// If enabled, the system matrix is refilled in place from one call to the next and the concrete solver performs
+    /// the symbolic analysis only when the sparsity pattern changes. A concrete direct sparse solver may or may not
+    /// support separate symbolic analysis and numeric factorization; the in-place matrix refill is always available.
+    void ReuseSymbolicAnalysis(bool val);
+
+    /// Return the number of calls to Setup which required a symbolic analysis.
+    unsigned int GetNumSymbolicAnalyses() const { return m_analyze_call; }
+
+    /// Enable/disable the mixed-precision mode (default: false).\n
+    /// If enabled, and if supported by the concrete solver, the matrix is factorized in single precision and the
+    /// solution is improved by iterative refinement with double-precision residuals (see SetIterativeRefinement). If
+    /// the concrete solver does not support single-precision factorization, this setting has no effect. The setting
+    /// takes effect at the next call to Setup.
+    void EnableMixedPrecision(bool val);
+
+    /// Return true if the matrix is factorized in single precision.
+    bool UsesMixedPrecision() const { return m_mixed_precision && SupportsMixedPrecision(); }
+
+    /// Set the parameters of the iterative refinement of the solution.\n
+    /// At most 'max_steps' refinement steps are performed after each solve, stopping as soon as the norm of the
+    /// residual, relative to the norm of the right-hand side, is below 'tolerance'. Each step evaluates the residual in
+    /// double precision and solves for a correction using the current factorization. By default, no refinement is
+    /// performed in double precision and at most 10 steps are performed in mixed-precision mode. The refinement stops
+    /// early if a step does not reduce the residual; the solve fails if the residual grows (e.g., for a matrix too
+    /// ill-conditioned for a single-precision factorization) and a warning is issued if the tolerance is not reached.
+    void SetIterativeRefinement(int max_steps, double tolerance = 1e-12);
+
+    /// Return the number of iterative refinement steps performed at the last solve.
+    int GetNumRefinementSteps() const { return m_refine_count; }
+
     /// Set estimate for matrix sparsity, a value in [0,1], with 0 indicating a fully dense matrix (default: 0.9).\n
     /// Only used if the sparsity pattern learner is disabled.
     void SetSparsityEstimate(double sparsity) { m_sparsity = sparsity; }
@@ -177,8 +227,13 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     virtual ChDirectSolverLS* AsDirect() override { return this; }
 
     /// Factorize the current sparse matrix and return true if successful.
+    /// If supported, concrete solvers should repeat the symbolic analysis only if #PatternChanged() returns true.
     virtual bool FactorizeMatrix() = 0;
 
+    /// Return true if the sparsity pattern of the current matrix differs from the one at the previous factorization.
+    /// Always true if reuse of the symbolic analysis is disabled.
+    bool PatternChanged() const { return m_pattern_changed; }
+
     /// Solve the linear system using the current factorization and right-hand side vector.
     /// Load the solution vector (already of appropriate size) and return true if succesful.
     virtual bool SolveSystem() = 0;
@@ -187,6 +242,10 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     /// This function is only called if Factorize or Solve returned false.
     virtual void PrintErrorMessage() = 0;
 
+    /// Return true if the concrete solver can factorize the matrix in single precision.
+    /// Such solvers must check #UsesMixedPrecision() in FactorizeMatrix and SolveSystem.
+    virtual bool SupportsMixedPrecision() const { return false; }
+
     /// Indicate whether or not the #Solve() phase requires an up-to-date problem matrix.
     /// Typically, direct solvers only require the matrix for their #Setup() phase.
     virtual bool SolveRequiresMatrix() const override { return false; }
@@ -205,6 +264,17 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     bool m_use_learner;   ///< use the sparsity pattern learner?
     bool m_force_update;  ///< force a call to the sparsity pattern learner?
 
+    bool m_reuse_analysis;        ///< refill matrix in place and reuse symbolic analysis?
+    bool m_pattern_changed;       ///< did the sparsity pattern change since the last factorization?
+    size_t m_pattern_hash;        ///< hash of the sparsity pattern at the last factorization
+    unsigned int m_analyze_call;  ///< counter for calls to Setup requiring a symbolic analysis
+    ChSparseSlotMap m_slot_map;   ///< cached positions of matrix elements (for in-place refill)
+
+    bool m_mixed_precision;  ///< factorize in single precision (if supported)?
+    int m_refine_steps;      ///< maximum number of iterative refinement steps (-1: default)
+    double m_refine_tol;     ///< tolerance on the relative residual for iterative refinement
+    int m_refine_count;      ///< number of refinement steps at the last solve
+
     bool m_use_perm;              ///< use of the permutation vector?
     bool m_use_rhs_sparsity;      ///< leverage right-hand side sparsity?
     bool m_null_pivot_detection;  ///< enable detection of zero pivots?
@@ -215,6 +285,16 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     ChTimer m_timer_solve_solvercall;  ///< timer for solution
 
   private:
+    /// Refill the current matrix in place; return false if the sparsity pattern must be updated.
+    bool RefillMatrix(ChSystemDescriptor& sysd);
+
+    /// Update the hash of the current matrix sparsity pattern and set the pattern change flag.
+    void UpdatePatternHash();
+
+    /// Improve the current solution by iterative refinement.
+    /// Return false if a solve failed or if the refinement diverged; warn if the tolerance was not reached.
+    bool RefineSolution();
+
     void WriteMatrix(const std::string& filename, const ChSparseMatrix& M);
     void WriteVector(const std::string& filename, const ChVectorDynamic<double>& v);
 };
@@ -243,7 +323,13 @@ class ChApi ChSolverSparseLU : public ChDirectSolverLS {
     /// This function is only called if Factorize or Solve returned false.
     virtual void PrintErrorMessage() override;
 
+    /// The matrix can be factorized in single precision.
+    virtual bool SupportsMixedPrecision() const override { return true; }
+
     Eigen::SparseLU<ChSparseMatrix, Eigen::COLAMDOrdering<int>> m_engine;  ///< Eigen SparseLU solver
+
+    ChSparseMatrixFloat m_mat_f;                                                  ///< single-precision matrix
+    Eigen::SparseLU<ChSparseMatrixFloat, Eigen::COLAMDOrdering<int>> m_engine_f;  ///< single-precision solver
 };
 
 /// Sparse QR direct solver.\n
@@ -268,7 +354,63 @@ class ChApi ChSolverSparseQR : public ChDirectSolverLS {
     /// This function is only called if Factorize or Solve returned false.
     virtual void PrintErrorMessage() override;
 
+    /// The matrix can be factorized in single precision.
+    virtual bool SupportsMixedPrecision() const override { return true; }
+
     Eigen::SparseQR<ChSparseMatrix, Eigen::COLAMDOrdering<int>> m_engine;  ///< Eigen SparseQR solver
+
+    ChSparseMatrixFloat m_mat_f;                                                  ///< single-precision matrix
+    Eigen::SparseQR<ChSparseMatrixFloat, Eigen::COLAMDOrdering<int>> m_engine_f;  ///< single-precision solver
+};
+
+/// Sparse Cholesky direct solver for symmetric matrices.\n
+/// Built-in supernodal multifrontal LDL^T factorization (see ChSupernodalLDLT), with an approximate minimum degree
+/// ordering and a multithreaded numeric factorization. Since only the lower triangle of the problem matrix is used, it
+/// applies to problems with symmetric Jacobians (e.g., static, modal, and implicit dynamic FEA analyses). Constraint
+/// rows are eliminated after the variables they couple, so that saddle-point matrices with a positive definite mass
+/// and stiffness block can be factorized without pivoting. With the SYMMETRIC_POSDEF matrix symmetry type, the rows
+/// are ordered for minimum fill only and the factorization fails if the matrix is not positive definite. Pivots
+/// perturbed in a (nearly) singular matrix can be compensated by iterative refinement (see SetIterativeRefinement).
+/// The default matrix symmetry type is SYMMETRIC_INDEF; a GENERAL matrix is treated as symmetric indefinite.\n
+/// Cannot handle VI and complementarity problems, so it cannot be used with NSC formulations.\n
+/// See ChDirectSolverLS for more details.
+class ChApi ChSolverSparseCholesky : public ChDirectSolverLS {
+  public:
+    ChSolverSparseCholesky();
+    ~ChSolverSparseCholesky() {}
+    virtual Type GetType() const override { return Type::SPARSE_CHOLESKY; }
+
+    /// Set the number of threads for the numeric factorization.\n
+    /// By default, the number of threads of the system descriptor is used (see ChSystem::SetNumThreads).
+    void SetNumThreads(int num_threads);
+
+    /// Return the number of negative pivots at the last factorization (the number of negative eigenvalues).
+    int GetNumNegativePivots() const { return m_engine.GetNumNegativePivots(); }
+
+    /// Return the number of pivots perturbed at the last factorization.
+    int GetNumPerturbedPivots() const { return m_engine.GetNumPerturbedPivots(); }
+
+    /// Return the number of nonzeros in the strictly lower triangle of the factor.
+    size_t GetNumNonZerosFactor() const { return m_engine.GetNumNonZerosL(); }
+
+    /// Perform the solver setup operations.
+    virtual bool Setup(ChSystemDescriptor& sysd) override;
+
+  private:
+    /// Factorize the current sparse matrix and return true if successful.
+    virtual bool FactorizeMatrix() override;
+
+    /// Solve the linear system using the current factorization and right-hand side vector.
+    /// Load the solution vector (already of appropriate size) and return true if succesful.
+    virtual bool SolveSystem() override;
+
+    /// Display an error message corresponding to the last failure.
+    /// This function is only called if Factorize or Solve returned false.
+    virtual void PrintErrorMessage() override;
+
+    ChSupernodalLDLT m_engine;  ///< supernodal LDL^T factorization
+    int m_num_threads;          ///< user-specified number of threads (0: use the system descriptor setting)
+    int m_num_vars;             ///< number of variables in the problem matrix (-1: unknown)
 };
 
 /// @} chrono_solver
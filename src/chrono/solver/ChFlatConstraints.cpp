@@ -0,0 +1,180 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2024 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/solver/ChFlatConstraints.h"
+#include "chrono/solver/ChConstraintTwoTuplesContactN.h"
+
+namespace chrono {
+
+void ChFlatConstraints::Build(const std::vector<ChConstraint*>& all_constraints,
+                              const std::vector<ChVariables*>& variables,
+                              unsigned int num_variables) {
+    n_q = num_variables;
+
+    // Map each entry of the global vector of variables to the owning ChVariables object
+    var_of_col.assign(n_q, -1);
+    for (int iv = 0; iv < (int)variables.size(); iv++) {
+        auto var = variables[iv];
+        if (var->IsActive()) {
+            for (unsigned int j = 0; j < var->GetDOF(); j++)
+                var_of_col[var->GetOffset() + j] = iv;
+        }
+    }
+
+    // Collect the active constraints
+    constraints.clear();
+    for (auto constr : all_constraints) {
+        if (constr->IsActive())
+            constraints.push_back(constr);
+    }
+    int n_c = (int)constraints.size();
+
+    row_start.resize(n_c + 1);
+    col.clear();
+    Cq.clear();
+    Eq.clear();
+    Cq_f.clear();
+    Eq_f.clear();
+    g.resize(n_c);
+    b.resize(n_c);
+    cfm.resize(n_c);
+    l.resize(n_c);
+    friction.setZero(n_c);
+    cohesion.setZero(n_c);
+
+    row_buffer.resize(1, n_q);
+
+    for (int i = 0; i < n_c; i++) {
+        auto constr = constraints[i];
+        row_start[i] = (int)col.size();
+
+        // Extract the Jacobian row (each active variable is pasted as a dense segment)
+        row_buffer.setZero();
+        constr->PasteJacobianInto(row_buffer, 0, 0);
+
+        // Process the row one variable at a time, computing [Eq] = [invM]*[Cq]' for each variable
+        double g_i = 0;
+        ChSparseMatrix::InnerIterator it(row_buffer, 0);
+        while (it) {
+            auto var = variables[var_of_col[it.col()]];
+            int offset = (int)var->GetOffset();
+            int dof = (int)var->GetDOF();
+
+            cq_seg.setZero(dof);
+            for (; it && it.col() < offset + dof; ++it)
+                cq_seg(it.col() - offset) = it.value();
+
+            eq_seg.resize(dof);
+            var->ComputeMassInverseTimesVector(eq_seg, cq_seg);
+
+            for (int j = 0; j < dof; j++) {
+                col.push_back(offset + j);
+                if (single_precision) {
+                    Cq_f.push_back((float)cq_seg(j));
+                    Eq_f.push_back((float)eq_seg(j));
+                } else {
+                    Cq.push_back(cq_seg(j));
+                    Eq.push_back(eq_seg(j));
+                }
+            }
+            g_i += cq_seg.dot(eq_seg);
+        }
+
+        cfm(i) = constr->GetComplianceTerm();
+        g(i) = g_i + cfm(i);
+        b(i) = constr->GetRightHandSide();
+        l(i) = constr->GetLagrangeMultiplier();
+    }
+    row_start[n_c] = (int)col.size();
+
+    // Group constraints in blocks (friction triplets are projected together)
+    blocks.clear();
+    for (int i = 0; i < n_c;) {
+        Block block{i, 1, Projection::GENERIC};
+        if (constraints[i]->GetMode() == ChConstraint::Mode::FRICTION && i + 2 < n_c &&
+            constraints[i + 1]->GetMode() == ChConstraint::Mode::FRICTION &&
+            constraints[i + 2]->GetMode() == ChConstraint::Mode::FRICTION) {
+            block.size = 3;
+            if (auto contact = dynamic_cast<ChConstraintTwoTuplesContactNall*>(constraints[i])) {
+                block.projection = Projection::CONTACT;
+                friction(i) = contact->GetFrictionCoefficient();
+                cohesion(i) = contact->GetCohesion();
+            }
+        }
+        blocks.push_back(block);
+        i += block.size;
+    }
+}
+
+void ChFlatConstraints::ProjectBlock(const Block& block, double* lvec) const {
+    int i = block.start;
+
+    if (block.projection == Projection::GENERIC) {
+        for (int k = 0; k < block.size; k++)
+            constraints[i + k]->SetLagrangeMultiplier(lvec[i + k]);
+        constraints[i]->Project();
+        for (int k = 0; k < block.size; k++)
+            lvec[i + k] = constraints[i + k]->GetLagrangeMultiplier();
+        return;
+    }
+
+    // Anitescu-Tasora projection on cone generator and polar cone (see ChConstraintTwoTuplesContactN::Project)
+    double mu = friction(i);
+    double f_n = lvec[i] + cohesion(i);
+    double f_u = lvec[i + 1];
+    double f_v = lvec[i + 2];
+
+    if (mu == 0) {
+        lvec[i + 1] = 0;
+        lvec[i + 2] = 0;
+        if (f_n < 0)
+            lvec[i] = 0;
+    } else {
+        double mu2 = mu * mu;
+        double f_n2 = f_n * f_n;
+        double f_t2 = f_u * f_u + f_v * f_v;
+
+        if ((f_n <= 0 && f_t2 < f_n2 / mu2) || (f_n < 1e-14 && f_n > -1e-14)) {
+            // inside lower cone or close to origin: reset normal, u, v to zero
+            lvec[i] = 0;
+            lvec[i + 1] = 0;
+            lvec[i + 2] = 0;
+        } else if (f_t2 >= f_n2 * mu2) {
+            // project orthogonally to generator segment of upper cone
+            double f_t = std::sqrt(f_t2);
+            double f_n_proj = (f_t * mu + f_n) / (mu2 + 1);
+            double tproj_div_t = f_n_proj * mu / f_t;
+            lvec[i] = f_n_proj - cohesion(i);
+            lvec[i + 1] = tproj_div_t * f_u;
+            lvec[i + 2] = tproj_div_t * f_v;
+        }
+    }
+
+    // Keep the normal multiplier in sync, as it may be needed by other constraints (e.g., rolling friction)
+    constraints[i]->SetLagrangeMultiplier(lvec[i]);
+}
+
+void ChFlatConstraints::Project(double* lvec) const {
+    for (const auto& block : blocks)
+        ProjectBlock(block, lvec);
+}
+
+void ChFlatConstraints::ScatterMultipliers() const {
+    for (int i = 0; i < (int)constraints.size(); i++)
+        constraints[i]->SetLagrangeMultiplier(l(i));
+}
+
+}  // end namespace chrono
@@ -0,0 +1,144 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2024 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#ifndef CH_FLAT_CONSTRAINTS_H
+#define CH_FLAT_CONSTRAINTS_H
+
+#include <vector>
+
+#include "chrono/solver/ChConstraint.h"
+#include "chrono/solver/ChVariables.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Flattened (structure-of-arrays) representation of the active constraints in a system descriptor.
+/// All data needed by the iterative VI solvers is packed in contiguous buffers:
+/// - the constraint Jacobians [Cq_i] and the products [Eq_i]=[invM]*[Cq_i]', stored row-wise (CSR-like) together with
+///   the indices of the corresponding entries in the global vector of variables 'q';
+/// - the Schur complement diagonal g_i, the right-hand sides b_i, the compliance terms cfm_i and the multipliers l_i;
+/// - friction and cohesion coefficients for frictional contacts, which are projected without virtual calls.
+///
+/// Solvers operate on a global vector 'q' (ordered as in ChSystemDescriptor::FromVariablesToVector) instead of the
+/// states stored in the individual ChVariables objects.
+///
+/// Optionally, the Jacobian entries [Cq] and [Eq] can be stored in single precision (see SetSinglePrecision). This
+/// halves the memory traffic of the Jacobian products, which dominate the cost of the iterative VI solvers for large
+/// problems. All other data and all accumulations are kept in double precision.
+class ChApi ChFlatConstraints {
+  public:
+    /// Type of projection applied to a block of constraints.
+    enum class Projection {
+        CONTACT,  ///< frictional contact triplet N,U,V (projection onto the friction cone)
+        GENERIC,  ///< projection delegated to the ChConstraint objects
+    };
+
+    /// Group of consecutive constraints projected as a unit (a single constraint or a friction triplet).
+    struct Block {
+        int start;              ///< index of first constraint
+        int size;               ///< number of constraints (1 or 3)
+        Projection projection;  ///< projection type
+    };
+
+    ChFlatConstraints() : n_q(0), single_precision(false) {}
+
+    /// Enable/disable single-precision storage of the Jacobian entries (default: false).
+    /// The setting takes effect at the next call to Build.
+    void SetSinglePrecision(bool val) { single_precision = val; }
+
+    /// Return true if the Jacobian entries are stored in single precision.
+    bool IsSinglePrecision() const { return single_precision; }
+
+    /// Pack the data of all active constraints.
+    /// The offsets of the active variables and constraints must be up-to-date (see
+    /// ChSystemDescriptor::UpdateCountsAndOffsets) and the constraint Jacobians must be loaded.
+    void Build(const std::vector<ChConstraint*>& constraints,
+               const std::vector<ChVariables*>& variables,
+               unsigned int num_variables);
+
+    /// Return the number of packed (active) constraints.
+    int GetNumConstraints() const { return (int)constraints.size(); }
+
+    /// Return the size of the global vector of variables.
+    unsigned int GetNumVariables() const { return n_q; }
+
+    /// Compute [Cq_i]*q for the i-th constraint.
+    double JacobianTimesVector(int i, const double* q) const {
+        return single_precision ? RowTimesVector(Cq_f.data(), i, q) : RowTimesVector(Cq.data(), i, q);
+    }
+
+    /// Perform q += [Eq_i]*deltal for the i-th constraint.
+    void IncrementVector(int i, double deltal, double* q) const {
+        if (single_precision)
+            IncrementVectorRow(Eq_f.data(), i, deltal, q);
+        else
+            IncrementVectorRow(Eq.data(), i, deltal, q);
+    }
+
+    /// Project the multipliers of the given block onto their admissible set.
+    /// The array 'lvec' holds the multipliers of all packed constraints.
+    void ProjectBlock(const Block& block, double* lvec) const;
+
+    /// Project all multipliers onto their admissible sets.
+    void Project(double* lvec) const;
+
+    /// Copy the multipliers in 'l' to the ChConstraint objects.
+    void ScatterMultipliers() const;
+
+    std::vector<ChConstraint*> constraints;  ///< packed (active) constraints
+    std::vector<Block> blocks;               ///< constraint blocks
+
+    std::vector<int> row_start;  ///< start of each constraint row in the Jacobian arrays (size n+1)
+    std::vector<int> col;        ///< index in the global vector of variables of each Jacobian entry
+    std::vector<double> Cq;      ///< Jacobian entries (empty if stored in single precision)
+    std::vector<double> Eq;      ///< entries of [invM]*[Cq]' (empty if stored in single precision)
+    std::vector<float> Cq_f;     ///< Jacobian entries, single precision (empty if stored in double precision)
+    std::vector<float> Eq_f;     ///< entries of [invM]*[Cq]', single precision (empty if stored in double precision)
+
+    ChVectorDynamic<> g;         ///< Schur complement diagonal [Cq_i]*[invM]*[Cq_i]' + cfm_i
+    ChVectorDynamic<> b;         ///< right-hand sides b_i
+    ChVectorDynamic<> cfm;       ///< compliance terms cfm_i
+    ChVectorDynamic<> l;         ///< Lagrange multipliers l_i
+    ChVectorDynamic<> friction;  ///< friction coefficient (only for the first constraint of a contact triplet)
+    ChVectorDynamic<> cohesion;  ///< cohesion (only for the first constraint of a contact triplet)
+
+  private:
+    template <typename Real>
+    double RowTimesVector(const Real* row, int i, const double* q) const {
+        double result = 0;
+        for (int k = row_start[i]; k < row_start[i + 1]; k++)
+            result += row[k] * q[col[k]];
+        return result;
+    }
+
+    template <typename Real>
+    void IncrementVectorRow(const Real* row, int i, double deltal, double* q) const {
+        for (int k = row_start[i]; k < row_start[i + 1]; k++)
+            q[col[k]] += row[k] * deltal;
+    }
+
+    unsigned int n_q;                  ///< size of the global vector of variables
+    bool single_precision;             ///< store Jacobian entries in single precision?
+    std::vector<int> var_of_col;       ///< index of the variable owning each entry of the global vector
+    ChSparseMatrix row_buffer;         ///< scratch matrix for extracting Jacobian rows
+    ChVectorDynamic<> cq_seg, eq_seg;  ///< scratch vectors for [Eq] computation
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
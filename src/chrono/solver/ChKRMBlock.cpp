@@ -52,21 +52,28 @@ void ChKRMBlock::SetVariables(std::vector<ChVariables*> mvariables) {
     KRM.resize(msize, msize);
 }
 
-void ChKRMBlock::AddMatrixTimesVectorInto(ChVectorRef result, ChVectorConstRef vect) const {
+// Product and diagonal of a matrix with the layout of a KRM block, for the given variables.
+// Templated on the matrix type, so that the stored KRM matrix is accessed directly (not through an Eigen::Ref).
+
+template <typename Matrix>
+static void AddProduct(const std::vector<ChVariables*>& variables,
+                       const Matrix& H,
+                       ChVectorRef result,
+                       ChVectorConstRef vect) {
     unsigned int kio = 0;
-    for (unsigned int iv = 0; iv < GetNumVariables(); iv++) {
-        unsigned int io = GetVariable(iv)->GetOffset();
-        unsigned int in = GetVariable(iv)->GetDOF();
-        if (GetVariable(iv)->IsActive()) {
+    for (unsigned int iv = 0; iv < variables.size(); iv++) {
+        unsigned int io = variables[iv]->GetOffset();
+        unsigned int in = variables[iv]->GetDOF();
+        if (variables[iv]->IsActive()) {
             unsigned int kjo = 0;
-            for (unsigned int jv = 0; jv < GetNumVariables(); jv++) {
-                unsigned int jo = GetVariable(jv)->GetOffset();
-                unsigned int jn = GetVariable(jv)->GetDOF();
-                if (GetVariable(jv)->IsActive()) {
+            for (unsigned int jv = 0; jv < variables.size(); jv++) {
+                unsigned int jo = variables[jv]->GetOffset();
+                unsigned int jn = variables[jv]->GetDOF();
+                if (variables[jv]->IsActive()) {
                     for (unsigned int r = 0; r < in; r++) {
                         double tot = 0;
                         for (unsigned int c = 0; c < jn; c++) {
-                            tot += KRM(kio + r, kjo + c) * vect(jo + c);
+                            tot += H(kio + r, kjo + c) * vect(jo + c);
                         }
                         result(io + r) += tot;
                     }
@@ -80,14 +87,15 @@ void ChKRMBlock::AddMatrixTimesVectorInto(ChVectorRef result, ChVectorConstRef v
     }
 }
 
-void ChKRMBlock::DiagonalAdd(ChVectorRef result) const {
+template <typename Matrix>
+static void AddDiagonal(const std::vector<ChVariables*>& variables, const Matrix& H, ChVectorRef result) {
     unsigned int kio = 0;
-    for (unsigned int iv = 0; iv < GetNumVariables(); iv++) {
-        unsigned int io = GetVariable(iv)->GetOffset();
-        unsigned int in = GetVariable(iv)->GetDOF();
-        if (GetVariable(iv)->IsActive()) {
+    for (unsigned int iv = 0; iv < variables.size(); iv++) {
+        unsigned int io = variables[iv]->GetOffset();
+        unsigned int in = variables[iv]->GetDOF();
+        if (variables[iv]->IsActive()) {
             for (unsigned int r = 0; r < in; r++) {
-                result(io + r) += KRM(kio + r, kio + r);
+                result(io + r) += H(kio + r, kio + r);
             }
             //// RADU: using Eigen as below leads to *noticeable* performance drop!
             ////result.segment(io, in) += KRM.diagonal().segment(kio, in);
@@ -96,6 +104,22 @@ void ChKRMBlock::DiagonalAdd(ChVectorRef result) const {
     }
 }
 
+void ChKRMBlock::AddMatrixTimesVectorInto(ChVectorRef result, ChVectorConstRef vect) const {
+    AddProduct(variables, KRM, result, vect);
+}
+
+void ChKRMBlock::AddMatrixTimesVectorInto(ChVectorRef result, ChVectorConstRef vect, ChMatrixConstRef H) const {
+    AddProduct(variables, H, result, vect);
+}
+
+void ChKRMBlock::DiagonalAdd(ChVectorRef result) const {
+    AddDiagonal(variables, KRM, result);
+}
+
+void ChKRMBlock::DiagonalAdd(ChVectorRef result, ChMatrixConstRef H) const {
+    AddDiagonal(variables, H, result);
+}
+
 void ChKRMBlock::PasteMatrixInto(ChSparseMatrix& mat,
                                  unsigned int start_row,
                                  unsigned int start_col,
@@ -51,18 +51,36 @@ class ChApi ChKRMBlock {
     ChVariables* GetVariable(unsigned int m) const { return variables[m]; }
 
     /// Access the KRM matrix as a single block, corresponding to the referenced ChVariable objects.
-    ChMatrixRef GetMatrix() { return KRM; }
+    /// If the matrix was released (see ReleaseMatrix), it is reallocated.
+    ChMatrixRef GetMatrix() {
+        if (KRM.size() == 0 && !variables.empty())
+            SetVariables(variables);
+        return KRM;
+    }
+
+    /// Release the memory used by the KRM matrix.
+    /// Used when products with the KRM matrix are evaluated on the fly (see ChSystemDescriptor::EnableMatrixFreeKRM).
+    void ReleaseMatrix() { KRM.resize(0, 0); }
 
     /// Add the product of the block matrix by a given vector and add to result.
     /// Note: 'result' and 'vect' are system-level vectors of appropriate size. This function must index into these
     /// vectors using the offsets of the associated variables variable.
     void AddMatrixTimesVectorInto(ChVectorRef result, ChVectorConstRef vect) const;
 
+    /// Add the product of the given matrix by a given vector and add to result.
+    /// The matrix H replaces the KRM matrix of this block and must have the same size; this allows evaluating products
+    /// with a matrix computed on the fly, without storing it.
+    void AddMatrixTimesVectorInto(ChVectorRef result, ChVectorConstRef vect, ChMatrixConstRef H) const;
+
     /// Add the diagonal of the stiffness matrix block(s) as a column vector to 'result'.
     /// NOTE: the 'result' vector must already have the size of system unknowns, ie the size of the total variables &
     /// constraints in the system; the procedure will use the ChVariable offsets (that must be already updated).
     void DiagonalAdd(ChVectorRef result) const;
 
+    /// Add the diagonal of the given matrix as a column vector to 'result'.
+    /// The matrix H replaces the KRM matrix of this block and must have the same size.
+    void DiagonalAdd(ChVectorRef result, ChMatrixConstRef H) const;
+
     /// Write the KRM matrix into the specified global matrix at the offsets of the referenced ChVariable objects.
     /// Additional offsets can be specified to place the submatrix into a different position of the global matrix.
     /// If the ovewrite parameters is set to true, the submatrix overwrites the existing values in the global matrix,
@@ -36,6 +36,7 @@ class ChSolver_Type_enum_mapper : public ChSolver {
     CH_ENUM_VAL(Type::MINRES);
     CH_ENUM_VAL(Type::BICGSTAB);
     CH_ENUM_VAL(Type::CUSTOM);
+    CH_ENUM_VAL(Type::SPARSE_CHOLESKY);
     CH_ENUM_MAPPER_END(Type);
 };
 
@@ -45,16 +45,18 @@ class ChApi ChSolver {
         APGD,             ///< Accelerated Projected Gradient Descent
         ADMM,             ///< Alternating Direction Method of Multipliers
         // Direct linear solvers
-        SPARSE_LU,    ///< Sparse supernodal LU factorization
-        SPARSE_QR,    ///< Sparse left-looking rank-revealing QR factorization
-        PARDISO_MKL,  ///< Pardiso MKL (super-nodal sparse direct solver)
-        MUMPS,        ///< Mumps (MUltifrontal Massively Parallel sparse direct Solver)
+        SPARSE_LU,        ///< Sparse supernodal LU factorization
+        SPARSE_QR,        ///< Sparse left-looking rank-revealing QR factorization
+        PARDISO_MKL,      ///< Pardiso MKL (super-nodal sparse direct solver)
+        MUMPS,            ///< Mumps (MUltifrontal Massively Parallel sparse direct Solver)
         // Iterative linear solvers
         GMRES,     ///< Generalized Minimal RESidual Algorithm
         MINRES,    ///< MINimum RESidual method
         BICGSTAB,  ///< Bi-conjugate gradient stabilized
         // Other
         CUSTOM,
+        // Direct linear solvers (appended, to preserve the values of the other types)
+        SPARSE_CHOLESKY,  ///< Sparse supernodal LDL^T factorization (symmetric matrices)
     };
 
     virtual ~ChSolver() {}
@@ -62,6 +64,10 @@ class ChApi ChSolver {
     /// Return type of the solver.
     virtual Type GetType() const { return Type::CUSTOM; }
 
+    /// Return a new solver of the same type and with the same settings, or nullptr if not supported.
+    /// Used to solve independent subproblems concurrently (see ChSystem::EnableSolverIslands).
+    virtual ChSolver* Clone() const { return nullptr; }
+
     /// Return true if iterative solver.
     virtual bool IsIterative() const = 0;
 
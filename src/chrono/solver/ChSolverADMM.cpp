@@ -163,11 +163,15 @@ double ChSolverADMM::_SolveBasic(ChSystemDescriptor& sysd) {
 
     ChVectorDynamic<> S(nc);
 
+    // Compute diagonal values of N (needed by the preconditioner), only mass effect, neglecting stiffness for the
+    // moment, TODO:  g_i=[Cq_i]*[invM_i]*[Cq_i]'
+    // If enabled, pack the constraints in the flattened representation (used in the projections)
+    if (this->precond)
+        sysd.UpdateConstraintsAuxiliary();
+    else
+        sysd.UpdateFlatConstraints();
+
     if (this->precond == true) {
-        // Compute diagonal values of N , only mass effect, neglecting stiffness for the moment, TODO
-        //  g_i=[Cq_i]*[invM_i]*[Cq_i]'
-        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-            mconstraints[ic]->Update_auxiliary();
 
         // Average all g_i for the triplet of contact constraints n,u,v.
         int j_friction_comp = 0;
@@ -576,11 +580,15 @@ double ChSolverADMM::_SolveFast(ChSystemDescriptor& sysd) {
 
     ChVectorDynamic<> S(nc);
 
+    // Compute diagonal values of N (needed by the preconditioner), only mass effect, neglecting stiffness for the
+    // moment, TODO:  g_i=[Cq_i]*[invM_i]*[Cq_i]'
+    // If enabled, pack the constraints in the flattened representation (used in the projections)
+    if (this->precond)
+        sysd.UpdateConstraintsAuxiliary();
+    else
+        sysd.UpdateFlatConstraints();
+
     if (this->precond == true) {
-        // Compute diagonal values of N , only mass effect, neglecting stiffness for the moment, TODO
-        //  g_i=[Cq_i]*[invM_i]*[Cq_i]'
-        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-            mconstraints[ic]->Update_auxiliary();
 
         // Average all g_i for the triplet of contact constraints n,u,v.
         int j_friction_comp = 0;
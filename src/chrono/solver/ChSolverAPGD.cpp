@@ -79,8 +79,8 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
 
     // Update auxiliary data in all constraints before starting,
     // that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-        mconstraints[ic]->Update_auxiliary();
+    // (if enabled, this packs the constraint data in the flattened representation)
+    sysd.UpdateConstraintsAuxiliary();
 
     double L, t;
     double theta;
@@ -120,9 +120,7 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
 
     // (1) gamma_0 = zeros(nc,1)
     if (m_warm_start) {
-        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-            if (mconstraints[ic]->IsActive())
-                mconstraints[ic]->IncrementState(mconstraints[ic]->GetLagrangeMultiplier());
+        sysd.IncrementVariablesState();
     } else {
         for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
             mconstraints[ic]->SetLagrangeMultiplier(0.);
@@ -158,8 +156,10 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
     for (m_iterations = 0; m_iterations < m_max_iterations; m_iterations++) {
         // (8) g = N * y_k - r
         // (9) gamma_(k+1) = ProjectionOperator(y_k - t_k * g)
+        // (the gradient g also enters the step-size test and the restart test below, so it must include r)
         sysd.SchurComplementProduct(g, y);  // g = N * y
-        gammaNew = y - t * (g + r);
+        g += r;                             // g = N * y + r
+        gammaNew = y - t * g;
         sysd.ConstraintsProject(gammaNew);
 
         // (10) while 0.5 * gamma_(k+1)' * N * gamma_(k+1) - gamma_(k+1)' * r >=
@@ -244,10 +244,7 @@ double ChSolverAPGD::Solve(ChSystemDescriptor& sysd) {
     sysd.FromVectorToVariables(Minvk);
 
     // ... + (M^-1)*D*l     (this increment and also stores 'qb' in the ChVariable items)
-    for (size_t ic = 0; ic < mconstraints.size(); ic++) {
-        if (mconstraints[ic]->IsActive())
-            mconstraints[ic]->IncrementState(mconstraints[ic]->GetLagrangeMultiplier());
-    }
+    sysd.IncrementVariablesState();
 
     return residual;
 }
@@ -34,6 +34,8 @@ class ChApi ChSolverAPGD : public ChIterativeSolverVI {
 
     virtual Type GetType() const override { return Type::APGD; }
 
+    virtual ChSolverAPGD* Clone() const override { return new ChSolverAPGD(*this); }
+
     /// Performs the solution of the problem.
     virtual double Solve(ChSystemDescriptor& sysd) override;
 
@@ -25,7 +25,7 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraints();
     std::vector<ChVariables*>& mvariables = sysd.GetVariables();
 
-    if (sysd.GetKRMBlocks().size() > 0) {
+    if (sysd.GetKRMBlocks().size() > 0 || sysd.GetKRMOperators().size() > 0) {
         std::cerr << "\n\nChSolverBB: Can NOT use Barzilai-Borwein solver if there are stiffness matrices."
                   << std::endl;
         throw std::runtime_error("ChSolverBB: Do NOT use Barzilai-Borwein solver if there are stiffness matrices.");
@@ -68,8 +68,8 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
 
     // Update auxiliary data in all constraints before starting,
     // that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-        mconstraints[ic]->Update_auxiliary();
+    // (if enabled, this packs the constraint data in the flattened representation)
+    sysd.UpdateConstraintsAuxiliary();
 
     // Average all g_i for the triplet of contact constraints n,u,v.
     //  Can be used for the fixed point phase and/or by preconditioner.
@@ -339,10 +339,7 @@ double ChSolverBB::Solve(ChSystemDescriptor& sysd) {
     sysd.FromVectorToVariables(mq);
 
     // ... + (M^-1)*D*l     (this increment and also stores 'qb' in the ChVariable items)
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
-        if (mconstraints[ic]->IsActive())
-            mconstraints[ic]->IncrementState(mconstraints[ic]->GetLagrangeMultiplier());
-    }
+    sysd.IncrementVariablesState();
 
     if (verbose)
         std::cout << "-----" << std::endl;
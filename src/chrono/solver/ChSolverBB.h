@@ -36,6 +36,8 @@ class ChApi ChSolverBB : public ChIterativeSolverVI {
 
     virtual Type GetType() const override { return Type::BARZILAIBORWEIN; }
 
+    virtual ChSolverBB* Clone() const override { return new ChSolverBB(*this); }
+
     /// Performs the solution of the problem.
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
@@ -35,6 +35,8 @@ class ChApi ChSolverPJacobi : public ChIterativeSolverVI {
 
     virtual Type GetType() const override { return Type::PJACOBI; }
 
+    virtual ChSolverPJacobi* Clone() const override { return new ChSolverPJacobi(*this); }
+
     /// Performs the solution of the problem.
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
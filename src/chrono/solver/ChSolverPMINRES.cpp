@@ -30,7 +30,7 @@ double ChSolverPMINRES::Solve(ChSystemDescriptor& sysd) {
 
     // If stiffness blocks are used, the Schur complement cannot be esily
     // used, so fall back to the Solve_SupportingStiffness method, that operates on KKT.
-    if (sysd.GetKRMBlocks().size() > 0)
+    if (sysd.GetKRMBlocks().size() > 0 || sysd.GetKRMOperators().size() > 0)
         return this->Solve_SupportingStiffness(sysd);
 
     // Allocate auxiliary vectors;
@@ -56,8 +56,8 @@ double ChSolverPMINRES::Solve(ChSystemDescriptor& sysd) {
 
     // Update auxiliary data in all constraints before starting,
     // that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
-        mconstraints[ic]->Update_auxiliary();
+    // (if enabled, this packs the constraint data in the flattened representation)
+    sysd.UpdateConstraintsAuxiliary();
 
     // Average all g_i for the triplet of contact constraints n,u,v.
     //  Can be used as diagonal preconditioner.
@@ -271,10 +271,7 @@ double ChSolverPMINRES::Solve(ChSystemDescriptor& sysd) {
     sysd.FromVectorToVariables(mq);
 
     // ... + (M^-1)*D*l     (this increment and also stores 'qb' in the ChVariable items)
-    for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
-        if (mconstraints[ic]->IsActive())
-            mconstraints[ic]->IncrementState(mconstraints[ic]->GetLagrangeMultiplier());
-    }
+    sysd.IncrementVariablesState();
 
     if (verbose)
         std::cout << "-----" << std::endl;
@@ -43,6 +43,8 @@ CH_DEPRECATED("deprecated. Use ChSolverMINRES instead.")
 
     virtual Type GetType() const override { return Type::PMINRES; }
 
+    virtual ChSolverPMINRES* Clone() const override { return new ChSolverPMINRES(*this); }
+
     /// Performs the solution of the problem.
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
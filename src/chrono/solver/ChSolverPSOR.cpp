@@ -12,6 +12,9 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "chrono/solver/ChSolverPSOR.h"
 
 namespace chrono {
@@ -20,9 +23,18 @@ namespace chrono {
 CH_FACTORY_REGISTER(ChSolverPSOR)
 CH_UPCASTING(ChSolverPSOR, ChIterativeSolverVI)
 
-ChSolverPSOR::ChSolverPSOR() : maxviolation(0) {}
+ChSolverPSOR::ChSolverPSOR() : maxviolation(0), m_coloring(false) {}
 
 double ChSolverPSOR::Solve(ChSystemDescriptor& sysd) {
+    if (m_coloring)
+        return SolveColored(sysd);
+
+    m_colors.clear();
+    m_uncolored.clear();
+
+    if (sysd.UseFlatConstraints())
+        return SolveFlat(sysd);
+
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraints();
     std::vector<ChVariables*>& mvariables = sysd.GetVariables();
 
@@ -210,4 +222,386 @@ double ChSolverPSOR::Solve(ChSystemDescriptor& sysd) {
     return maxviolation;
 }
 
+// -----------------------------------------------------------------------------
+// Serial variant on flattened constraint data
+// -----------------------------------------------------------------------------
+
+double ChSolverPSOR::SolveFlat(ChSystemDescriptor& sysd) {
+    std::vector<ChVariables*>& mvariables = sysd.GetVariables();
+
+    m_iterations = 0;
+    maxviolation = 0;
+    double maxdeltalambda = 0.;
+
+    // 1)  Pack the constraint data, including g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+    sysd.UpdateFlatConstraints();
+    ChFlatConstraints& fc = sysd.GetFlatConstraints();
+    ChVectorDynamic<>& l = fc.l;
+
+    // Average all g_i for the triplet of contact constraints n,u,v.
+    for (const auto& block : fc.blocks) {
+        if (block.size == 3) {
+            int i = block.start;
+            double average_g_i = (fc.g(i) + fc.g(i + 1) + fc.g(i + 2)) / 3.0;
+            fc.g.segment(i, 3).setConstant(average_g_i);
+        }
+    }
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system, and load it in the global vector q
+    for (unsigned int iv = 0; iv < mvariables.size(); iv++) {
+        if (mvariables[iv]->IsActive())
+            mvariables[iv]->ComputeMassInverseTimesVector(mvariables[iv]->State(), mvariables[iv]->Force());  // q = [M]'*fb
+    }
+
+    ChVectorDynamic<> qvec;
+    sysd.FromVariablesToVector(qvec);
+    double* q = qvec.data();
+
+    // 3)  Add the effect of initial (guessed) lagrangian reactions of constraints, if a warm start is desired.
+    //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
+    if (m_warm_start) {
+        for (int i = 0; i < fc.GetNumConstraints(); i++)
+            fc.IncrementVector(i, l(i), q);
+    } else {
+        l.setZero();
+    }
+
+    // 4)  Perform the iteration loops
+    std::fill(violation_history.begin(), violation_history.end(), 0.0);
+    std::fill(dlambda_history.begin(), dlambda_history.end(), 0.0);
+
+    double old_lambda[3];
+
+    for (int iter = 0; iter < m_max_iterations; iter++) {
+        maxviolation = 0;
+        maxdeltalambda = 0;
+
+        for (const auto& block : fc.blocks) {
+            int i = block.start;
+            double candidate_violation;
+
+            // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i  and update  lambda += delta_lambda
+            for (int k = 0; k < block.size; k++) {
+                double mresidual = fc.JacobianTimesVector(i + k, q) + fc.b(i + k) + fc.cfm(i + k) * l(i + k);
+                if (k == 0) {
+                    if (block.size == 3 || fc.constraints[i]->GetMode() == ChConstraint::Mode::UNILATERAL)
+                        candidate_violation = std::abs(std::min(0.0, mresidual));
+                    else
+                        candidate_violation = std::abs(fc.constraints[i]->Violation(mresidual));
+                }
+                old_lambda[k] = l(i + k);
+                l(i + k) += (m_omega / fc.g(i + k)) * (-mresidual);
+            }
+
+            // project onto admissible set (for a friction triplet, the N,U,V components are projected together)
+            fc.ProjectBlock(block, l.data());
+
+            // apply the smoothing and increment the variables by  [invM]*[Cq_i]'*delta_lambda
+            for (int k = 0; k < block.size; k++) {
+                if (m_shlambda != 1.0)
+                    l(i + k) = m_shlambda * l(i + k) + (1.0 - m_shlambda) * old_lambda[k];
+                double true_delta = l(i + k) - old_lambda[k];
+                fc.IncrementVector(i + k, true_delta, q);
+                maxdeltalambda = std::max(maxdeltalambda, std::abs(true_delta));
+            }
+
+            maxviolation = std::max(maxviolation, candidate_violation);
+        }
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        m_iterations++;
+
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < m_tolerance)
+            break;
+    }
+
+    // Copy the solution back to the variables and constraints
+    sysd.FromVectorToVariables(qvec);
+    fc.ScatterMultipliers();
+
+    return maxviolation;
+}
+
+// -----------------------------------------------------------------------------
+// Graph-colored multithreaded variant
+// -----------------------------------------------------------------------------
+
+void ChSolverPSOR::ColorConstraints(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraints();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariables();
+
+    // Collect active constraints and group them in blocks (friction triplets are always relaxed together)
+    m_active.clear();
+    for (auto constr : mconstraints) {
+        if (constr->IsActive())
+            m_active.push_back(constr);
+    }
+
+    std::vector<Block> blocks;
+    unsigned int num_active = (unsigned int)m_active.size();
+    for (unsigned int ic = 0; ic < num_active;) {
+        unsigned int size = 1;
+        if (m_active[ic]->GetMode() == ChConstraint::Mode::FRICTION && ic + 2 < num_active &&
+            m_active[ic + 1]->GetMode() == ChConstraint::Mode::FRICTION &&
+            m_active[ic + 2]->GetMode() == ChConstraint::Mode::FRICTION)
+            size = 3;
+        blocks.push_back({ic, size});
+        ic += size;
+    }
+
+    // Index the active variables (inactive variables, e.g. fixed bodies, are never modified and do not create
+    // dependencies between constraints)
+    std::unordered_map<const ChVariables*, unsigned int> var_index;
+    for (auto var : mvariables) {
+        if (var->IsActive())
+            var_index.emplace(var, (unsigned int)var_index.size());
+    }
+
+    // Greedy coloring, processing the blocks in descriptor order (deterministic).
+    // For each variable, keep the list of colors already assigned to blocks acting on it.
+    std::vector<std::vector<unsigned int>> var_colors(var_index.size());
+    std::vector<size_t> forbidden;  // stamp (block index + 1) of the last block for which a color was forbidden
+    std::vector<unsigned int> block_vars;
+    std::vector<ChVariables*> vars;
+
+    m_colors.clear();
+    m_uncolored.clear();
+
+    for (size_t ib = 0; ib < blocks.size(); ib++) {
+        const Block& block = blocks[ib];
+
+        vars.clear();
+        for (unsigned int k = 0; k < block.size; k++)
+            m_active[block.start + k]->GetVariablesList(vars);
+
+        // Constraints that do not report their variables cannot be safely relaxed in parallel
+        if (vars.empty()) {
+            m_uncolored.push_back(block);
+            continue;
+        }
+
+        block_vars.clear();
+        for (auto var : vars) {
+            auto it = var_index.find(var);
+            if (it != var_index.end())
+                block_vars.push_back(it->second);
+        }
+
+        for (auto iv : block_vars) {
+            for (auto color : var_colors[iv])
+                forbidden[color] = ib + 1;
+        }
+
+        unsigned int color = 0;
+        while (color < forbidden.size() && forbidden[color] == ib + 1)
+            color++;
+        if (color == forbidden.size()) {
+            forbidden.push_back(0);
+            m_colors.push_back(std::vector<Block>());
+        }
+
+        m_colors[color].push_back(block);
+        for (auto iv : block_vars) {
+            if (std::find(var_colors[iv].begin(), var_colors[iv].end(), color) == var_colors[iv].end())
+                var_colors[iv].push_back(color);
+        }
+    }
+}
+
+double ChSolverPSOR::RelaxBlock(const Block& block, double& maxdeltalambda) const {
+    ChConstraint* const* c = &m_active[block.start];
+    double candidate_violation = 0;
+
+    if (block.size == 3) {
+        // Friction triplet N,U,V
+        double old_lambda[3];
+        for (int k = 0; k < 3; k++) {
+            // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+            double mresidual = c[k]->ComputeJacobianTimesState() + c[k]->GetRightHandSide() +
+                               c[k]->GetComplianceTerm() * c[k]->GetLagrangeMultiplier();
+            if (k == 0)
+                candidate_violation = fabs(std::min(0.0, mresidual));
+
+            // update:   lambda += delta_lambda;
+            double deltal = (m_omega / c[k]->GetSchurComplement()) * (-mresidual);
+            old_lambda[k] = c[k]->GetLagrangeMultiplier();
+            c[k]->SetLagrangeMultiplier(old_lambda[k] + deltal);
+        }
+
+        c[0]->Project();  // the N normal component will take care of N,U,V
+
+        for (int k = 0; k < 3; k++) {
+            double new_lambda = c[k]->GetLagrangeMultiplier();
+            if (m_shlambda != 1.0) {
+                new_lambda = m_shlambda * new_lambda + (1.0 - m_shlambda) * old_lambda[k];
+                c[k]->SetLagrangeMultiplier(new_lambda);
+            }
+            double true_delta = new_lambda - old_lambda[k];
+            c[k]->IncrementState(true_delta);
+            maxdeltalambda = std::max(maxdeltalambda, fabs(true_delta));
+        }
+
+        return candidate_violation;
+    }
+
+    // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+    double mresidual = c[0]->ComputeJacobianTimesState() + c[0]->GetRightHandSide() +
+                       c[0]->GetComplianceTerm() * c[0]->GetLagrangeMultiplier();
+
+    if (c[0]->GetMode() == ChConstraint::Mode::UNILATERAL)
+        candidate_violation = fabs(std::min(0.0, mresidual));
+    else
+        candidate_violation = fabs(c[0]->Violation(mresidual));
+
+    // update:   lambda += delta_lambda;
+    double deltal = (m_omega / c[0]->GetSchurComplement()) * (-mresidual);
+    double old_lambda = c[0]->GetLagrangeMultiplier();
+    c[0]->SetLagrangeMultiplier(old_lambda + deltal);
+    c[0]->Project();
+
+    double new_lambda = c[0]->GetLagrangeMultiplier();
+    if (m_shlambda != 1.0) {
+        new_lambda = m_shlambda * new_lambda + (1.0 - m_shlambda) * old_lambda;
+        c[0]->SetLagrangeMultiplier(new_lambda);
+    }
+
+    double true_delta = new_lambda - old_lambda;
+    c[0]->IncrementState(true_delta);
+    maxdeltalambda = std::max(maxdeltalambda, fabs(true_delta));
+
+    return candidate_violation;
+}
+
+double ChSolverPSOR::SolveColored(ChSystemDescriptor& sysd) {
+    std::vector<ChVariables*>& mvariables = sysd.GetVariables();
+    int nthreads = sysd.GetNumThreads();
+
+    m_iterations = 0;
+    maxviolation = 0;
+
+    // 0)  Partition the active constraints in independent sets
+    ColorConstraints(sysd);
+
+    int num_active = (int)m_active.size();
+    int num_variables = (int)mvariables.size();
+
+    // 1)  Update auxiliary data in all constraints before starting,
+    //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+#pragma omp parallel for num_threads(nthreads)
+    for (int ic = 0; ic < num_active; ic++)
+        m_active[ic]->Update_auxiliary();
+
+    // Average all g_i for the triplet of contact constraints n,u,v.
+    auto average_gi = [this](const Block& block) {
+        if (block.size == 3) {
+            ChConstraint** c = &m_active[block.start];
+            double average_g_i =
+                (c[0]->GetSchurComplement() + c[1]->GetSchurComplement() + c[2]->GetSchurComplement()) / 3.0;
+            c[0]->SetSchurComplement(average_g_i);
+            c[1]->SetSchurComplement(average_g_i);
+            c[2]->SetSchurComplement(average_g_i);
+        }
+    };
+    for (const auto& blocks : m_colors) {
+        int num_blocks = (int)blocks.size();
+#pragma omp parallel for num_threads(nthreads)
+        for (int ib = 0; ib < num_blocks; ib++)
+            average_gi(blocks[ib]);
+    }
+    for (const auto& block : m_uncolored)
+        average_gi(block);
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system:
+#pragma omp parallel for num_threads(nthreads)
+    for (int iv = 0; iv < num_variables; iv++) {
+        if (mvariables[iv]->IsActive())
+            mvariables[iv]->ComputeMassInverseTimesVector(mvariables[iv]->State(), mvariables[iv]->Force());
+    }
+
+    // 3)  For all items with variables, add the effect of initial (guessed)
+    //     lagrangian reactions of constraints, if a warm start is desired.
+    //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
+    if (m_warm_start) {
+        auto warm_start = [this](const Block& block) {
+            for (unsigned int k = 0; k < block.size; k++) {
+                ChConstraint* c = m_active[block.start + k];
+                c->IncrementState(c->GetLagrangeMultiplier());
+            }
+        };
+        for (const auto& blocks : m_colors) {
+            int num_blocks = (int)blocks.size();
+#pragma omp parallel for num_threads(nthreads)
+            for (int ib = 0; ib < num_blocks; ib++)
+                warm_start(blocks[ib]);
+        }
+        for (const auto& block : m_uncolored)
+            warm_start(block);
+    } else {
+        for (auto constr : sysd.GetConstraints())
+            constr->SetLagrangeMultiplier(0.);
+    }
+
+    // 4)  Perform the iteration loops
+    //     Blocks of the same color do not share variables and are relaxed concurrently.
+    std::fill(violation_history.begin(), violation_history.end(), 0.0);
+    std::fill(dlambda_history.begin(), dlambda_history.end(), 0.0);
+
+    for (int iter = 0; iter < m_max_iterations; iter++) {
+        double iter_violation = 0;
+        double iter_deltalambda = 0;
+
+        for (const auto& blocks : m_colors) {
+            int num_blocks = (int)blocks.size();
+#pragma omp parallel for num_threads(nthreads) reduction(max : iter_violation, iter_deltalambda)
+            for (int ib = 0; ib < num_blocks; ib++) {
+                double violation = RelaxBlock(blocks[ib], iter_deltalambda);
+                iter_violation = std::max(iter_violation, violation);
+            }
+        }
+
+        for (const auto& block : m_uncolored) {
+            double violation = RelaxBlock(block, iter_deltalambda);
+            iter_violation = std::max(iter_violation, violation);
+        }
+
+        maxviolation = iter_violation;
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, iter_deltalambda, iter);
+
+        m_iterations++;
+
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < m_tolerance)
+            break;
+    }
+
+    return maxviolation;
+}
+
+void ChSolverPSOR::ArchiveOut(ChArchiveOut& archive_out) {
+    // version number
+    archive_out.VersionWrite<ChSolverPSOR>();
+    // serialize parent class
+    ChIterativeSolverVI::ArchiveOut(archive_out);
+    // serialize all member data:
+    archive_out << CHNVP(m_coloring);
+}
+
+void ChSolverPSOR::ArchiveIn(ChArchiveIn& archive_in) {
+    // version number
+    /*int version =*/archive_in.VersionRead<ChSolverPSOR>();
+    // deserialize parent class
+    ChIterativeSolverVI::ArchiveIn(archive_in);
+    // stream in all member data:
+    archive_in >> CHNVP(m_coloring);
+}
+
 }  // end namespace chrono
@@ -24,6 +24,10 @@ namespace chrono {
 
 /// An iterative solver based on projective fixed point method, with overrelaxation and immediate variable update as in
 /// SOR methods.\n
+/// Optionally, the constraints can be partitioned with a graph coloring such that constraints of the same color do not
+/// share any active ChVariables; each color is then relaxed in parallel (see EnableGraphColoring).\n
+/// If the system descriptor uses the flattened constraint representation (see
+/// ChSystemDescriptor::EnableFlatConstraints), the serial sweep operates on the packed constraint buffers.\n
 /// See ChSystemDescriptor for more information about the problem formulation and the data structures passed to the
 /// solver.
 
@@ -35,6 +39,8 @@ class ChApi ChSolverPSOR : public ChIterativeSolverVI {
 
     virtual Type GetType() const override { return Type::PSOR; }
 
+    virtual ChSolverPSOR* Clone() const override { return new ChSolverPSOR(*this); }
+
     /// Performs the solution of the problem.
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
@@ -44,8 +50,51 @@ class ChApi ChSolverPSOR : public ChIterativeSolverVI {
     /// For the PSOR solver, this is the maximum constraint violation.
     virtual double GetError() const override { return maxviolation; }
 
+    /// Enable/disable the multithreaded graph-colored variant of the solver (default: false).
+    /// If enabled, constraints (with friction triplets kept together) are greedily colored so that no two constraints
+    /// of the same color act on the same active variables. Colors are processed in sequence, while the constraints of
+    /// a color are relaxed in parallel using the number of threads set in the system descriptor. The coloring depends
+    /// only on the order of the constraints in the descriptor, so results do not depend on the number of threads (they
+    /// do differ from the serial PSOR results, since the relaxation order is different).
+    void EnableGraphColoring(bool val) { m_coloring = val; }
+
+    /// Return true if the graph-colored variant of the solver is used.
+    bool IsGraphColoringEnabled() const { return m_coloring; }
+
+    /// Return the number of colors used during the last solve (0 if graph coloring is disabled).
+    unsigned int GetNumColors() const { return (unsigned int)m_colors.size(); }
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOut(ChArchiveOut& archive_out) override;
+
+    /// Method to allow de-serialization of transient data from archives.
+    virtual void ArchiveIn(ChArchiveIn& archive_in) override;
+
   private:
+    /// Group of consecutive active constraints relaxed as a unit (a single constraint or a friction triplet).
+    struct Block {
+        unsigned int start;  ///< index of first constraint in the list of active constraints
+        unsigned int size;   ///< number of constraints (1 or 3)
+    };
+
+    /// Perform the multithreaded graph-colored solution.
+    double SolveColored(ChSystemDescriptor& sysd);
+
+    /// Perform the serial solution using the flattened constraint representation.
+    double SolveFlat(ChSystemDescriptor& sysd);
+
+    /// Partition the active constraints in blocks and color the blocks.
+    void ColorConstraints(ChSystemDescriptor& sysd);
+
+    /// Relax the constraints in the given block and return the block violation.
+    double RelaxBlock(const Block& block, double& maxdeltalambda) const;
+
     double maxviolation;
+
+    bool m_coloring;                           ///< use the graph-colored variant
+    std::vector<ChConstraint*> m_active;       ///< list of active constraints
+    std::vector<std::vector<Block>> m_colors;  ///< constraint blocks, grouped by color
+    std::vector<Block> m_uncolored;            ///< blocks with unknown connectivity (relaxed serially)
 };
 
 /// @} chrono_solver
@@ -40,6 +40,8 @@ CH_DEPRECATED("deprecated. Use ChSolverPSOR, ChSolverBB, or ChSolverAPGD instead
 
     virtual Type GetType() const override { return Type::PSSOR; }
 
+    virtual ChSolverPSSOR* Clone() const override { return new ChSolverPSSOR(*this); }
+
     /// Performs the solution of the problem.
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
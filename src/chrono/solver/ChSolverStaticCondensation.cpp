@@ -0,0 +1,442 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "chrono/solver/ChSolverStaticCondensation.h"
+#include "chrono/utils/ChTraceProfiler.h"
+
+namespace chrono {
+
+// Interior rows of a substructure, with the factorization of their block and the contribution to the interface system.
+struct ChSolverStaticCondensation::Domain {
+    std::vector<int> rows;      // interior rows (sorted)
+    std::vector<int> boundary;  // coupled interface rows, as indices in the interface system (sorted)
+
+    ChSparseMatrix A_dd;               // interior block
+    ChSparseMatrix A_dB;               // coupling block (interior rows, boundary columns)
+    std::vector<int> map_dd;           // matrix nonzero of each A_dd nonzero
+    std::vector<int> map_dB;           // matrix nonzero of each A_dB nonzero
+    std::vector<ptrdiff_t> schur_pos;  // position in S of each entry of the (dense) boundary clique
+
+    ChSupernodalLDLT engine;  // factorization of A_dd
+    bool factorized = false;  // is there a valid factorization?
+    Eigen::VectorXd ref;      // values of A_dd and A_dB at the last factorization
+    Eigen::MatrixXd S_d;      // A_dB^T * A_dd^-1 * A_dB
+};
+
+// Position of the element (row, col) in the compressed row-major matrix, or -1 if not a nonzero.
+static ptrdiff_t FindEntry(const ChSparseMatrix& M, int row, int col) {
+    const int* begin = M.innerIndexPtr() + M.outerIndexPtr()[row];
+    const int* end = M.innerIndexPtr() + M.outerIndexPtr()[row + 1];
+    const int* it = std::lower_bound(begin, end, col);
+    return (it != end && *it == col) ? it - M.innerIndexPtr() : -1;
+}
+
+// Build a compressed matrix with the given nonzeros and return, for each of its nonzeros, the associated source index.
+static void BuildBlock(ChSparseMatrix& M,
+                       int rows,
+                       int cols,
+                       const std::vector<Eigen::Triplet<double>>& entries,
+                       std::vector<int>& map) {
+    // Tag each element with its source index (exact in double precision); no element is repeated
+    M.resize(rows, cols);
+    M.setFromTriplets(entries.begin(), entries.end());
+    M.makeCompressed();
+    map.resize(M.nonZeros());
+    for (int k = 0; k < (int)M.nonZeros(); k++)
+        map[k] = (int)M.valuePtr()[k];
+}
+
+ChSolverStaticCondensation::ChSolverStaticCondensation()
+    : m_num_threads(0),
+      m_sysd_threads(1),
+      m_num_vars(-1),
+      m_reuse_tol(0),
+      m_analyzed(false),
+      m_failed_domain(-1),
+      m_failed_schur(false),
+      m_num_factorized(0),
+      m_num_reused(0) {
+    m_symmetry = MatrixSymmetryType::SYMMETRIC_INDEF;
+    m_reuse_analysis = true;
+}
+
+ChSolverStaticCondensation::~ChSolverStaticCondensation() {}
+
+void ChSolverStaticCondensation::SetInteriorReuseTolerance(double tol) {
+    m_reuse_tol = std::max(tol, 0.0);
+    if (m_reuse_tol > 0 && m_refine_steps < 0)
+        m_refine_steps = 10;
+}
+
+bool ChSolverStaticCondensation::Setup(ChSystemDescriptor& sysd) {
+    // Substructure of each row: variables first (at their offsets), then the active constraints
+    m_num_vars = sysd.CountActiveVariables();
+    int num_constr = sysd.CountActiveConstraints();
+    m_row_substructure.assign(m_num_vars + num_constr, -1);
+
+    const auto& vars = sysd.GetVariables();
+    const auto& vars_sub = sysd.GetVariablesSubstructure();
+    for (size_t i = 0; i < vars.size(); i++) {
+        if (vars[i]->IsActive())
+            std::fill_n(m_row_substructure.begin() + vars[i]->GetOffset(), vars[i]->GetDOF(), vars_sub[i]);
+    }
+
+    const auto& constraints = sysd.GetConstraints();
+    const auto& constraints_sub = sysd.GetConstraintsSubstructure();
+    int row = m_num_vars;
+    for (size_t i = 0; i < constraints.size(); i++) {
+        if (constraints[i]->IsActive())
+            m_row_substructure[row++] = constraints_sub[i];
+    }
+
+    m_sysd_threads = sysd.GetNumThreads();
+
+    return ChDirectSolverLS::Setup(sysd);
+}
+
+// A row of a substructure is interior if it is coupled only to rows of the same substructure. A constraint row must
+// also be coupled to at least one interior variable, otherwise its pivot in the interior block would vanish.
+void ChSolverStaticCondensation::AnalyzePartition() {
+    CH_TRACE_ZONE("AnalyzePartition");
+
+    int n = m_dim;
+    const int* outer = m_mat.outerIndexPtr();
+    const int* inner = m_mat.innerIndexPtr();
+    const double* values = m_mat.valuePtr();
+
+    std::vector<int> sub(n, -1);
+    if ((int)m_row_substructure.size() == n)
+        sub = m_row_substructure;
+    m_analyzed_rows = sub;
+
+    // Without a system descriptor, constraint rows are identified by their zero diagonal
+    int num_vars = (m_num_vars >= 0 && m_num_vars <= n) ? m_num_vars : -1;
+    std::vector<char> is_constraint(n, 0);
+    for (int i = 0; i < n; i++) {
+        if (num_vars >= 0) {
+            is_constraint[i] = (i >= num_vars);
+        } else {
+            ptrdiff_t k = FindEntry(m_mat, i, i);
+            is_constraint[i] = (k < 0 || values[k] == 0);
+        }
+    }
+
+    std::vector<char> interior(n, 0);
+    for (int i = 0; i < n; i++) {
+        if (sub[i] < 0 || is_constraint[i])
+            continue;
+        interior[i] = 1;
+        for (int k = outer[i]; k < outer[i + 1] && interior[i]; k++)
+            interior[i] = (sub[inner[k]] == sub[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        if (sub[i] < 0 || !is_constraint[i])
+            continue;
+        bool coupled = true;
+        bool has_interior = false;
+        for (int k = outer[i]; k < outer[i + 1]; k++) {
+            coupled = coupled && (sub[inner[k]] == sub[i]);
+            has_interior = has_interior || (interior[inner[k]] && inner[k] != i);
+        }
+        interior[i] = coupled && has_interior;
+    }
+
+    // Local index of each row in its substructure or in the interface system
+    std::map<int, int> domain_index;
+    std::vector<int> local(n);
+    m_domains.clear();
+    m_interface.clear();
+    for (int i = 0; i < n; i++) {
+        if (interior[i]) {
+            auto found = domain_index.emplace(sub[i], (int)m_domains.size());
+            if (found.second)
+                m_domains.push_back(chrono_types::make_unique<Domain>());
+            auto& domain = *m_domains[found.first->second];
+            local[i] = (int)domain.rows.size();
+            domain.rows.push_back(i);
+        } else {
+            local[i] = (int)m_interface.size();
+            m_interface.push_back(i);
+        }
+    }
+    int nB = (int)m_interface.size();
+
+    // Interface system pattern: interface block of the matrix and boundary cliques of all substructures
+    std::vector<Eigen::Triplet<double>> schur_entries;
+    for (int a = 0; a < nB; a++) {
+        int i = m_interface[a];
+        for (int k = outer[i]; k < outer[i + 1]; k++) {
+            if (!interior[inner[k]])
+                schur_entries.push_back({a, local[inner[k]], 0.0});
+        }
+    }
+
+    for (auto& domain_ptr : m_domains) {
+        auto& domain = *domain_ptr;
+        int nI = (int)domain.rows.size();
+
+        // Boundary rows coupled to the interior rows
+        for (int i : domain.rows) {
+            for (int k = outer[i]; k < outer[i + 1]; k++) {
+                if (!interior[inner[k]])
+                    domain.boundary.push_back(local[inner[k]]);
+            }
+        }
+        std::sort(domain.boundary.begin(), domain.boundary.end());
+        domain.boundary.erase(std::unique(domain.boundary.begin(), domain.boundary.end()), domain.boundary.end());
+        int nb = (int)domain.boundary.size();
+
+        // Interior and coupling blocks, with the matrix nonzero of each of their nonzeros
+        std::vector<Eigen::Triplet<double>> dd, dB;
+        for (int r = 0; r < nI; r++) {
+            int i = domain.rows[r];
+            for (int k = outer[i]; k < outer[i + 1]; k++) {
+                int j = inner[k];
+                if (interior[j]) {
+                    dd.push_back({r, local[j], (double)k});
+                } else {
+                    auto c = std::lower_bound(domain.boundary.begin(), domain.boundary.end(), local[j]);
+                    dB.push_back({r, (int)(c - domain.boundary.begin()), (double)k});
+                }
+            }
+        }
+        BuildBlock(domain.A_dd, nI, nI, dd, domain.map_dd);
+        BuildBlock(domain.A_dB, nI, nb, dB, domain.map_dB);
+
+        for (int a : domain.boundary)
+            for (int b : domain.boundary)
+                schur_entries.push_back({a, b, 0.0});
+
+        // Primal rows precede the constraint rows, both in the matrix and in the interior block
+        int num_primal = -1;
+        if (num_vars >= 0)
+            num_primal = (int)(std::lower_bound(domain.rows.begin(), domain.rows.end(), num_vars) - domain.rows.begin());
+
+        domain.engine.SetPositiveDefinite(false);
+        domain.engine.AnalyzePattern(domain.A_dd, num_primal);
+        domain.factorized = false;
+    }
+
+    m_schur.resize(nB, nB);
+    m_schur.setFromTriplets(schur_entries.begin(), schur_entries.end());
+    m_schur.makeCompressed();
+
+    // Positions of the matrix interface block and of the substructure contributions in the interface system
+    m_schur_map.clear();
+    for (int a = 0; a < nB; a++) {
+        int i = m_interface[a];
+        for (int k = outer[i]; k < outer[i + 1]; k++) {
+            if (!interior[inner[k]])
+                m_schur_map.push_back({k, (int)FindEntry(m_schur, a, local[inner[k]])});
+        }
+    }
+    for (auto& domain : m_domains) {
+        int nb = (int)domain->boundary.size();
+        domain->schur_pos.resize((size_t)nb * nb);
+        for (int a = 0; a < nb; a++)
+            for (int b = 0; b < nb; b++)
+                domain->schur_pos[(size_t)a * nb + b] = FindEntry(m_schur, domain->boundary[a], domain->boundary[b]);
+    }
+
+    if (nB > 0) {
+        int num_primal = -1;
+        if (num_vars >= 0)
+            num_primal = (int)(std::lower_bound(m_interface.begin(), m_interface.end(), num_vars) - m_interface.begin());
+        m_schur_engine.SetPositiveDefinite(false);
+        m_schur_engine.AnalyzePattern(m_schur, num_primal);
+    }
+
+    m_analyzed = true;
+}
+
+bool ChSolverStaticCondensation::FactorizeMatrix() {
+    m_failed_domain = -1;
+    m_failed_schur = false;
+
+    if (PatternChanged() || !m_analyzed || m_analyzed_rows.size() != (size_t)m_dim ||
+        ((int)m_row_substructure.size() == m_dim && m_row_substructure != m_analyzed_rows)) {
+        AnalyzePartition();
+    }
+
+    int num_threads = m_num_threads > 0 ? m_num_threads : m_sysd_threads;
+    int num_domains = (int)m_domains.size();
+    const double* values = m_mat.valuePtr();
+
+    // Factorize the interior blocks and compute their contributions to the interface system
+    int num_factorized = 0;
+    int num_reused = 0;
+    int failed = num_domains;
+    {
+        CH_TRACE_ZONE("FactorizeSubstructures");
+
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads) reduction(+ : num_factorized, num_reused)
+        for (int d = 0; d < num_domains; d++) {
+            auto& domain = *m_domains[d];
+            auto nnz_dd = domain.A_dd.nonZeros();
+            auto nnz_dB = domain.A_dB.nonZeros();
+
+            Eigen::VectorXd current(nnz_dd + nnz_dB);
+            for (Eigen::Index k = 0; k < nnz_dd; k++)
+                current(k) = values[domain.map_dd[k]];
+            for (Eigen::Index k = 0; k < nnz_dB; k++)
+                current(nnz_dd + k) = values[domain.map_dB[k]];
+
+            if (domain.factorized && current.size() == domain.ref.size()) {
+                double change = (current - domain.ref).lpNorm<Eigen::Infinity>();
+                if (change <= m_reuse_tol * domain.ref.lpNorm<Eigen::Infinity>()) {
+                    num_reused++;
+                    continue;
+                }
+            }
+
+            std::copy_n(current.data(), nnz_dd, domain.A_dd.valuePtr());
+            std::copy_n(current.data() + nnz_dd, nnz_dB, domain.A_dB.valuePtr());
+            domain.ref = current;
+
+            domain.factorized = domain.engine.Factorize(domain.A_dd);
+            if (!domain.factorized) {
+#pragma omp critical
+                failed = std::min(failed, d);
+                continue;
+            }
+            num_factorized++;
+
+            // S_d = A_dB^T * A_dd^-1 * A_dB, one column of the coupling block at a time
+            int nI = (int)domain.rows.size();
+            int nb = (int)domain.boundary.size();
+            Eigen::MatrixXd A_dB = domain.A_dB;
+            Eigen::MatrixXd X(nI, nb);
+            ChVectorDynamic<> col(nI);
+            ChVectorDynamic<> sol(nI);
+            for (int c = 0; c < nb; c++) {
+                col = A_dB.col(c);
+                domain.engine.Solve(col, sol);
+                X.col(c) = sol;
+            }
+            domain.S_d.noalias() = A_dB.transpose() * X;
+        }
+    }
+
+    m_num_factorized += num_factorized;
+    m_num_reused += num_reused;
+
+    if (failed < num_domains) {
+        m_failed_domain = failed;
+        return false;
+    }
+
+    if (m_interface.empty())
+        return true;
+
+    // Assemble and factorize the interface Schur complement
+    CH_TRACE_ZONE("FactorizeInterface");
+
+    double* S = m_schur.valuePtr();
+    std::fill_n(S, m_schur.nonZeros(), 0.0);
+    for (const auto& entry : m_schur_map)
+        S[entry.second] += values[entry.first];
+    for (const auto& domain : m_domains) {
+        int nb = (int)domain->boundary.size();
+        for (int a = 0; a < nb; a++)
+            for (int b = 0; b < nb; b++)
+                S[domain->schur_pos[(size_t)a * nb + b]] -= domain->S_d(a, b);
+    }
+
+    m_schur_engine.SetNumThreads(num_threads);
+    m_failed_schur = !m_schur_engine.Factorize(m_schur);
+
+    return !m_failed_schur;
+}
+
+bool ChSolverStaticCondensation::SolveSystem() {
+    int num_threads = m_num_threads > 0 ? m_num_threads : m_sysd_threads;
+    int num_domains = (int)m_domains.size();
+    int nB = (int)m_interface.size();
+
+    // Interface right-hand side: r_B = b_B - sum_d A_dB^T * A_dd^-1 * b_d
+    ChVectorDynamic<> rhs_B(nB);
+    for (int a = 0; a < nB; a++)
+        rhs_B(a) = m_rhs(m_interface[a]);
+
+    std::vector<ChVectorDynamic<>> contrib(num_domains);
+
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+    for (int d = 0; d < num_domains; d++) {
+        const auto& domain = *m_domains[d];
+        int nI = (int)domain.rows.size();
+        ChVectorDynamic<> b_d(nI);
+        ChVectorDynamic<> y_d(nI);
+        for (int r = 0; r < nI; r++)
+            b_d(r) = m_rhs(domain.rows[r]);
+        domain.engine.Solve(b_d, y_d);
+        contrib[d] = domain.A_dB.transpose() * y_d;
+    }
+
+    for (int d = 0; d < num_domains; d++) {
+        const auto& boundary = m_domains[d]->boundary;
+        for (size_t a = 0; a < boundary.size(); a++)
+            rhs_B(boundary[a]) -= contrib[d](a);
+    }
+
+    // Interface unknowns
+    ChVectorDynamic<> x_B(nB);
+    if (nB > 0)
+        m_schur_engine.Solve(rhs_B, x_B);
+    for (int a = 0; a < nB; a++)
+        m_sol(m_interface[a]) = x_B(a);
+
+    // Interior unknowns: x_d = A_dd^-1 * (b_d - A_dB * x_B)
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+    for (int d = 0; d < num_domains; d++) {
+        const auto& domain = *m_domains[d];
+        int nI = (int)domain.rows.size();
+        int nb = (int)domain.boundary.size();
+        ChVectorDynamic<> x_b(nb);
+        for (int a = 0; a < nb; a++)
+            x_b(a) = x_B(domain.boundary[a]);
+        ChVectorDynamic<> b_d(nI);
+        ChVectorDynamic<> x_d(nI);
+        for (int r = 0; r < nI; r++)
+            b_d(r) = m_rhs(domain.rows[r]);
+        b_d -= domain.A_dB * x_b;
+        domain.engine.Solve(b_d, x_d);
+        for (int r = 0; r < nI; r++)
+            m_sol(domain.rows[r]) = x_d(r);
+    }
+
+    return true;
+}
+
+void ChSolverStaticCondensation::PrintErrorMessage() {
+    if (m_failed_domain >= 0) {
+        const auto& domain = *m_domains[m_failed_domain];
+        int row = domain.engine.GetFailedRow();
+        std::cout << "Static condensation: factorization of substructure " << m_failed_domain << " failed";
+        if (row >= 0)
+            std::cout << " (row " << domain.rows[row] << ")";
+        std::cout << std::endl;
+    } else if (m_failed_schur) {
+        int row = m_schur_engine.GetFailedRow();
+        std::cout << "Static condensation: factorization of the interface system failed";
+        if (row >= 0)
+            std::cout << " (row " << m_interface[row] << ")";
+        std::cout << std::endl;
+    } else {
+        std::cout << "Static condensation: matrix does not match the symbolic analysis" << std::endl;
+    }
+}
+
+}  // end namespace chrono
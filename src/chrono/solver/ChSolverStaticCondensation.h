@@ -0,0 +1,131 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_SOLVER_STATIC_CONDENSATION_H
+#define CH_SOLVER_STATIC_CONDENSATION_H
+
+#include <memory>
+#include <vector>
+
+#include "chrono/solver/ChDirectSolverLS.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/** \class ChSolverStaticCondensation
+\brief Sparse direct solver with static condensation of substructures.
+
+The unknowns of the problem are partitioned using the substructures declared in the system descriptor (see
+ChSystemDescriptor::BeginSubstructure, ChAssembly::SetSubstructure, and ChModalAssembly). The rows of a substructure
+which are coupled only to rows of the same substructure are its \e interior unknowns; all other rows (rows coupled to
+other substructures or to the rest of the system, and rows outside any substructure) are \e interface unknowns. With
+the interior block A_dd of substructure d and its coupling A_dB with the interface unknowns, the solver:
+- factorizes each interior block A_dd (sparse LDL^T, see ChSupernodalLDLT), with all substructures processed
+  concurrently;
+- assembles the interface Schur complement S = A_BB - sum_d A_dB^T A_dd^-1 A_dB and factorizes it;
+- solves for the interface unknowns and then recovers the interior unknowns of each substructure concurrently.
+
+The factorization of a substructure (and its contribution to S) is reused as long as its interior and coupling blocks
+are unchanged, so that the Newton iterations of a step only factorize the substructures whose Jacobian changed. With a
+positive reuse tolerance (see SetInteriorReuseTolerance), the factorization is also kept for small relative changes of
+these blocks; iterative refinement, with residuals evaluated on the current matrix, then corrects the solution. Since
+the partition is analyzed again whenever the sparsity pattern changes, reuse of the symbolic analysis (see
+ReuseSymbolicAnalysis) is enabled by default for this solver.
+
+Since only the lower triangles of the interior blocks and of S are factorized, the problem matrix must be symmetric.
+Constraint rows are eliminated after the variables they couple (see ChSolverSparseCholesky). If no substructures are
+declared, all rows are interface rows and the solver reduces to a single sparse LDL^T factorization.\n
+Cannot handle VI and complementarity problems, so it cannot be used with NSC formulations.\n
+See ChDirectSolverLS for more details.
+*/
+class ChApi ChSolverStaticCondensation : public ChDirectSolverLS {
+  public:
+    ChSolverStaticCondensation();
+    ~ChSolverStaticCondensation();
+
+    virtual Type GetType() const override { return Type::CUSTOM; }
+
+    /// Set the number of threads (default: number of threads of the system descriptor).\n
+    /// Substructures are factorized and solved concurrently; the interface system uses all threads.
+    void SetNumThreads(int num_threads) { m_num_threads = num_threads; }
+
+    /// Set the relative change of the interior and coupling blocks of a substructure below which its factorization is
+    /// reused (default: 0, i.e., reuse only if unchanged).\n
+    /// The change is measured, in the max norm, relative to the blocks at the last factorization of the substructure.
+    /// If positive and iterative refinement was not set, up to 10 refinement steps are performed at each solve (see
+    /// SetIterativeRefinement).
+    void SetInteriorReuseTolerance(double tol);
+
+    /// Set the substructure of each matrix row, for use with SetupCurrent (-1 for rows outside any substructure).
+    /// The row substructures are otherwise set from the system descriptor at each call to Setup.
+    void SetRowSubstructures(const std::vector<int>& substructures) { m_row_substructure = substructures; }
+
+    /// Return the number of substructures with interior unknowns.
+    int GetNumSubstructures() const { return (int)m_domains.size(); }
+
+    /// Return the number of interface unknowns.
+    int GetNumInterfaceRows() const { return (int)m_interface.size(); }
+
+    /// Return the cumulative number of substructure factorizations.
+    unsigned int GetNumSubstructureFactorizations() const { return m_num_factorized; }
+
+    /// Return the cumulative number of reused substructure factorizations.
+    unsigned int GetNumReusedFactorizations() const { return m_num_reused; }
+
+    /// Perform the solver setup operations.
+    virtual bool Setup(ChSystemDescriptor& sysd) override;
+
+  private:
+    struct Domain;
+
+    /// Partition the matrix rows and perform the symbolic analysis of the interior blocks and of the interface system.
+    void AnalyzePartition();
+
+    /// Factorize the current sparse matrix and return true if successful.
+    virtual bool FactorizeMatrix() override;
+
+    /// Solve the linear system using the current factorization and right-hand side vector.
+    /// Load the solution vector (already of appropriate size) and return true if succesful.
+    virtual bool SolveSystem() override;
+
+    /// Display an error message corresponding to the last failure.
+    /// This function is only called if Factorize or Solve returned false.
+    virtual void PrintErrorMessage() override;
+
+    int m_num_threads;    ///< number of threads (0: use the system descriptor setting)
+    int m_sysd_threads;   ///< number of threads of the system descriptor
+    int m_num_vars;       ///< number of variable rows (-1 if unknown)
+    double m_reuse_tol;   ///< relative tolerance for the reuse of substructure factorizations
+    bool m_analyzed;      ///< was the partition analyzed?
+    int m_failed_domain;  ///< substructure with a failed factorization (-1 if none)
+    bool m_failed_schur;  ///< did the factorization of the interface system fail?
+
+    std::vector<int> m_row_substructure;             ///< substructure of each matrix row
+    std::vector<int> m_analyzed_rows;                ///< row substructures at the last analysis
+    std::vector<int> m_interface;                    ///< interface rows
+    std::vector<std::unique_ptr<Domain>> m_domains;  ///< substructures with interior rows
+
+    ChSparseMatrix m_schur;                        ///< interface Schur complement
+    std::vector<std::pair<int, int>> m_schur_map;  ///< (matrix nonzero, S nonzero) pairs of the interface block
+    ChSupernodalLDLT m_schur_engine;               ///< factorization of the interface Schur complement
+
+    unsigned int m_num_factorized;  ///< number of substructure factorizations
+    unsigned int m_num_reused;      ///< number of reused substructure factorizations
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,625 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "chrono/solver/ChSupernodalLDLT.h"
+
+#include <Eigen/OrderingMethods>
+
+namespace chrono {
+
+// Width of the column blocks in the dense factorization of the supernode panels
+static const int BLOCK_SIZE = 32;
+
+// Pattern of the strictly lower triangle of the symmetrically permuted matrix P*A*P^T, by rows and by columns.
+// Entries are symmetrized (each off-diagonal entry of A contributes to the lower triangle), duplicates are allowed.
+static void LowerPattern(const ChSparseMatrix& A,
+                         const std::vector<int>& pinv,
+                         std::vector<int>& row_ptr,
+                         std::vector<int>& row_idx,
+                         std::vector<int>& col_ptr,
+                         std::vector<int>& col_idx) {
+    int n = (int)A.rows();
+    const int* Ap = A.outerIndexPtr();
+    const int* Ai = A.innerIndexPtr();
+
+    row_ptr.assign(n + 1, 0);
+    col_ptr.assign(n + 1, 0);
+    for (int r = 0; r < n; r++) {
+        for (int k = Ap[r]; k < Ap[r + 1]; k++) {
+            int i = pinv[r];
+            int j = pinv[Ai[k]];
+            if (i == j)
+                continue;
+            row_ptr[std::max(i, j) + 1]++;
+            col_ptr[std::min(i, j) + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        row_ptr[i + 1] += row_ptr[i];
+        col_ptr[i + 1] += col_ptr[i];
+    }
+
+    row_idx.resize(row_ptr[n]);
+    col_idx.resize(col_ptr[n]);
+    std::vector<int> row_pos(row_ptr.begin(), row_ptr.end() - 1);
+    std::vector<int> col_pos(col_ptr.begin(), col_ptr.end() - 1);
+    for (int r = 0; r < n; r++) {
+        for (int k = Ap[r]; k < Ap[r + 1]; k++) {
+            int i = pinv[r];
+            int j = pinv[Ai[k]];
+            if (i == j)
+                continue;
+            row_idx[row_pos[std::max(i, j)]++] = std::min(i, j);
+            col_idx[col_pos[std::min(i, j)]++] = std::max(i, j);
+        }
+    }
+}
+
+// Elimination tree from the rows of the strictly lower triangle (Liu's algorithm with path compression).
+static void EliminationTree(int n,
+                            const std::vector<int>& row_ptr,
+                            const std::vector<int>& row_idx,
+                            std::vector<int>& parent) {
+    std::vector<int> ancestor(n, -1);
+    parent.assign(n, -1);
+    for (int k = 0; k < n; k++) {
+        for (int p = row_ptr[k]; p < row_ptr[k + 1]; p++) {
+            int i = row_idx[p];
+            while (i != -1 && i < k) {
+                int next = ancestor[i];
+                ancestor[i] = k;
+                if (next == -1)
+                    parent[i] = k;
+                i = next;
+            }
+        }
+    }
+}
+
+// Postorder of a forest, with children visited in increasing order.
+static void PostOrder(const std::vector<int>& parent, std::vector<int>& post) {
+    int n = (int)parent.size();
+    std::vector<int> head(n, -1);
+    std::vector<int> next(n, -1);
+    for (int j = n - 1; j >= 0; j--) {
+        if (parent[j] != -1) {
+            next[j] = head[parent[j]];
+            head[parent[j]] = j;
+        }
+    }
+
+    post.clear();
+    post.reserve(n);
+    std::vector<int> stack;
+    for (int j = 0; j < n; j++) {
+        if (parent[j] != -1)
+            continue;
+        stack.push_back(j);
+        while (!stack.empty()) {
+            int p = stack.back();
+            int c = head[p];
+            if (c == -1) {
+                stack.pop_back();
+                post.push_back(p);
+            } else {
+                head[p] = next[c];
+                stack.push_back(c);
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+ChSupernodalLDLT::ChSupernodalLDLT()
+    : m_num_threads(1),
+      m_posdef(false),
+      m_pivot_tol(1e-13),
+      m_analyzed(false),
+      m_n(0),
+      m_num_primal(-1),
+      m_num_neg(0),
+      m_num_perturbed(0),
+      m_failed_row(-1) {}
+
+void ChSupernodalLDLT::SetNumThreads(int num_threads) {
+    m_num_threads = std::max(1, num_threads);
+}
+
+size_t ChSupernodalLDLT::GetNumNonZerosL() const {
+    size_t nnz = 0;
+    for (int s = 0; s < GetNumSupernodes(); s++) {
+        size_t nc = m_sup_ptr[s + 1] - m_sup_ptr[s];
+        size_t m = m_row_ptr[s + 1] - m_row_ptr[s];
+        nnz += m * nc - nc * (nc + 1) / 2;
+    }
+    return nnz;
+}
+
+void ChSupernodalLDLT::AnalyzePattern(const ChSparseMatrix& A, int num_primal) {
+    int n = (int)A.rows();
+    const int* Ap = A.outerIndexPtr();
+    const int* Ai = A.innerIndexPtr();
+    const double* Ax = A.valuePtr();
+
+    m_n = n;
+    m_num_primal = num_primal;
+
+    // Identify the rows to be eliminated after the variables they couple
+    std::vector<char> delayed(n, 0);
+    if (!m_posdef) {
+        for (int i = 0; i < n; i++) {
+            if (num_primal >= 0) {
+                delayed[i] = (i >= num_primal);
+                continue;
+            }
+            delayed[i] = 1;
+            for (int k = Ap[i]; k < Ap[i + 1]; k++) {
+                if (Ai[k] == i && Ax[k] != 0)
+                    delayed[i] = 0;
+            }
+        }
+    }
+
+    // Fill-reducing ordering of the primal rows. The graph includes the couplings introduced by the elimination of
+    // the delayed rows (a clique on the variables coupled by each delayed row).
+    std::vector<int> primal(n, -1);
+    std::vector<int> primal_rows;
+    for (int i = 0; i < n; i++) {
+        if (!delayed[i]) {
+            primal[i] = (int)primal_rows.size();
+            primal_rows.push_back(i);
+        }
+    }
+    int np = (int)primal_rows.size();
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(A.nonZeros());
+    std::vector<int> vars;
+    for (int i = 0; i < n; i++) {
+        if (!delayed[i]) {
+            for (int k = Ap[i]; k < Ap[i + 1]; k++) {
+                if (!delayed[Ai[k]])
+                    triplets.emplace_back(primal[i], primal[Ai[k]], 1.0);
+            }
+        } else {
+            vars.clear();
+            for (int k = Ap[i]; k < Ap[i + 1]; k++) {
+                if (!delayed[Ai[k]])
+                    vars.push_back(primal[Ai[k]]);
+            }
+            for (int a : vars) {
+                for (int b : vars)
+                    triplets.emplace_back(a, b, 1.0);
+            }
+        }
+    }
+
+    std::vector<int> amd_order(np);
+    if (np > 0) {
+        Eigen::SparseMatrix<double, Eigen::ColMajor, int> G(np, np);
+        G.setFromTriplets(triplets.begin(), triplets.end());
+        Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> perm;
+        Eigen::AMDOrdering<int> amd;
+        amd(G, perm);
+        for (int k = 0; k < np; k++)
+            amd_order[k] = perm.indices()(k);
+    }
+    triplets.clear();
+    triplets.shrink_to_fit();
+
+    // Place each delayed row right after the last of its coupled variables
+    std::vector<int> amd_pos(np);
+    for (int k = 0; k < np; k++)
+        amd_pos[amd_order[k]] = k;
+
+    std::vector<std::pair<int, int>> delayed_rows;
+    for (int i = 0; i < n; i++) {
+        if (!delayed[i])
+            continue;
+        int last = -1;
+        for (int k = Ap[i]; k < Ap[i + 1]; k++) {
+            if (!delayed[Ai[k]])
+                last = std::max(last, amd_pos[primal[Ai[k]]]);
+        }
+        delayed_rows.push_back({last < 0 ? np : last, i});
+    }
+    std::sort(delayed_rows.begin(), delayed_rows.end());
+
+    std::vector<int> order;
+    order.reserve(n);
+    size_t d = 0;
+    for (int k = 0; k < np; k++) {
+        order.push_back(primal_rows[amd_order[k]]);
+        while (d < delayed_rows.size() && delayed_rows[d].first == k)
+            order.push_back(delayed_rows[d++].second);
+    }
+    while (d < delayed_rows.size())
+        order.push_back(delayed_rows[d++].second);
+
+    // Postorder the elimination tree, so that the columns of each subtree (and of each supernode) are consecutive.
+    // A postordering does not change the fill-in, and keeps each delayed row after its coupled variables (which are
+    // its descendants in the elimination tree).
+    std::vector<int> pinv(n);
+    for (int k = 0; k < n; k++)
+        pinv[order[k]] = k;
+
+    std::vector<int> row_ptr, row_idx, col_ptr, col_idx, parent, post;
+    LowerPattern(A, pinv, row_ptr, row_idx, col_ptr, col_idx);
+    EliminationTree(n, row_ptr, row_idx, parent);
+    PostOrder(parent, post);
+
+    m_order.resize(n);
+    for (int k = 0; k < n; k++)
+        m_order[k] = order[post[k]];
+    for (int k = 0; k < n; k++)
+        pinv[m_order[k]] = k;
+
+    m_delayed.resize(n);
+    for (int k = 0; k < n; k++)
+        m_delayed[k] = delayed[m_order[k]];
+
+    LowerPattern(A, pinv, row_ptr, row_idx, col_ptr, col_idx);
+    EliminationTree(n, row_ptr, row_idx, parent);
+
+    // Column counts of L, from the row subtrees of the elimination tree
+    std::vector<int> col_count(n, 1);
+    std::vector<int> mark(n, -1);
+    for (int k = 0; k < n; k++) {
+        mark[k] = k;
+        for (int p = row_ptr[k]; p < row_ptr[k + 1]; p++) {
+            for (int i = row_idx[p]; mark[i] != k; i = parent[i]) {
+                col_count[i]++;
+                mark[i] = k;
+            }
+        }
+    }
+
+    // Fundamental supernodes: a column is merged with the previous one if it is its only child in the elimination
+    // tree and the two columns of L have the same structure below the diagonal block
+    std::vector<int> num_children(n, 0);
+    for (int j = 0; j < n; j++) {
+        if (parent[j] != -1)
+            num_children[parent[j]]++;
+    }
+
+    m_sup_ptr.clear();
+    for (int j = 0; j < n; j++) {
+        bool merge = j > 0 && parent[j - 1] == j && col_count[j - 1] == col_count[j] + 1 && num_children[j] == 1;
+        if (!merge)
+            m_sup_ptr.push_back(j);
+    }
+    m_sup_ptr.push_back(n);
+    int ns = (int)m_sup_ptr.size() - 1;
+
+    std::vector<int> col_sup(n);
+    for (int s = 0; s < ns; s++) {
+        for (int j = m_sup_ptr[s]; j < m_sup_ptr[s + 1]; j++)
+            col_sup[j] = s;
+    }
+
+    m_sup_parent.assign(ns, -1);
+    m_child_ptr.assign(ns + 1, 0);
+    for (int s = 0; s < ns; s++) {
+        int p = parent[m_sup_ptr[s + 1] - 1];
+        if (p != -1) {
+            m_sup_parent[s] = col_sup[p];
+            m_child_ptr[col_sup[p] + 1]++;
+        }
+    }
+    for (int s = 0; s < ns; s++)
+        m_child_ptr[s + 1] += m_child_ptr[s];
+    m_child.resize(m_child_ptr[ns]);
+    std::vector<int> child_pos(m_child_ptr.begin(), m_child_ptr.end() - 1);
+    for (int s = 0; s < ns; s++) {
+        if (m_sup_parent[s] != -1)
+            m_child[child_pos[m_sup_parent[s]]++] = s;
+    }
+
+    // Row structure of each supernode: its own columns, followed by the (sorted) rows of the original matrix and of
+    // the update matrices of its children below the diagonal block
+    m_row_ptr.assign(1, 0);
+    m_rows.clear();
+    std::fill(mark.begin(), mark.end(), -1);
+    for (int s = 0; s < ns; s++) {
+        int f = m_sup_ptr[s];
+        int l = m_sup_ptr[s + 1];
+        size_t start = m_rows.size();
+        for (int j = f; j < l; j++) {
+            m_rows.push_back(j);
+            mark[j] = s;
+        }
+        for (int j = f; j < l; j++) {
+            for (int p = col_ptr[j]; p < col_ptr[j + 1]; p++) {
+                int i = col_idx[p];
+                if (mark[i] != s) {
+                    mark[i] = s;
+                    m_rows.push_back(i);
+                }
+            }
+        }
+        for (int q = m_child_ptr[s]; q < m_child_ptr[s + 1]; q++) {
+            int c = m_child[q];
+            int nc = m_sup_ptr[c + 1] - m_sup_ptr[c];
+            for (int p = m_row_ptr[c] + nc; p < m_row_ptr[c + 1]; p++) {
+                int i = m_rows[p];
+                if (mark[i] != s) {
+                    mark[i] = s;
+                    m_rows.push_back(i);
+                }
+            }
+        }
+        std::sort(m_rows.begin() + start + (l - f), m_rows.end());
+        m_row_ptr.push_back((int)m_rows.size());
+    }
+
+    // Position of the update rows of each supernode in the row structure of its parent
+    m_rel.assign(m_rows.size(), -1);
+    std::vector<int> local(n, -1);
+    for (int s = 0; s < ns; s++) {
+        for (int p = m_row_ptr[s]; p < m_row_ptr[s + 1]; p++)
+            local[m_rows[p]] = p - m_row_ptr[s];
+        for (int q = m_child_ptr[s]; q < m_child_ptr[s + 1]; q++) {
+            int c = m_child[q];
+            int nc = m_sup_ptr[c + 1] - m_sup_ptr[c];
+            for (int p = m_row_ptr[c] + nc; p < m_row_ptr[c + 1]; p++)
+                m_rel[p] = local[m_rows[p]];
+        }
+    }
+
+    // Storage of the dense supernode panels
+    m_lx_ptr.assign(ns + 1, 0);
+    for (int s = 0; s < ns; s++) {
+        size_t nc = m_sup_ptr[s + 1] - m_sup_ptr[s];
+        size_t m = m_row_ptr[s + 1] - m_row_ptr[s];
+        m_lx_ptr[s + 1] = m_lx_ptr[s] + m * nc;
+    }
+
+    // Position in the supernode panels of each nonzero of the lower triangle of the permuted matrix
+    m_map.assign(A.nonZeros(), -1);
+    m_diag.clear();
+    for (int r = 0; r < n; r++) {
+        for (int k = Ap[r]; k < Ap[r + 1]; k++) {
+            int i = pinv[r];
+            int j = pinv[Ai[k]];
+            if (i < j)
+                continue;
+            if (i == j)
+                m_diag.push_back(k);
+            int s = col_sup[j];
+            int f = m_sup_ptr[s];
+            int nc = m_sup_ptr[s + 1] - f;
+            int m = m_row_ptr[s + 1] - m_row_ptr[s];
+            int li = i - f;
+            if (i >= f + nc) {
+                auto begin = m_rows.begin() + m_row_ptr[s];
+                li = (int)(std::lower_bound(begin + nc, m_rows.begin() + m_row_ptr[s + 1], i) - begin);
+            }
+            m_map[k] = (ptrdiff_t)(m_lx_ptr[s] + (size_t)m * (j - f) + li);
+        }
+    }
+
+    // Levels of the supernodal elimination tree (leaves at level 0). Supernodes in the same level are independent.
+    std::vector<int> height(ns, 0);
+    int num_levels = ns > 0 ? 1 : 0;
+    for (int s = 0; s < ns; s++) {
+        int p = m_sup_parent[s];
+        if (p != -1) {
+            height[p] = std::max(height[p], height[s] + 1);
+            num_levels = std::max(num_levels, height[p] + 1);
+        }
+    }
+    m_level_ptr.assign(num_levels + 1, 0);
+    for (int s = 0; s < ns; s++)
+        m_level_ptr[height[s] + 1]++;
+    for (int h = 0; h < num_levels; h++)
+        m_level_ptr[h + 1] += m_level_ptr[h];
+    m_level.resize(ns);
+    std::vector<int> level_pos(m_level_ptr.begin(), m_level_ptr.end() - 1);
+    for (int s = 0; s < ns; s++)
+        m_level[level_pos[height[s]]++] = s;
+
+    m_Lx.assign(m_lx_ptr[ns], 0.0);
+    m_D.resize(n);
+    m_update.clear();
+    m_update.resize(ns);
+
+    m_analyzed = true;
+}
+
+bool ChSupernodalLDLT::Factorize(const ChSparseMatrix& A) {
+    m_num_neg = 0;
+    m_num_perturbed = 0;
+    m_failed_row = -1;
+
+    if (!m_analyzed || A.rows() != m_n || A.nonZeros() != (Eigen::Index)m_map.size())
+        return false;
+
+    // Load the lower triangle of the permuted matrix in the supernode panels
+    const double* Ax = A.valuePtr();
+    std::fill(m_Lx.begin(), m_Lx.end(), 0.0);
+    for (size_t k = 0; k < m_map.size(); k++) {
+        if (m_map[k] >= 0)
+            m_Lx[m_map[k]] += Ax[k];
+    }
+
+    double scale = 0;
+    for (int k : m_diag)
+        scale = std::max(scale, std::abs(Ax[k]));
+    if (scale == 0)
+        scale = 1;
+
+    // Process the levels of the supernodal elimination tree bottom-up. The supernodes in a level depend only on
+    // supernodes in lower levels and are factorized concurrently. Levels with a single supernode (typically the
+    // largest ones, near the root) are processed outside a parallel region.
+    int num_neg = 0;
+    int num_perturbed = 0;
+    int failed_col = -1;
+    for (int h = 0; h + 1 < (int)m_level_ptr.size() && failed_col < 0; h++) {
+        int first = m_level_ptr[h];
+        int last = m_level_ptr[h + 1];
+        if (last - first == 1 || m_num_threads == 1) {
+            for (int t = first; t < last && failed_col < 0; t++)
+                failed_col = FactorizeSupernode(m_level[t], scale, num_neg, num_perturbed);
+            continue;
+        }
+
+#pragma omp parallel for schedule(dynamic) num_threads(m_num_threads) reduction(+ : num_neg, num_perturbed)
+        for (int t = first; t < last; t++) {
+            int col = FactorizeSupernode(m_level[t], scale, num_neg, num_perturbed);
+            if (col >= 0) {
+#pragma omp critical
+                failed_col = col;
+            }
+        }
+    }
+
+    for (auto& U : m_update)
+        U.resize(0, 0);
+
+    m_num_neg = num_neg;
+    m_num_perturbed = num_perturbed;
+    if (failed_col >= 0) {
+        m_failed_row = m_order[failed_col];
+        return false;
+    }
+
+    return true;
+}
+
+int ChSupernodalLDLT::FactorizeSupernode(int s, double scale, int& num_neg, int& num_perturbed) {
+    int f = m_sup_ptr[s];
+    int nc = m_sup_ptr[s + 1] - f;
+    int m = m_row_ptr[s + 1] - m_row_ptr[s];
+    int u = m - nc;
+
+    // Frontal matrix: the panel with the columns of this supernode (stored in place in the factor) and the update
+    // matrix passed on to the parent supernode
+    Eigen::Map<Eigen::MatrixXd> P(m_Lx.data() + m_lx_ptr[s], m, nc);
+    Eigen::MatrixXd& U = m_update[s];
+    U.setZero(u, u);
+
+    // Extend-add the update matrices of the children
+    for (int q = m_child_ptr[s]; q < m_child_ptr[s + 1]; q++) {
+        int c = m_child[q];
+        const int* rel = m_rel.data() + m_row_ptr[c] + (m_sup_ptr[c + 1] - m_sup_ptr[c]);
+        Eigen::MatrixXd& Uc = m_update[c];
+        int uc = (int)Uc.rows();
+        for (int b = 0; b < uc; b++) {
+            int lb = rel[b];
+            if (lb < nc) {
+                for (int a = b; a < uc; a++)
+                    P(rel[a], lb) += Uc(a, b);
+            } else {
+                for (int a = b; a < uc; a++)
+                    U(rel[a] - nc, lb - nc) += Uc(a, b);
+            }
+        }
+        Uc.resize(0, 0);
+    }
+
+    // Blocked right-looking LDL^T factorization of the panel
+    double tol = m_pivot_tol * scale;
+    double delta = std::sqrt(std::numeric_limits<double>::epsilon()) * scale;
+    for (int kb = 0; kb < nc; kb += BLOCK_SIZE) {
+        int ke = std::min(kb + BLOCK_SIZE, nc);
+        for (int k = kb; k < ke; k++) {
+            double d = P(k, k);
+            if (m_posdef && !(d > tol))
+                return f + k;
+            if (std::abs(d) <= tol) {
+                d = (d < 0 || (d == 0 && m_delayed[f + k])) ? -delta : delta;
+                num_perturbed++;
+            }
+            if (d < 0)
+                num_neg++;
+            m_D(f + k) = d;
+
+            // Rank-1 update of the remaining columns in the block, then scale the column
+            for (int j = k + 1; j < ke; j++)
+                P.col(j).tail(m - j) -= P.col(k).tail(m - j) * (P(j, k) / d);
+            P.col(k).tail(m - k - 1) /= d;
+        }
+
+        // Rank-b update of the trailing columns of the panel
+        if (ke < nc) {
+            auto Lb = P.block(ke, kb, m - ke, ke - kb);
+            Eigen::MatrixXd W = Lb * m_D.segment(f + kb, ke - kb).asDiagonal();
+            P.block(ke, ke, m - ke, nc - ke).noalias() -= W * Lb.topRows(nc - ke).transpose();
+        }
+    }
+
+    // Update matrix: U -= L21 * D1 * L21^T (lower triangle only)
+    if (u > 0) {
+        auto L21 = P.bottomRows(u);
+        Eigen::MatrixXd W = L21 * m_D.segment(f, nc).asDiagonal();
+        U.triangularView<Eigen::Lower>() -= W * L21.transpose();
+    }
+
+    return -1;
+}
+
+void ChSupernodalLDLT::Solve(const ChVectorDynamic<>& b, ChVectorDynamic<>& x) const {
+    int ns = GetNumSupernodes();
+
+    Eigen::VectorXd y(m_n);
+    for (int k = 0; k < m_n; k++)
+        y(k) = b(m_order[k]);
+
+    // Forward substitution with the unit lower triangular factor
+    Eigen::VectorXd tmp;
+    for (int s = 0; s < ns; s++) {
+        int f = m_sup_ptr[s];
+        int nc = m_sup_ptr[s + 1] - f;
+        int m = m_row_ptr[s + 1] - m_row_ptr[s];
+        int u = m - nc;
+        const int* rows = m_rows.data() + m_row_ptr[s] + nc;
+        Eigen::Map<const Eigen::MatrixXd> P(m_Lx.data() + m_lx_ptr[s], m, nc);
+
+        P.topRows(nc).triangularView<Eigen::UnitLower>().solveInPlace(y.segment(f, nc));
+        if (u > 0) {
+            tmp.noalias() = P.bottomRows(u) * y.segment(f, nc);
+            for (int t = 0; t < u; t++)
+                y(rows[t]) -= tmp(t);
+        }
+    }
+
+    y.array() /= m_D.array();
+
+    // Backward substitution with the transpose of the factor
+    for (int s = ns - 1; s >= 0; s--) {
+        int f = m_sup_ptr[s];
+        int nc = m_sup_ptr[s + 1] - f;
+        int m = m_row_ptr[s + 1] - m_row_ptr[s];
+        int u = m - nc;
+        const int* rows = m_rows.data() + m_row_ptr[s] + nc;
+        Eigen::Map<const Eigen::MatrixXd> P(m_Lx.data() + m_lx_ptr[s], m, nc);
+
+        if (u > 0) {
+            tmp.resize(u);
+            for (int t = 0; t < u; t++)
+                tmp(t) = y(rows[t]);
+            y.segment(f, nc).noalias() -= P.bottomRows(u).transpose() * tmp;
+        }
+        P.topRows(nc).transpose().triangularView<Eigen::UnitUpper>().solveInPlace(y.segment(f, nc));
+    }
+
+    x.resize(m_n);
+    for (int k = 0; k < m_n; k++)
+        x(m_order[k]) = y(k);
+}
+
+}  // end namespace chrono
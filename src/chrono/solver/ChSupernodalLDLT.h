@@ -0,0 +1,129 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_SUPERNODAL_LDLT_H
+#define CH_SUPERNODAL_LDLT_H
+
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChMatrix.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Supernodal multifrontal LDL^T factorization of sparse symmetric matrices.
+///
+/// The symbolic analysis computes a fill-reducing ordering (approximate minimum degree), the elimination tree, and
+/// the supernodes (groups of consecutive columns of L with identical sparsity below the diagonal block). The numeric
+/// factorization processes the supernodes bottom-up in the elimination tree: each supernode assembles its frontal
+/// matrix from the original matrix and the update matrices of its children and factorizes it with dense blocked
+/// kernels. Independent subtrees are factorized concurrently, level by level.
+///
+/// Only the lower triangle of the (permuted) matrix is used, so the matrix must be symmetric. No numerical pivoting is
+/// performed. To factorize symmetric saddle-point matrices (e.g., KKT matrices with a zero or small constraint block),
+/// the rows past the first 'num_primal' ones are eliminated only after all the variables they couple; for a positive
+/// definite primal block, their pivots are then nonzero Schur complements. Pivots that are still (nearly) zero are
+/// replaced by small values of the same sign and the factorization proceeds; the accuracy of the solution can then be
+/// recovered with iterative refinement.
+class ChApi ChSupernodalLDLT {
+  public:
+    ChSupernodalLDLT();
+
+    /// Set the number of threads for the numeric factorization (default: 1).
+    void SetNumThreads(int num_threads);
+
+    /// Declare the matrix as positive definite (default: false). Must be set before the symbolic analysis.\n
+    /// If true, all rows are ordered for minimum fill and the factorization fails at the first non-positive pivot.
+    void SetPositiveDefinite(bool val) { m_posdef = val; }
+
+    /// Return true if the matrix is declared positive definite.
+    bool IsPositiveDefinite() const { return m_posdef; }
+
+    /// Set the threshold, relative to the largest diagonal entry, below which pivots are perturbed (default: 1e-13).
+    void SetPivotThreshold(double val) { m_pivot_tol = val; }
+
+    /// Perform the symbolic analysis of the given matrix (which must be in compressed mode).
+    /// The rows past the first 'num_primal' ones are eliminated after the variables they couple. If 'num_primal' is
+    /// negative, these are identified as the rows with no (or a zero) diagonal entry.
+    void AnalyzePattern(const ChSparseMatrix& A, int num_primal = -1);
+
+    /// Perform the numeric factorization of the given matrix, which must have the sparsity pattern of the matrix
+    /// passed to the last call to AnalyzePattern. Return false if the factorization failed.
+    bool Factorize(const ChSparseMatrix& A);
+
+    /// Solve A*x = b using the current factorization.
+    void Solve(const ChVectorDynamic<>& b, ChVectorDynamic<>& x) const;
+
+    /// Return true if the symbolic analysis was performed.
+    bool IsAnalyzed() const { return m_analyzed; }
+
+    /// Return the number of primal rows used in the last symbolic analysis.
+    int GetNumPrimal() const { return m_num_primal; }
+
+    /// Return the number of supernodes.
+    int GetNumSupernodes() const { return (int)m_sup_ptr.size() - 1; }
+
+    /// Return the number of nonzeros in the strictly lower triangle of the factor L.
+    size_t GetNumNonZerosL() const;
+
+    /// Return the number of negative pivots at the last factorization (the number of negative eigenvalues of A).
+    int GetNumNegativePivots() const { return m_num_neg; }
+
+    /// Return the number of pivots perturbed at the last factorization.
+    int GetNumPerturbedPivots() const { return m_num_perturbed; }
+
+    /// Return the row (in the original ordering) at which the last factorization failed, or -1 if successful.
+    int GetFailedRow() const { return m_failed_row; }
+
+  private:
+    /// Assemble and factorize the frontal matrix of the given supernode.
+    /// Return the column (in the permuted ordering) with an invalid pivot, or -1 if successful.
+    int FactorizeSupernode(int s, double scale, int& num_neg, int& num_perturbed);
+
+    int m_num_threads;   ///< number of threads for the numeric factorization
+    bool m_posdef;       ///< is the matrix declared positive definite?
+    double m_pivot_tol;  ///< relative pivot perturbation threshold
+
+    bool m_analyzed;                ///< was the symbolic analysis performed?
+    int m_n;                        ///< matrix size
+    int m_num_primal;               ///< number of primal rows at the last analysis
+    std::vector<int> m_order;       ///< permuted ordering (new index -> original index)
+    std::vector<char> m_delayed;    ///< flags for rows ordered after their coupled variables (new index)
+    std::vector<ptrdiff_t> m_map;   ///< position in the factor of each matrix nonzero (-1 if not used)
+    std::vector<int> m_diag;        ///< indices of the diagonal matrix nonzeros
+    std::vector<int> m_sup_ptr;     ///< first column of each supernode
+    std::vector<int> m_sup_parent;  ///< parent of each supernode in the supernodal elimination tree
+    std::vector<int> m_child_ptr;   ///< start of the children of each supernode in m_child
+    std::vector<int> m_child;       ///< children of all supernodes
+    std::vector<int> m_row_ptr;     ///< start of the row structure of each supernode in m_rows
+    std::vector<int> m_rows;        ///< row structures of all supernodes (sorted)
+    std::vector<int> m_rel;         ///< position of each update row in the row structure of the parent
+    std::vector<size_t> m_lx_ptr;   ///< start of the dense panel of each supernode in m_Lx
+    std::vector<int> m_level_ptr;   ///< start of each level of the supernodal elimination tree
+    std::vector<int> m_level;       ///< supernodes sorted by level (leaves first)
+
+    std::vector<double> m_Lx;               ///< dense supernode panels (column-major)
+    Eigen::VectorXd m_D;                    ///< diagonal factor
+    std::vector<Eigen::MatrixXd> m_update;  ///< pending update matrices (lower triangle)
+    int m_num_neg;                          ///< number of negative pivots
+    int m_num_perturbed;                    ///< number of perturbed pivots
+    int m_failed_row;                       ///< row at which the factorization failed
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -13,11 +13,16 @@
 // =============================================================================
 
 #include <iomanip>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
 
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
 #include "chrono/core/ChMatrix.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 namespace chrono {
 
@@ -27,7 +32,16 @@ CH_FACTORY_REGISTER(ChSystemDescriptor)
 
 #define CH_SPINLOCK_HASHSIZE 203
 
-ChSystemDescriptor::ChSystemDescriptor() : n_q(0), n_c(0), c_a(1.0), freeze_count(false) {
+ChSystemDescriptor::ChSystemDescriptor()
+    : n_q(0),
+      n_c(0),
+      c_a(1.0),
+      m_num_threads(1),
+      m_deterministic(false),
+      m_use_flat(false),
+      m_mf_operator(nullptr),
+      m_mf_krm(false),
+      freeze_count(false) {
     m_constraints.clear();
     m_variables.clear();
     m_KRMblocks.clear();
@@ -88,6 +102,175 @@ unsigned int ChSystemDescriptor::CountActiveConstraints() const {
     return n_c;
 }
 
+void ChSystemDescriptor::UpdateFlatConstraints() {
+    if (!m_use_flat)
+        return;
+
+    m_flat.Build(m_constraints, m_variables, CountActiveVariables());
+}
+
+void ChSystemDescriptor::UpdateConstraintsAuxiliary() {
+    if (!m_use_flat) {
+        for (auto constr : m_constraints)
+            constr->Update_auxiliary();
+        return;
+    }
+
+    m_flat.Build(m_constraints, m_variables, CountActiveVariables());
+    for (int i = 0; i < m_flat.GetNumConstraints(); i++)
+        m_flat.constraints[i]->SetSchurComplement(m_flat.g(i));
+}
+
+void ChSystemDescriptor::IncrementVariablesState() {
+    if (!m_use_flat) {
+        for (auto constr : m_constraints) {
+            if (constr->IsActive())
+                constr->IncrementState(constr->GetLagrangeMultiplier());
+        }
+        return;
+    }
+
+    FromVariablesToVector(m_flat_q, true);
+    for (int i = 0; i < m_flat.GetNumConstraints(); i++)
+        m_flat.IncrementVector(i, m_flat.constraints[i]->GetLagrangeMultiplier(), m_flat_q.data());
+    FromVectorToVariables(m_flat_q);
+}
+
+bool ChSystemDescriptor::ComputeIslands() {
+    m_islands.clear();
+
+    // KRM operators do not expose the variables they couple
+    if (!m_KRMoperators.empty())
+        return false;
+
+    // Index the active variables
+    std::unordered_map<ChVariables*, int> var_index;
+    std::vector<ChVariables*> vars;
+    std::vector<int> vars_substructure;
+    for (size_t i = 0; i < m_variables.size(); i++) {
+        if (m_variables[i]->IsActive()) {
+            var_index[m_variables[i]] = (int)vars.size();
+            vars.push_back(m_variables[i]);
+            vars_substructure.push_back(m_variables_substructure[i]);
+        }
+    }
+    int nv = (int)vars.size();
+
+    // Union-find over the active variables
+    std::vector<int> parent(nv);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    // Merge the variables coupled by each item (constraint or KRM block).
+    // Return the index of one of the active variables of the item, or -1 if it acts only on inactive variables.
+    auto merge = [&](const std::vector<ChVariables*>& item_vars) {
+        int first = -1;
+        for (auto var : item_vars) {
+            auto it = var_index.find(var);
+            if (it == var_index.end())
+                continue;
+            if (first < 0) {
+                first = find(it->second);
+            } else {
+                int other = find(it->second);
+                parent[std::max(first, other)] = std::min(first, other);
+                first = std::min(first, other);
+            }
+        }
+        return first;
+    };
+
+    std::vector<ChVariables*> item_vars;
+
+    std::vector<int> constr_var(m_constraints.size(), -1);
+    for (size_t ic = 0; ic < m_constraints.size(); ic++) {
+        if (!m_constraints[ic]->IsActive())
+            continue;
+        item_vars.clear();
+        m_constraints[ic]->GetVariablesList(item_vars);
+        if (item_vars.empty())
+            return false;
+        constr_var[ic] = merge(item_vars);
+    }
+
+    std::vector<int> krm_var(m_KRMblocks.size(), -1);
+    for (size_t ik = 0; ik < m_KRMblocks.size(); ik++) {
+        item_vars.clear();
+        for (unsigned int j = 0; j < m_KRMblocks[ik]->GetNumVariables(); j++)
+            item_vars.push_back(m_KRMblocks[ik]->GetVariable(j));
+        krm_var[ik] = merge(item_vars);
+    }
+
+    // Flag the sets of variables coupled through constraints or KRM blocks
+    std::vector<bool> coupled(nv, false);
+    for (auto iv : constr_var) {
+        if (iv >= 0)
+            coupled[find(iv)] = true;
+    }
+    for (auto iv : krm_var) {
+        if (iv >= 0)
+            coupled[find(iv)] = true;
+    }
+
+    // Assign islands, in order of first appearance of their variables.
+    // Uncoupled variables and items acting only on inactive variables are collected in a shared island.
+    std::vector<int> root_island(nv, -1);
+    int free_island = -1;
+    auto get_island = [&](int iv) {
+        if (iv >= 0) {
+            int root = find(iv);
+            if (coupled[root]) {
+                if (root_island[root] < 0) {
+                    root_island[root] = (int)m_islands.size();
+                    m_islands.push_back(chrono_types::make_unique<ChSystemDescriptor>());
+                }
+                return root_island[root];
+            }
+        }
+        if (free_island < 0) {
+            free_island = (int)m_islands.size();
+            m_islands.push_back(chrono_types::make_unique<ChSystemDescriptor>());
+        }
+        return free_island;
+    };
+
+    // Insert variables and constraints in the islands, preserving their substructure tags
+    for (int iv = 0; iv < nv; iv++) {
+        auto& island = m_islands[get_island(iv)];
+        island->m_variables.push_back(vars[iv]);
+        island->m_variables_substructure.push_back(vars_substructure[iv]);
+    }
+    for (size_t ic = 0; ic < m_constraints.size(); ic++) {
+        if (m_constraints[ic]->IsActive()) {
+            auto& island = m_islands[get_island(constr_var[ic])];
+            island->m_constraints.push_back(m_constraints[ic]);
+            island->m_constraints_substructure.push_back(m_constraints_substructure[ic]);
+        }
+    }
+    for (size_t ik = 0; ik < m_KRMblocks.size(); ik++)
+        m_islands[get_island(krm_var[ik])]->InsertKRMBlock(m_KRMblocks[ik]);
+
+    for (auto& island : m_islands) {
+        island->SetMassFactor(c_a);
+        island->EnableFlatConstraints(m_use_flat, m_flat.IsSinglePrecision());
+        island->SetDeterministic(m_deterministic);
+    }
+
+    // Sort islands by decreasing number of constraints (larger problems are processed first)
+    std::stable_sort(m_islands.begin(), m_islands.end(),
+                     [](const std::unique_ptr<ChSystemDescriptor>& a, const std::unique_ptr<ChSystemDescriptor>& b) {
+                         return a->m_constraints.size() > b->m_constraints.size();
+                     });
+
+    return true;
+}
+
 void ChSystemDescriptor::UpdateCountsAndOffsets() {
     freeze_count = false;
     CountActiveVariables();
@@ -110,6 +293,9 @@ void ChSystemDescriptor::PasteMassKRMMatrixInto(ChSparseMatrix& Z,
     for (const auto& KRMBlock : m_KRMblocks) {
         KRMBlock->PasteMatrixInto(Z, start_row, start_col, false);
     }
+
+    if (!m_KRMoperators.empty())
+        throw std::runtime_error("ChSystemDescriptor: cannot assemble the system matrix in matrix-free KRM mode.");
 }
 
 unsigned int ChSystemDescriptor::PasteConstraintsJacobianMatrixInto(ChSparseMatrix& Z,
@@ -156,6 +342,8 @@ void ChSystemDescriptor::PasteComplianceMatrixInto(ChSparseMatrix& Z,
 }
 
 void ChSystemDescriptor::BuildSystemMatrix(ChSparseMatrix* Z, ChVectorDynamic<>* rhs) const {
+    CH_TRACE_ZONE("BuildSystemMatrix");
+
     n_q = CountActiveVariables();
 
     n_c = CountActiveConstraints();
@@ -235,16 +423,24 @@ unsigned int ChSystemDescriptor::BuildDiagonalVector(ChVectorDynamic<>& Diagonal
     n_c = CountActiveConstraints();
     Diagonal_vect.setZero(n_q + n_c);
 
-    // Fill the diagonal values given by ChKRMBlock objects , if any
-    // (This cannot be easily parallelized because of possible write concurrency).
-    for (const auto& krm_block : m_KRMblocks) {
-        krm_block->DiagonalAdd(Diagonal_vect);
-    }
+    if (m_mf_operator) {
+        // Diagonal values provided by the matrix-free operator
+        m_mf_operator->AddDiagonalInto(Diagonal_vect);
+    } else {
+        // Fill the diagonal values given by ChKRMBlock objects , if any
+        // (This cannot be easily parallelized because of possible write concurrency).
+        for (const auto& krm_block : m_KRMblocks) {
+            krm_block->DiagonalAdd(Diagonal_vect);
+        }
+        for (const auto& krm_operator : m_KRMoperators) {
+            krm_operator->DiagonalAdd(Diagonal_vect);
+        }
 
-    // Get the 'M' diagonal terms given by ChVariables objects
-    for (const auto& var : m_variables) {
-        if (var->IsActive()) {
-            var->AddMassDiagonalInto(Diagonal_vect, c_a);
+        // Get the 'M' diagonal terms given by ChVariables objects
+        for (const auto& var : m_variables) {
+            if (var->IsActive()) {
+                var->AddMassDiagonalInto(Diagonal_vect, c_a);
+            }
         }
     }
 
@@ -373,11 +569,34 @@ void ChSystemDescriptor::SchurComplementProduct(ChVectorDynamic<>& result,
                                                 const ChVectorDynamic<>& lvector,
                                                 std::vector<bool>* enabled) {
     // currently, the case with ChKRMBlock items is not supported (only diagonal M is supported, no K)
-    assert(m_KRMblocks.size() == 0);
+    assert(m_KRMblocks.size() == 0 && m_KRMoperators.size() == 0);
     assert(lvector.size() == CountActiveConstraints());
 
     result.setZero(n_c);
 
+    if (m_num_threads > 1 || m_deterministic) {
+        SchurComplementProductParallel(result, lvector, enabled);
+        return;
+    }
+
+    if (m_use_flat) {
+        // Flattened representation: operate on a global vector of variables
+        m_flat_q.setZero(m_flat.GetNumVariables());
+        int nc = m_flat.GetNumConstraints();
+        for (int i = 0; i < nc; i++) {
+            if (enabled && !(*enabled)[i])
+                continue;
+            m_flat.IncrementVector(i, lvector(i), m_flat_q.data());
+            result(i) = m_flat.cfm(i) * lvector(i);
+        }
+        for (int i = 0; i < nc; i++) {
+            if (enabled && !(*enabled)[i])
+                continue;
+            result(i) += m_flat.JacobianTimesVector(i, m_flat_q.data());
+        }
+        return;
+    }
+
     // Performs the sparse product    result = [N]*l = [ [Cq][M^(-1)][Cq'] - [E] ] *l
     // in different phases:
 
@@ -394,6 +613,7 @@ void ChSystemDescriptor::SchurComplementProduct(ChVectorDynamic<>& result,
     //     Also, begin to add the cfm term ( -[E]*l ) to the result.
 
     // ATTENTION:  this loop cannot be parallelized! Concurrent write to some q may happen
+    // (see SchurComplementProductParallel for the multithreaded version, using per-thread accumulation)
     for (const auto& constr : m_constraints) {
         if (constr->IsActive()) {
             int s_c = constr->GetOffset();
@@ -434,18 +654,33 @@ void ChSystemDescriptor::SystemProduct(ChVectorDynamic<>& result, const ChVector
 
     result.setZero(n_q + n_c);
 
+    if (m_num_threads > 1 || m_deterministic) {
+        SystemProductParallel(result, x);
+        return;
+    }
+
     // 1) First row: result.q part =  [M + K]*x.q + [Cq']*x.l
 
-    // 1.1)  do  M*x.q
-    for (const auto& var : m_variables) {
-        if (var->IsActive()) {
-            var->AddMassTimesVectorInto(result, x, c_a);
+    if (m_mf_operator) {
+        // 1.1-1.2)  do  H*x.q  through the matrix-free operator
+        m_mf_operator->AddProductInto(result, x);
+    } else {
+        // 1.1)  do  M*x.q
+        for (const auto& var : m_variables) {
+            if (var->IsActive()) {
+                var->AddMassTimesVectorInto(result, x, c_a);
+            }
         }
-    }
 
-    // 1.2)  add also K*x.q  (NON straight parallelizable - risk of concurrency in writing)
-    for (const auto& krm_block : m_KRMblocks) {
-        krm_block->AddMatrixTimesVectorInto(result, x);
+        // 1.2)  add also K*x.q  (NON straight parallelizable - risk of concurrency in writing)
+        for (const auto& krm_block : m_KRMblocks) {
+            krm_block->AddMatrixTimesVectorInto(result, x);
+        }
+
+        // 1.2b)  add K*x.q of the KRM operators (these are evaluated matrix-free)
+        for (const auto& krm_operator : m_KRMoperators) {
+            krm_operator->AddMatrixTimesVectorInto(result, x);
+        }
     }
 
     // 1.3)  add also [Cq]'*x.l  (NON straight parallelizable - risk of concurrency in writing)
@@ -465,7 +700,176 @@ void ChSystemDescriptor::SystemProduct(ChVectorDynamic<>& result, const ChVector
     }
 }
 
+// Multithreaded products.
+// The constraints (and KRM blocks) are split in contiguous chunks, one per thread (or a fixed number of chunks in
+// deterministic mode). The contributions [Cq']*l of each chunk are accumulated in a separate vector, and these vectors
+// are then summed in a fixed order. The result is thus independent of thread scheduling and, in deterministic mode, of
+// the number of threads.
+
+void ChSystemDescriptor::ReduceThreadVectors(int nchunks, int size) {
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < size; i++) {
+        double sum = m_thread_q[0](i);
+        for (int t = 1; t < nchunks; t++)
+            sum += m_thread_q[t](i);
+        m_thread_q[0](i) = sum;
+    }
+}
+
+void ChSystemDescriptor::SchurComplementProductParallel(ChVectorDynamic<>& result,
+                                                        const ChVectorDynamic<>& lvector,
+                                                        std::vector<bool>* enabled) {
+    int nthreads = m_num_threads;
+    int nchunks = GetNumChunks();
+    m_thread_q.resize(nchunks);
+
+    if (m_use_flat) {
+        int nv = (int)m_flat.GetNumVariables();
+        int nc = m_flat.GetNumConstraints();
+
+        // 1 - accumulate qb_t = [M^(-1)][Cq']*l over each chunk of constraints; add cfm terms
+#pragma omp parallel for num_threads(nthreads)
+        for (int t = 0; t < nchunks; t++) {
+            CH_TRACE_ZONE("SchurComplementProduct (chunk)");
+            m_thread_q[t].setZero(nv);
+            int start = (int)((size_t)nc * t / nchunks);
+            int end = (int)((size_t)nc * (t + 1) / nchunks);
+            for (int i = start; i < end; i++) {
+                if (enabled && !(*enabled)[i])
+                    continue;
+                m_flat.IncrementVector(i, lvector(i), m_thread_q[t].data());
+                result(i) = m_flat.cfm(i) * lvector(i);
+            }
+        }
+
+        // 2 - qb = sum of qb_t
+        ReduceThreadVectors(nchunks, nv);
+
+        // 3 - result += [Cq]*qb
+        const double* q = m_thread_q[0].data();
+#pragma omp parallel for num_threads(nthreads)
+        for (int i = 0; i < nc; i++) {
+            if (enabled && !(*enabled)[i])
+                continue;
+            result(i) += m_flat.JacobianTimesVector(i, q);
+        }
+
+        return;
+    }
+
+    int nv = (int)CountActiveVariables();
+    int nc = (int)m_constraints.size();
+
+    // 1 - accumulate [Cq']*l over each chunk of constraints; add cfm terms
+#pragma omp parallel for num_threads(nthreads)
+    for (int t = 0; t < nchunks; t++) {
+        CH_TRACE_ZONE("SchurComplementProduct (chunk)");
+        m_thread_q[t].setZero(nv);
+        int start = (int)((size_t)nc * t / nchunks);
+        int end = (int)((size_t)nc * (t + 1) / nchunks);
+        for (int ic = start; ic < end; ic++) {
+            auto constr = m_constraints[ic];
+            if (!constr->IsActive())
+                continue;
+            int s_c = constr->GetOffset();
+            if (enabled && !(*enabled)[s_c])
+                continue;
+            double li = lvector(s_c);
+            constr->AddJacobianTransposedTimesScalarInto(m_thread_q[t], li);
+            result(s_c) = constr->GetComplianceTerm() * li;
+        }
+    }
+
+    // 2 - sum the per-chunk contributions
+    ReduceThreadVectors(nchunks, nv);
+
+    // 3 - set the qb vector (in each ChVariable) to qb = [M^(-1)]*[Cq']*l
+    const auto& Cql = m_thread_q[0];
+#pragma omp parallel for num_threads(nthreads)
+    for (int iv = 0; iv < (int)m_variables.size(); iv++) {
+        auto var = m_variables[iv];
+        if (var->IsActive())
+            var->ComputeMassInverseTimesVector(var->State(), Cql.segment(var->GetOffset(), var->GetDOF()));
+    }
+
+    // 4 - result += [Cq]*qb
+#pragma omp parallel for num_threads(nthreads)
+    for (int ic = 0; ic < nc; ic++) {
+        auto constr = m_constraints[ic];
+        if (constr->IsActive() && (!enabled || (*enabled)[constr->GetOffset()]))
+            result(constr->GetOffset()) += constr->ComputeJacobianTimesState();
+    }
+}
+
+void ChSystemDescriptor::SystemProductParallel(ChVectorDynamic<>& result, const ChVectorDynamic<>& x) {
+    int nthreads = m_num_threads;
+    int nchunks = GetNumChunks();
+    m_thread_q.resize(nchunks);
+
+    int nv = (int)n_q;
+    int nc = (int)m_constraints.size();
+    int nk = m_mf_operator ? 0 : (int)m_KRMblocks.size();
+
+    // 1) First row: result.q part =  [M + K]*x.q + [Cq']*x.l
+
+    // 1.1)  do  M*x.q  (each variable writes to its own segment), or H*x.q through the matrix-free operator
+    if (m_mf_operator) {
+        m_mf_operator->AddProductInto(result, x);
+    } else {
+#pragma omp parallel for num_threads(nthreads)
+        for (int iv = 0; iv < (int)m_variables.size(); iv++) {
+            auto var = m_variables[iv];
+            if (var->IsActive())
+                var->AddMassTimesVectorInto(result, x, c_a);
+        }
+    }
+
+    // 1.2)  accumulate K*x.q and [Cq']*x.l over each chunk of KRM blocks and constraints
+#pragma omp parallel for num_threads(nthreads)
+    for (int t = 0; t < nchunks; t++) {
+        CH_TRACE_ZONE("SystemProduct (chunk)");
+        m_thread_q[t].setZero(nv);
+        int start = (int)((size_t)nk * t / nchunks);
+        int end = (int)((size_t)nk * (t + 1) / nchunks);
+        for (int ik = start; ik < end; ik++)
+            m_KRMblocks[ik]->AddMatrixTimesVectorInto(m_thread_q[t], x);
+        start = (int)((size_t)nc * t / nchunks);
+        end = (int)((size_t)nc * (t + 1) / nchunks);
+        for (int ic = start; ic < end; ic++) {
+            auto constr = m_constraints[ic];
+            if (constr->IsActive())
+                constr->AddJacobianTransposedTimesScalarInto(m_thread_q[t], x(constr->GetOffset() + nv));
+        }
+    }
+
+    // 1.3)  sum the per-chunk contributions
+    ReduceThreadVectors(nchunks, nv);
+    result.head(nv) += m_thread_q[0];
+
+    // 1.4)  add K*x.q of the KRM operators (these are evaluated matrix-free, in parallel over non-overlapping items)
+    if (!m_mf_operator) {
+        for (const auto& krm_operator : m_KRMoperators)
+            krm_operator->AddMatrixTimesVectorInto(result, x);
+    }
+
+    // 2) Second row: result.l part =  [C_q]*x.q + [E]*x.l
+#pragma omp parallel for num_threads(nthreads)
+    for (int ic = 0; ic < nc; ic++) {
+        auto constr = m_constraints[ic];
+        if (constr->IsActive()) {
+            int s_c = constr->GetOffset() + nv;
+            constr->AddJacobianTimesVectorInto(result(s_c), x);
+            result(s_c) += constr->GetComplianceTerm() * x(s_c);
+        }
+    }
+}
+
 void ChSystemDescriptor::ConstraintsProject(ChVectorDynamic<>& multipliers) {
+    if (m_use_flat) {
+        m_flat.Project(multipliers.data());
+        return;
+    }
+
     FromVectorToConstraints(multipliers);
 
     for (const auto& constr : m_constraints) {
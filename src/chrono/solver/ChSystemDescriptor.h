@@ -15,9 +15,12 @@
 #ifndef CHSYSTEMDESCRIPTOR_H
 #define CHSYSTEMDESCRIPTOR_H
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "chrono/solver/ChConstraint.h"
+#include "chrono/solver/ChFlatConstraints.h"
 #include "chrono/solver/ChKRMBlock.h"
 #include "chrono/solver/ChVariables.h"
 
@@ -71,6 +74,36 @@ namespace chrono {
 
 class ChApi ChSystemDescriptor {
   public:
+    /// Interface for a matrix-free representation of the H block of the system matrix.
+    /// If an operator is attached to the descriptor (see SetMatrixFreeOperator), it replaces the mass matrices of the
+    /// variables and the KRM blocks in SystemProduct() and BuildDiagonalVector(). Vectors are indexed as the active
+    /// variables of the descriptor.
+    class ChApi MatrixFreeOperator {
+      public:
+        virtual ~MatrixFreeOperator() {}
+
+        /// Increment the given vector with the product H*x (only the first n_q entries of the two vectors are used).
+        virtual void AddProductInto(ChVectorDynamic<>& result, const ChVectorDynamic<>& x) = 0;
+
+        /// Increment the given vector with an approximation of the diagonal of H (used for preconditioning).
+        virtual void AddDiagonalInto(ChVectorDynamic<>& diag) = 0;
+    };
+
+    /// Interface for a matrix-free representation of a set of KRM blocks.
+    /// In the matrix-free KRM mode (see EnableMatrixFreeKRM), items that support it (e.g., ChMesh) insert a KRM operator
+    /// instead of their ChKRMBlock objects, and evaluate products with their KRM matrices on the fly, element by
+    /// element, without storing them. Vectors are indexed with the offsets of the variables (as in ChKRMBlock).
+    class ChApi KRMOperator {
+      public:
+        virtual ~KRMOperator() {}
+
+        /// Add the product of the KRM matrix by a given vector into 'result'.
+        virtual void AddMatrixTimesVectorInto(ChVectorDynamic<>& result, const ChVectorDynamic<>& vect) = 0;
+
+        /// Add the diagonal of the KRM matrix into 'result'.
+        virtual void DiagonalAdd(ChVectorDynamic<>& result) = 0;
+    };
+
     ChSystemDescriptor();
     virtual ~ChSystemDescriptor();
 
@@ -83,26 +116,58 @@ class ChApi ChSystemDescriptor {
     /// Access the vector of KRM matrix blocks.
     std::vector<ChKRMBlock*>& GetKRMBlocks() { return m_KRMblocks; }
 
+    /// Access the vector of KRM operators (matrix-free KRM mode).
+    std::vector<KRMOperator*>& GetKRMOperators() { return m_KRMoperators; }
+
     /// Begin insertion of items
     virtual void BeginInsertion() {
         m_constraints.clear();
         m_variables.clear();
         m_KRMblocks.clear();
+        m_KRMoperators.clear();
+        m_constraints_substructure.clear();
+        m_variables_substructure.clear();
+        m_substructures.clear();
     }
 
     /// Insert reference to a ChConstraint object.
-    virtual void InsertConstraint(ChConstraint* mc) { m_constraints.push_back(mc); }
+    virtual void InsertConstraint(ChConstraint* mc) {
+        m_constraints.push_back(mc);
+        m_constraints_substructure.push_back(m_substructures.empty() ? -1 : m_substructures.back());
+    }
 
     /// Insert reference to a ChVariables object.
-    virtual void InsertVariables(ChVariables* mv) { m_variables.push_back(mv); }
+    virtual void InsertVariables(ChVariables* mv) {
+        m_variables.push_back(mv);
+        m_variables_substructure.push_back(m_substructures.empty() ? -1 : m_substructures.back());
+    }
 
     /// Insert reference to a ChKRMBlock object (a piece of matrix).
     virtual void InsertKRMBlock(ChKRMBlock* mk) { m_KRMblocks.push_back(mk); }
 
+    /// Insert reference to a KRMOperator object (a piece of matrix, available only through products).
+    virtual void InsertKRMOperator(KRMOperator* mk) { m_KRMoperators.push_back(mk); }
+
     /// End insertion of items.
     /// A derived class should always call UpdateCountsAndOffsets.
     virtual void EndInsertion() { UpdateCountsAndOffsets(); }
 
+    /// Begin the insertion of the variables and constraints of the substructure with given (nonnegative) identifier.
+    /// Variables and constraints inserted until the matching EndSubstructure() are tagged with this identifier. Since
+    /// variables and constraints are inserted in separate passes, the same identifier is used in each pass. Nested
+    /// substructures are allowed; items are tagged with the innermost one. Solvers may use this partition of the
+    /// problem to eliminate the interior unknowns of each substructure separately (see ChSolverStaticCondensation).
+    void BeginSubstructure(int id) { m_substructures.push_back(id); }
+
+    /// End the insertion of the variables and constraints of the current substructure.
+    void EndSubstructure() { m_substructures.pop_back(); }
+
+    /// Return the substructure identifiers of the inserted constraints (-1 for constraints outside substructures).
+    const std::vector<int>& GetConstraintsSubstructure() const { return m_constraints_substructure; }
+
+    /// Return the substructure identifiers of the inserted variables (-1 for variables outside substructures).
+    const std::vector<int>& GetVariablesSubstructure() const { return m_variables_substructure; }
+
     /// Count & returns the scalar variables in the system.
     /// This excludes ChVariable object that are set as inactive.
     /// Notes:
@@ -127,6 +192,100 @@ class ChApi ChSystemDescriptor {
     /// Get the c_a coefficient (default=1) used for scaling the M masses of the m_variables.
     virtual double GetMassFactor() { return c_a; }
 
+    /// Attach a matrix-free operator for the H block of the system matrix (nullptr to detach).
+    /// While attached, the H block is only available through SystemProduct() and BuildDiagonalVector(); it is up to
+    /// the caller to use it only with solvers that do not need the assembled matrix (e.g., ChIterativeSolverLS).
+    void SetMatrixFreeOperator(MatrixFreeOperator* op) { m_mf_operator = op; }
+
+    /// Return the attached matrix-free operator (nullptr if none).
+    MatrixFreeOperator* GetMatrixFreeOperator() const { return m_mf_operator; }
+
+    /// Enable/disable the matrix-free KRM mode (default: false).
+    /// If enabled, items that support it (currently ChMesh) do not load their KRM blocks. Instead, they insert a KRM
+    /// operator which evaluates the element stiffness, damping, and mass contributions to SystemProduct() and
+    /// BuildDiagonalVector() on the fly, element by element (see ChElementBase::AddKRMProductInto). This reduces the
+    /// memory footprint of large FEA meshes, at the cost of more expensive products. The system matrix cannot be
+    /// assembled in this mode, so it can only be used with solvers that operate through SystemProduct() (e.g.,
+    /// ChSolverMINRES, ChSolverGMRES, ChSolverBiCGSTAB).
+    /// The mode takes effect the next time items are injected in the descriptor.
+    void EnableMatrixFreeKRM(bool val) { m_mf_krm = val; }
+
+    /// Return true if the matrix-free KRM mode is enabled.
+    bool IsMatrixFreeKRM() const { return m_mf_krm; }
+
+    /// Set the number of threads that solvers may use when operating on this descriptor (default: 1).
+    /// With more than one thread, SchurComplementProduct() and SystemProduct() are evaluated in parallel.
+    /// When the descriptor is owned by a ChSystem, this is set automatically to ChSystem::GetNumThreadsChrono().
+    void SetNumThreads(int num_threads) { m_num_threads = std::max(1, num_threads); }
+
+    /// Get the number of threads that solvers may use when operating on this descriptor.
+    int GetNumThreads() const { return m_num_threads; }
+
+    /// Enable/disable the deterministic mode (default: false).
+    /// If enabled, SchurComplementProduct() and SystemProduct() always split the constraints in the same number of
+    /// chunks (see GetNumChunks) and sum the chunk contributions in a fixed order, regardless of the number of threads.
+    /// Results are then bit-identical for any number of threads (including 1), at the cost of a small overhead for
+    /// single-threaded runs.
+    /// When the descriptor is owned by a ChSystem, this is set automatically to ChSystem::IsDeterministic().
+    void SetDeterministic(bool val) { m_deterministic = val; }
+
+    /// Return true if the deterministic mode is enabled.
+    bool IsDeterministic() const { return m_deterministic; }
+
+    /// Enable/disable the flattened constraint representation (default: false).
+    /// If enabled, the iterative VI solvers pack the data of all active constraints in contiguous buffers (see
+    /// ChFlatConstraints) once per solve and operate on these buffers instead of calling the virtual methods of the
+    /// individual constraints. This mode is used by ChSolverPSOR (serial sweep) and, through SchurComplementProduct(),
+    /// ConstraintsProject() and IncrementVariablesState(), by ChSolverAPGD, ChSolverBB, ChSolverPMINRES and
+    /// ChSolverADMM. ChSolverPSSOR and ChSolverPJacobi always operate on the individual constraints.
+    /// Optionally, the constraint Jacobians can be packed in single precision, to reduce memory traffic at the cost of
+    /// accuracy (see ChFlatConstraints::SetSinglePrecision).
+    void EnableFlatConstraints(bool val, bool single_precision = false) {
+        m_use_flat = val;
+        m_flat.SetSinglePrecision(single_precision);
+    }
+
+    /// Return true if the flattened constraint representation is used.
+    bool UseFlatConstraints() const { return m_use_flat; }
+
+    /// Pack the active constraints in the flattened representation.
+    /// This function is called by the iterative VI solvers at the beginning of a solve, after the constraint Jacobians
+    /// have been loaded. It does nothing if the flattened representation is not enabled.
+    void UpdateFlatConstraints();
+
+    /// Update the auxiliary data of the constraints, i.e. the Schur complement diagonal terms
+    /// g_i = [Cq_i]*[invM]*[Cq_i]' + cfm_i and the products [Eq_i] = [invM]*[Cq_i]'.
+    /// If the flattened representation is enabled, this data is computed only once, while packing the constraints (see
+    /// UpdateFlatConstraints), and the terms g_i are copied to the individual constraints. Otherwise,
+    /// ChConstraint::Update_auxiliary is called for each constraint.
+    void UpdateConstraintsAuxiliary();
+
+    /// Increment the state of the active variables with [invM]*[Cq]'*l, for the current multipliers l of the active
+    /// constraints. Equivalent to calling ChConstraint::IncrementState for each active constraint, but operating on the
+    /// flattened representation if enabled (in which case the constraint auxiliary data must have been updated with
+    /// UpdateConstraintsAuxiliary).
+    void IncrementVariablesState();
+
+    /// Access the flattened constraint representation.
+    /// The data is valid only after a call to UpdateFlatConstraints().
+    ChFlatConstraints& GetFlatConstraints() { return m_flat; }
+
+    /// Partition the active variables, constraints, and KRM blocks of this descriptor in independent islands.
+    /// Two variables belong to the same island if they are coupled through an active constraint or a KRM block. Each
+    /// island is represented by a separate system descriptor which references a subset of the items in this descriptor.
+    /// Variables not coupled to any constraint or KRM block are collected in a single island. Islands are sorted by
+    /// decreasing number of constraints. Return false (and no islands) if the decomposition is not possible, i.e. if
+    /// some active constraint does not report the variables it acts upon (see ChConstraint::GetVariablesList), or if
+    /// KRM operators are present (matrix-free KRM mode).
+    /// Notes:
+    /// - EndInsertion() must be called on an island before solving it; this updates the offsets of its variables and
+    ///   constraints, so UpdateCountsAndOffsets() must be called on this descriptor once all islands are solved.
+    /// - islands do not share variables or constraints and can therefore be solved concurrently.
+    bool ComputeIslands();
+
+    /// Access the islands found by the last call to ComputeIslands().
+    std::vector<std::unique_ptr<ChSystemDescriptor>>& GetIslands() { return m_islands; }
+
     /// Get a vector with all the 'fb' known terms associated to all variables, ordered into a column vector.
     /// The column vector must be passed as a ChMatrix<> object, which will be automatically reset and resized to the
     /// proper length if necessary.
@@ -368,10 +527,45 @@ class ChApi ChSystemDescriptor {
     std::vector<ChConstraint*> m_constraints;  ///< list of all constraints in the current Chrono system
     std::vector<ChVariables*> m_variables;     ///< list of all variables in the current Chrono system
     std::vector<ChKRMBlock*> m_KRMblocks;      ///< list of all KRM blocks in the current Chrono system
+    std::vector<KRMOperator*> m_KRMoperators;  ///< list of all KRM operators in the current Chrono system
+
+    std::vector<int> m_constraints_substructure;  ///< substructure identifier of each constraint
+    std::vector<int> m_variables_substructure;    ///< substructure identifier of each variable
+    std::vector<int> m_substructures;             ///< stack of substructures being inserted
+
+    double c_a;            ///< coefficient form M mass matrices in m_variables
+    int m_num_threads;     ///< number of threads available to solvers
+    bool m_deterministic;  ///< use a thread-count independent chunking in parallel products
+
+    bool m_use_flat;             ///< use flattened constraint representation
+    ChFlatConstraints m_flat;    ///< flattened constraint data
+    ChVectorDynamic<> m_flat_q;  ///< scratch vector of variables for flattened products
+
+    std::vector<std::unique_ptr<ChSystemDescriptor>> m_islands;  ///< independent subproblems (see ComputeIslands)
 
-    double c_a;  ///< coefficient form M mass matrices in m_variables
+    std::vector<ChVectorDynamic<>> m_thread_q;  ///< per-chunk accumulation vectors for parallel products
+
+    MatrixFreeOperator* m_mf_operator;  ///< matrix-free H operator (if any)
+    bool m_mf_krm;                      ///< matrix-free KRM mode
 
   private:
+    /// Number of chunks used in deterministic mode.
+    static const int m_deterministic_chunks = 16;
+
+    /// Return the number of chunks in which the constraints are split for the multithreaded products.
+    int GetNumChunks() const { return m_deterministic ? m_deterministic_chunks : m_num_threads; }
+
+    /// Multithreaded version of SchurComplementProduct.
+    void SchurComplementProductParallel(ChVectorDynamic<>& result,
+                                        const ChVectorDynamic<>& lvector,
+                                        std::vector<bool>* enabled);
+
+    /// Multithreaded version of SystemProduct.
+    void SystemProductParallel(ChVectorDynamic<>& result, const ChVectorDynamic<>& x);
+
+    /// Sum the per-chunk accumulation vectors (in chunk order) into the first one.
+    void ReduceThreadVectors(int nchunks, int size);
+
     mutable unsigned int n_q;  ///< number of active variables
     mutable unsigned int n_c;  ///< number of active constraints
     bool freeze_count;         ///< cache the number of active variables and constraints
@@ -16,6 +16,8 @@
 #define CHINTEGRABLE_H
 
 #include <cstdlib>
+#include <limits>
+#include <vector>
 
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChFrame.h"
@@ -29,6 +31,8 @@ namespace chrono {
 class ChLumpingParms {
   public:
     ChLumpingParms(double Ck = 1000, double Cr = 0) : Ck_penalty(Ck), Cr_penalty(Cr), error(0){};
+    virtual ~ChLumpingParms() {}
+
     double Ck_penalty;  // stiffness penalty for constraints if any
     double Cr_penalty;  // damping penalty for constraints if any
     double error;       // store here the error done when trying lumping masses
@@ -423,6 +427,42 @@ class ChApi ChIntegrableIIorder : public ChIntegrable {
         throw std::runtime_error("LoadConstraint_Ct() not implemented, implicit integrators cannot be used. ");
     }
 
+    //
+    // Functions required by multirate integration schemes
+    //
+
+    /// Flag the velocity-level coordinates belonging to the fast partition of a multirate integrator.
+    /// On return, 'fast' has one entry for each velocity-level coordinate (true for coordinates in the fast partition).
+    /// Return false if the integrable object does not support partitioning or if the fast partition is empty.
+    virtual bool StateGetFastPartition(std::vector<bool>& fast) { return false; }
+
+    /// Restrict subsequent calls to StateSolveCorrection to the fast partition.
+    /// While restricted, the slow coordinates are prescribed (excluded from the solution) and move with the velocities
+    /// in the provided vector v (entries of v corresponding to fast coordinates are ignored). Their effect on the
+    /// constraints coupling the two partitions is accounted for in the constraint right-hand sides.
+    virtual void StateRestrictToFastPartition(const ChStateDelta& v) {}
+
+    /// Undo the effect of StateRestrictToFastPartition.
+    virtual void StateReleaseFastPartition() {}
+
+    //
+    // Functions required by explicit integration schemes
+    //
+
+    /// Estimate the critical (stability) time step of explicit integrators with lumped mass.
+    /// Return infinity if the integrable object does not provide an estimate.
+    virtual double GetCriticalStepSize() { return std::numeric_limits<double>::infinity(); }
+
+    /// Scale the lumped mass (see LoadLumpedMass_Md) of the components with a critical time step smaller than the
+    /// specified target step, such that their critical step matches the target. A non-positive value removes mass
+    /// scaling. The default implementation does nothing.
+    virtual void SetMassScaling(double target_step) {}
+
+    /// Compute and load the current constraint Jacobians, as used by LoadResidual_CqL.
+    /// Explicit integrators which enforce constraints with a penalty (and hence never call StateSolveCorrection) must
+    /// call this function before LoadResidual_CqL. The default implementation does nothing.
+    virtual void LoadConstraintJacobians() {}
+
     //
     // OVERRIDE ChIntegrable BASE MEMBERS TO SUPPORT 1st ORDER INTEGRATORS:
     //
@@ -0,0 +1,217 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CH_STATE_SNAPSHOT_H
+#define CH_STATE_SNAPSHOT_H
+
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChCoordsys.h"
+#include "chrono/core/ChMatrix.h"
+#include "chrono/core/ChVector2.h"
+
+namespace chrono {
+
+/// In-memory binary snapshot of the dynamic state of a system (see ChSystem::SaveState).
+/// Data is appended with Write() and read back, in the same order, through a Reader. A snapshot only holds the data
+/// needed to restore the dynamic state of the system it was taken from (not its topology or parameters). The storage
+/// is reused across saves, so that repeatedly saving a system of fixed size does not allocate memory. A snapshot can
+/// be copied (e.g. to branch several times from the same state) and can be read concurrently by multiple readers.
+/// Only trivially copyable values are copied bitwise; vectors, quaternions, and coordinate systems are written by
+/// component, and other structures must be written field by field.
+class ChStateSnapshot {
+  public:
+    ChStateSnapshot() {}
+
+    /// Discard the snapshot data (the allocated storage is kept).
+    void Clear() { m_data.clear(); }
+
+    /// Return the size (in bytes) of the snapshot data.
+    size_t GetSize() const { return m_data.size(); }
+
+    /// Return true if the snapshot holds no data.
+    bool IsEmpty() const { return m_data.empty(); }
+
+    /// Reserve storage for the specified number of bytes.
+    void Reserve(size_t size) { m_data.reserve(size); }
+
+    /// Append a value of plain data type (one that can be copied bitwise).
+    template <typename T>
+    void Write(const T& val) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain data types can be copied bitwise");
+        WriteBytes(&val, sizeof(T));
+    }
+
+    /// Append a 2D vector (components).
+    template <typename Real>
+    void Write(const ChVector2<Real>& val) {
+        Write(val.x());
+        Write(val.y());
+    }
+
+    /// Append a 3D vector (components).
+    template <typename Real>
+    void Write(const ChVector3<Real>& val) {
+        Write(val.x());
+        Write(val.y());
+        Write(val.z());
+    }
+
+    /// Append a quaternion (components).
+    template <typename Real>
+    void Write(const ChQuaternion<Real>& val) {
+        Write(val.e0());
+        Write(val.e1());
+        Write(val.e2());
+        Write(val.e3());
+    }
+
+    /// Append a coordinate system (position and rotation).
+    template <typename Real>
+    void Write(const ChCoordsys<Real>& val) {
+        Write(val.pos);
+        Write(val.rot);
+    }
+
+    /// Append a dynamic vector (size and values).
+    void WriteVector(const ChVectorDynamic<>& vec) {
+        Write((size_t)vec.size());
+        WriteBytes(vec.data(), vec.size() * sizeof(double));
+    }
+
+    /// Append a std::vector of plain data type values (size and values).
+    template <typename T>
+    void WriteVector(const std::vector<T>& vec) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain data types can be copied bitwise");
+        Write(vec.size());
+        WriteBytes(vec.data(), vec.size() * sizeof(T));
+    }
+
+    /// Append the data of another snapshot (size and data).
+    /// This allows storing records which can be skipped by a reader (see Reader::ReadSnapshot).
+    void WriteSnapshot(const ChStateSnapshot& other) {
+        Write(other.m_data.size());
+        WriteBytes(other.m_data.data(), other.m_data.size());
+    }
+
+    /// Sequential reader of the data in a snapshot.
+    class Reader {
+      public:
+        explicit Reader(const ChStateSnapshot& snapshot) : m_snapshot(snapshot), m_pos(0) {}
+
+        /// Read a value of plain data type.
+        template <typename T>
+        void Read(T& val) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only plain data types can be copied bitwise");
+            ReadBytes(&val, sizeof(T));
+        }
+
+        /// Read a 2D vector.
+        template <typename Real>
+        void Read(ChVector2<Real>& val) {
+            Read(val.x());
+            Read(val.y());
+        }
+
+        /// Read a 3D vector.
+        template <typename Real>
+        void Read(ChVector3<Real>& val) {
+            Read(val.x());
+            Read(val.y());
+            Read(val.z());
+        }
+
+        /// Read a quaternion.
+        template <typename Real>
+        void Read(ChQuaternion<Real>& val) {
+            Read(val.e0());
+            Read(val.e1());
+            Read(val.e2());
+            Read(val.e3());
+        }
+
+        /// Read a coordinate system.
+        template <typename Real>
+        void Read(ChCoordsys<Real>& val) {
+            Read(val.pos);
+            Read(val.rot);
+        }
+
+        /// Read a dynamic vector, resizing it if needed.
+        void ReadVector(ChVectorDynamic<>& vec) {
+            size_t size;
+            Read(size);
+            CheckSize(size, sizeof(double));
+            vec.resize(size);
+            ReadBytes(vec.data(), size * sizeof(double));
+        }
+
+        /// Read a std::vector of plain data type values, resizing it if needed.
+        template <typename T>
+        void ReadVector(std::vector<T>& vec) {
+            static_assert(std::is_trivially_copyable<T>::value, "Only plain data types can be copied bitwise");
+            size_t size;
+            Read(size);
+            CheckSize(size, sizeof(T));
+            vec.resize(size);
+            ReadBytes(vec.data(), size * sizeof(T));
+        }
+
+        /// Read the data of a snapshot appended with WriteSnapshot, replacing the data of the given snapshot.
+        void ReadSnapshot(ChStateSnapshot& other) {
+            size_t size;
+            Read(size);
+            CheckSize(size, 1);
+            other.m_data.resize(size);
+            ReadBytes(other.m_data.data(), size);
+        }
+
+        /// Return true if all the snapshot data was read.
+        bool IsAtEnd() const { return m_pos == m_snapshot.m_data.size(); }
+
+      private:
+        // Check that the remaining data holds the specified number of elements (before resizing any container).
+        void CheckSize(size_t num_elements, size_t element_size) const {
+            if (num_elements > (m_snapshot.m_data.size() - m_pos) / element_size)
+                throw std::runtime_error("ChStateSnapshot: attempt to read past the end of the snapshot data.");
+        }
+
+        void ReadBytes(void* dst, size_t num_bytes) {
+            if (num_bytes > m_snapshot.m_data.size() - m_pos)
+                throw std::runtime_error("ChStateSnapshot: attempt to read past the end of the snapshot data.");
+            if (num_bytes > 0)
+                std::memcpy(dst, m_snapshot.m_data.data() + m_pos, num_bytes);
+            m_pos += num_bytes;
+        }
+
+        const ChStateSnapshot& m_snapshot;
+        size_t m_pos;
+    };
+
+  private:
+    void WriteBytes(const void* src, size_t num_bytes) {
+        size_t pos = m_data.size();
+        m_data.resize(pos + num_bytes);
+        if (num_bytes > 0)
+            std::memcpy(m_data.data() + pos, src, num_bytes);
+    }
+
+    std::vector<char> m_data;  ///< snapshot data
+};
+
+}  // end namespace chrono
+
+#endif
@@ -12,9 +12,12 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "chrono/timestepper/ChTimestepper.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 namespace chrono {
 
@@ -24,6 +27,35 @@ CH_UPCASTING(ChImplicitIterativeTimestepper, ChImplicitTimestepper)
 
 // -----------------------------------------------------------------------------
 
+double ChErrorControlTimestepper::ErrorNorm(const ChVectorDynamic<>& err, const ChVectorDynamic<>& ref) const {
+    if (err.size() == 0)
+        return 0;
+    return (err.array() / (err_reltol * ref.array().abs() + err_abstol)).matrix().norm() / std::sqrt(err.size());
+}
+
+bool ChErrorControlTimestepper::ControlStep(double h, double err_nrm, int order, bool truncated) {
+    err_last = err_nrm;
+    double err = std::max(err_nrm, 1e-10);
+
+    if (err_nrm <= 1) {
+        // Accepted step: PI controller, with growth limited to a factor of 5
+        double factor = err_safety * std::pow(err, -0.7 / order) * std::pow(err_prev, 0.4 / order);
+        double h_proposed = h * std::min(std::max(factor, 0.2), 5.0);
+        h_next = truncated ? std::max(h_next, h_proposed) : h_proposed;
+        err_prev = err;
+        num_accepted++;
+        return true;
+    }
+
+    // Rejected step: reduce step size using the current error only
+    double factor = err_safety * std::pow(err, -1.0 / order);
+    h_next = h * std::min(std::max(factor, 0.2), 0.9);
+    num_rejected++;
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
 // Trick to avoid putting the following mapper macro inside the class definition in .h file:
 // enclose macros in local 'ChTimestepper_Type_enum_mapper', just to avoid avoiding cluttering of the parent class.
 class ChTimestepper_Type_enum_mapper : public ChTimestepper {
@@ -40,6 +72,8 @@ class ChTimestepper_Type_enum_mapper : public ChTimestepper {
     CH_ENUM_VAL(Type::EULER_EXPLICIT);
     CH_ENUM_VAL(Type::LEAPFROG);
     CH_ENUM_VAL(Type::NEWMARK);
+    CH_ENUM_VAL(Type::MULTIRATE);
+    CH_ENUM_VAL(Type::CENTRAL_DIFFERENCE);
     CH_ENUM_VAL(Type::CUSTOM);
     CH_ENUM_MAPPER_END(Type);
 };
@@ -76,6 +110,8 @@ CH_UPCASTING(ChTimestepperEulerExpl, ChExplicitTimestepper)
 // Euler explicit timestepper.
 // This performs the typical  y_new = y+ dy/dt * dt integration with Euler formula.
 void ChTimestepperEulerExpl::Advance(const double dt) {
+    CH_TRACE_ZONE("EulerExpl::Advance");
+
     // setup main vectors
     GetIntegrable()->StateSetup(Y, dYdt);
 
@@ -129,6 +165,8 @@ CH_UPCASTING(ChTimestepperEulerExplIIorder, ChExplicitTimestepper)
 //    v_new = v + a * dt
 // integration with Euler formula.
 void ChTimestepperEulerExplIIorder::Advance(const double dt) {
+    CH_TRACE_ZONE("EulerExplIIorder::Advance");
+
     // downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -184,6 +222,8 @@ CH_UPCASTING(ChTimestepperEulerSemiImplicit, ChExplicitTimestepper)
 //    x_new = x + v_new * dt
 // integration with Euler semi-implicit formula.
 void ChTimestepperEulerSemiImplicit::Advance(const double dt) {
+    CH_TRACE_ZONE("EulerSemiImplicit::Advance");
+
     // downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -235,6 +275,8 @@ CH_UPCASTING(ChTimestepperRungeKuttaExpl, ChExplicitTimestepper)
 
 // Performs a step of a 4th order explicit Runge-Kutta integration scheme.
 void ChTimestepperRungeKuttaExpl::Advance(const double dt) {
+    CH_TRACE_ZONE("RungeKuttaExpl::Advance");
+
     // setup main vectors
     GetIntegrable()->StateSetup(Y, dYdt);
 
@@ -299,6 +341,8 @@ CH_UPCASTING(ChTimestepperHeun, ChExplicitTimestepper)
 
 // Performs a step of a Heun explicit integrator. It is like a 2nd Runge Kutta.
 void ChTimestepperHeun::Advance(const double dt) {
+    CH_TRACE_ZONE("Heun::Advance");
+
     // setup main vectors
     GetIntegrable()->StateSetup(Y, dYdt);
 
@@ -360,6 +404,8 @@ CH_UPCASTING(ChTimestepperLeapfrog, ChExplicitTimestepper)
 // Suggestion: use the ChTimestepperEulerSemiImplicit, it gives
 // the same accuracy with a bit of faster performance.
 void ChTimestepperLeapfrog::Advance(const double dt) {
+    CH_TRACE_ZONE("Leapfrog::Advance");
+
     // downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -407,6 +453,211 @@ void ChTimestepperLeapfrog::ArchiveIn(ChArchiveIn& archive) {
 
 // -----------------------------------------------------------------------------
 
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChTimestepperCentralDifference)
+CH_UPCASTING(ChTimestepperCentralDifference, ChTimestepperIIorder)
+CH_UPCASTING(ChTimestepperCentralDifference, ChExplicitTimestepper)
+
+ChTimestepperCentralDifference::ChTimestepperCentralDifference(ChIntegrableIIorder* intgr)
+    : ChTimestepperIIorder(intgr),
+      substepping(true),
+      safety(0.9),
+      mass_scaling_step(0),
+      critical_step(std::numeric_limits<double>::infinity()),
+      num_substeps(1),
+      initialized(false),
+      T_end(0) {
+    SetDiagonalLumpingON();
+}
+
+void ChTimestepperCentralDifference::SetMassScaling(double target_step) {
+    mass_scaling_step = std::max(0.0, target_step);
+    initialized = false;
+}
+
+void ChTimestepperCentralDifference::Initialize(ChIntegrableIIorder* integrable) {
+    CH_TRACE_ZONE("CentralDifference::Initialize");
+
+    integrable->SetMassScaling(mass_scaling_step);
+    critical_step = integrable->GetCriticalStepSize();
+
+    Md.setZero(integrable->GetNumCoordsVelLevel());
+    double err = 0;
+    integrable->LoadLumpedMass_Md(Md, err, 1.0);
+    if (lumping_parameters)
+        lumping_parameters->error = err;
+
+    if (Md.size() > 0 && Md.minCoeff() <= 0)
+        throw std::runtime_error("ChTimestepperCentralDifference: lumped mass matrix is not positive definite.");
+
+    // Combine with the critical step of the constraint penalty (conservative, since the largest eigenvalue of the sum
+    // of the element and penalty stiffness matrices is not larger than the sum of the largest eigenvalues)
+    double penalty_step = PenaltyCriticalStepSize(integrable);
+    if (std::isfinite(penalty_step))
+        critical_step = std::isfinite(critical_step)
+                            ? 1 / std::sqrt(1 / (critical_step * critical_step) + 1 / (penalty_step * penalty_step))
+                            : penalty_step;
+
+    initialized = true;
+}
+
+double ChTimestepperCentralDifference::PenaltyCriticalStepSize(ChIntegrableIIorder* integrable) {
+    unsigned int nc = integrable->GetNumConstraints();
+    unsigned int nv = integrable->GetNumCoordsVelLevel();
+    if (nc == 0 || nv == 0 || !lumping_parameters || lumping_parameters->Ck_penalty <= 0)
+        return std::numeric_limits<double>::infinity();
+
+    // Power iteration for the largest eigenvalue of Md^-1/2 * Ck * Cq' * Cq * Md^-1/2.
+    // The products with Cq are evaluated by finite differences of the constraint violations.
+    ChVectorDynamic<> s = Md.cwiseSqrt().cwiseInverse();
+    ChVectorDynamic<> C0 = ChVectorDynamic<>::Zero(nc);
+    ChVectorDynamic<> C1(nc);
+    ChVectorDynamic<> Rc(nv);
+    ChStateDelta Dx(nv, integrable);
+    ChState Xp(integrable->GetNumCoordsPosLevel(), integrable);
+
+    integrable->StateScatter(X, V, T, true);
+    integrable->LoadConstraint_C(C0, 1.0);
+    integrable->LoadConstraintJacobians();
+
+    ChVectorDynamic<> z(nv);
+    for (unsigned int i = 0; i < nv; i++)
+        z(i) = 1.0 + 0.5 * std::sin(1.0 + i);
+
+    double lambda = 0;
+    for (int it = 0; it < 30; it++) {
+        z.normalize();
+        double eps = 1e-7 * std::max(1.0, X.lpNorm<Eigen::Infinity>()) / s.cwiseProduct(z).lpNorm<Eigen::Infinity>();
+        Dx = s.cwiseProduct(z) * eps;
+        integrable->StateIncrementX(Xp, X, Dx);
+        integrable->StateScatter(Xp, V, T, true);
+        C1.setZero();
+        integrable->LoadConstraint_C(C1, 1.0);
+        integrable->StateScatter(X, V, T, true);
+
+        Rc.setZero();
+        integrable->LoadResidual_CqL(Rc, (C1 - C0) * (lumping_parameters->Ck_penalty / eps), 1.0);
+        Rc = s.cwiseProduct(Rc);
+
+        double lambda_new = z.dot(Rc);
+        z = Rc;
+        if (z.norm() == 0)
+            break;
+        bool converged = std::abs(lambda_new - lambda) < 1e-3 * std::abs(lambda_new);
+        lambda = lambda_new;
+        if (converged)
+            break;
+    }
+
+    if (lambda <= 0)
+        return std::numeric_limits<double>::infinity();
+    return 2.0 / std::sqrt(lambda);
+}
+
+void ChTimestepperCentralDifference::ComputeAcceleration(ChIntegrableIIorder* integrable) {
+    R.setZero(integrable->GetNumCoordsVelLevel());
+    L.setZero(integrable->GetNumConstraints());
+
+    integrable->LoadResidual_F(R, 1.0);  // R = f
+
+    if (integrable->GetNumConstraints() && lumping_parameters) {
+        integrable->LoadConstraint_C(L, -lumping_parameters->Ck_penalty);  // L  = -k*C
+        integrable->LoadConstraintJacobians();                             // Cq at current state
+        integrable->LoadResidual_CqL(R, L, 1.0);                           // R += Cq'*L
+    }
+
+    A.array() = R.array() / Md.array();  // a = Md^-1 * R
+}
+
+void ChTimestepperCentralDifference::Advance(const double dt) {
+    CH_TRACE_ZONE("CentralDifference::Advance");
+
+    // downcast
+    ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
+
+    // re-initialize if the problem size changed
+    if (Md.size() != mintegrable->GetNumCoordsVelLevel() || A.size() != Md.size())
+        initialized = false;
+
+    // setup main vectors
+    mintegrable->StateSetup(X, V, A);
+    Xnew.setZero(mintegrable->GetNumCoordsPosLevel(), mintegrable);
+
+    mintegrable->StateGather(X, V, T);  // state <- system
+
+    // acceleration at beginning of step (reuse the one of the last step, if still valid)
+    if (!initialized || T != T_end) {
+        if (!initialized)
+            Initialize(mintegrable);
+        mintegrable->StateScatter(X, V, T, true);
+        ComputeAcceleration(mintegrable);
+    }
+
+    num_substeps = 1;
+    if (substepping && std::isfinite(critical_step) && critical_step > 0)
+        num_substeps = std::max(1, (int)std::ceil(dt / (safety * critical_step)));
+    double h = dt / num_substeps;
+
+    for (int k = 0; k < num_substeps; k++) {
+        CH_TRACE_ZONE("CentralDifference::Substep");
+
+        V += A * (0.5 * h);                            // v(n+1/2) = v(n) + h/2 * a(n)
+        mintegrable->StateIncrementX(Xnew, X, V * h);  // x(n+1) = x(n) + h * v(n+1/2)
+        X = Xnew;
+        T += h;
+
+        mintegrable->StateScatter(X, V, T, true);  // state -> system
+        ComputeAcceleration(mintegrable);          // a(n+1), with v(n+1/2) in velocity-dependent forces
+
+        V += A * (0.5 * h);  // v(n+1) = v(n+1/2) + h/2 * a(n+1)
+    }
+
+    T_end = T;
+
+    mintegrable->StateScatter(X, V, T, true);  // state -> system
+    mintegrable->StateScatterAcceleration(A);  // -> system auxiliary data
+    mintegrable->StateScatterReactions(L);     // -> system auxiliary data
+}
+
+void ChTimestepperCentralDifference::SnapshotOut(ChStateSnapshot& snapshot) {
+    ChTimestepperIIorder::SnapshotOut(snapshot);
+    snapshot.Write(T_end);
+    snapshot.WriteVector(A);
+}
+
+void ChTimestepperCentralDifference::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    ChTimestepperIIorder::SnapshotIn(reader);
+    reader.Read(T_end);
+    reader.ReadVector(A);
+}
+
+void ChTimestepperCentralDifference::ArchiveOut(ChArchiveOut& archive) {
+    // version number
+    archive.VersionWrite<ChTimestepperCentralDifference>();
+    // serialize parent class:
+    ChTimestepperIIorder::ArchiveOut(archive);
+    ChExplicitTimestepper::ArchiveOut(archive);
+    // serialize all member data:
+    archive << CHNVP(substepping);
+    archive << CHNVP(safety);
+    archive << CHNVP(mass_scaling_step);
+}
+
+void ChTimestepperCentralDifference::ArchiveIn(ChArchiveIn& archive) {
+    // version number
+    /*int version =*/archive.VersionRead<ChTimestepperCentralDifference>();
+    // deserialize parent class:
+    ChTimestepperIIorder::ArchiveIn(archive);
+    ChExplicitTimestepper::ArchiveIn(archive);
+    // stream in all member data:
+    archive >> CHNVP(substepping);
+    archive >> CHNVP(safety);
+    archive >> CHNVP(mass_scaling_step);
+    initialized = false;
+}
+
+// -----------------------------------------------------------------------------
+
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChTimestepperEulerImplicit)
 CH_UPCASTING(ChTimestepperEulerImplicit, ChTimestepperIIorder)
@@ -414,6 +665,8 @@ CH_UPCASTING(ChTimestepperEulerImplicit, ChImplicitIterativeTimestepper)
 
 // Performs a step of Euler implicit for II order systems
 void ChTimestepperEulerImplicit::Advance(const double dt) {
+    CH_TRACE_ZONE("EulerImplicit::Advance");
+
     // downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -526,6 +779,8 @@ CH_UPCASTING(ChTimestepperEulerImplicitLinearized, ChImplicitTimestepper)
 // If the solver in StateSolveCorrection is a CCP complementarity
 // solver, this is the typical Anitescu stabilized timestepper for DVIs.
 void ChTimestepperEulerImplicitLinearized::Advance(const double dt) {
+    CH_TRACE_ZONE("EulerImplicitLinearized::Advance");
+
     // downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -615,6 +870,8 @@ CH_UPCASTING(ChTimestepperEulerImplicitProjected, ChImplicitTimestepper)
 // If the solver in StateSolveCorrection is a CCP complementarity
 // solver, this is the Tasora stabilized timestepper for DVIs.
 void ChTimestepperEulerImplicitProjected::Advance(const double dt) {
+    CH_TRACE_ZONE("EulerImplicitProjected::Advance");
+
     // downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -726,6 +983,8 @@ CH_UPCASTING(ChTimestepperTrapezoidal, ChImplicitIterativeTimestepper)
 // order in constraint reactions. Use damped HHT or damped Newmark for
 // more advanced options.
 void ChTimestepperTrapezoidal::Advance(const double dt) {
+    CH_TRACE_ZONE("Trapezoidal::Advance");
+
     // downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -840,6 +1099,8 @@ CH_UPCASTING(ChTimestepperTrapezoidalLinearized, ChImplicitIterativeTimestepper)
 
 // Performs a step of trapezoidal implicit linearized for II order systems
 void ChTimestepperTrapezoidalLinearized::Advance(const double dt) {
+    CH_TRACE_ZONE("TrapezoidalLinearized::Advance");
+
     // downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -939,6 +1200,8 @@ CH_UPCASTING(ChTimestepperTrapezoidalLinearized2, ChImplicitIterativeTimestepper
 // Performs a step of trapezoidal implicit linearized for II order systems
 /// SIMPLIFIED VERSION -DOES NOT WORK - PREFER ChTimestepperTrapezoidalLinearized
 void ChTimestepperTrapezoidalLinearized2::Advance(const double dt) {
+    CH_TRACE_ZONE("TrapezoidalLinearized2::Advance");
+
     // downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -1026,6 +1289,7 @@ void ChTimestepperTrapezoidalLinearized2::ArchiveIn(ChArchiveIn& archive) {
 CH_FACTORY_REGISTER(ChTimestepperNewmark)
 CH_UPCASTING(ChTimestepperNewmark, ChTimestepperIIorder)
 CH_UPCASTING(ChTimestepperNewmark, ChImplicitIterativeTimestepper)
+CH_UPCASTING(ChTimestepperNewmark, ChErrorControlTimestepper)
 
 // Set the numerical damping parameter gamma and the beta parameter.
 void ChTimestepperNewmark::SetGammaBeta(double mgamma, double mbeta) {
@@ -1043,6 +1307,8 @@ void ChTimestepperNewmark::SetGammaBeta(double mgamma, double mbeta) {
 
 // Performs a step of Newmark constrained implicit for II order DAE systems
 void ChTimestepperNewmark::Advance(const double dt) {
+    CH_TRACE_ZONE("Newmark::Advance");
+
     // downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -1059,37 +1325,115 @@ void ChTimestepperNewmark::Advance(const double dt) {
     Rold.setZero(mintegrable->GetNumCoordsVelLevel());
     Qc.setZero(mintegrable->GetNumConstraints());
     L.setZero(mintegrable->GetNumConstraints());
+    Lnew.setZero(mintegrable->GetNumConstraints());
 
     mintegrable->StateGather(X, V, T);  // state <- system
     mintegrable->StateGatherAcceleration(A);
 
+    numiters = 0;
+    numsetups = 0;
+    numsolves = 0;
+
+    if (!error_control) {
+        // single step of size dt, accepted even if the Newton iteration did not converge
+        SolveStep(mintegrable, dt);
+
+        X = Xnew;
+        V = Vnew;
+        A = Anew;
+        L = Lnew;
+        T += dt;
+    } else {
+        // internal steps with local error control, until reaching the final time
+        double tfinal = T + dt;
+        if (h_next <= 0 || h_next > dt)
+            h_next = dt;
+
+        while (T < tfinal) {
+            bool last = (h_next >= tfinal - T);
+            bool truncated = (h_next > tfinal - T);
+            double h = last ? tfinal - T : h_next;
+
+            bool converged = SolveStep(mintegrable, h);
+
+            bool accepted = false;
+            if (converged) {
+                // local error estimate for positions, relative to the position increment over the step
+                double err = ErrorNorm((Anew - A) * (h * h * std::abs(beta - 1.0 / 6.0)), Vnew * h);
+                int order = 3;
+
+                // with numerical damping (gamma > 1/2) the method is only first-order accurate: estimate also the
+                // local error for velocities, relative to the velocity increment over the step
+                if (gamma > 0.5) {
+                    double err_v = ErrorNorm((Anew - A) * (h * (gamma - 0.5)), Anew * h);
+                    if (err_v > err) {
+                        err = err_v;
+                        order = 2;
+                    }
+                }
+
+                accepted = ControlStep(h, err, order, truncated);
+            }
+
+            if (accepted) {
+                if (verbose)
+                    std::cout << " Newmark step accepted (" << err_last << ").  T = " << T + h << "  h = " << h
+                              << std::endl;
+                X = Xnew;
+                V = Vnew;
+                A = Anew;
+                L = Lnew;
+                T = last ? tfinal : T + h;
+                continue;
+            }
+
+            // rejected step (Newton not converged or error test failed): retry with smaller step size
+            if (!converged)
+                h_next = h * 0.5;
+
+            if (verbose)
+                std::cout << " ---Newmark step rejected (" << (converged ? "error test" : "no convergence")
+                          << "), reduce stepsize to " << h_next << std::endl;
+
+            if (h_next < 1e-10)
+                throw std::runtime_error("Newmark: Reached minimum allowable step size.");
+
+            mintegrable->StateScatter(X, V, T, false);  // state -> system
+        }
+    }
+
+    mintegrable->StateScatter(X, V, T, true);  // state -> system
+    mintegrable->StateScatterAcceleration(A);  // -> system auxiliary data
+    mintegrable->StateScatterReactions(L);     // -> system auxiliary data
+}
+
+bool ChTimestepperNewmark::SolveStep(ChIntegrableIIorder* mintegrable, double h) {
     // extrapolate a prediction as a warm start
 
+    Anew.setZero(mintegrable->GetNumCoordsVelLevel(), mintegrable);
     Vnew = V;
-    Xnew = X + Vnew * dt;
+    Xnew = X + Vnew * h;
+    Lnew = L;
 
     // use Newton Raphson iteration to solve implicit Newmark for a_new
 
     //
-    // [ M - dt*gamma*dF/dv - dt^2*beta*dF/dx    Cq' ] [ Da   ] = [ -M*(a_new) + f_new + Cq*l_new ]
-    // [ Cq                                      0   ] [ -Dl  ] = [ -1/(beta*dt^2)*C              ]
+    // [ M - h*gamma*dF/dv - h^2*beta*dF/dx    Cq' ] [ Da   ] = [ -M*(a_new) + f_new + Cq*l_new ]
+    // [ Cq                                    0   ] [ -Dl  ] = [ -1/(beta*h^2)*C               ]
 
-    numiters = 0;
-    numsetups = 0;
-    numsolves = 0;
     bool call_setup = true;
 
     for (int i = 0; i < this->GetMaxIters(); ++i) {
-        mintegrable->StateScatter(Xnew, Vnew, T + dt, false);  // state -> system
+        mintegrable->StateScatter(Xnew, Vnew, T + h, false);  // state -> system
 
         R.setZero(mintegrable->GetNumCoordsVelLevel());
         Qc.setZero(mintegrable->GetNumConstraints());
         mintegrable->LoadResidual_F(R, 1.0);          //  f_new
-        mintegrable->LoadResidual_CqL(R, L, 1.0);     //   Cq'*l_new
+        mintegrable->LoadResidual_CqL(R, Lnew, 1.0);  //   Cq'*l_new
         mintegrable->LoadResidual_Mv(R, Anew, -1.0);  //  - M*a_new
         mintegrable->LoadConstraint_C(
-            Qc, (1.0 / (beta * dt * dt)), Qc_do_clamp,
-            Qc_clamping);  //  Qc = 1/(beta*dt^2)*C  (sign will be flipped later in StateSolveCorrection)
+            Qc, (1.0 / (beta * h * h)), Qc_do_clamp,
+            Qc_clamping);  //  Qc = 1/(beta*h^2)*C  (sign will be flipped later in StateSolveCorrection)
 
         if (verbose)
             std::cout << " Newmark iteration=" << i << "  |R|=" << R.lpNorm<Eigen::Infinity>()
@@ -1098,9 +1442,9 @@ void ChTimestepperNewmark::Advance(const double dt) {
         if ((R.lpNorm<Eigen::Infinity>() < abstolS) && (Qc.lpNorm<Eigen::Infinity>() < abstolL)) {
             if (verbose) {
                 std::cout << " Newmark NR converged (" << i << ")."
-                          << "  T = " << T + dt << "  h = " << dt << std::endl;
+                          << "  T = " << T + h << "  h = " << h << std::endl;
             }
-            break;
+            return true;
         }
 
         if (verbose && modified_Newton && call_setup)
@@ -1109,10 +1453,10 @@ void ChTimestepperNewmark::Advance(const double dt) {
         mintegrable->StateSolveCorrection(  //
             Da, Dl, R, Qc,                  //
             1.0,                            // factor for  M
-            -dt * gamma,                    // factor for  dF/dv
-            -dt * dt * beta,                // factor for  dF/dx
-            Xnew, Vnew, T + dt,             // not used here (scatter = false)
-            false,                          // do not scatter update to Xnew Vnew T+dt before computing correction
+            -h * gamma,                     // factor for  dF/dv
+            -h * h * beta,                  // factor for  dF/dx
+            Xnew, Vnew, T + h,              // not used here (scatter = false)
+            false,                          // do not scatter update to Xnew Vnew T+h before computing correction
             false,                          // full update? (not used, since no scatter)
             call_setup                      // force a call to the solver's Setup() function
         );
@@ -1126,22 +1470,25 @@ void ChTimestepperNewmark::Advance(const double dt) {
         // If using modified Newton, do not call Setup again
         call_setup = !modified_Newton;
 
-        L += Dl;  // Note it is not -= Dl because we assume StateSolveCorrection flips sign of Dl
+        Lnew += Dl;  // Note it is not -= Dl because we assume StateSolveCorrection flips sign of Dl
         Anew += Da;
 
-        Xnew = X + V * dt + A * (dt * dt * (0.5 - beta)) + Anew * (dt * dt * beta);
+        Xnew = X + V * h + A * (h * h * (0.5 - beta)) + Anew * (h * h * beta);
 
-        Vnew = V + A * (dt * (1.0 - gamma)) + Anew * (dt * gamma);
+        Vnew = V + A * (h * (1.0 - gamma)) + Anew * (h * gamma);
     }
 
-    X = Xnew;
-    V = Vnew;
-    A = Anew;
-    T += dt;
+    return false;
+}
 
-    mintegrable->StateScatter(X, V, T, true);  // state -> system
-    mintegrable->StateScatterAcceleration(A);  // -> system auxiliary data
-    mintegrable->StateScatterReactions(L);     // -> system auxiliary data
+void ChTimestepperNewmark::SnapshotOut(ChStateSnapshot& snapshot) {
+    ChTimestepperIIorder::SnapshotOut(snapshot);
+    ErrorControlSnapshotOut(snapshot);
+}
+
+void ChTimestepperNewmark::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    ChTimestepperIIorder::SnapshotIn(reader);
+    ErrorControlSnapshotIn(reader);
 }
 
 void ChTimestepperNewmark::ArchiveOut(ChArchiveOut& archive) {
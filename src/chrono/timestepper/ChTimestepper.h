@@ -21,6 +21,7 @@
 #include "chrono/serialization/ChArchive.h"
 #include "chrono/timestepper/ChIntegrable.h"
 #include "chrono/timestepper/ChState.h"
+#include "chrono/timestepper/ChStateSnapshot.h"
 
 namespace chrono {
 
@@ -44,6 +45,8 @@ class ChApi ChTimestepper {
         EULER_EXPLICIT = 8,
         LEAPFROG = 9,
         NEWMARK = 10,
+        MULTIRATE = 11,
+        CENTRAL_DIFFERENCE = 12,
         CUSTOM = 20
     };
 
@@ -80,6 +83,14 @@ class ChApi ChTimestepper {
     /// Turn on/off logging of messages.
     void SetVerbose(bool verb) { verbose = verb; }
 
+    /// Append to the snapshot the integrator history needed to continue the integration from the current state (e.g.
+    /// the current time and internal step size). Used by ChSystem::SaveState.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) { snapshot.Write(T); }
+
+    /// Restore the integrator history from the snapshot, reading the data written by SnapshotOut.
+    /// Used by ChSystem::RestoreState.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) { reader.Read(T); }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& archive);
 
@@ -186,12 +197,17 @@ class ChApi ChExplicitTimestepper {
     /// If lumping not supported because ChIntegrable::LoadLumpedMass_Md() not implemented, throw exception.
     /// If lumping introduces some approximation, you'll get nonzero in GetLumpingError().
     /// Optionally paramters: the stiffness penalty for constraints, and damping penalty for constraints.
-    void SetDiagonalLumpingON(double Ck = 1000, double Cr = 0) { lumping_parameters = new ChLumpingParms(Ck, Cr); }
+    void SetDiagonalLumpingON(double Ck = 1000, double Cr = 0) {
+        if (lumping_parameters)
+            delete (lumping_parameters);
+        lumping_parameters = new ChLumpingParms(Ck, Cr);
+    }
 
     /// Turn off the diagonal lumping (default is off)
     void SetDiagonalLumpingOFF() {
         if (lumping_parameters)
             delete (lumping_parameters);
+        lumping_parameters = nullptr;
     }
 
     /// Gets the diagonal lumping error done last time the integrator has been called
@@ -307,6 +323,88 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
     }
 };
 
+/// Base properties for timesteppers with local error control.
+/// If error control is enabled, the local truncation error of each internal step is estimated and measured in a
+/// weighted RMS norm, using the tolerance atol + rtol * |ref_i| for the i-th component (where ref is a reference vector
+/// provided by the integrator). Steps with an error norm larger than 1 are rejected and retried with a smaller step
+/// size. The size of the next step is selected with a PI controller (Gustafsson) and is bounded by the step size passed
+/// to Advance (e.g., through ChSystem::DoStepDynamics), which thus acts as the maximum internal step size.
+class ChApi ChErrorControlTimestepper {
+  protected:
+    bool error_control;  ///< local error control enabled?
+    double err_reltol;   ///< relative tolerance for the local error test
+    double err_abstol;   ///< absolute tolerance for the local error test
+    double err_safety;   ///< safety factor for the step size selection
+    double err_last;     ///< error norm of the last attempted step
+    double err_prev;     ///< error norm of the last accepted step
+    double h_next;       ///< proposed size of the next step (0 if none)
+
+    unsigned int num_accepted;  ///< number of accepted steps
+    unsigned int num_rejected;  ///< number of rejected steps
+
+  public:
+    ChErrorControlTimestepper()
+        : error_control(false),
+          err_reltol(1e-3),
+          err_abstol(1e-6),
+          err_safety(0.9),
+          err_last(0),
+          err_prev(1),
+          h_next(0),
+          num_accepted(0),
+          num_rejected(0) {}
+    virtual ~ChErrorControlTimestepper() {}
+
+    /// Enable/disable local error control (default: false).
+    void SetErrorControl(bool enable) { error_control = enable; }
+
+    /// Return true if local error control is enabled.
+    bool GetErrorControl() const { return error_control; }
+
+    /// Set the relative and absolute tolerances for the local error test (default: 1e-3 and 1e-6).
+    void SetErrorTolerances(double rel_tol, double abs_tol) {
+        err_reltol = rel_tol;
+        err_abstol = abs_tol;
+    }
+
+    /// Return the total number of accepted steps (with error control enabled).
+    unsigned int GetNumAcceptedSteps() const { return num_accepted; }
+
+    /// Return the total number of steps rejected by the local error test (with error control enabled).
+    unsigned int GetNumRejectedSteps() const { return num_rejected; }
+
+    /// Return the error norm of the last attempted step (the step was accepted if this value is not larger than 1).
+    double GetErrorEstimate() const { return err_last; }
+
+    /// Return the step size proposed for the next step.
+    double GetProposedStepSize() const { return h_next; }
+
+  protected:
+    /// Append the state of the step size controller to the snapshot.
+    void ErrorControlSnapshotOut(ChStateSnapshot& snapshot) const {
+        snapshot.Write(err_last);
+        snapshot.Write(err_prev);
+        snapshot.Write(h_next);
+    }
+
+    /// Restore the state of the step size controller from the snapshot.
+    void ErrorControlSnapshotIn(ChStateSnapshot::Reader& reader) {
+        reader.Read(err_last);
+        reader.Read(err_prev);
+        reader.Read(h_next);
+    }
+
+    /// Return the WRMS norm of the given error vector, using the reference vector to set the component tolerances.
+    double ErrorNorm(const ChVectorDynamic<>& err, const ChVectorDynamic<>& ref) const;
+
+    /// Test the error norm of a step of size h and set the proposed size of the next step.
+    /// The argument 'order' is the order of the local error estimate (i.e., the error scales as h^order). If the step
+    /// was cut short of the proposed step size (e.g., to reach the end of the Advance interval) and is accepted, the
+    /// current proposal is kept unless the controller suggests a larger step.
+    /// Return true if the step is accepted.
+    bool ControlStep(double h, double err_nrm, int order, bool truncated = false);
+};
+
 /// Euler explicit timestepper.
 /// This performs the typical  y_new = y+ dy/dt * dt integration with Euler formula.
 class ChApi ChTimestepperEulerExpl : public ChTimestepperIorder, public ChExplicitTimestepper {
@@ -448,6 +546,92 @@ class ChApi ChTimestepperLeapfrog : public ChTimestepperIIorder, public ChExplic
     virtual void ArchiveIn(ChArchiveIn& archive) override;
 };
 
+/// Central difference explicit integrator for II order systems, with lumped (diagonal) mass.
+/// This is the standard integrator of explicit FEA codes, here in its synchronous (velocity Verlet) form:
+/// <pre>
+///   v(n+1/2) = v(n) + h/2 * a(n)
+///   x(n+1)   = x(n) + h * v(n+1/2)
+///   a(n+1)   = Md^-1 * [ f(x(n+1), v(n+1/2)) + Cq' * l ],   l = -Ck * C
+///   v(n+1)   = v(n+1/2) + h/2 * a(n+1)
+/// </pre>
+/// Each step requires a single force evaluation and no linear solve: the lumped mass Md (see
+/// ChIntegrableIIorder::LoadLumpedMass_Md) is inverted trivially and constraints, if any, are enforced with the penalty
+/// set with SetDiagonalLumpingON (diagonal lumping is always on for this timestepper).
+/// The scheme is only conditionally stable. The critical step is estimated by the integrable object (for a ChSystem,
+/// from its FEA elements, see ChMesh::GetCriticalStepSize), combined with the critical step of the constraint penalty
+/// (for the lumped mass and the penalty stiffness Ck), and, by default, each step is split in substeps no larger than a
+/// fraction of the critical step. The penalty damping Cr and the stiffness of contacts and of force elements other than
+/// FEA elements are not accounted for. Optionally, the lumped mass of elements with a critical step smaller than a
+/// target value can be scaled (selective mass scaling).
+/// The lumped mass and the critical step are evaluated at the first step and then cached; call Reset if masses or
+/// stiffnesses change substantially. The acceleration at the end of a step is reused at the beginning of the next one,
+/// so that changes made between steps (e.g., new contacts) are accounted for starting with the second substep.
+class ChApi ChTimestepperCentralDifference : public ChTimestepperIIorder, public ChExplicitTimestepper {
+  public:
+    ChTimestepperCentralDifference(ChIntegrableIIorder* intgr = nullptr);
+
+    virtual Type GetType() const override { return Type::CENTRAL_DIFFERENCE; }
+
+    /// Enable/disable automatic substepping (default: true).
+    /// If enabled, each step is split in the smallest number of equal substeps not larger than the critical step
+    /// multiplied by the safety factor.
+    void SetAutomaticSubstepping(bool val) { substepping = val; }
+
+    /// Set the safety factor applied to the estimated critical step (default: 0.9).
+    void SetSafetyFactor(double factor) { safety = factor; }
+
+    /// Set the target step for selective mass scaling (default: 0, no mass scaling).
+    /// The lumped mass of all elements with a smaller critical step is increased so that their critical step matches
+    /// the target. This adds mass to the model and alters its dynamics; it should be used with care.
+    void SetMassScaling(double target_step);
+
+    /// Force the evaluation of the lumped mass, of the critical step, and of the acceleration at the next step.
+    void Reset() { initialized = false; }
+
+    /// Return the estimated critical step, including the constraint penalty (infinity if no estimate is available).
+    double GetCriticalStepSize() const { return critical_step; }
+
+    /// Return the number of substeps taken in the last step.
+    int GetNumSubsteps() const { return num_substeps; }
+
+    /// Performs an integration timestep
+    virtual void Advance(const double dt  ///< timestep to advance
+                         ) override;
+
+    /// Append the integrator history to the snapshot.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Restore the integrator history from the snapshot.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOut(ChArchiveOut& archive) override;
+
+    /// Method to allow de-serialization of transient data from archives.
+    virtual void ArchiveIn(ChArchiveIn& archive) override;
+
+  private:
+    /// Evaluate the lumped mass and the critical step.
+    void Initialize(ChIntegrableIIorder* integrable);
+
+    /// Estimate the critical step for the constraint penalty stiffness and the lumped mass (infinity if no constraints).
+    double PenaltyCriticalStepSize(ChIntegrableIIorder* integrable);
+
+    /// Compute the acceleration at the current (scattered) state.
+    void ComputeAcceleration(ChIntegrableIIorder* integrable);
+
+    bool substepping;          ///< split steps in substeps not larger than the critical step?
+    double safety;             ///< safety factor on the critical step
+    double mass_scaling_step;  ///< target step for mass scaling (0 if disabled)
+    double critical_step;      ///< estimated critical step
+    int num_substeps;          ///< number of substeps in last step
+    bool initialized;          ///< lumped mass and critical step available?
+    double T_end;              ///< time at end of last step (acceleration A is valid at this time)
+    ChVectorDynamic<> Md;      ///< lumped mass (diagonal)
+    ChVectorDynamic<> R;       ///< forces
+    ChState Xnew;              ///< new positions
+};
+
 /// Performs a step of Euler implicit for II order systems.
 class ChApi ChTimestepperEulerImplicit : public ChTimestepperIIorder, public ChImplicitIterativeTimestepper {
   protected:
@@ -625,7 +809,15 @@ class ChApi ChTimestepperTrapezoidalLinearized2 : public ChTimestepperIIorder, p
 
 /// Performs a step of Newmark constrained implicit for II order DAE systems.
 /// See Negrut et al. 2007.
-class ChApi ChTimestepperNewmark : public ChTimestepperIIorder, public ChImplicitIterativeTimestepper {
+/// With local error control enabled (see ChErrorControlTimestepper::SetErrorControl), each call to Advance may take
+/// several internal steps. The local error estimate is h^2 * (beta - 1/6) * (a_new - a_old) for the positions
+/// (Zienkiewicz-Xie), with tolerances relative to the position increment over the step. With numerical damping
+/// (gamma > 1/2), the error h * (gamma - 1/2) * (a_new - a_old) for the velocities, with tolerances relative to the
+/// velocity increment over the step, is also tested. Steps for which the Newton iteration does not converge are also
+/// rejected.
+class ChApi ChTimestepperNewmark : public ChTimestepperIIorder,
+                                   public ChImplicitIterativeTimestepper,
+                                   public ChErrorControlTimestepper {
   private:
     double gamma;
     double beta;
@@ -634,11 +826,15 @@ class ChApi ChTimestepperNewmark : public ChTimestepperIIorder, public ChImplici
     ChState Xnew;
     ChStateDelta Vnew;
     ChStateDelta Anew;
+    ChVectorDynamic<> Lnew;
     ChVectorDynamic<> R;
     ChVectorDynamic<> Rold;
     ChVectorDynamic<> Qc;
     bool modified_Newton;
 
+    /// Solve the nonlinear Newmark equations for a step of size h; return true if the Newton iteration converged.
+    bool SolveStep(ChIntegrableIIorder* integrable, double h);
+
   public:
     /// Constructors (default empty)
     ChTimestepperNewmark(ChIntegrableIIorder* intgr = nullptr)
@@ -673,6 +869,12 @@ class ChApi ChTimestepperNewmark : public ChTimestepperIIorder, public ChImplici
     virtual void Advance(const double dt  ///< timestep to advance
                          ) override;
 
+    /// Append the integrator history to the snapshot.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Restore the integrator history from the snapshot.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& archive) override;
 
@@ -12,9 +12,11 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 
 #include "chrono/timestepper/ChTimestepperHHT.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 namespace chrono {
 
@@ -22,6 +24,7 @@ namespace chrono {
 CH_FACTORY_REGISTER(ChTimestepperHHT)
 CH_UPCASTING(ChTimestepperHHT, ChTimestepperIIorder)
 CH_UPCASTING(ChTimestepperHHT, ChImplicitIterativeTimestepper)
+CH_UPCASTING(ChTimestepperHHT, ChErrorControlTimestepper)
 
 ChTimestepperHHT::ChTimestepperHHT(ChIntegrableIIorder* intgr)
     : ChTimestepperIIorder(intgr),
@@ -50,6 +53,8 @@ void ChTimestepperHHT::SetAlpha(double val) {
 
 // Performs a step of HHT (generalized alpha) implicit for II order systems
 void ChTimestepperHHT::Advance(const double dt) {
+    CH_TRACE_ZONE("HHT::Advance");
+
     // Downcast
     ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
 
@@ -82,7 +87,12 @@ void ChTimestepperHHT::Advance(const double dt) {
     // If we had a streak of successful steps, consider a stepsize increase.
     // Note that we never attempt a step larger than the specified dt value.
     // If step size control is disabled, always use h = dt.
-    if (!step_control) {
+    // With error control, start from the step size proposed by the error controller.
+    if (error_control) {
+        if (h_next <= 0 || h_next > dt)
+            h_next = dt;
+        num_successful_steps = 0;
+    } else if (!step_control) {
         h = dt;
         num_successful_steps = 0;
     } else if (num_successful_steps >= req_successful_steps) {
@@ -108,6 +118,16 @@ void ChTimestepperHHT::Advance(const double dt) {
 
     // Loop until reaching final time
     while (true) {
+        // With error control, do not step past the final time
+        bool truncated = false;
+        if (error_control) {
+            truncated = (h_next > tfinal - T);
+            double new_h = std::min(h_next, tfinal - T);
+            if (new_h != h)
+                call_setup = true;
+            h = new_h;
+        }
+
         Prepare(mintegrable);
 
         // Newton for state at T+h
@@ -117,6 +137,8 @@ void ChTimestepperHHT::Advance(const double dt) {
         unsigned int it;
 
         for (it = 0; it < maxiters; it++) {
+            CH_TRACE_ZONE("HHT::Newton iteration");
+
             if (verbose && modified_Newton && call_setup)
                 std::cout << " HHT call Setup." << std::endl;
 
@@ -139,7 +161,21 @@ void ChTimestepperHHT::Advance(const double dt) {
                 break;
         }
 
-        if (converged) {
+        if (converged && error_control && !ControlStep(h, EstimateError(), 3, truncated)) {
+            // ------ NR converged, but the local error test failed
+
+            if (verbose)
+                std::cout << " ---HHT error test failed (" << err_last << "), reduce stepsize to " << h_next
+                          << std::endl;
+
+            // bail out if stepsize reaches minimum allowable
+            if (h_next < h_min) {
+                if (verbose)
+                    std::cerr << " HHT at minimum stepsize. Exiting..." << std::endl;
+                throw std::runtime_error("HHT: Reached minimum allowable step size.");
+            }
+
+        } else if (converged) {
             // ------ NR converged
 
             // if the number of iterations was low enough, increase the count of successive
@@ -181,7 +217,7 @@ void ChTimestepperHHT::Advance(const double dt) {
                 call_setup = true;
             */
 
-        } else if (!step_control) {
+        } else if (!step_control && !error_control) {
             // ------ NR did not converge and we do not control stepsize
 
             // reset the count of successive successful steps
@@ -207,6 +243,7 @@ void ChTimestepperHHT::Advance(const double dt) {
 
             // decrease stepsize
             h *= step_decrease_factor;
+            h_next = h;
 
             if (verbose)
                 std::cout << " ---HHT reduce stepsize to " << h << std::endl;
@@ -242,17 +279,19 @@ void ChTimestepperHHT::Advance(const double dt) {
 }
 
 // Prepare attempting a step of size h (assuming a converged state at the current time t):
-// - Initialize residual vector with terms at current time
+// - Initialize residual vector with terms at current time (with the constraint Jacobians evaluated at the current
+//   state, so that the step depends only on the state and not on the Jacobians left by the last Newton iteration)
 // - Obtain a prediction at T+h for NR using extrapolation from solution at current time.
 // - For ACCELERATION mode, if not using step size control, start with zero acceleration
 //   guess (previous step not guaranteed to have converged)
 // - Set the error weight vectors (using solution at current time)
 void ChTimestepperHHT::Prepare(ChIntegrableIIorder* integrable) {
-    if (step_control)
+    if (step_control || error_control)
         Anew = A;
     Vnew = V + Anew * h;
     Xnew = X + Vnew * h + Anew * (h * h);
     integrable->LoadResidual_F(Rold, -alpha / (1.0 + alpha));       // -alpha/(1.0+alpha) * f_old
+    integrable->LoadConstraintJacobians();                          // Cq at current time (not at the last iterate)
     integrable->LoadResidual_CqL(Rold, L, -alpha / (1.0 + alpha));  // -alpha/(1.0+alpha) * Cq'*l_old
     CalcErrorWeights(A, reltol, abstolS, ewtS);
 
@@ -350,12 +389,32 @@ bool ChTimestepperHHT::CheckConvergence(int it) {
     return converged;
 }
 
+// Estimate the local truncation error in the positions at T+h (Zienkiewicz-Xie estimator), relative to the position
+// increment over the step.
+double ChTimestepperHHT::EstimateError() const {
+    return ErrorNorm((Anew - A) * (h * h * std::abs(beta - 1.0 / 6.0)), Vnew * h);
+}
+
 // Calculate the error weight vector corresponding to the specified solution vector x,
 // using the given relative and absolute tolerances.
 void ChTimestepperHHT::CalcErrorWeights(const ChVectorDynamic<>& x, double rtol, double atol, ChVectorDynamic<>& ewt) {
     ewt = (rtol * x.cwiseAbs() + atol).cwiseInverse();
 }
 
+void ChTimestepperHHT::SnapshotOut(ChStateSnapshot& snapshot) {
+    ChTimestepperIIorder::SnapshotOut(snapshot);
+    snapshot.Write(h);
+    snapshot.Write(num_successful_steps);
+    ErrorControlSnapshotOut(snapshot);
+}
+
+void ChTimestepperHHT::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    ChTimestepperIIorder::SnapshotIn(reader);
+    reader.Read(h);
+    reader.Read(num_successful_steps);
+    ErrorControlSnapshotIn(reader);
+}
+
 void ChTimestepperHHT::ArchiveOut(ChArchiveOut& archive) {
     // version number
     archive.VersionWrite<ChTimestepperHHT>();
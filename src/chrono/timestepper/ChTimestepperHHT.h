@@ -27,7 +27,13 @@ namespace chrono {
 /// Implementation of the HHT implicit integrator for II order systems.
 /// This timestepper allows use of an adaptive time-step, as well as optional use of a modified
 /// Newton scheme for the solution of the resulting nonlinear problem.
-class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIterativeTimestepper {
+/// The step size can be adapted based on the convergence of the Newton iteration (see SetStepControl) and/or on an
+/// estimate of the local truncation error (see ChErrorControlTimestepper::SetErrorControl). The error estimate is
+/// h^2 * (beta - 1/6) * (a_new - a_old) for the positions (Zienkiewicz-Xie), with tolerances relative to the position
+/// increment over the step.
+class ChApi ChTimestepperHHT : public ChTimestepperIIorder,
+                               public ChImplicitIterativeTimestepper,
+                               public ChErrorControlTimestepper {
   public:
     ChTimestepperHHT(ChIntegrableIIorder* intgr = nullptr);
 
@@ -85,6 +91,12 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     /// convergence rate estimate is set to 1.
     double GetEstimatedConvergenceRate() const { return convergence_rate; }
 
+    /// Append the integrator history (including the internal step size) to the snapshot.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Restore the integrator history from the snapshot.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOut(ChArchiveOut& archive) override;
 
@@ -96,6 +108,7 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     void Increment(ChIntegrableIIorder* integrable);
     bool CheckConvergence(int it);
     void CalcErrorWeights(const ChVectorDynamic<>& x, double rtol, double atol, ChVectorDynamic<>& ewt);
+    double EstimateError() const;
 
   private:
     double alpha;  ///< HHT method parameter:  -1/3 <= alpha <= 0
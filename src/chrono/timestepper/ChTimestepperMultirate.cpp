@@ -0,0 +1,138 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2024 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#include "chrono/timestepper/ChTimestepperMultirate.h"
+#include "chrono/utils/ChTraceProfiler.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChTimestepperMultirate)
+CH_UPCASTING(ChTimestepperMultirate, ChTimestepperIIorder)
+CH_UPCASTING(ChTimestepperMultirate, ChImplicitTimestepper)
+
+ChTimestepperMultirate::ChTimestepperMultirate(ChIntegrableIIorder* intgr)
+    : ChTimestepperIIorder(intgr), ChImplicitTimestepper(), num_substeps(10) {}
+
+void ChTimestepperMultirate::SolveStep(ChIntegrableIIorder* integrable, double h) {
+    // Anitescu/Trinkle linearized step (see ChTimestepperEulerImplicitLinearized):
+    //
+    // [ M - h*dF/dv - h^2*dF/dx    Cq' ] [ v_new ] = [ M*(v_old) + h*f]
+    // [ Cq                         0   ] [ -h*l  ] = [ -C/h - Ct ]
+
+    R.setZero(integrable->GetNumCoordsVelLevel());
+    Qc.setZero(integrable->GetNumConstraints());
+
+    integrable->LoadResidual_F(R, h);                                     // R  = h*f
+    integrable->LoadResidual_Mv(R, V, 1.0);                               // R += M*(v_old)
+    integrable->LoadConstraint_C(Qc, 1.0 / h, Qc_do_clamp, Qc_clamping);  // Qc = C/h
+    integrable->LoadConstraint_Ct(Qc, 1.0);                               // Qc += Ct
+
+    integrable->StateSolveCorrection(  //
+        V, L, R, Qc,                   //
+        1.0,                           // factor for  M
+        -h,                            // factor for  dF/dv
+        -h * h,                        // factor for  dF/dx
+        X, V, T + h,                   // not needed
+        false,                         // do not scatter update to Xnew Vnew T+h before computing correction
+        false,                         // full update? (not used, since no scatter)
+        true                           // force a call to the solver's Setup() function
+    );
+}
+
+void ChTimestepperMultirate::Advance(const double dt) {
+    CH_TRACE_ZONE("Multirate::Advance");
+
+    // downcast
+    ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
+
+    // setup main vectors
+    mintegrable->StateSetup(X, V, A);
+    L.setZero(mintegrable->GetNumConstraints());
+
+    mintegrable->StateGather(X, V, T);  // state <- system
+
+    mintegrable->StateGatherReactions(L);  // state <- system (may be needed for warm starting StateSolveCorrection)
+    L *= dt;                               // because reactions = forces, here L = impulses
+
+    Vold = V;
+
+    bool partitioned = num_substeps > 1 && mintegrable->StateGetFastPartition(fast);
+
+    // Macro step on the full system
+    SolveStep(mintegrable, dt);
+
+    if (!partitioned) {
+        L *= (1.0 / dt);
+        mintegrable->StateScatterAcceleration((V - Vold) * (1 / dt));
+        X += V * dt;
+        T += dt;
+        mintegrable->StateScatter(X, V, T, true);  // state -> system
+        mintegrable->StateScatterReactions(L);     // -> system auxiliary data
+        return;
+    }
+
+    // Keep the macro-step velocities of the slow partition only and prescribe them during the substeps
+    for (size_t i = 0; i < fast.size(); i++) {
+        if (fast[i])
+            V(i) = Vold(i);
+    }
+
+    mintegrable->StateRestrictToFastPartition(V);
+
+    // Subcycle the fast partition
+    double h = dt / num_substeps;
+    L *= (h / dt);
+
+    for (int k = 0; k < num_substeps; k++) {
+        CH_TRACE_ZONE("Multirate::Substep");
+
+        SolveStep(mintegrable, h);
+
+        X += V * h;
+        T += h;
+
+        mintegrable->StateScatter(X, V, T, true);  // state -> system
+    }
+
+    mintegrable->StateReleaseFastPartition();
+
+    // Reactions of constraints acting on slow coordinates only are those of the macro step (rescaled above)
+    L *= (1.0 / h);
+
+    mintegrable->StateScatterAcceleration((V - Vold) * (1 / dt));  // -> system auxiliary data
+    mintegrable->StateScatterReactions(L);                         // -> system auxiliary data
+}
+
+void ChTimestepperMultirate::ArchiveOut(ChArchiveOut& archive) {
+    // version number
+    archive.VersionWrite<ChTimestepperMultirate>();
+    // serialize parent class:
+    ChTimestepperIIorder::ArchiveOut(archive);
+    // ChImplicitTimestepper::ArchiveOut(archive);
+    // serialize all member data:
+    archive << CHNVP(num_substeps);
+}
+
+void ChTimestepperMultirate::ArchiveIn(ChArchiveIn& archive) {
+    // version number
+    /*int version =*/archive.VersionRead<ChTimestepperMultirate>();
+    // deserialize parent class:
+    ChTimestepperIIorder::ArchiveIn(archive);
+    // ChImplicitTimestepper::ArchiveIn(archive);
+    // stream in all member data:
+    archive >> CHNVP(num_substeps);
+}
+
+}  // end namespace chrono
@@ -0,0 +1,82 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2024 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#ifndef CHTIMESTEPPER_MULTIRATE_H
+#define CHTIMESTEPPER_MULTIRATE_H
+
+#include <algorithm>
+#include <vector>
+
+#include "chrono/timestepper/ChTimestepper.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_timestepper
+/// @{
+
+/// Multirate linearized implicit Euler timestepper for II order systems.
+/// The state is split in a slow and a fast partition, as reported by ChIntegrableIIorder::StateGetFastPartition (for
+/// a ChSystem, the fast partition consists of all physics items flagged with ChPhysicsItem::SetMultirateFast).
+/// Each step of size H proceeds as follows:
+/// - a macro step of size H (linearized implicit Euler, as in ChTimestepperEulerImplicitLinearized) is taken on the
+///   full system; only the resulting slow velocities are retained;
+/// - the fast partition is then advanced with a number of substeps of size h = H/m, the slow coordinates being
+///   prescribed with the constant macro-step velocities (i.e., slow positions are linearly interpolated over the
+///   macro step). Constraints coupling the two partitions are enforced in each substep on the fast coordinates only.
+///
+/// Only the (smaller) fast partition enters the substep linear solves. Note that the collision detection is performed
+/// only once per macro step.
+/// If the integrable object does not provide a fast partition, or if the number of substeps is 1, a step of this
+/// timestepper is identical to a step of ChTimestepperEulerImplicitLinearized.
+class ChApi ChTimestepperMultirate : public ChTimestepperIIorder, public ChImplicitTimestepper {
+  public:
+    ChTimestepperMultirate(ChIntegrableIIorder* intgr = nullptr);
+
+    /// Return type of the integration method.
+    virtual Type GetType() const override { return Type::MULTIRATE; }
+
+    /// Set the number of substeps of the fast partition in each (macro) step.
+    /// Default: 10.
+    void SetNumSubsteps(int num) { num_substeps = std::max(1, num); }
+
+    /// Return the number of substeps of the fast partition in each (macro) step.
+    int GetNumSubsteps() const { return num_substeps; }
+
+    /// Perform an integration timestep, by advancing the state by the specified (macro) time step.
+    virtual void Advance(const double dt) override;
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOut(ChArchiveOut& archive) override;
+
+    /// Method to allow de-serialization of transient data from archives.
+    virtual void ArchiveIn(ChArchiveIn& archive) override;
+
+  private:
+    /// Load the residuals of a linearized implicit Euler step of size h and solve for the new velocities.
+    void SolveStep(ChIntegrableIIorder* integrable, double h);
+
+  private:
+    int num_substeps;  ///< number of substeps of the fast partition
+
+    ChStateDelta Vold;       ///< velocities at beginning of step
+    ChVectorDynamic<> R;     ///< residual (dynamics portion)
+    ChVectorDynamic<> Qc;    ///< residual (constraints portion)
+    std::vector<bool> fast;  ///< flags for velocity-level coordinates in the fast partition
+};
+
+/// @} chrono_timestepper
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,138 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <atomic>
+#include <thread>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/utils/ChBatchRunner.h"
+#include "chrono/utils/ChProfiler.h"
+
+namespace chrono {
+namespace utils {
+
+ChBatchRunner::ChBatchRunner(int num_threads)
+    : m_threads_chrono(1), m_threads_collision(1), m_threads_eigen(1), m_run_time(0) {
+    SetNumThreads(num_threads);
+}
+
+void ChBatchRunner::SetNumThreads(int num_threads) {
+    if (num_threads <= 0)
+        num_threads = (int)std::thread::hardware_concurrency();
+    m_num_threads = std::max(num_threads, 1);
+}
+
+void ChBatchRunner::SetNumThreadsPerSimulation(int num_threads_chrono,
+                                               int num_threads_collision,
+                                               int num_threads_eigen) {
+    m_threads_chrono = num_threads_chrono;
+    m_threads_collision = num_threads_collision;
+    m_threads_eigen = num_threads_eigen;
+}
+
+void ChBatchRunner::Run(int num_simulations, Factory factory) {
+    m_results.clear();
+    m_results.resize(std::max(num_simulations, 0), Result{false, "", std::vector<double>()});
+
+    ChTimer timer;
+    timer.start();
+
+    // Dynamic scheduling: each worker picks the next pending simulation until none is left.
+    // Each simulation runs to completion on the worker thread that created it.
+    std::atomic<int> next(0);
+    auto worker = [&]() {
+        int index;
+        while ((index = next++) < num_simulations)
+            RunSimulation(index, factory);
+    };
+
+    int num_workers = std::min(m_num_threads, num_simulations);
+
+#ifndef CH_NO_PROFILE
+    // The built-in profiler is not thread-safe
+    bool profiling = utils::ChProfileManager::IsEnabled();
+    if (num_workers > 1)
+        utils::ChProfileManager::Enable(false);
+#endif
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < num_workers; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+        thread.join();
+
+#ifndef CH_NO_PROFILE
+    utils::ChProfileManager::Enable(profiling);
+#endif
+
+    timer.stop();
+    m_run_time = timer();
+}
+
+void ChBatchRunner::RunSimulation(int index, const Factory& factory) {
+    auto& result = m_results[index];
+    try {
+        auto sim = factory(index);
+        if (!sim)
+            throw std::runtime_error("factory returned no simulation");
+
+        if (auto sys = sim->GetSystem())
+            sys->SetNumThreads(m_threads_chrono, m_threads_collision, m_threads_eigen);
+
+        while (sim->Advance()) {
+        }
+
+        result.output = sim->GetOutput();
+        result.success = true;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    } catch (...) {
+        result.error = "unknown error";
+    }
+}
+
+// Process-wide cache of shared meshes.
+static ChSharedCache<ChTriangleMeshConnected>& SharedMeshes() {
+    static ChSharedCache<ChTriangleMeshConnected> meshes;
+    return meshes;
+}
+
+static std::string SharedMeshKey(const std::string& filename, bool load_normals, bool load_uv) {
+    return filename + (load_normals ? "|n" : "|") + (load_uv ? "uv" : "");
+}
+
+std::shared_ptr<ChTriangleMeshConnected> ChBatchRunner::GetSharedMesh(const std::string& filename,
+                                                                      bool load_normals,
+                                                                      bool load_uv) {
+    return SharedMeshes().Get(SharedMeshKey(filename, load_normals, load_uv), [&]() {
+        auto mesh = ChTriangleMeshConnected::CreateFromWavefrontFile(filename, load_normals, load_uv);
+        if (!mesh)
+            throw std::runtime_error("Cannot load mesh file " + filename);
+        return mesh;
+    });
+}
+
+bool ChBatchRunner::ReleaseSharedMesh(const std::string& filename, bool load_normals, bool load_uv) {
+    return SharedMeshes().Remove(SharedMeshKey(filename, load_normals, load_uv));
+}
+
+void ChBatchRunner::ClearSharedMeshes() {
+    SharedMeshes().Clear();
+}
+
+size_t ChBatchRunner::GetNumSharedMeshes() {
+    return SharedMeshes().Size();
+}
+
+}  // end namespace utils
+}  // end namespace chrono
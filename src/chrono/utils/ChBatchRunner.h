@@ -0,0 +1,208 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Utilities for running batches of independent simulations (e.g., parameter
+// sweeps) concurrently in a single process.
+//
+// =============================================================================
+
+#ifndef CH_BATCH_RUNNER_H
+#define CH_BATCH_RUNNER_H
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Thread-safe cache of read-only data, loaded once and shared by all users (e.g., the simulations in a batch).
+/// Data is identified by a string key (e.g., a file name). Concurrent requests for the same key wait for a single
+/// load. The cached data is shared, and must not be modified by its users.
+template <typename T>
+class ChSharedCache {
+  public:
+    typedef std::function<std::shared_ptr<T>()> Loader;
+
+    /// Return the data with given key, invoking the loader if the data is not yet cached.
+    /// If the loader throws, the exception is propagated to all waiting callers and the key is not cached.
+    std::shared_ptr<T> Get(const std::string& key, Loader loader) {
+        std::promise<std::shared_ptr<T>> promise;
+        std::shared_future<std::shared_ptr<T>> future;
+        bool load = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_data.find(key);
+            if (it == m_data.end()) {
+                future = promise.get_future().share();
+                m_data.emplace(key, future);
+                load = true;
+            } else {
+                future = it->second;
+            }
+        }
+
+        if (load) {
+            try {
+                promise.set_value(loader());
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_data.erase(key);
+                }
+                promise.set_exception(std::current_exception());
+            }
+        }
+
+        return future.get();
+    }
+
+    /// Return the number of cached data entries.
+    size_t Size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_data.size();
+    }
+
+    /// Remove the data with given key from the cache and return true if it was cached.
+    /// Data still in use is kept alive by its users; a later request for the key loads the data again.
+    bool Remove(const std::string& key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_data.erase(key) > 0;
+    }
+
+    /// Remove all cached data (data still in use is kept alive by its users).
+    void Clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_data.clear();
+    }
+
+  private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_future<std::shared_ptr<T>>> m_data;
+};
+
+/// Runner for a batch of independent simulations (e.g., a parameter sweep), executed concurrently in one process.
+/// Simulations are created by a user-provided factory and are scheduled dynamically on a pool of worker threads:
+/// each worker repeatedly picks the next pending simulation, creates it, advances it to completion, and collects its
+/// output in memory. A simulation is created, run, and destroyed on a single worker thread. Since concurrency is
+/// obtained across simulations, the Chrono system of each simulation is set to run single-threaded by default (see
+/// SetNumThreadsPerSimulation). Read-only data can be loaded once and shared across all simulations using a
+/// ChSharedCache; the runner provides such a cache for OBJ meshes (see GetSharedMesh). Other resources read by the
+/// Chrono loaders (e.g., vehicle JSON specification files and tire data tables) are not shared and are loaded by each
+/// simulation.
+class ChApi ChBatchRunner {
+  public:
+    /// Base class for a simulation in a batch.
+    class ChApi Simulation {
+      public:
+        virtual ~Simulation() {}
+
+        /// Return the Chrono system of this simulation, if any.
+        /// If provided, the number of threads used by the system is set as specified in SetNumThreadsPerSimulation.
+        virtual ChSystem* GetSystem() { return nullptr; }
+
+        /// Advance the simulation (e.g., by one step). Return false once the simulation is complete.
+        virtual bool Advance() = 0;
+
+        /// Return the simulation results. This function is called once, after the simulation completed.
+        virtual std::vector<double> GetOutput() { return std::vector<double>(); }
+    };
+
+    /// Factory for the simulations in a batch, invoked with the index of the simulation to be created.
+    /// Note that the factory is called concurrently from the worker threads.
+    typedef std::function<std::unique_ptr<Simulation>(int index)> Factory;
+
+    /// Construct a batch runner with the specified number of worker threads.
+    /// If num_threads = 0, use the number of hardware threads.
+    ChBatchRunner(int num_threads = 0);
+
+    /// Set the number of worker threads (if 0, use the number of hardware threads).
+    void SetNumThreads(int num_threads);
+
+    /// Get the number of worker threads.
+    int GetNumThreads() const { return m_num_threads; }
+
+    /// Set the number of threads used by the Chrono system of each simulation (default: 1, 1, 1).
+    /// See ChSystem::SetNumThreads.
+    void SetNumThreadsPerSimulation(int num_threads_chrono, int num_threads_collision, int num_threads_eigen);
+
+    /// Create and run the specified number of simulations, using the given factory.
+    /// This function returns after all simulations completed. Exceptions thrown by a simulation are caught and
+    /// reported through GetError.
+    void Run(int num_simulations, Factory factory);
+
+    /// Get the number of simulations in the last batch.
+    int GetNumSimulations() const { return (int)m_results.size(); }
+
+    /// Return true if the specified simulation in the last batch completed without errors.
+    bool Succeeded(int index) const { return m_results[index].success; }
+
+    /// Return the error message for the specified simulation in the last batch (empty if no errors).
+    const std::string& GetError(int index) const { return m_results[index].error; }
+
+    /// Return the output of the specified simulation in the last batch.
+    const std::vector<double>& GetOutput(int index) const { return m_results[index].output; }
+
+    /// Return the wall-clock time (in seconds) for running the last batch.
+    double GetRunTime() const { return m_run_time; }
+
+    /// Return a triangle mesh loaded from the given Wavefront OBJ file, shared by all users in the process.
+    /// The mesh is loaded only once and must be treated as read-only. Cached meshes are kept until released with
+    /// ReleaseSharedMesh or ClearSharedMeshes.
+    static std::shared_ptr<ChTriangleMeshConnected> GetSharedMesh(const std::string& filename,
+                                                                  bool load_normals = true,
+                                                                  bool load_uv = false);
+
+    /// Evict the shared mesh loaded with the given arguments from the cache and return true if it was cached.
+    /// The mesh is freed once no longer used.
+    static bool ReleaseSharedMesh(const std::string& filename, bool load_normals = true, bool load_uv = false);
+
+    /// Evict all shared meshes from the cache. Meshes are freed once no longer used.
+    static void ClearSharedMeshes();
+
+    /// Return the number of cached shared meshes.
+    static size_t GetNumSharedMeshes();
+
+  private:
+    struct Result {
+        bool success;
+        std::string error;
+        std::vector<double> output;
+    };
+
+    void RunSimulation(int index, const Factory& factory);
+
+    int m_num_threads;
+    int m_threads_chrono;
+    int m_threads_collision;
+    int m_threads_eigen;
+    std::vector<Result> m_results;
+    double m_run_time;
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
@@ -27,6 +27,7 @@
 
 #ifndef CH_NO_PROFILE
 
+    #include <atomic>
     #include <cstdio>
     #include <new>
     #include <cfloat>
@@ -109,6 +110,12 @@ class ChApi ChProfileManager {
     static void Start_Profile(const char* name);
     static void Stop_Profile(void);
 
+    /// Enable/disable profiling (default: enabled).
+    /// The profile tree is shared by all threads; profiling must be disabled while several systems are simulated
+    /// concurrently (see utils::ChBatchRunner).
+    static void Enable(bool val) { Enabled = val; }
+    static bool IsEnabled() { return Enabled; }
+
     static void CleanupMemory(void) { Root.CleanupMemory(); }
 
     static void Reset(void);
@@ -128,14 +135,24 @@ class ChApi ChProfileManager {
     static ChProfileNode* CurrentNode;
     static int FrameCounter;
     static unsigned long int ResetTime;
+    static std::atomic<bool> Enabled;
 };
 
 /// Simple way to profile a function's scope.
 class ChApi ChProfileSample {
   public:
-    ChProfileSample(const char* name) { ChProfileManager::Start_Profile(name); }
+    ChProfileSample(const char* name) : m_active(ChProfileManager::IsEnabled()) {
+        if (m_active)
+            ChProfileManager::Start_Profile(name);
+    }
+
+    ~ChProfileSample(void) {
+        if (m_active)
+            ChProfileManager::Stop_Profile();
+    }
 
-    ~ChProfileSample(void) { ChProfileManager::Stop_Profile(); }
+  private:
+    bool m_active;
 };
 
 }  // end namespace utils
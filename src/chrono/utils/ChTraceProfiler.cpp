@@ -0,0 +1,205 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2024 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+
+#include "chrono/utils/ChTraceProfiler.h"
+
+namespace chrono {
+namespace utils {
+
+// Buffer of the current thread (buffers are owned by the profiler and never released).
+static thread_local void* tls_buffer = nullptr;
+
+ChTraceProfiler& ChTraceProfiler::GetInstance() {
+    static ChTraceProfiler profiler;
+    return profiler;
+}
+
+ChTraceProfiler::ChTraceProfiler()
+    : m_enabled(false), m_step(-1), m_max_zones(1 << 20), m_origin(std::chrono::steady_clock::now()) {}
+
+ChTraceProfiler::ThreadBuffer& ChTraceProfiler::GetThreadBuffer() {
+    if (!tls_buffer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto buffer = new ThreadBuffer;
+        buffer->id = (int)m_buffers.size();
+        buffer->name = "thread " + std::to_string(buffer->id);
+        buffer->current = -1;
+        buffer->dropped_open = 0;
+        buffer->dropped = 0;
+        m_buffers.push_back(std::unique_ptr<ThreadBuffer>(buffer));
+        tls_buffer = buffer;
+    }
+    return *static_cast<ThreadBuffer*>(tls_buffer);
+}
+
+void ChTraceProfiler::BeginZone(const char* name) {
+    auto& buffer = GetThreadBuffer();
+    if (buffer.zones.size() >= GetMaxZonesPerThread()) {
+        // Buffer full: drop the zone (all zones dropped from now on are nested in the innermost recorded one)
+        buffer.dropped_open++;
+        buffer.dropped++;
+        return;
+    }
+    buffer.zones.push_back({name, Now(), -1, buffer.current, GetStep()});
+    buffer.current = (int)buffer.zones.size() - 1;
+}
+
+void ChTraceProfiler::EndZone() {
+    auto& buffer = GetThreadBuffer();
+    if (buffer.dropped_open > 0) {
+        buffer.dropped_open--;
+        return;
+    }
+    if (buffer.current < 0)
+        return;
+    auto& zone = buffer.zones[buffer.current];
+    zone.end = Now();
+    buffer.current = zone.parent;
+}
+
+void ChTraceProfiler::SetThreadName(const std::string& name) {
+    auto& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    buffer.name = name;
+}
+
+void ChTraceProfiler::Reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& buffer : m_buffers) {
+        buffer->zones.clear();
+        buffer->current = -1;
+        buffer->dropped_open = 0;
+        buffer->dropped = 0;
+    }
+    m_step.store(-1, std::memory_order_relaxed);
+}
+
+size_t ChTraceProfiler::GetNumZones() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t num_zones = 0;
+    for (const auto& buffer : m_buffers)
+        num_zones += buffer->zones.size();
+    return num_zones;
+}
+
+size_t ChTraceProfiler::GetNumDroppedZones() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t num_dropped = 0;
+    for (const auto& buffer : m_buffers)
+        num_dropped += buffer->dropped;
+    return num_dropped;
+}
+
+std::string ChTraceProfiler::GetZonePath(const ThreadBuffer& buffer, int index) {
+    std::string path = buffer.zones[index].name;
+    for (int p = buffer.zones[index].parent; p >= 0; p = buffer.zones[p].parent)
+        path = std::string(buffer.zones[p].name) + "/" + path;
+    return path;
+}
+
+// Write a string as a JSON string literal.
+static void WriteJSONString(std::ostream& os, const std::string& str) {
+    os << '"';
+    for (auto c : str) {
+        if (c == '"' || c == '\\')
+            os << '\\';
+        os << c;
+    }
+    os << '"';
+}
+
+bool ChTraceProfiler::WriteChromeTrace(const std::string& filename) const {
+    std::ofstream os(filename);
+    if (!os.is_open())
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    for (const auto& buffer : m_buffers) {
+        // Thread name metadata event
+        os << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << buffer->id
+           << ",\"args\":{\"name\":";
+        WriteJSONString(os, buffer->name);
+        os << "}}";
+        first = false;
+
+        // Complete events (timestamps in microseconds); zones still open are not reported
+        for (const auto& zone : buffer->zones) {
+            if (zone.end < 0)
+                continue;
+            os << ",\n{\"ph\":\"X\",\"name\":";
+            WriteJSONString(os, zone.name);
+            os << ",\"pid\":0,\"tid\":" << buffer->id << ",\"ts\":" << 1e-3 * zone.start
+               << ",\"dur\":" << 1e-3 * (zone.end - zone.start) << ",\"args\":{\"step\":" << zone.step << "}}";
+        }
+    }
+
+    os << "\n]}\n";
+
+    return true;
+}
+
+bool ChTraceProfiler::WriteStepSummary(const std::string& filename) const {
+    std::ofstream os(filename);
+    if (!os.is_open())
+        return false;
+
+    // Statistics for a given zone path within a step
+    struct Stats {
+        int calls = 0;
+        std::map<int, int64_t> thread_time;  // accumulated time per thread
+    };
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::map<std::pair<int, std::string>, Stats> stats;
+    for (const auto& buffer : m_buffers) {
+        for (int i = 0; i < (int)buffer->zones.size(); i++) {
+            const auto& zone = buffer->zones[i];
+            if (zone.end < 0)
+                continue;
+            auto& s = stats[std::make_pair(zone.step, GetZonePath(*buffer, i))];
+            s.calls++;
+            s.thread_time[buffer->id] += zone.end - zone.start;
+        }
+    }
+
+    os << "step,zone,calls,threads,total_ms,max_thread_ms\n";
+    os << std::setprecision(6);
+    for (const auto& entry : stats) {
+        const auto& s = entry.second;
+        int64_t total = 0;
+        int64_t max_thread = 0;
+        for (const auto& t : s.thread_time) {
+            total += t.second;
+            max_thread = std::max(max_thread, t.second);
+        }
+        os << entry.first.first << "," << entry.first.second << "," << s.calls << "," << s.thread_time.size() << ","
+           << 1e-6 * total << "," << 1e-6 * max_thread << "\n";
+    }
+
+    return true;
+}
+
+}  // end namespace utils
+}  // end namespace chrono
@@ -0,0 +1,213 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2024 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: Radu Serban
+// =============================================================================
+//
+// Thread-aware hierarchical profiler based on scoped zones.
+//
+// Instrumentation macros (CH_TRACE_ZONE, CH_TRACE_BEGIN, CH_TRACE_END, CH_TRACE_STEP) expand to nothing unless Chrono
+// was configured with ENABLE_TRACE_PROFILER (which defines CHRONO_TRACE_PROFILER in ChConfig.h). When compiled in,
+// recording must still be turned on at run time with ChTraceProfiler::GetInstance().Enable(true).
+//
+// =============================================================================
+
+#ifndef CH_TRACE_PROFILER_H
+#define CH_TRACE_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "chrono/ChConfig.h"
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Low-overhead, thread-aware hierarchical profiler.
+/// Each thread records the zones it enters and exits in its own buffer (no locking after the first zone recorded by
+/// a thread). Zones are nested per thread, with simulation steps delimited by calls to NewStep (see CH_TRACE_STEP).
+/// Recorded data can be exported as:
+/// - a Chrome trace (JSON format readable by chrome://tracing or https://ui.perfetto.dev), showing the timeline of
+///   all zones on all threads;
+/// - a per-step CSV summary, listing for each step and each zone path the number of calls, the number of threads
+///   which executed the zone, the total time, and the largest time spent by any single thread (load imbalance).
+///
+/// Zone names must be string literals (or otherwise have static storage duration), as only their address is stored.
+/// The number of zones recorded by each thread is limited (see SetMaxZonesPerThread); once a thread buffer is full,
+/// further zones on that thread are dropped (and counted, see GetNumDroppedZones) until the next Reset.
+/// The profiler must not be reset, queried, or exported while other threads are recording zones: call these functions
+/// between simulation steps or after disabling recording.
+class ChApi ChTraceProfiler {
+  public:
+    /// Return the profiler instance.
+    static ChTraceProfiler& GetInstance();
+
+    /// Enable/disable recording (default: false).
+    /// Recording should only be toggled between simulation steps, so that all zones are properly closed.
+    void Enable(bool val) { m_enabled.store(val, std::memory_order_relaxed); }
+
+    /// Return true if recording is enabled.
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    /// Mark the start of a new simulation step.
+    void NewStep() { m_step.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Return the current step index (-1 before the first step).
+    int GetStep() const { return m_step.load(std::memory_order_relaxed); }
+
+    /// Enter a zone with the given name on the calling thread.
+    void BeginZone(const char* name);
+
+    /// Exit the innermost open zone on the calling thread.
+    void EndZone();
+
+    /// Set the maximum number of zones recorded by each thread (default: 2^20).
+    /// Should be set before recording starts; buffers already larger than the new limit are not truncated.
+    void SetMaxZonesPerThread(size_t max_zones) { m_max_zones.store(max_zones, std::memory_order_relaxed); }
+
+    /// Return the maximum number of zones recorded by each thread.
+    size_t GetMaxZonesPerThread() const { return m_max_zones.load(std::memory_order_relaxed); }
+
+    /// Set a name for the calling thread (used in the Chrome trace).
+    void SetThreadName(const std::string& name);
+
+    /// Discard all recorded zones and reset the step counter.
+    void Reset();
+
+    /// Return the total number of recorded zones (over all threads).
+    size_t GetNumZones() const;
+
+    /// Return the total number of zones dropped because a thread buffer was full (over all threads).
+    size_t GetNumDroppedZones() const;
+
+    /// Write the recorded zones in Chrome trace event format.
+    /// Zones still open are not reported. Must not be called while other threads are recording zones.
+    /// Return false if the output file could not be opened.
+    bool WriteChromeTrace(const std::string& filename) const;
+
+    /// Write a per-step summary of the recorded zones in CSV format.
+    /// Zones still open are not reported. Must not be called while other threads are recording zones.
+    /// Return false if the output file could not be opened.
+    bool WriteStepSummary(const std::string& filename) const;
+
+  private:
+    /// Recorded zone.
+    struct Zone {
+        const char* name;  ///< zone name
+        int64_t start;     ///< start time (ns since profiler creation)
+        int64_t end;       ///< end time (ns since profiler creation; -1 if still open)
+        int parent;        ///< index of enclosing zone in the thread buffer (-1 if none)
+        int step;          ///< step index at zone entry
+    };
+
+    /// Per-thread zone buffer.
+    struct ThreadBuffer {
+        int id;                   ///< thread identifier (in order of registration)
+        std::string name;         ///< thread name
+        std::vector<Zone> zones;  ///< recorded zones, in order of entry
+        int current;              ///< index of innermost open zone (-1 if none)
+        int dropped_open;         ///< number of open dropped zones (nested in the innermost recorded zone)
+        size_t dropped;           ///< number of dropped zones
+    };
+
+    ChTraceProfiler();
+
+    /// Return the buffer of the calling thread, creating it if needed.
+    ThreadBuffer& GetThreadBuffer();
+
+    /// Return the time (in ns) elapsed since the profiler was created.
+    int64_t Now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_origin)
+            .count();
+    }
+
+    /// Return the path of the given zone (names of all enclosing zones, separated by '/').
+    static std::string GetZonePath(const ThreadBuffer& buffer, int index);
+
+    std::atomic<bool> m_enabled;                           ///< recording enabled?
+    std::atomic<int> m_step;                               ///< current step index
+    std::atomic<size_t> m_max_zones;                       ///< maximum number of zones per thread
+    std::chrono::steady_clock::time_point m_origin;        ///< time origin
+    mutable std::mutex m_mutex;                            ///< guard for thread buffer registration
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;  ///< thread buffers, in order of registration
+};
+
+/// Scoped profiler zone.
+/// The zone is entered at construction and exited at destruction. Nothing is recorded if the profiler is disabled
+/// at construction time.
+class ChTraceZone {
+  public:
+    ChTraceZone(const char* name) : m_active(ChTraceProfiler::GetInstance().IsEnabled()) {
+        if (m_active)
+            ChTraceProfiler::GetInstance().BeginZone(name);
+    }
+
+    ~ChTraceZone() {
+        if (m_active)
+            ChTraceProfiler::GetInstance().EndZone();
+    }
+
+    ChTraceZone(const ChTraceZone&) = delete;
+    ChTraceZone& operator=(const ChTraceZone&) = delete;
+
+  private:
+    bool m_active;
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#ifdef CHRONO_TRACE_PROFILER
+
+    #define CH_TRACE_CONCAT_IMPL(a, b) a##b
+    #define CH_TRACE_CONCAT(a, b) CH_TRACE_CONCAT_IMPL(a, b)
+
+    /// Profile the enclosing scope as a zone with the given name.
+    #define CH_TRACE_ZONE(name) chrono::utils::ChTraceZone CH_TRACE_CONCAT(ch_trace_zone_, __LINE__)(name)
+
+    /// Enter a zone with the given name (must be paired with CH_TRACE_END in the same thread).
+    #define CH_TRACE_BEGIN(name)                                              \
+        do {                                                                  \
+            if (chrono::utils::ChTraceProfiler::GetInstance().IsEnabled())    \
+                chrono::utils::ChTraceProfiler::GetInstance().BeginZone(name); \
+        } while (0)
+
+    /// Exit the zone entered with the last CH_TRACE_BEGIN.
+    #define CH_TRACE_END()                                                 \
+        do {                                                               \
+            if (chrono::utils::ChTraceProfiler::GetInstance().IsEnabled()) \
+                chrono::utils::ChTraceProfiler::GetInstance().EndZone();   \
+        } while (0)
+
+    /// Mark the start of a new simulation step.
+    #define CH_TRACE_STEP() chrono::utils::ChTraceProfiler::GetInstance().NewStep()
+
+#else
+
+    #define CH_TRACE_ZONE(name)
+    #define CH_TRACE_BEGIN(name)
+    #define CH_TRACE_END()
+    #define CH_TRACE_STEP()
+
+#endif
+
+#endif
@@ -2831,6 +2831,9 @@ void ChModalAssembly::InjectVariables(ChSystemDescriptor& descriptor) {
     if (m_is_model_reduced) {
         descriptor.InsertVariables(this->modal_variables);
     } else {
+        // The internal items form a substructure, which can be condensed on the boundary (see
+        // ChSolverStaticCondensation)
+        descriptor.BeginSubstructure(GetIdentifier());
         for (auto& body : internal_bodylist) {
             body->InjectVariables(descriptor);
         }
@@ -2843,6 +2846,7 @@ void ChModalAssembly::InjectVariables(ChSystemDescriptor& descriptor) {
         for (auto& item : internal_otherphysicslist) {
             item->InjectVariables(descriptor);
         }
+        descriptor.EndSubstructure();
     }
 }
 
@@ -2850,6 +2854,7 @@ void ChModalAssembly::InjectConstraints(ChSystemDescriptor& descriptor) {
     ChAssembly::InjectConstraints(descriptor);  // parent
 
     if (!m_is_model_reduced) {
+        descriptor.BeginSubstructure(GetIdentifier());
         for (auto& body : internal_bodylist) {
             body->InjectConstraints(descriptor);
         }
@@ -2862,6 +2867,7 @@ void ChModalAssembly::InjectConstraints(ChSystemDescriptor& descriptor) {
         for (auto& item : internal_otherphysicslist) {
             item->InjectConstraints(descriptor);
         }
+        descriptor.EndSubstructure();
     } else {
         // there is no internal Lagrange multiplier in the reduced state
     }
@@ -48,7 +48,8 @@ void ChSolverMumps::SetMatrixSymmetryType(MatrixSymmetryType symmetry) {
 
 bool ChSolverMumps::FactorizeMatrix() {
     m_engine.SetMatrix(m_mat);
-    auto mumps_err = m_engine.MumpsCall(ChMumpsEngine::mumps_JOB::ANALYZE_FACTORIZE);
+    auto mumps_err = m_engine.MumpsCall(PatternChanged() ? ChMumpsEngine::mumps_JOB::ANALYZE_FACTORIZE
+                                                         : ChMumpsEngine::mumps_JOB::FACTORIZE);
     return (mumps_err == 0);
 }
 
@@ -22,7 +22,9 @@ ChSolverPardisoMKL::ChSolverPardisoMKL(unsigned int num_threads) {
 }
 
 bool ChSolverPardisoMKL::FactorizeMatrix() {
-    m_engine.compute(m_mat);
+    if (PatternChanged())
+        m_engine.analyzePattern(m_mat);
+    m_engine.factorize(m_mat);
     return (m_engine.info() == Eigen::Success);
 }
 
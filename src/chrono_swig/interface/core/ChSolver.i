@@ -53,6 +53,7 @@ Type GetType() const { return chrono::ChSolver::Type::CUSTOM; }
 #include "chrono/solver/ChSolverVI.h"
 #include "chrono/solver/ChSolverLS.h"
 #include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChSolverStaticCondensation.h"
 #include "chrono/solver/ChIterativeSolver.h"
 #include "chrono/solver/ChIterativeSolverLS.h"
 #include "chrono/solver/ChIterativeSolverVI.h"
@@ -83,6 +84,8 @@ using namespace chrono;
 %shared_ptr(chrono::ChSolverPJacobi)
 %shared_ptr(chrono::ChSolverSparseLU)
 %shared_ptr(chrono::ChSolverSparseQR)
+%shared_ptr(chrono::ChSolverSparseCholesky)
+%shared_ptr(chrono::ChSolverStaticCondensation)
 %shared_ptr(chrono::ChSolverADMM)
 
 // Parse the header file to generate wrappers
@@ -90,6 +93,7 @@ using namespace chrono;
 %include "../../../chrono/solver/ChSolverVI.h"
 %include "../../../chrono/solver/ChSolverLS.h"
 %include "../../../chrono/solver/ChDirectSolverLS.h"
+%include "../../../chrono/solver/ChSolverStaticCondensation.h"
 %include "../../../chrono/solver/ChIterativeSolver.h"
 %include "../../../chrono/solver/ChIterativeSolverLS.h"
 %include "../../../chrono/solver/ChIterativeSolverVI.h"
@@ -117,3 +121,5 @@ using namespace chrono;
 
 %DefSharedPtrDynamicCast(chrono, ChDirectSolverLS, ChSolverSparseQR)
 %DefSharedPtrDynamicCast(chrono, ChDirectSolverLS, ChSolverSparseLU)
+%DefSharedPtrDynamicCast(chrono, ChDirectSolverLS, ChSolverSparseCholesky)
+%DefSharedPtrDynamicCast(chrono, ChDirectSolverLS, ChSolverStaticCondensation)
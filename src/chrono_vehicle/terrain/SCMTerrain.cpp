@@ -17,11 +17,13 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 #include <queue>
 #include <unordered_set>
 #include <limits>
+#include <stdexcept>
 
 #ifdef _OPENMP
     #include <omp.h>
@@ -33,6 +35,7 @@
 #include "chrono/assets/ChTexture.h"
 #include "chrono/assets/ChVisualShapeBox.h"
 #include "chrono/utils/ChConvexHull.h"
+#include "chrono/utils/ChTraceProfiler.h"
 #include "chrono/utils/ChUtils.h"
 
 #include "chrono_vehicle/ChVehicleModelData.h"
@@ -249,6 +252,25 @@ void SCMTerrain::SetModifiedNodes(const std::vector<NodeLevel>& nodes) {
     m_loader->SetModifiedNodes(nodes);
 }
 
+// Enable/disable storage of node records in dense tiles.
+void SCMTerrain::EnableTiledNodeStorage(bool val) {
+    m_loader->m_grid_map.SetTiled(val);
+}
+
+int SCMTerrain::GetNumNodeTiles() const {
+    return m_loader->m_grid_map.IsTiled() ? (int)m_loader->m_grid_map.GetTiles().size() : 0;
+}
+
+// Evict node tiles far from the given location, optionally streaming them out.
+int SCMTerrain::EvictNodeTiles(const ChVector3d& loc, double radius, std::ostream* os) {
+    return m_loader->EvictNodeTiles(loc, radius, os);
+}
+
+// Load node tiles from the given stream.
+int SCMTerrain::LoadNodeTiles(std::istream& is) {
+    return m_loader->LoadNodeTiles(is);
+}
+
 bool SCMTerrain::GetContactForceBody(std::shared_ptr<ChBody> body, ChVector3d& force, ChVector3d& torque) const {
     auto itr = m_loader->m_body_forces.find(body.get());
     if (itr == m_loader->m_body_forces.end()) {
@@ -408,6 +430,7 @@ void SCMLoader::Initialize(double sizeX, double sizeY, double delta) {
 
     m_nx = static_cast<int>(std::ceil((sizeX / 2) / delta));  // half number of divisions in X direction
     m_ny = static_cast<int>(std::ceil((sizeY / 2) / delta));  // number of divisions in Y direction
+    m_grid_map.SetGridRange(m_nx, m_ny);
 
     m_delta = sizeX / (2 * m_nx);   // grid spacing
     m_area = std::pow(m_delta, 2);  // area of a cell
@@ -443,6 +466,7 @@ void SCMLoader::Initialize(const std::string& heightmap_file,
 
     m_nx = static_cast<int>(std::ceil((sizeX / 2) / delta));  // half number of divisions in X direction
     m_ny = static_cast<int>(std::ceil((sizeY / 2) / delta));  // number of divisions in Y direction
+    m_grid_map.SetGridRange(m_nx, m_ny);
     int nvx = 2 * m_nx + 1;                                   // number of grid vertices in X direction
     int nvy = 2 * m_ny + 1;                                   // number of grid vertices in Y direction
     m_delta = sizeX / (2.0 * m_nx);                           // grid spacing
@@ -550,6 +574,7 @@ void SCMLoader::Initialize(const ChTriangleMeshConnected& trimesh, double delta)
     // Initial grid extent
     m_nx = static_cast<int>(std::ceil((sizeX / 2) / delta));  // half number of divisions in X direction
     m_ny = static_cast<int>(std::ceil((sizeY / 2) / delta));  // number of divisions in Y direction
+    m_grid_map.SetGridRange(m_nx, m_ny);
     m_delta = sizeX / (2.0 * m_nx);                           // grid spacing
     m_area = std::pow(m_delta, 2);                            // area of a cell
     int nvx = 2 * m_nx + 1;                                   // number of grid vertices in X direction
@@ -720,16 +745,15 @@ SCMTerrain::NodeInfo SCMLoader::GetNodeInfo(const ChVector3d& loc) const {
     int j = static_cast<int>(std::round(loc_loc.y() / m_delta));
     ChVector2i ij(i, j);
 
-    // First query the hash-map
-    auto p = m_grid_map.find(ij);
-    if (p != m_grid_map.end()) {
-        ni.sinkage = p->second.sinkage;
-        ni.sinkage_plastic = p->second.sinkage_plastic;
-        ni.sinkage_elastic = p->second.sinkage_elastic;
-        ni.sigma = p->second.sigma;
-        ni.sigma_yield = p->second.sigma_yield;
-        ni.kshear = p->second.kshear;
-        ni.tau = p->second.tau;
+    // First query the node records
+    if (auto nr = m_grid_map.Find(ij)) {
+        ni.sinkage = nr->sinkage;
+        ni.sinkage_plastic = nr->sinkage_plastic;
+        ni.sinkage_elastic = nr->sinkage_elastic;
+        ni.sigma = nr->sigma;
+        ni.sigma_yield = nr->sigma_yield;
+        ni.kshear = nr->kshear;
+        ni.tau = nr->tau;
         return ni;
     }
 
@@ -813,10 +837,9 @@ ChVector3d SCMLoader::GetInitNormal(const ChVector2i& loc) const {
 
 // Get the terrain height (relative to the SCM plane) at the specified grid vertex.
 double SCMLoader::GetHeight(const ChVector2i& loc) const {
-    // First query the hash-map
-    auto p = m_grid_map.find(loc);
-    if (p != m_grid_map.end())
-        return p->second.level;
+    // First query the node records
+    if (auto nr = m_grid_map.Find(loc))
+        return nr->level;
 
     // Else return undeformed height
     return GetInitHeight(loc);
@@ -1037,6 +1060,8 @@ static const std::vector<ChVector2i> neighbors4{
 
 // Reset the list of forces, and fills it with forces from a soil contact model.
 void SCMLoader::ComputeInternalForces() {
+    CH_TRACE_ZONE("SCM ComputeInternalForces");
+
     // Initialize list of modified visualization mesh vertices (use any externally modified vertices)
     std::vector<int> modified_vertices = m_external_modified_vertices;
     m_external_modified_vertices.clear();
@@ -1044,7 +1069,7 @@ void SCMLoader::ComputeInternalForces() {
     // Reset quantities at grid nodes modified over previous step
     // (required for bulldozing effects and for proper visualization coloring)
     for (const auto& ij : m_modified_nodes) {
-        auto& nr = m_grid_map.at(ij);
+        auto& nr = m_grid_map.At(ij);
         nr.sigma = 0;
         nr.sinkage_elastic = 0;
         nr.step_plastic_flow = 0;
@@ -1083,6 +1108,7 @@ void SCMLoader::ComputeInternalForces() {
     // ---------------------
 
     m_timer_moving_patches.start();
+    CH_TRACE_BEGIN("SCM moving patches");
 
     // Update patch information (find range of grid indices)
     if (m_moving_patch) {
@@ -1093,6 +1119,7 @@ void SCMLoader::ComputeInternalForces() {
         UpdateFixedPatch(m_patches[0]);
     }
 
+    CH_TRACE_END();
     m_timer_moving_patches.stop();
 
     // -------------------------
@@ -1113,6 +1140,7 @@ void SCMLoader::ComputeInternalForces() {
     m_num_ray_hits = 0;
 
     m_timer_ray_casting.start();
+    CH_TRACE_BEGIN("SCM ray casting");
 
 #ifdef RAY_CASTING_WITH_CRITICAL_SECTION
 
@@ -1152,9 +1180,7 @@ void SCMLoader::ComputeInternalForces() {
     #pragma omp critical(SCM_ray_casting)
                 {
                     // If this is the first hit from this node, initialize the node record
-                    if (m_grid_map.find(ij) == m_grid_map.end()) {
-                        m_grid_map.insert(std::make_pair(ij, NodeRecord(z, z, GetInitNormal(ij))));
-                    }
+                    m_grid_map.Insert(ij, NodeRecord(z, z, GetInitNormal(ij)));
 
                     // Add to our map of hits to process
                     HitRecord record = {mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1};
@@ -1168,20 +1194,25 @@ void SCMLoader::ComputeInternalForces() {
 
 #else
 
-    // Map-reduce approach (to eliminate critical section)
+    // Batched ray casting (no critical section)
 
     const int nthreads = GetSystem()->GetNumThreadsChrono();
-    std::vector<std::unordered_map<ChVector2i, HitRecord, CoordHash>> t_hits(nthreads);
+    std::vector<ChCollisionSystem::ChRay> rays;
+    std::vector<ChCollisionSystem::ChRayhitResult> ray_results;
+    std::vector<ChVector2i> ray_nodes;
+    std::vector<char> ray_active;
 
     // Loop through all moving patches (user-defined or default one)
     for (auto& p : m_patches) {
         m_timer_ray_testing.start();
-
-        // Loop through all vertices in the patch range
-        int num_ray_casts = 0;
-    #pragma omp parallel for num_threads(nthreads) reduction(+ : num_ray_casts)
-        for (int k = 0; k < p.m_range.size(); k++) {
-            int t_num = ChOMP::GetThreadNum();
+        CH_TRACE_BEGIN("SCM ray testing");
+
+        // Create rays at all vertices in the patch range
+        int num_vertices = (int)p.m_range.size();
+        rays.resize(num_vertices);
+        ray_active.resize(num_vertices);
+    #pragma omp parallel for num_threads(nthreads)
+        for (int k = 0; k < num_vertices; k++) {
             ChVector2i ij = p.m_range[k];
 
             // Move from (i, j) to (x, y, z) representation in the world frame
@@ -1192,48 +1223,56 @@ void SCMLoader::ComputeInternalForces() {
             ChVector3d vertex_abs = m_plane.TransformPointLocalToParent(ChVector3d(x, y, z));
 
             // Create ray at current grid location
-            ChCollisionSystem::ChRayhitResult mrayhit_result;
-            ChVector3d to = vertex_abs + m_Z * m_test_offset_up;
-            ChVector3d from = to - m_Z * m_test_offset_down;
+            rays[k].to = vertex_abs + m_Z * m_test_offset_up;
+            rays[k].from = rays[k].to - m_Z * m_test_offset_down;
 
             // Ray-OBB test (quick rejection)
-            if (m_moving_patch && !RayOBBtest(p, from, m_Z))
-                continue;
-
-            // Cast ray into collision system
-            GetSystem()->GetCollisionSystem()->RayHit(from, to, mrayhit_result);
-            num_ray_casts++;
+            ray_active[k] = !m_moving_patch || RayOBBtest(p, rays[k].from, m_Z);
+        }
 
-            if (mrayhit_result.hit) {
-                // Add to our map of hits to process
-                HitRecord record = {mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1};
-                t_hits[t_num].insert(std::make_pair(ij, record));
+        // Discard rejected rays (preserving the order of the patch range, for coherence of ray packets)
+        ray_nodes.clear();
+        int num_ray_casts = 0;
+        for (int k = 0; k < num_vertices; k++) {
+            if (ray_active[k]) {
+                rays[num_ray_casts++] = rays[k];
+                ray_nodes.push_back(p.m_range[k]);
             }
         }
+        rays.resize(num_ray_casts);
+
+        // Cast all rays into collision system
+        GetSystem()->GetCollisionSystem()->RayHitBatch(rays, ray_results);
 
+        CH_TRACE_END();
         m_timer_ray_testing.stop();
 
         m_num_ray_casts += num_ray_casts;
 
         // Sequential insertion in global hits
-        for (int t_num = 0; t_num < nthreads; t_num++) {
-            for (auto& h : t_hits[t_num]) {
-                // If this is the first hit from this node, initialize the node record
-                if (m_grid_map.find(h.first) == m_grid_map.end()) {
-                    double z = GetInitHeight(h.first);
-                    m_grid_map.insert(std::make_pair(h.first, NodeRecord(z, z, GetInitNormal(h.first))));
-                }
-                ////hits.insert(h);
+        for (int k = 0; k < num_ray_casts; k++) {
+            const auto& result = ray_results[k];
+            if (!result.hit)
+                continue;
+
+            const auto& ij = ray_nodes[k];
+
+            // If this is the first hit from this node, initialize the node record
+            if (!m_grid_map.Find(ij)) {
+                double z = GetInitHeight(ij);
+                m_grid_map.Insert(ij, NodeRecord(z, z, GetInitNormal(ij)));
             }
 
-            hits.insert(t_hits[t_num].begin(), t_hits[t_num].end());
-            t_hits[t_num].clear();
+            // Add to our map of hits to process
+            HitRecord record = {result.hitModel->GetContactable(), result.abs_hitPoint, -1};
+            hits.insert(std::make_pair(ij, record));
         }
         m_num_ray_hits = (int)hits.size();
     }
 
 #endif
 
+    CH_TRACE_END();
     m_timer_ray_casting.stop();
 
     // --------------------
@@ -1241,6 +1280,7 @@ void SCMLoader::ComputeInternalForces() {
     // --------------------
 
     m_timer_contact_patches.start();
+    CH_TRACE_BEGIN("SCM contact patches");
 
     // Collect hit vertices assigned to each contact patch.
     struct ContactPatchRecord {
@@ -1313,6 +1353,7 @@ void SCMLoader::ComputeInternalForces() {
         }
     }
 
+    CH_TRACE_END();
     m_timer_contact_patches.stop();
 
     // ----------------------
@@ -1320,6 +1361,7 @@ void SCMLoader::ComputeInternalForces() {
     // ----------------------
 
     m_timer_contact_forces.start();
+    CH_TRACE_BEGIN("SCM contact forces");
 
     // Initialize local values for the soil parameters
     double Bekker_Kphi = m_Bekker_Kphi;
@@ -1335,7 +1377,7 @@ void SCMLoader::ComputeInternalForces() {
     for (auto& h : hits) {
         ChVector2d ij = h.first;
 
-        auto& nr = m_grid_map.at(ij);      // node record
+        auto& nr = m_grid_map.At(ij);      // node record
         const double& ca = nr.normal.z();  // cosine of angle between local normal and SCM plane vertical
 
         ChContactable* contactable = h.second.contactable;
@@ -1500,6 +1542,7 @@ void SCMLoader::ComputeInternalForces() {
         }
     }
 
+    CH_TRACE_END();
     m_timer_contact_forces.stop();
 
     // --------------------------------------------------
@@ -1507,6 +1550,7 @@ void SCMLoader::ComputeInternalForces() {
     // --------------------------------------------------
 
     m_timer_bulldozing.start();
+    CH_TRACE_BEGIN("SCM bulldozing");
 
     m_num_erosion_nodes = 0;
 
@@ -1518,6 +1562,7 @@ void SCMLoader::ComputeInternalForces() {
 
         // (1) Raise boundaries of each contact patch
         m_timer_bulldozing_boundary.start();
+        CH_TRACE_BEGIN("SCM bulldozing boundary");
 
         NodeSet boundary;  // union of contact patch boundaries
         for (auto p : contact_patches) {
@@ -1526,7 +1571,7 @@ void SCMLoader::ComputeInternalForces() {
             // Calculate the displaced material from all touched nodes and identify boundary
             double tot_step_flow = 0;
             for (const auto& ij : p.nodes) {                 // for each node in contact patch
-                const auto& nr = m_grid_map.at(ij);          //   get node record
+                const auto& nr = m_grid_map.At(ij);          //   get node record
                 if (nr.sigma <= 0)                           //   if node not touched
                     continue;                                //     skip (not in effective patch)
                 tot_step_flow += nr.step_plastic_flow;       //   accumulate displaced material
@@ -1534,9 +1579,10 @@ void SCMLoader::ComputeInternalForces() {
                     ChVector2i nbr_ij = ij + neighbors4[k];  //     neighbor node coordinates
                     ////if (!CheckMeshBounds(nbr_ij))                     //     if neighbor out of bounds
                     ////    continue;                                     //       skip neighbor
-                    if (m_grid_map.find(nbr_ij) == m_grid_map.end())  //     if neighbor not yet recorded
+                    auto nbr_nr = m_grid_map.Find(nbr_ij);            //     neighbor record
+                    if (!nbr_nr)                                      //     if neighbor not yet recorded
                         p_boundary.insert(nbr_ij);                    //       set neighbor as boundary
-                    else if (m_grid_map.at(nbr_ij).sigma <= 0)        //     if neighbor not touched
+                    else if (nbr_nr->sigma <= 0)                      //     if neighbor not touched
                         p_boundary.insert(nbr_ij);                    //       set neighbor as boundary
                 }
             }
@@ -1548,13 +1594,13 @@ void SCMLoader::ComputeInternalForces() {
             // Raise boundary (create a sharp spike which will be later smoothed out with erosion)
             for (const auto& ij : p_boundary) {                                  // for each node in bndry
                 m_modified_nodes.push_back(ij);                                  //   mark as modified
-                if (m_grid_map.find(ij) == m_grid_map.end()) {                   //   if not yet recorded
+                if (!m_grid_map.Find(ij)) {                                      //   if not yet recorded
                     double z = GetInitHeight(ij);                                //     undeformed height
                     const ChVector3d& n = GetInitNormal(ij);                     //     terrain normal
-                    m_grid_map.insert(std::make_pair(ij, NodeRecord(z, z, n)));  //     add new node record
+                    m_grid_map.Insert(ij, NodeRecord(z, z, n));                  //     add new node record
                     m_modified_nodes.push_back(ij);                              //     mark as modified
                 }                                                                //
-                auto& nr = m_grid_map.at(ij);                                    //   node record
+                auto& nr = m_grid_map.At(ij);                                    //   node record
                 nr.erosion = true;                                               //   add to erosion domain
                 AddMaterialToNode(diff, nr);                                     //   add raise amount
             }
@@ -1564,10 +1610,12 @@ void SCMLoader::ComputeInternalForces() {
 
         }  // end for contact_patches
 
+        CH_TRACE_END();
         m_timer_bulldozing_boundary.stop();
 
         // (2) Calculate erosion domain (dilate boundary)
         m_timer_bulldozing_domain.start();
+        CH_TRACE_BEGIN("SCM bulldozing domain");
 
         NodeSet erosion_domain = boundary;
         NodeSet erosion_front = boundary;  // initialize erosion front to boundary nodes
@@ -1578,16 +1626,16 @@ void SCMLoader::ComputeInternalForces() {
                     ChVector2i nbr_ij = ij + neighbors4[k];  //   neighbor node coordinates
                     ////if (!CheckMeshBounds(nbr_ij))                       //   if out of bounds
                     ////    continue;                                       //     ignore neighbor
-                    if (m_grid_map.find(nbr_ij) == m_grid_map.end()) {  //   if neighbor not yet recorded
+                    if (!m_grid_map.Find(nbr_ij)) {                     //   if neighbor not yet recorded
                         double z = GetInitHeight(nbr_ij);               //     undeformed height at neighbor location
                         const ChVector3d& n = GetInitNormal(nbr_ij);    //     terrain normal at neighbor location
                         NodeRecord nr(z, z, n);                         //     create new record
                         nr.erosion = true;                              //     include in erosion domain
-                        m_grid_map.insert(std::make_pair(nbr_ij, nr));  //     add new node record
+                        m_grid_map.Insert(nbr_ij, nr);                  //     add new node record
                         front.insert(nbr_ij);                           //     add neighbor to new front
                         m_modified_nodes.push_back(nbr_ij);             //     mark as modified
                     } else {                                            //   if neighbor previously recorded
-                        NodeRecord& nr = m_grid_map.at(nbr_ij);         //     get existing record
+                        NodeRecord& nr = m_grid_map.At(nbr_ij);         //     get existing record
                         if (!nr.erosion && nr.sigma <= 0) {             //     if neighbor not touched
                             nr.erosion = true;                          //       include in erosion domain
                             front.insert(nbr_ij);                       //       add neighbor to new front
@@ -1601,20 +1649,22 @@ void SCMLoader::ComputeInternalForces() {
         }
 
         m_num_erosion_nodes = static_cast<int>(erosion_domain.size());
+        CH_TRACE_END();
         m_timer_bulldozing_domain.stop();
 
         // (3) Erosion algorithm on domain
         m_timer_bulldozing_erosion.start();
+        CH_TRACE_BEGIN("SCM bulldozing erosion");
 
         for (int iter = 0; iter < m_erosion_iterations; iter++) {
             for (const auto& ij : erosion_domain) {
-                auto& nr = m_grid_map.at(ij);
+                auto& nr = m_grid_map.At(ij);
                 for (int k = 0; k < 4; k++) {
                     ChVector2i nbr_ij = ij + neighbors4[k];
-                    auto rec = m_grid_map.find(nbr_ij);
-                    if (rec == m_grid_map.end())
+                    auto rec = m_grid_map.Find(nbr_ij);
+                    if (!rec)
                         continue;
-                    auto& nbr_nr = rec->second;
+                    auto& nbr_nr = *rec;
 
                     // (3.1) Flow remaining material to neighbor
                     double diff = 0.5 * (nr.massremainder - nbr_nr.massremainder) / 4;  //// TODO: rethink this!
@@ -1641,10 +1691,12 @@ void SCMLoader::ComputeInternalForces() {
             }
         }
 
+        CH_TRACE_END();
         m_timer_bulldozing_erosion.stop();
 
     }  // end do_bulldozing
 
+    CH_TRACE_END();
     m_timer_bulldozing.stop();
 
     // --------------------
@@ -1652,6 +1704,7 @@ void SCMLoader::ComputeInternalForces() {
     // --------------------
 
     m_timer_visualization.start();
+    CH_TRACE_BEGIN("SCM visualization");
 
     if (m_trimesh_shape) {
         // Loop over list of modified nodes and adjust corresponding mesh vertices.
@@ -1659,7 +1712,7 @@ void SCMLoader::ComputeInternalForces() {
         for (const auto& ij : m_modified_nodes) {
             if (!CheckMeshBounds(ij))                 // if node outside mesh
                 continue;                             //   do nothing
-            const auto& nr = m_grid_map.at(ij);       // grid node record
+            const auto& nr = m_grid_map.At(ij);       // grid node record
             int iv = GetMeshVertexIndex(ij);          // mesh vertex index
             UpdateMeshVertexCoordinates(ij, iv, nr);  // update vertex coordinates and color
             modified_vertices.push_back(iv);          // cache in list of modified mesh vertices
@@ -1670,6 +1723,7 @@ void SCMLoader::ComputeInternalForces() {
         m_trimesh_shape->SetModifiedVertices(modified_vertices);
     }
 
+    CH_TRACE_END();
     m_timer_visualization.stop();
 }
 
@@ -1782,14 +1836,13 @@ void SCMLoader::UpdateMeshVertexNormal(const ChVector2i ij, int iv) {
 std::vector<SCMTerrain::NodeLevel> SCMLoader::GetModifiedNodes(bool all_nodes) const {
     std::vector<SCMTerrain::NodeLevel> nodes;
     if (all_nodes) {
-        for (const auto& nr : m_grid_map) {
-            nodes.push_back(std::make_pair(nr.first, nr.second.level));
-        }
+        m_grid_map.ForEach(
+            [&nodes](const ChVector2i& ij, const NodeRecord& nr) { nodes.push_back(std::make_pair(ij, nr.level)); });
     } else {
         for (const auto& ij : m_modified_nodes) {
-            auto rec = m_grid_map.find(ij);
-            assert(rec != m_grid_map.end());
-            nodes.push_back(std::make_pair(ij, rec->second.level));
+            auto rec = m_grid_map.Find(ij);
+            assert(rec);
+            nodes.push_back(std::make_pair(ij, rec->level));
         }
     }
     return nodes;
@@ -1801,7 +1854,7 @@ std::vector<SCMTerrain::NodeLevel> SCMLoader::GetModifiedNodes(bool all_nodes) c
 void SCMLoader::SetModifiedNodes(const std::vector<SCMTerrain::NodeLevel>& nodes) {
     for (const auto& n : nodes) {
         // Modify existing entry in grid map or insert new one
-        m_grid_map[n.first] = SCMLoader::NodeRecord(n.second, n.second, GetInitNormal(n.first));
+        m_grid_map.Set(n.first, SCMLoader::NodeRecord(n.second, n.second, GetInitNormal(n.first)));
     }
 
     // Update visualization
@@ -1810,7 +1863,7 @@ void SCMLoader::SetModifiedNodes(const std::vector<SCMTerrain::NodeLevel>& nodes
             auto ij = n.first;                           // grid location
             if (!CheckMeshBounds(ij))                    // if outside mesh
                 continue;                                //   do nothing
-            const auto& nr = m_grid_map.at(ij);          // grid node record
+            const auto& nr = m_grid_map.At(ij);          // grid node record
             int iv = GetMeshVertexIndex(ij);             // mesh vertex index
             UpdateMeshVertexCoordinates(ij, iv, nr);     // update vertex coordinates and color
             if (!m_trimesh_shape->IsWireframe())         // if not in wireframe mode
@@ -1820,5 +1873,405 @@ void SCMLoader::SetModifiedNodes(const std::vector<SCMTerrain::NodeLevel>& nodes
     }
 }
 
+// Evict node tiles with center farther than the given radius from the specified location.
+int SCMLoader::EvictNodeTiles(const ChVector3d& loc, double radius, std::ostream* os) {
+    if (!m_grid_map.IsTiled())
+        return 0;
+
+    // Express location in the SCM frame
+    ChVector3d loc_loc = m_plane.TransformPointParentToLocal(loc);
+    ChVector2d loc_2d(loc_loc.x(), loc_loc.y());
+
+    const int S = NodeStore::TILE_SIZE;
+    std::vector<ChVector2i> nodes;
+    int num_evicted = 0;
+    for (const auto& t : m_grid_map.GetTiles()) {
+        ChVector2d center = (ChVector2d(t.x(), t.y()) * S + 0.5 * (S - 1)) * m_delta;
+        if ((center - loc_2d).Length() <= radius)
+            continue;
+        if (os)
+            m_grid_map.WriteTile(t, *os);
+        m_grid_map.EvictTile(t, nodes);
+        num_evicted++;
+    }
+
+    if (nodes.empty())
+        return num_evicted;
+
+    // Remove evicted nodes from the list of modified nodes
+    m_modified_nodes.erase(std::remove_if(m_modified_nodes.begin(), m_modified_nodes.end(),
+                                          [this](const ChVector2i& ij) { return !m_grid_map.Find(ij); }),
+                           m_modified_nodes.end());
+
+    // Reset visualization at evicted nodes
+    UpdateMeshVertices(nodes);
+
+    return num_evicted;
+}
+
+// Load node tiles from the given input stream.
+int SCMLoader::LoadNodeTiles(std::istream& is) {
+    if (!m_grid_map.IsTiled())
+        return 0;
+
+    std::vector<ChVector2i> nodes;
+    int num_loaded = 0;
+    while (m_grid_map.ReadTile(is, nodes))
+        num_loaded++;
+
+    // Update visualization at loaded nodes
+    UpdateMeshVertices(nodes);
+
+    return num_loaded;
+}
+
+// Save the records of all modified grid nodes.
+void SCMLoader::SnapshotOut(ChStateSnapshot& snapshot) {
+    snapshot.Write(m_grid_map.Size());
+    m_grid_map.ForEach([&snapshot](const ChVector2i& ij, const NodeRecord& nr) {
+        snapshot.Write(ij);
+        nr.SnapshotOut(snapshot);
+    });
+}
+
+// Restore the records of modified grid nodes and reset the visualization at all affected nodes.
+void SCMLoader::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    std::vector<ChVector2i> nodes;
+    nodes.reserve(m_grid_map.Size());
+    m_grid_map.ForEach([&nodes](const ChVector2i& ij, const NodeRecord& nr) { nodes.push_back(ij); });
+    m_grid_map.Clear();
+
+    size_t num_records;
+    reader.Read(num_records);
+    for (size_t i = 0; i < num_records; i++) {
+        ChVector2i ij;
+        NodeRecord nr;
+        reader.Read(ij);
+        nr.SnapshotIn(reader);
+        m_grid_map.Set(ij, nr);
+        nodes.push_back(ij);
+    }
+
+    m_modified_nodes.clear();
+
+    // Update visualization at nodes modified either before or after the rollback
+    UpdateMeshVertices(nodes);
+}
+
+void SCMLoader::NodeRecord::SnapshotOut(ChStateSnapshot& snapshot) const {
+    snapshot.Write(level_initial);
+    snapshot.Write(level);
+    snapshot.Write(hit_level);
+    snapshot.Write(normal);
+    snapshot.Write(sinkage);
+    snapshot.Write(sinkage_plastic);
+    snapshot.Write(sinkage_elastic);
+    snapshot.Write(sigma);
+    snapshot.Write(sigma_yield);
+    snapshot.Write(kshear);
+    snapshot.Write(tau);
+    snapshot.Write(erosion);
+    snapshot.Write(massremainder);
+    snapshot.Write(step_plastic_flow);
+}
+
+void SCMLoader::NodeRecord::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    reader.Read(level_initial);
+    reader.Read(level);
+    reader.Read(hit_level);
+    reader.Read(normal);
+    reader.Read(sinkage);
+    reader.Read(sinkage_plastic);
+    reader.Read(sinkage_elastic);
+    reader.Read(sigma);
+    reader.Read(sigma_yield);
+    reader.Read(kshear);
+    reader.Read(tau);
+    reader.Read(erosion);
+    reader.Read(massremainder);
+    reader.Read(step_plastic_flow);
+}
+
+// Update visualization mesh vertices at the given grid nodes (using the undeformed state for unrecorded nodes).
+void SCMLoader::UpdateMeshVertices(const std::vector<ChVector2i>& nodes) {
+    if (!m_trimesh_shape)
+        return;
+
+    for (const auto& ij : nodes) {
+        if (!CheckMeshBounds(ij))
+            continue;
+        int iv = GetMeshVertexIndex(ij);
+        if (auto nr = m_grid_map.Find(ij)) {
+            UpdateMeshVertexCoordinates(ij, iv, *nr);
+        } else {
+            double z = GetInitHeight(ij);
+            UpdateMeshVertexCoordinates(ij, iv, NodeRecord(z, z, GetInitNormal(ij)));
+        }
+        m_external_modified_vertices.push_back(iv);
+    }
+
+    if (!m_trimesh_shape->IsWireframe()) {
+        for (const auto& ij : nodes) {
+            if (CheckMeshBounds(ij))
+                UpdateMeshVertexNormal(ij, GetMeshVertexIndex(ij));
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Implementation of SCMLoader::NodeStore
+// -----------------------------------------------------------------------------
+
+// Integer division rounding towards negative infinity.
+static inline int FloorDiv(int a, int b) {
+    return (a >= 0) ? a / b : -((-a - 1) / b) - 1;
+}
+
+SCMLoader::NodeStore::Tile::Tile(const ChVector2i& t)
+    : origin(t.x() * TILE_SIZE, t.y() * TILE_SIZE),
+      records(TILE_SIZE * TILE_SIZE),
+      used(TILE_SIZE * TILE_SIZE, 0),
+      num_used(0) {}
+
+void SCMLoader::NodeStore::SetTiled(bool val) {
+    if (val != m_tiled)
+        Rebuild(val, m_nx, m_ny);
+}
+
+void SCMLoader::NodeStore::SetGridRange(int nx, int ny) {
+    Rebuild(m_tiled, nx, ny);
+}
+
+void SCMLoader::NodeStore::Rebuild(bool tiled, int nx, int ny) {
+    // Cache existing records
+    std::vector<std::pair<ChVector2i, NodeRecord>> records;
+    records.reserve(Size());
+    ForEach([&records](const ChVector2i& ij, const NodeRecord& nr) { records.push_back(std::make_pair(ij, nr)); });
+
+    Clear();
+    m_tiled = tiled;
+    m_nx = nx;
+    m_ny = ny;
+
+    // Dense array of tiles covering the grid
+    auto t_min = GetTileCoords(ChVector2i(-nx, -ny));
+    auto t_max = GetTileCoords(ChVector2i(+nx, +ny));
+    m_tx_min = t_min.x();
+    m_ty_min = t_min.y();
+    m_ntx = tiled ? t_max.x() - t_min.x() + 1 : 0;
+    m_nty = tiled ? t_max.y() - t_min.y() + 1 : 0;
+    m_tiles.clear();
+    m_tiles.resize(m_ntx * m_nty);
+
+    // Re-insert records
+    for (const auto& r : records)
+        Insert(r.first, r.second);
+}
+
+ChVector2i SCMLoader::NodeStore::GetTileCoords(const ChVector2i& ij) {
+    return ChVector2i(FloorDiv(ij.x(), TILE_SIZE), FloorDiv(ij.y(), TILE_SIZE));
+}
+
+SCMLoader::NodeStore::Tile* SCMLoader::NodeStore::GetTile(const ChVector2i& t) const {
+    int ix = t.x() - m_tx_min;
+    int iy = t.y() - m_ty_min;
+    if (ix >= 0 && ix < m_ntx && iy >= 0 && iy < m_nty)
+        return m_tiles[iy * m_ntx + ix].get();
+    auto it = m_outer_tiles.find(t);
+    return (it == m_outer_tiles.end()) ? nullptr : it->second.get();
+}
+
+std::unique_ptr<SCMLoader::NodeStore::Tile>& SCMLoader::NodeStore::TileSlot(const ChVector2i& t) {
+    int ix = t.x() - m_tx_min;
+    int iy = t.y() - m_ty_min;
+    if (ix >= 0 && ix < m_ntx && iy >= 0 && iy < m_nty)
+        return m_tiles[iy * m_ntx + ix];
+    return m_outer_tiles[t];
+}
+
+SCMLoader::NodeStore::Tile* SCMLoader::NodeStore::GetOrCreateTile(const ChVector2i& t) {
+    auto& tile = TileSlot(t);
+    if (!tile)
+        tile = chrono_types::make_unique<Tile>(t);
+    return tile.get();
+}
+
+const SCMLoader::NodeRecord* SCMLoader::NodeStore::Find(const ChVector2i& ij) const {
+    if (!m_tiled) {
+        auto it = m_map.find(ij);
+        return (it == m_map.end()) ? nullptr : &it->second;
+    }
+
+    auto tile = GetTile(GetTileCoords(ij));
+    if (!tile)
+        return nullptr;
+    int k = tile->Index(ij);
+    return tile->used[k] ? &tile->records[k] : nullptr;
+}
+
+SCMLoader::NodeRecord* SCMLoader::NodeStore::Find(const ChVector2i& ij) {
+    return const_cast<NodeRecord*>(static_cast<const NodeStore*>(this)->Find(ij));
+}
+
+const SCMLoader::NodeRecord& SCMLoader::NodeStore::At(const ChVector2i& ij) const {
+    auto nr = Find(ij);
+    if (!nr)
+        throw std::out_of_range("SCM node record not found");
+    return *nr;
+}
+
+SCMLoader::NodeRecord& SCMLoader::NodeStore::At(const ChVector2i& ij) {
+    return const_cast<NodeRecord&>(static_cast<const NodeStore*>(this)->At(ij));
+}
+
+SCMLoader::NodeRecord& SCMLoader::NodeStore::Insert(const ChVector2i& ij, const NodeRecord& nr) {
+    if (!m_tiled)
+        return m_map.insert(std::make_pair(ij, nr)).first->second;
+
+    auto tile = GetOrCreateTile(GetTileCoords(ij));
+    int k = tile->Index(ij);
+    if (!tile->used[k]) {
+        tile->records[k] = nr;
+        tile->used[k] = 1;
+        tile->num_used++;
+        m_num_records++;
+    }
+    return tile->records[k];
+}
+
+void SCMLoader::NodeStore::Set(const ChVector2i& ij, const NodeRecord& nr) {
+    Insert(ij, nr) = nr;
+}
+
+void SCMLoader::NodeStore::Clear() {
+    m_map.clear();
+    for (auto& tile : m_tiles)
+        tile.reset();
+    m_outer_tiles.clear();
+    m_num_records = 0;
+}
+
+std::vector<ChVector2i> SCMLoader::NodeStore::GetTiles() const {
+    std::vector<ChVector2i> tiles;
+    for (int i = 0; i < (int)m_tiles.size(); i++) {
+        if (m_tiles[i])
+            tiles.push_back(ChVector2i(m_tx_min + i % m_ntx, m_ty_min + i / m_ntx));
+    }
+    for (const auto& tile : m_outer_tiles)
+        tiles.push_back(tile.first);
+    return tiles;
+}
+
+// Binary I/O of node records
+template <typename T>
+static void WriteValue(std::ostream& os, const T& val) {
+    os.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template <typename T>
+static void ReadValue(std::istream& is, T& val) {
+    is.read(reinterpret_cast<char*>(&val), sizeof(T));
+}
+
+void SCMLoader::NodeStore::WriteTile(const ChVector2i& t, std::ostream& os) const {
+    auto tile = GetTile(t);
+    if (!tile)
+        return;
+
+    WriteValue(os, t.x());
+    WriteValue(os, t.y());
+    WriteValue(os, tile->num_used);
+    for (int k = 0; k < TILE_SIZE * TILE_SIZE; k++) {
+        if (!tile->used[k])
+            continue;
+        const auto& nr = tile->records[k];
+        WriteValue(os, k);
+        WriteValue(os, nr.level_initial);
+        WriteValue(os, nr.level);
+        WriteValue(os, nr.hit_level);
+        WriteValue(os, nr.normal.x());
+        WriteValue(os, nr.normal.y());
+        WriteValue(os, nr.normal.z());
+        WriteValue(os, nr.sinkage);
+        WriteValue(os, nr.sinkage_plastic);
+        WriteValue(os, nr.sinkage_elastic);
+        WriteValue(os, nr.sigma);
+        WriteValue(os, nr.sigma_yield);
+        WriteValue(os, nr.kshear);
+        WriteValue(os, nr.tau);
+        WriteValue(os, nr.erosion);
+        WriteValue(os, nr.massremainder);
+        WriteValue(os, nr.step_plastic_flow);
+    }
+}
+
+bool SCMLoader::NodeStore::ReadTile(std::istream& is, std::vector<ChVector2i>& nodes) {
+    int tx, ty, num_used;
+    ReadValue(is, tx);
+    ReadValue(is, ty);
+    ReadValue(is, num_used);
+    if (!is || num_used < 0 || num_used > TILE_SIZE * TILE_SIZE)
+        return false;
+
+    // Read the tile in a temporary, so that a truncated or malformed stream leaves the store unchanged
+    ChVector2i t(tx, ty);
+    auto new_tile = chrono_types::make_unique<Tile>(t);
+    for (int i = 0; i < num_used; i++) {
+        int k;
+        ReadValue(is, k);
+        if (!is || k < 0 || k >= TILE_SIZE * TILE_SIZE || new_tile->used[k])
+            return false;
+        auto& nr = new_tile->records[k];
+        ReadValue(is, nr.level_initial);
+        ReadValue(is, nr.level);
+        ReadValue(is, nr.hit_level);
+        ReadValue(is, nr.normal.x());
+        ReadValue(is, nr.normal.y());
+        ReadValue(is, nr.normal.z());
+        ReadValue(is, nr.sinkage);
+        ReadValue(is, nr.sinkage_plastic);
+        ReadValue(is, nr.sinkage_elastic);
+        ReadValue(is, nr.sigma);
+        ReadValue(is, nr.sigma_yield);
+        ReadValue(is, nr.kshear);
+        ReadValue(is, nr.tau);
+        ReadValue(is, nr.erosion);
+        ReadValue(is, nr.massremainder);
+        ReadValue(is, nr.step_plastic_flow);
+        if (!is)
+            return false;
+        new_tile->used[k] = 1;
+    }
+    new_tile->num_used = num_used;
+
+    // Replace any existing tile at this location
+    auto& tile = TileSlot(t);
+    if (tile) {
+        m_num_records -= tile->num_used;
+        tile->ForEach([&nodes](const ChVector2i& ij, const NodeRecord& nr) { nodes.push_back(ij); });
+    }
+    tile = std::move(new_tile);
+    tile->ForEach([&nodes](const ChVector2i& ij, const NodeRecord& nr) { nodes.push_back(ij); });
+    m_num_records += num_used;
+
+    return true;
+}
+
+void SCMLoader::NodeStore::EvictTile(const ChVector2i& t, std::vector<ChVector2i>& nodes) {
+    auto tile = GetTile(t);
+    if (!tile)
+        return;
+
+    tile->ForEach([&nodes](const ChVector2i& ij, const NodeRecord& nr) { nodes.push_back(ij); });
+    m_num_records -= tile->num_used;
+
+    int ix = t.x() - m_tx_min;
+    int iy = t.y() - m_ty_min;
+    if (ix >= 0 && ix < m_ntx && iy >= 0 && iy < m_nty)
+        m_tiles[iy * m_ntx + ix].reset();
+    else
+        m_outer_tiles.erase(t);
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
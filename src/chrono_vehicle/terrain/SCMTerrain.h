@@ -21,6 +21,8 @@
 #define SCM_TERRAIN_H
 
 #include <string>
+#include <istream>
+#include <memory>
 #include <ostream>
 #include <unordered_map>
 
@@ -223,6 +225,27 @@ class CH_VEHICLE_API SCMTerrain : public ChTerrain {
     /// GetContactForceNode for rigid bodies and FEA nodes, respectively.
     void SetCosimulationMode(bool val);
 
+    /// Enable/disable storage of grid node records in dense tiles (default: false).
+    /// By default, the records of modified grid nodes are stored in a hash map. If enabled, node records are stored in
+    /// dense tiles of 64x64 nodes, allocated on first touch and indexed by tile coordinates. This eliminates hashing in
+    /// node lookups (significant for large contact patches) and allows streaming and eviction of terrain regions (see
+    /// EvictNodeTiles and LoadNodeTiles).
+    void EnableTiledNodeStorage(bool val);
+
+    /// Return the number of allocated node tiles (0 if tiled storage is not enabled).
+    int GetNumNodeTiles() const;
+
+    /// Evict all node tiles with center farther than the given radius from the specified location.
+    /// Distances are measured in the SCM plane. If an output stream is provided, the evicted tiles are first written to
+    /// it (see LoadNodeTiles). Grid nodes in evicted tiles revert to their undeformed state. Return the number of
+    /// evicted tiles. No-op if tiled storage is not enabled.
+    int EvictNodeTiles(const ChVector3d& loc, double radius, std::ostream* os = nullptr);
+
+    /// Load node tiles from the given input stream (as written by EvictNodeTiles).
+    /// Loaded tiles replace any existing tiles at the same locations. Return the number of loaded tiles. No-op if tiled
+    /// storage is not enabled.
+    int LoadNodeTiles(std::istream& is);
+
     /// Initialize the terrain system (flat).
     /// This version creates a flat array of points.
     void Initialize(double sizeX,  ///< [in] terrain dimension in the X direction
@@ -376,6 +399,12 @@ class CH_VEHICLE_API SCMLoader : public ChLoadContainer {
                     double delta                             ///< [in] grid spacing
     );
 
+    /// Append the records of all modified grid nodes to the given snapshot.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Replace the records of modified grid nodes with those in the snapshot.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
   private:
     // SCM patch type
     enum class PatchType {
@@ -428,6 +457,9 @@ class CH_VEHICLE_API SCMLoader : public ChLoadContainer {
               erosion(false),
               massremainder(0),
               step_plastic_flow(0) {}
+
+        void SnapshotOut(ChStateSnapshot& snapshot) const;
+        void SnapshotIn(ChStateSnapshot::Reader& reader);
     };
 
     // Hash function for a pair of integer grid coordinates
@@ -437,6 +469,122 @@ class CH_VEHICLE_API SCMLoader : public ChLoadContainer {
         std::size_t operator()(const ChVector2i& p) const { return p.x() * 31 + p.y(); }
     };
 
+    // Storage for the records of modified grid nodes.
+    // Node records are kept either in a hash map or in dense square tiles of TILE_SIZE x TILE_SIZE nodes. Tiles are
+    // allocated on first touch and indexed by tile coordinates, through a dense array for tiles covering the SCM grid
+    // and through a hash map for tiles outside the grid bounds. Tiles can be streamed out, read back, and evicted.
+    class NodeStore {
+      public:
+        static const int TILE_SIZE = 64;
+
+        NodeStore()
+            : m_tiled(false), m_tx_min(0), m_ty_min(0), m_ntx(0), m_nty(0), m_nx(0), m_ny(0), m_num_records(0) {}
+
+        // Select the storage type (existing records are preserved).
+        void SetTiled(bool val);
+
+        // Return true if node records are stored in dense tiles.
+        bool IsTiled() const { return m_tiled; }
+
+        // Set the range of grid indices [-nx, +nx] x [-ny, +ny] (existing records are preserved).
+        void SetGridRange(int nx, int ny);
+
+        // Return a pointer to the record of the specified node (nullptr if no record exists).
+        NodeRecord* Find(const ChVector2i& ij);
+        const NodeRecord* Find(const ChVector2i& ij) const;
+
+        // Return the record of the specified node (which must exist).
+        NodeRecord& At(const ChVector2i& ij);
+        const NodeRecord& At(const ChVector2i& ij) const;
+
+        // Add the given record for the specified node, if no record exists. Return the node record.
+        NodeRecord& Insert(const ChVector2i& ij, const NodeRecord& nr);
+
+        // Set the record of the specified node (overwriting any existing record).
+        void Set(const ChVector2i& ij, const NodeRecord& nr);
+
+        // Return the number of node records.
+        size_t Size() const { return m_tiled ? m_num_records : m_map.size(); }
+
+        // Delete all node records.
+        void Clear();
+
+        // Invoke f(ij, nr) for each node record.
+        template <typename F>
+        void ForEach(F f) const {
+            if (!m_tiled) {
+                for (const auto& r : m_map)
+                    f(r.first, r.second);
+                return;
+            }
+            for (const auto& tile : m_tiles) {
+                if (tile)
+                    tile->ForEach(f);
+            }
+            for (const auto& tile : m_outer_tiles)
+                tile.second->ForEach(f);
+        }
+
+        // Return the coordinates of the tile containing the specified node.
+        static ChVector2i GetTileCoords(const ChVector2i& ij);
+
+        // Return the coordinates of all allocated tiles.
+        std::vector<ChVector2i> GetTiles() const;
+
+        // Write the tile with given coordinates to a (binary) output stream.
+        void WriteTile(const ChVector2i& t, std::ostream& os) const;
+
+        // Read a tile from a (binary) input stream, replacing any existing tile at the same location.
+        // Append the coordinates of all loaded nodes to the provided list. Return false at end of stream or if the
+        // stream is truncated or malformed, in which case the store is left unchanged.
+        bool ReadTile(std::istream& is, std::vector<ChVector2i>& nodes);
+
+        // Delete the tile with given coordinates.
+        // Append the coordinates of all nodes with records in the evicted tile to the provided list.
+        void EvictTile(const ChVector2i& t, std::vector<ChVector2i>& nodes);
+
+      private:
+        // Dense tile of node records.
+        struct Tile {
+            Tile(const ChVector2i& t);
+            int Index(const ChVector2i& ij) const { return (ij.y() - origin.y()) * TILE_SIZE + (ij.x() - origin.x()); }
+            ChVector2i Node(int k) const { return origin + ChVector2i(k % TILE_SIZE, k / TILE_SIZE); }
+            template <typename F>
+            void ForEach(F f) const {
+                for (int k = 0; k < TILE_SIZE * TILE_SIZE; k++) {
+                    if (used[k])
+                        f(Node(k), records[k]);
+                }
+            }
+
+            ChVector2i origin;                // grid coordinates of first node in tile
+            std::vector<NodeRecord> records;  // node records (row-major)
+            std::vector<char> used;           // flags for existing records
+            int num_used;                     // number of existing records
+        };
+
+        // Return the tile with given coordinates (nullptr if not allocated).
+        Tile* GetTile(const ChVector2i& t) const;
+
+        // Return the tile with given coordinates, allocating it if needed.
+        Tile* GetOrCreateTile(const ChVector2i& t);
+
+        // Return the owner of the tile with given coordinates (in the dense array or in the hash map).
+        std::unique_ptr<Tile>& TileSlot(const ChVector2i& t);
+
+        // Re-insert all records after a change in storage type or grid range.
+        void Rebuild(bool tiled, int nx, int ny);
+
+        bool m_tiled;                                                 // use dense tiles?
+        std::unordered_map<ChVector2i, NodeRecord, CoordHash> m_map;  // node records (hash map storage)
+        std::vector<std::unique_ptr<Tile>> m_tiles;                   // tiles covering the grid
+        std::unordered_map<ChVector2i, std::unique_ptr<Tile>, CoordHash> m_outer_tiles;  // tiles outside the grid
+        int m_tx_min, m_ty_min;                                       // coordinates of first grid tile
+        int m_ntx, m_nty;                                             // number of grid tiles
+        int m_nx, m_ny;                                               // grid range
+        size_t m_num_records;                                         // number of records (tiled storage)
+    };
+
     // Create visualization mesh
     void CreateVisualizationMesh(double sizeX, double sizeY);
 
@@ -535,6 +683,15 @@ class CH_VEHICLE_API SCMLoader : public ChLoadContainer {
     // Modify the level of grid nodes from the given list.
     void SetModifiedNodes(const std::vector<SCMTerrain::NodeLevel>& nodes);
 
+    // Evict node tiles far from the given location (tiled node storage only).
+    int EvictNodeTiles(const ChVector3d& loc, double radius, std::ostream* os);
+
+    // Load node tiles from the given stream (tiled node storage only).
+    int LoadNodeTiles(std::istream& is);
+
+    // Reset visualization mesh vertices at the given grid nodes.
+    void UpdateMeshVertices(const std::vector<ChVector2i>& nodes);
+
     PatchType m_type;      ///< type of SCM patch
     ChCoordsys<> m_plane;  ///< SCM frame (deformation occurs along the z axis of this frame)
     ChVector3d m_Z;        ///< SCM plane vertical direction (in absolute frame)
@@ -546,8 +703,8 @@ class CH_VEHICLE_API SCMLoader : public ChLoadContainer {
     ChMatrixDynamic<> m_heights;  ///< (base) grid heights (when initializing from height-field map)
     double m_base_height;         ///< default height for vertices outside the projection of input mesh
 
-    std::unordered_map<ChVector2i, NodeRecord, CoordHash> m_grid_map;  ///< modified grid nodes (persistent)
-    std::vector<ChVector2i> m_modified_nodes;                          ///< modified grid nodes (current)
+    NodeStore m_grid_map;                      ///< modified grid nodes (persistent)
+    std::vector<ChVector2i> m_modified_nodes;  ///< modified grid nodes (current)
 
     std::vector<MovingPatchInfo> m_patches;  ///< set of active moving patches
     bool m_moving_patch;                     ///< user-specified moving patches?
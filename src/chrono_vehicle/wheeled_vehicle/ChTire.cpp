@@ -70,6 +70,21 @@ void ChTire::Initialize(std::shared_ptr<ChWheel> wheel) {
     m_initialized = true;
 }
 
+// -----------------------------------------------------------------------------
+// Save and restore the tire state in a system snapshot.
+// -----------------------------------------------------------------------------
+void ChTire::SnapshotOut(ChStateSnapshot& snapshot) {
+    snapshot.Write(m_slip_angle);
+    snapshot.Write(m_longitudinal_slip);
+    snapshot.Write(m_camber_angle);
+}
+
+void ChTire::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    reader.Read(m_slip_angle);
+    reader.Read(m_longitudinal_slip);
+    reader.Read(m_camber_angle);
+}
+
 // -----------------------------------------------------------------------------
 // Calculate kinematics quantities (slip angle, longitudinal slip, camber angle,
 // and toe-in angle) using the given state of the associated wheel.
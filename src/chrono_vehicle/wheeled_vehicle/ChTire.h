@@ -149,6 +149,14 @@ class CH_VEHICLE_API ChTire : public ChPart {
     /// Advance the state of this tire by the specified time step.
     virtual void Advance(double step) {}
 
+    /// Append the internal (history) state of this tire to the given snapshot.
+    /// Tires are registered with the system of the associated wheel when initialized through the vehicle, so that their
+    /// state is saved and restored together with the system state (see ChSystem::SaveState).
+    virtual void SnapshotOut(ChStateSnapshot& snapshot);
+
+    /// Restore the internal state of this tire, reading the data written by SnapshotOut.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader);
+
   protected:
     /// Construct a tire subsystem with given name.
     ChTire(const std::string& name);
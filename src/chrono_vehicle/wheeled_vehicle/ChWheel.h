@@ -26,6 +26,7 @@
 
 #include "chrono/assets/ChVisualShapeCylinder.h"
 #include "chrono/assets/ChVisualShapeTriangleMesh.h"
+#include "chrono/physics/ChSystem.h"
 
 #include "chrono_vehicle/ChApiVehicle.h"
 #include "chrono_vehicle/ChChassis.h"
@@ -130,6 +131,8 @@ class CH_VEHICLE_API ChWheel : public ChPart {
     VehicleSide m_side;                 ///< wheel mounted on left/right side
     double m_offset;                    ///< offset from spindle center
 
+    std::shared_ptr<ChSystem::StateSnapshotCallback> m_tire_snapshot;  ///< snapshot callback for the attached tire
+
     std::string m_vis_mesh_file;                                 ///< visualization mesh file (may be empty)
     std::shared_ptr<ChVisualShapeTriangleMesh> m_trimesh_shape;  ///< visualization mesh asset
     std::shared_ptr<ChVisualShape> m_cyl_shape;                  ///< visualization cylinder asset
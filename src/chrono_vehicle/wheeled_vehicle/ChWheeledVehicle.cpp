@@ -33,6 +33,42 @@ ChWheeledVehicle::ChWheeledVehicle(const std::string& name, ChContactMethod cont
 ChWheeledVehicle::ChWheeledVehicle(const std::string& name, ChSystem* system)
     : ChVehicle(name, system), m_parking_on(false) {}
 
+// -----------------------------------------------------------------------------
+// Callback for saving and restoring the tire state in system snapshots.
+// Each record holds a presence flag and, if the tire still exists, its state as a sized block, so that the record can
+// be skipped if the tire expired between saving and restoring.
+// -----------------------------------------------------------------------------
+class TireSnapshotCallback : public ChSystem::StateSnapshotCallback {
+  public:
+    TireSnapshotCallback(std::shared_ptr<ChTire> tire) : m_tire(tire) {}
+
+    virtual void OnSave(ChStateSnapshot& snapshot) override {
+        auto tire = m_tire.lock();
+        snapshot.Write(tire != nullptr);
+        if (tire) {
+            m_record.Clear();
+            tire->SnapshotOut(m_record);
+            snapshot.WriteSnapshot(m_record);
+        }
+    }
+
+    virtual void OnRestore(ChStateSnapshot::Reader& reader) override {
+        bool present;
+        reader.Read(present);
+        if (!present)
+            return;
+        reader.ReadSnapshot(m_record);
+        if (auto tire = m_tire.lock()) {
+            ChStateSnapshot::Reader record_reader(m_record);
+            tire->SnapshotIn(record_reader);
+        }
+    }
+
+  private:
+    std::weak_ptr<ChTire> m_tire;
+    ChStateSnapshot m_record;  ///< tire state (storage reused across saves)
+};
+
 // -----------------------------------------------------------------------------
 // Initialize a tire and attach it to one of the vehicle's wheels.
 // -----------------------------------------------------------------------------
@@ -46,6 +82,13 @@ void ChWheeledVehicle::InitializeTire(std::shared_ptr<ChTire> tire,
     tire->SetVisualizationType(tire_vis);
     tire->SetCollisionType(tire_coll);
 
+    // Include the tire state in system snapshots (replacing the callback of a previous tire on this wheel).
+    auto system = wheel->GetSpindle()->GetSystem();
+    if (wheel->m_tire_snapshot)
+        system->UnregisterStateSnapshotCallback(wheel->m_tire_snapshot);
+    wheel->m_tire_snapshot = chrono_types::make_shared<TireSnapshotCallback>(tire);
+    system->RegisterStateSnapshotCallback(wheel->m_tire_snapshot);
+
     // Recalculate vehicle mass to include the mass of the tire.
     InitializeInertiaProperties();
 }
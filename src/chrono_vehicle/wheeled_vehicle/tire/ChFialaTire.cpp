@@ -30,6 +30,7 @@
 
 #include "chrono/core/ChGlobal.h"
 #include "chrono/functions/ChFunctionSineStep.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 #include "chrono_vehicle/wheeled_vehicle/tire/ChFialaTire.h"
 
@@ -64,6 +65,8 @@ void ChFialaTire::Initialize(std::shared_ptr<ChWheel> wheel) {
 }
 
 void ChFialaTire::Synchronize(double time, const ChTerrain& terrain) {
+    CH_TRACE_ZONE("FialaTire::Synchronize");
+
     m_time = time;
     WheelState wheel_state = m_wheel->GetState();
 
@@ -118,7 +121,33 @@ void ChFialaTire::Synchronize(double time, const ChTerrain& terrain) {
     }
 }
 
+void ChFialaTire::SnapshotOut(ChStateSnapshot& snapshot) {
+    ChForceElementTire::SnapshotOut(snapshot);
+    snapshot.Write(m_states.kappa);
+    snapshot.Write(m_states.alpha);
+    snapshot.Write(m_states.abs_vx);
+    snapshot.Write(m_states.abs_vt);
+    snapshot.Write(m_states.vsx);
+    snapshot.Write(m_states.vsy);
+    snapshot.Write(m_states.omega);
+    snapshot.Write(m_states.disc_normal);
+}
+
+void ChFialaTire::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    ChForceElementTire::SnapshotIn(reader);
+    reader.Read(m_states.kappa);
+    reader.Read(m_states.alpha);
+    reader.Read(m_states.abs_vx);
+    reader.Read(m_states.abs_vt);
+    reader.Read(m_states.vsx);
+    reader.Read(m_states.vsy);
+    reader.Read(m_states.omega);
+    reader.Read(m_states.disc_normal);
+}
+
 void ChFialaTire::Advance(double step) {
+    CH_TRACE_ZONE("FialaTire::Advance");
+
     // Set tire forces to zero.
     m_tireforce.force = ChVector3d(0, 0, 0);
     m_tireforce.moment = ChVector3d(0, 0, 0);
@@ -110,6 +110,12 @@ class CH_VEHICLE_API ChFialaTire : public ChForceElementTire {
     /// Advance the state of this tire by the specified time step.
     virtual void Advance(double step) override;
 
+    /// Append the internal state of this tire to the given snapshot.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Restore the internal state of this tire, reading the data written by SnapshotOut.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
     struct TireStates {
         double kappa;   // Contact Path - Stationary Longitudinal Slip State (Kappa)
         double alpha;   // Contact Path - Stationary Side Slip State (Alpha)
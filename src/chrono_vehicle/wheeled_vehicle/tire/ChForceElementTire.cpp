@@ -77,6 +77,32 @@ TerrainForce ChForceElementTire::ReportTireForceLocal(ChTerrain* terrain, ChCoor
 
 // -----------------------------------------------------------------------------
 
+void ChForceElementTire::SnapshotOut(ChStateSnapshot& snapshot) {
+    ChTire::SnapshotOut(snapshot);
+    snapshot.Write(m_data.in_contact);
+    snapshot.Write(m_data.frame);
+    snapshot.Write(m_data.vel);
+    snapshot.Write(m_data.normal_force);
+    snapshot.Write(m_data.depth);
+    snapshot.Write(m_tireforce.force);
+    snapshot.Write(m_tireforce.point);
+    snapshot.Write(m_tireforce.moment);
+}
+
+void ChForceElementTire::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    ChTire::SnapshotIn(reader);
+    reader.Read(m_data.in_contact);
+    reader.Read(m_data.frame);
+    reader.Read(m_data.vel);
+    reader.Read(m_data.normal_force);
+    reader.Read(m_data.depth);
+    reader.Read(m_tireforce.force);
+    reader.Read(m_tireforce.point);
+    reader.Read(m_tireforce.moment);
+}
+
+// -----------------------------------------------------------------------------
+
 void ChForceElementTire::AddVisualizationAssets(VisualizationType vis) {
     if (vis == VisualizationType::NONE)
         return;
@@ -62,6 +62,12 @@ class CH_VEHICLE_API ChForceElementTire : public ChTire {
     /// Enable/disable information terminal output (default: false).
     void SetVerbose(bool verbose) { m_verbose = verbose; }
 
+    /// Append the internal state of this tire to the given snapshot.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Restore the internal state of this tire, reading the data written by SnapshotOut.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
   protected:
     /// Construct a tire with the specified name.
     ChForceElementTire(const std::string& name);
@@ -40,6 +40,7 @@
 
 #include "chrono/core/ChGlobal.h"
 #include "chrono/functions/ChFunctionSineStep.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 #include "chrono_vehicle/ChConfigVehicle.h"
 #include "chrono_vehicle/ChVehicleModelData.h"
@@ -1753,6 +1754,8 @@ void ChPac02Tire::Initialize(std::shared_ptr<ChWheel> wheel) {
 }
 
 void ChPac02Tire::Synchronize(double time, const ChTerrain& terrain) {
+    CH_TRACE_ZONE("Pac02Tire::Synchronize");
+
     WheelState wheel_state = m_wheel->GetState();
 
     // Extract the wheel normal (expressed in global frame)
@@ -1835,7 +1838,55 @@ void ChPac02Tire::Synchronize(double time, const ChTerrain& terrain) {
     }
 }
 
+void ChPac02Tire::SnapshotOut(ChStateSnapshot& snapshot) {
+    ChForceElementTire::SnapshotOut(snapshot);
+    snapshot.Write(m_states.mu_scale);
+    snapshot.Write(m_states.mu_road);
+    snapshot.Write(m_states.grip_sat_x);
+    snapshot.Write(m_states.grip_sat_y);
+    snapshot.Write(m_states.kappa);
+    snapshot.Write(m_states.alpha);
+    snapshot.Write(m_states.gamma);
+    snapshot.Write(m_states.vx);
+    snapshot.Write(m_states.vsx);
+    snapshot.Write(m_states.vsy);
+    snapshot.Write(m_states.omega);
+    snapshot.Write(m_states.R_eff);
+    snapshot.Write(m_states.Fz0_prime);
+    snapshot.Write(m_states.dfz0);
+    snapshot.Write(m_states.Pi0_prime);
+    snapshot.Write(m_states.dpi);
+    snapshot.Write(m_states.brx);
+    snapshot.Write(m_states.bry);
+    snapshot.Write(m_states.disc_normal);
+}
+
+void ChPac02Tire::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    ChForceElementTire::SnapshotIn(reader);
+    reader.Read(m_states.mu_scale);
+    reader.Read(m_states.mu_road);
+    reader.Read(m_states.grip_sat_x);
+    reader.Read(m_states.grip_sat_y);
+    reader.Read(m_states.kappa);
+    reader.Read(m_states.alpha);
+    reader.Read(m_states.gamma);
+    reader.Read(m_states.vx);
+    reader.Read(m_states.vsx);
+    reader.Read(m_states.vsy);
+    reader.Read(m_states.omega);
+    reader.Read(m_states.R_eff);
+    reader.Read(m_states.Fz0_prime);
+    reader.Read(m_states.dfz0);
+    reader.Read(m_states.Pi0_prime);
+    reader.Read(m_states.dpi);
+    reader.Read(m_states.brx);
+    reader.Read(m_states.bry);
+    reader.Read(m_states.disc_normal);
+}
+
 void ChPac02Tire::Advance(double step) {
+    CH_TRACE_ZONE("Pac02Tire::Advance");
+
     // Set tire forces to zero.
     m_tireforce.force = ChVector3d(0, 0, 0);
     m_tireforce.moment = ChVector3d(0, 0, 0);
@@ -373,6 +373,12 @@ class CH_VEHICLE_API ChPac02Tire : public ChForceElementTire {
     /// Advance the state of this tire by the specified time step.
     virtual void Advance(double step) override;
 
+    /// Append the internal state of this tire to the given snapshot.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Restore the internal state of this tire, reading the data written by SnapshotOut.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
     struct TireStates {
         double mu_scale;         // scaling factor for tire patch forces
         double mu_road;          // actual road friction coefficient
@@ -33,6 +33,7 @@
 
 #include "chrono/core/ChGlobal.h"
 #include "chrono/functions/ChFunctionSineStep.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 #include "chrono_vehicle/wheeled_vehicle/tire/ChPac89Tire.h"
 
@@ -63,6 +64,8 @@ void ChPac89Tire::Initialize(std::shared_ptr<ChWheel> wheel) {
 }
 
 void ChPac89Tire::Synchronize(double time, const ChTerrain& terrain) {
+    CH_TRACE_ZONE("Pac89Tire::Synchronize");
+
     WheelState wheel_state = m_wheel->GetState();
 
     // Extract the wheel normal (expressed in global frame)
@@ -119,7 +122,37 @@ void ChPac89Tire::Synchronize(double time, const ChTerrain& terrain) {
     }
 }
 
+void ChPac89Tire::SnapshotOut(ChStateSnapshot& snapshot) {
+    ChForceElementTire::SnapshotOut(snapshot);
+    snapshot.Write(m_states.cp_long_slip);
+    snapshot.Write(m_states.cp_side_slip);
+    snapshot.Write(m_states.vx);
+    snapshot.Write(m_states.vsx);
+    snapshot.Write(m_states.vsy);
+    snapshot.Write(m_states.omega);
+    snapshot.Write(m_states.R_eff);
+    snapshot.Write(m_states.brx);
+    snapshot.Write(m_states.bry);
+    snapshot.Write(m_states.disc_normal);
+}
+
+void ChPac89Tire::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    ChForceElementTire::SnapshotIn(reader);
+    reader.Read(m_states.cp_long_slip);
+    reader.Read(m_states.cp_side_slip);
+    reader.Read(m_states.vx);
+    reader.Read(m_states.vsx);
+    reader.Read(m_states.vsy);
+    reader.Read(m_states.omega);
+    reader.Read(m_states.R_eff);
+    reader.Read(m_states.brx);
+    reader.Read(m_states.bry);
+    reader.Read(m_states.disc_normal);
+}
+
 void ChPac89Tire::Advance(double step) {
+    CH_TRACE_ZONE("Pac89Tire::Advance");
+
     // Set tire forces to zero.
     m_tireforce.force = ChVector3d(0, 0, 0);
     m_tireforce.moment = ChVector3d(0, 0, 0);
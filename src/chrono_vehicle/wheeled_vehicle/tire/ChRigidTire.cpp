@@ -21,6 +21,7 @@
 #include "chrono/core/ChGlobal.h"
 #include "chrono/physics/ChSystem.h"
 #include "chrono/physics/ChContactContainer.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 #include "chrono_vehicle/wheeled_vehicle/tire/ChRigidTire.h"
 
@@ -76,6 +77,8 @@ void ChRigidTire::Initialize(std::shared_ptr<ChWheel> wheel) {
 }
 
 void ChRigidTire::Synchronize(double time, const ChTerrain& terrain) {
+    CH_TRACE_ZONE("RigidTire::Synchronize");
+
     WheelState wheel_state = m_wheel->GetState();
 
     // Calculate tire reference frame
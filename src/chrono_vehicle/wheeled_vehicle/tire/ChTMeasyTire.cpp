@@ -46,6 +46,7 @@
 
 #include "chrono/core/ChGlobal.h"
 #include "chrono/functions/ChFunctionSineStep.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 #include "chrono_vehicle/wheeled_vehicle/tire/ChTMeasyTire.h"
 
@@ -105,6 +106,8 @@ void ChTMeasyTire::Initialize(std::shared_ptr<ChWheel> wheel) {
 // -----------------------------------------------------------------------------
 
 void ChTMeasyTire::Synchronize(double time, const ChTerrain& terrain) {
+    CH_TRACE_ZONE("TMeasyTire::Synchronize");
+
     m_time = time;
     WheelState wheel_state = m_wheel->GetState();
 
@@ -192,7 +195,71 @@ void ChTMeasyTire::Synchronize(double time, const ChTerrain& terrain) {
     }
 }
 
+void ChTMeasyTire::SnapshotOut(ChStateSnapshot& snapshot) {
+    ChForceElementTire::SnapshotOut(snapshot);
+    snapshot.Write(m_states.sx);
+    snapshot.Write(m_states.sy);
+    snapshot.Write(m_states.q);
+    snapshot.Write(m_states.gamma);
+    snapshot.Write(m_states.muscale);
+    snapshot.Write(m_states.vta);
+    snapshot.Write(m_states.vsx);
+    snapshot.Write(m_states.vsy);
+    snapshot.Write(m_states.omega);
+    snapshot.Write(m_states.R_eff);
+    snapshot.Write(m_states.P_len);
+    snapshot.Write(m_states.dfx0);
+    snapshot.Write(m_states.sxm);
+    snapshot.Write(m_states.fxm);
+    snapshot.Write(m_states.sxs);
+    snapshot.Write(m_states.fxs);
+    snapshot.Write(m_states.dfy0);
+    snapshot.Write(m_states.sym);
+    snapshot.Write(m_states.fym);
+    snapshot.Write(m_states.sys);
+    snapshot.Write(m_states.fys);
+    snapshot.Write(m_states.nL0);
+    snapshot.Write(m_states.sq0);
+    snapshot.Write(m_states.sqe);
+    snapshot.Write(m_states.brx);
+    snapshot.Write(m_states.bry);
+    snapshot.Write(m_states.disc_normal);
+}
+
+void ChTMeasyTire::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    ChForceElementTire::SnapshotIn(reader);
+    reader.Read(m_states.sx);
+    reader.Read(m_states.sy);
+    reader.Read(m_states.q);
+    reader.Read(m_states.gamma);
+    reader.Read(m_states.muscale);
+    reader.Read(m_states.vta);
+    reader.Read(m_states.vsx);
+    reader.Read(m_states.vsy);
+    reader.Read(m_states.omega);
+    reader.Read(m_states.R_eff);
+    reader.Read(m_states.P_len);
+    reader.Read(m_states.dfx0);
+    reader.Read(m_states.sxm);
+    reader.Read(m_states.fxm);
+    reader.Read(m_states.sxs);
+    reader.Read(m_states.fxs);
+    reader.Read(m_states.dfy0);
+    reader.Read(m_states.sym);
+    reader.Read(m_states.fym);
+    reader.Read(m_states.sys);
+    reader.Read(m_states.fys);
+    reader.Read(m_states.nL0);
+    reader.Read(m_states.sq0);
+    reader.Read(m_states.sqe);
+    reader.Read(m_states.brx);
+    reader.Read(m_states.bry);
+    reader.Read(m_states.disc_normal);
+}
+
 void ChTMeasyTire::Advance(double step) {
+    CH_TRACE_ZONE("TMeasyTire::Advance");
+
     // Set tire forces to zero.
     m_tireforce.force = ChVector3d(0, 0, 0);
     m_tireforce.moment = ChVector3d(0, 0, 0);
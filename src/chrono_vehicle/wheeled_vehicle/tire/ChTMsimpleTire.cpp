@@ -32,6 +32,7 @@
 
 #include "chrono/core/ChGlobal.h"
 #include "chrono/functions/ChFunctionSineStep.h"
+#include "chrono/utils/ChTraceProfiler.h"
 
 #include "chrono_vehicle/wheeled_vehicle/tire/ChTMsimpleTire.h"
 
@@ -91,6 +92,8 @@ void ChTMsimpleTire::Initialize(std::shared_ptr<ChWheel> wheel) {
 // -----------------------------------------------------------------------------
 
 void ChTMsimpleTire::Synchronize(double time, const ChTerrain& terrain) {
+    CH_TRACE_ZONE("TMsimpleTire::Synchronize");
+
     m_time = time;
     WheelState wheel_state = m_wheel->GetState();
 
@@ -156,7 +159,43 @@ void ChTMsimpleTire::Synchronize(double time, const ChTerrain& terrain) {
     }
 }
 
+void ChTMsimpleTire::SnapshotOut(ChStateSnapshot& snapshot) {
+    ChForceElementTire::SnapshotOut(snapshot);
+    snapshot.Write(m_states.sx);
+    snapshot.Write(m_states.sy);
+    snapshot.Write(m_states.gamma);
+    snapshot.Write(m_states.muscale);
+    snapshot.Write(m_states.vta);
+    snapshot.Write(m_states.vsx);
+    snapshot.Write(m_states.vsy);
+    snapshot.Write(m_states.omega);
+    snapshot.Write(m_states.R_eff);
+    snapshot.Write(m_states.P_len);
+    snapshot.Write(m_states.brx);
+    snapshot.Write(m_states.bry);
+    snapshot.Write(m_states.disc_normal);
+}
+
+void ChTMsimpleTire::SnapshotIn(ChStateSnapshot::Reader& reader) {
+    ChForceElementTire::SnapshotIn(reader);
+    reader.Read(m_states.sx);
+    reader.Read(m_states.sy);
+    reader.Read(m_states.gamma);
+    reader.Read(m_states.muscale);
+    reader.Read(m_states.vta);
+    reader.Read(m_states.vsx);
+    reader.Read(m_states.vsy);
+    reader.Read(m_states.omega);
+    reader.Read(m_states.R_eff);
+    reader.Read(m_states.P_len);
+    reader.Read(m_states.brx);
+    reader.Read(m_states.bry);
+    reader.Read(m_states.disc_normal);
+}
+
 void ChTMsimpleTire::Advance(double step) {
+    CH_TRACE_ZONE("TMsimpleTire::Advance");
+
     // Set tire forces to zero.
     m_tireforce.force = ChVector3d(0, 0, 0);
     m_tireforce.moment = ChVector3d(0, 0, 0);
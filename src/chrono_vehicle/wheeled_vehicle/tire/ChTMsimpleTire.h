@@ -228,6 +228,12 @@ class CH_VEHICLE_API ChTMsimpleTire : public ChForceElementTire {
     /// Advance the state of this tire by the specified time step.
     virtual void Advance(double step) override;
 
+    /// Append the internal state of this tire to the given snapshot.
+    virtual void SnapshotOut(ChStateSnapshot& snapshot) override;
+
+    /// Restore the internal state of this tire, reading the data written by SnapshotOut.
+    virtual void SnapshotIn(ChStateSnapshot::Reader& reader) override;
+
     void TMcombinedForces(double& fx, double& fy, double sx, double sy, double fz, double muscale);
     void CombinedCoulombForces(double& fx, double& fy, double fz, double muscale);
 
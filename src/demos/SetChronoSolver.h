@@ -95,7 +95,8 @@ bool SetChronoSolver(chrono::ChSystem& sys,
         sys.SetSolverType(slvr_type);
         switch (slvr_type) {
             case chrono::ChSolver::Type::SPARSE_LU:
-            case chrono::ChSolver::Type::SPARSE_QR: {
+            case chrono::ChSolver::Type::SPARSE_QR:
+            case chrono::ChSolver::Type::SPARSE_CHOLESKY: {
                 auto solver = std::static_pointer_cast<chrono::ChDirectSolverLS>(sys.GetSolver());
                 solver->LockSparsityPattern(false);
                 solver->UseSparsityPatternLearner(false);
@@ -0,0 +1,128 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit tests for the shared collision geometry cache.
+// - cached data is shared for identical content and released when unused
+// - simulation results do not depend on whether collision geometry is shared
+//
+// =============================================================================
+
+#include "chrono/collision/ChCollisionGeometryCache.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+TEST(ChCollisionGeometryCache, sharing) {
+    std::vector<ChVector3d> points = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+
+    ChCollisionGeometryCache<std::vector<ChVector3d>> cache;
+    int num_builds = 0;
+    auto builder = [&]() {
+        num_builds++;
+        return chrono_types::make_shared<std::vector<ChVector3d>>(points);
+    };
+
+    ChCollisionGeometryKey key1("hull");
+    key1.Add(0.01);
+    key1.Add(points);
+
+    ChCollisionGeometryKey key2("hull");
+    key2.Add(0.01);
+    key2.Add(points);
+
+    ChCollisionGeometryKey key3("hull");
+    key3.Add(0.02);
+    key3.Add(points);
+
+    ASSERT_TRUE(key1 == key2);
+    ASSERT_FALSE(key1 == key3);
+    ASSERT_EQ(key1.Hash(), key2.Hash());
+    ASSERT_NE(key1.Hash(), key3.Hash());
+    ASSERT_EQ(key1.Size(), key3.Size());
+
+    // Identical content is built once and shared
+    auto data1 = cache.Get(key1, builder);
+    auto data2 = cache.Get(key2, builder);
+    ASSERT_EQ(num_builds, 1);
+    ASSERT_EQ(data1, data2);
+    ASSERT_EQ(cache.Size(), 1);
+
+    // Different build parameters result in different data
+    auto data3 = cache.Get(key3, builder);
+    ASSERT_EQ(num_builds, 2);
+    ASSERT_NE(data1, data3);
+    ASSERT_EQ(cache.Size(), 2);
+
+    // Data no longer in use is released
+    data1.reset();
+    data2.reset();
+    ASSERT_EQ(cache.Size(), 1);
+    cache.Get(key1, builder);
+    ASSERT_EQ(num_builds, 3);
+}
+
+// ====================================================================================
+
+// Drop a number of identical convex hull bodies on the ground and return their final positions.
+static std::vector<double> Simulate(bool share) {
+    ChCollisionModel::EnableGeometrySharing(share);
+
+    ChSystemNSC sys;
+    sys.SetCollisionSystemType(ChCollisionSystem::Type::BULLET);
+    sys.SetGravitationalAcceleration(ChVector3d(0, 0, -9.81));
+
+    auto mat = chrono_types::make_shared<ChContactMaterialNSC>();
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(10, 10, 1, 1000, false, true, mat);
+    ground->SetPos(ChVector3d(0, 0, -0.5));
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<ChVector3d> points = {{-0.2, -0.2, -0.2}, {0.3, -0.2, -0.2}, {-0.2, 0.25, -0.2},
+                                      {0.2, 0.2, -0.15},  {0, 0, 0.3},       {0.1, -0.1, 0.2}};
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    for (int i = 0; i < 8; i++) {
+        auto body = chrono_types::make_shared<ChBodyEasyConvexHull>(points, 1000, false, true, mat);
+        body->SetPos(body->GetPos() + ChVector3d(0.7 * (i % 4) - 1, 0.7 * (i / 4), 0.5 + 0.1 * i));
+        sys.AddBody(body);
+        bodies.push_back(body);
+    }
+
+    for (int i = 0; i < 500; i++)
+        sys.DoStepDynamics(2e-3);
+
+    std::vector<double> pos;
+    for (const auto& body : bodies) {
+        pos.push_back(body->GetPos().x());
+        pos.push_back(body->GetPos().y());
+        pos.push_back(body->GetPos().z());
+    }
+    return pos;
+}
+
+TEST(ChCollisionGeometryCache, simulation) {
+    auto pos_shared = Simulate(true);
+    auto pos_unshared = Simulate(false);
+    ChCollisionModel::EnableGeometrySharing(true);
+
+    ASSERT_EQ(pos_shared.size(), pos_unshared.size());
+    for (size_t i = 0; i < pos_shared.size(); i++)
+        ASSERT_EQ(pos_shared[i], pos_unshared[i]) << "i = " << i;
+
+    // All bodies came to rest on the ground
+    for (size_t i = 2; i < pos_shared.size(); i += 3)
+        ASSERT_LT(pos_shared[i], 0.5);
+}
@@ -0,0 +1,102 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for batched ray-hit tests.
+// A grid of vertical rays, followed by randomly oriented rays, is cast against a
+// collection of boxes, spheres, and cylinders. The results of the batched tests
+// must match those of individual ray-hit tests.
+//
+// =============================================================================
+
+#include <random>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+TEST(RayHitBatch, bullet) {
+    ChSystemNSC sys;
+    sys.SetCollisionSystemType(ChCollisionSystem::Type::BULLET);
+    sys.SetNumThreads(4, 4, 1);
+
+    auto mat = chrono_types::make_shared<ChContactMaterialNSC>();
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 4, 0.2, 1000, false, true, mat);
+    ground->SetPos(ChVector3d(0, 0, -0.1));
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    std::default_random_engine generator(11);
+    std::uniform_real_distribution<double> distribution(-1.5, 1.5);
+    for (int i = 0; i < 30; i++) {
+        std::shared_ptr<ChBody> body;
+        switch (i % 3) {
+            case 0:
+                body = chrono_types::make_shared<ChBodyEasyBox>(0.3, 0.2, 0.1, 1000, false, true, mat);
+                break;
+            case 1:
+                body = chrono_types::make_shared<ChBodyEasySphere>(0.15, 1000, false, true, mat);
+                break;
+            case 2:
+                body = chrono_types::make_shared<ChBodyEasyCylinder>(ChAxis::Z, 0.1, 0.3, 1000, false, true, mat);
+                break;
+        }
+        body->SetPos(ChVector3d(distribution(generator), distribution(generator), 0.5 + 0.3 * (i % 4)));
+        body->SetRot(QuatFromAngleAxis(distribution(generator), ChVector3d(1, 2, 3).GetNormalized()));
+        body->SetFixed(true);
+        sys.AddBody(body);
+    }
+
+    sys.DoStepDynamics(1e-3);
+
+    std::vector<ChCollisionSystem::ChRay> rays;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            ChVector3d from(-2 + 0.1 * i, -2 + 0.1 * j, 3);
+            rays.push_back({from, from - ChVector3d(0, 0, 5)});
+        }
+    }
+    for (int i = 0; i < 200; i++) {
+        ChVector3d from(distribution(generator), distribution(generator), 3 + distribution(generator));
+        ChVector3d to(distribution(generator), distribution(generator), -1);
+        rays.push_back({from, to});
+    }
+
+    auto coll_sys = sys.GetCollisionSystem();
+    std::vector<ChCollisionSystem::ChRayhitResult> results;
+    int num_hits = coll_sys->RayHitBatch(rays, results);
+    ASSERT_EQ(results.size(), rays.size());
+
+    int num_hits_single = 0;
+    int num_hits_bodies = 0;
+    for (size_t i = 0; i < rays.size(); i++) {
+        ChCollisionSystem::ChRayhitResult result;
+        coll_sys->RayHit(rays[i].from, rays[i].to, result);
+        ASSERT_EQ(results[i].hit, result.hit) << "ray " << i;
+        if (!result.hit)
+            continue;
+        num_hits_single++;
+        if (result.hitModel != ground->GetCollisionModel().get())
+            num_hits_bodies++;
+        ASSERT_EQ(results[i].hitModel, result.hitModel) << "ray " << i;
+        ASSERT_LT((results[i].abs_hitPoint - result.abs_hitPoint).Length(), 1e-9) << "ray " << i;
+        ASSERT_LT((results[i].abs_hitNormal - result.abs_hitNormal).Length(), 1e-9) << "ray " << i;
+        ASSERT_NEAR(results[i].dist_factor, result.dist_factor, 1e-12) << "ray " << i;
+    }
+
+    ASSERT_EQ(num_hits, num_hits_single);
+    ASSERT_GT(num_hits_bodies, 50);
+}
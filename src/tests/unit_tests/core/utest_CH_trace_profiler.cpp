@@ -0,0 +1,110 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the trace profiler.
+// - nested zones recorded on several threads are reported with their paths in
+//   the per-step summary
+// - zones beyond the per-thread capacity are dropped, with proper nesting
+//
+// =============================================================================
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "chrono/utils/ChTraceProfiler.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+// ====================================================================================
+
+// Read the lines of the per-step summary (without header).
+static std::vector<std::string> ReadSummary(const ChTraceProfiler& profiler) {
+    EXPECT_TRUE(profiler.WriteStepSummary("trace_summary.csv"));
+    std::ifstream is("trace_summary.csv");
+    std::vector<std::string> lines;
+    std::string line;
+    std::getline(is, line);
+    while (std::getline(is, line)) {
+        // Keep the step, zone path, number of calls, and number of threads (discard timings)
+        std::stringstream ss(line);
+        std::string field;
+        std::string fields;
+        for (int i = 0; i < 4 && std::getline(ss, field, ','); i++)
+            fields += (i > 0 ? "," : "") + field;
+        lines.push_back(fields);
+    }
+    return lines;
+}
+
+static void RecordNested() {
+    ChTraceZone outer("outer");
+    for (int i = 0; i < 2; i++) {
+        ChTraceZone inner("inner");
+        ChTraceZone innermost("innermost");
+    }
+}
+
+TEST(TraceProfiler, nested_zones) {
+    auto& profiler = ChTraceProfiler::GetInstance();
+    profiler.Reset();
+    profiler.Enable(true);
+
+    profiler.NewStep();
+    RecordNested();
+    profiler.NewStep();
+    std::thread t1(RecordNested);
+    std::thread t2(RecordNested);
+    t1.join();
+    t2.join();
+
+    profiler.Enable(false);
+    RecordNested();  // not recorded
+
+    ASSERT_EQ(profiler.GetNumZones(), 3 * 5);
+    ASSERT_EQ(profiler.GetNumDroppedZones(), 0);
+
+    // step, path, calls, threads
+    std::vector<std::string> expected = {"0,outer,1,1", "0,outer/inner,2,1", "0,outer/inner/innermost,2,1",
+                                         "1,outer,2,2", "1,outer/inner,4,2", "1,outer/inner/innermost,4,2"};
+    ASSERT_EQ(ReadSummary(profiler), expected);
+
+    profiler.Reset();
+    ASSERT_EQ(profiler.GetNumZones(), 0);
+}
+
+TEST(TraceProfiler, capacity) {
+    auto& profiler = ChTraceProfiler::GetInstance();
+    profiler.Reset();
+    profiler.SetMaxZonesPerThread(2);
+    profiler.Enable(true);
+
+    profiler.NewStep();
+    RecordNested();  // records "outer" and the first "inner"
+    {
+        // Zones dropped while the buffer is full do not close recorded zones
+        ChTraceZone zone("dropped");
+    }
+
+    profiler.Enable(false);
+    ASSERT_EQ(profiler.GetNumZones(), 2);
+    ASSERT_EQ(profiler.GetNumDroppedZones(), 4);
+
+    std::vector<std::string> expected = {"0,outer,1,1", "0,outer/inner,1,1"};
+    ASSERT_EQ(ReadSummary(profiler), expected);
+
+    profiler.SetMaxZonesPerThread(1 << 20);
+    profiler.Reset();
+    ASSERT_EQ(profiler.GetNumDroppedZones(), 0);
+}
@@ -0,0 +1,130 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the batched evaluation of internal forces in ChMesh, using
+// ANCF 3843 brick elements. The internal forces loaded by the mesh (with the
+// elements evaluated in batches) must match those obtained by evaluating each
+// element separately.
+//
+// =============================================================================
+
+#include <random>
+
+#include "chrono/fea/ChElementHexaANCF_3843.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// ====================================================================================
+
+class BatchTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() override {
+        double length = 1.0;
+        double width = 0.1;
+        double height = 0.1;
+        int num_elements = 11;
+        double dx = length / num_elements;
+
+        auto material = chrono_types::make_shared<ChMaterialHexaANCF>(7850, 2e9, 0.3);
+
+        mesh = chrono_types::make_shared<ChMesh>();
+        mesh->SetAutomaticGravity(false);
+        sys.Add(mesh);
+
+        ChVector3d dir1(1, 0, 0);
+        ChVector3d dir2(0, 1, 0);
+        ChVector3d dir3(0, 0, 1);
+
+        std::shared_ptr<ChNodeFEAxyzDDD> nodes[4];
+        for (int j = 0; j < 4; j++) {
+            ChVector3d pos(0, (j % 2 - 0.5) * width, (j / 2 - 0.5) * height);
+            nodes[j] = chrono_types::make_shared<ChNodeFEAxyzDDD>(pos, dir1, dir2, dir3);
+            mesh->AddNode(nodes[j]);
+        }
+
+        for (int i = 1; i <= num_elements; i++) {
+            std::shared_ptr<ChNodeFEAxyzDDD> next[4];
+            for (int j = 0; j < 4; j++) {
+                ChVector3d pos(dx * i, (j % 2 - 0.5) * width, (j / 2 - 0.5) * height);
+                next[j] = chrono_types::make_shared<ChNodeFEAxyzDDD>(pos, dir1, dir2, dir3);
+                mesh->AddNode(next[j]);
+            }
+
+            auto element = chrono_types::make_shared<ChElementHexaANCF_3843>();
+            element->SetNodes(nodes[0], next[0], next[1], nodes[1], nodes[2], next[2], next[3], nodes[3]);
+            element->SetDimensions(dx, width, height);
+            element->SetMaterial(material);
+            element->SetAlphaDamp(0.0);
+            mesh->AddElement(element);
+            elements.push_back(element);
+
+            for (int j = 0; j < 4; j++)
+                nodes[j] = next[j];
+        }
+
+        sys.Setup();
+
+        // Perturb the nodal coordinates
+        std::default_random_engine generator(42);
+        std::uniform_real_distribution<double> distribution(-0.01, 0.01);
+        for (unsigned int i = 0; i < mesh->GetNumNodes(); i++) {
+            auto node = std::dynamic_pointer_cast<ChNodeFEAxyzDDD>(mesh->GetNode(i));
+            node->SetPos(node->GetPos() + ChVector3d(distribution(generator), distribution(generator), 0));
+            node->SetSlope1(node->GetSlope1() + ChVector3d(0, distribution(generator), distribution(generator)));
+            node->SetSlope2(node->GetSlope2() + ChVector3d(distribution(generator), 0, 0));
+        }
+    }
+
+    // Compare the internal forces loaded by the mesh with those obtained element by element.
+    void Compare() {
+        double c = 0.5;
+
+        ChVectorDynamic<> R_mesh(sys.GetNumCoordsVelLevel());
+        R_mesh.setZero();
+        mesh->IntLoadResidual_F(mesh->GetOffset_w(), R_mesh, c);
+
+        ChVectorDynamic<> R_ref(sys.GetNumCoordsVelLevel());
+        R_ref.setZero();
+        for (const auto& element : elements) {
+            ChVectorDynamic<> Fi(element->GetNumCoordsPosLevel());
+            element->ComputeInternalForces(Fi);
+            for (unsigned int in = 0; in < element->GetNumNodes(); in++) {
+                auto node = element->GetNode(in);
+                R_ref.segment(node->NodeGetOffsetVelLevel(), 12) += c * Fi.segment(12 * in, 12);
+            }
+        }
+
+        ASSERT_GT(R_ref.norm(), 0);
+        ASSERT_LT((R_mesh - R_ref).norm(), 1e-12 * R_ref.norm());
+    }
+
+    ChSystemSMC sys;
+    std::shared_ptr<ChMesh> mesh;
+    std::vector<std::shared_ptr<ChElementHexaANCF_3843>> elements;
+};
+
+TEST_F(BatchTest, internal_forces) {
+    Compare();
+}
+
+TEST_F(BatchTest, mixed_methods) {
+    Compare();
+
+    // Elements switched to a method without batched evaluation after the batches were formed
+    elements[2]->SetIntFrcCalcMethod(ChElementHexaANCF_3843::IntFrcMethod::PreInt);
+    elements[5]->SetAlphaDamp(0.01);
+    Compare();
+}
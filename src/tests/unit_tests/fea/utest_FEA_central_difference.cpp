@@ -0,0 +1,171 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit tests for the central difference explicit timestepper.
+// - the critical step of a chain of bar elements matches the analytical value
+//   L/c, reduced by the element damping, and the critical step of a constrained
+//   node accounts for the penalty
+// - with automatic substepping, an axially loaded bar chain follows the
+//   solution obtained with HHT, while steps above the critical one diverge
+//
+// =============================================================================
+
+#include "chrono/fea/ChElementBar.h"
+#include "chrono/fea/ChLinkNodeFrame.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/timestepper/ChTimestepper.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// ====================================================================================
+
+const double E_modulus = 1e7;
+const double density = 1000;
+const double area = 1e-4;
+const double length = 0.1;
+const int num_elements = 10;
+const double tip_force = 10;
+
+// Chain of bars along the X axis, fixed at its first node and loaded axially at its last node.
+class BarChain {
+  public:
+    BarChain(ChTimestepper::Type type, double damping = 0) {
+        sys.SetGravitationalAcceleration(ChVector3d(0, 0, 0));
+
+        mesh = chrono_types::make_shared<ChMesh>();
+        mesh->SetAutomaticGravity(false);
+        sys.Add(mesh);
+
+        std::shared_ptr<ChNodeFEAxyz> prev;
+        for (int i = 0; i <= num_elements; i++) {
+            auto node = chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(i * length, 0, 0));
+            mesh->AddNode(node);
+            if (i == 0)
+                node->SetFixed(true);
+            if (prev) {
+                auto element = chrono_types::make_shared<ChElementBar>();
+                element->SetNodes(prev, node);
+                element->SetArea(area);
+                element->SetDensity(density);
+                element->SetYoungModulus(E_modulus);
+                element->SetRayleighDamping(damping);
+                mesh->AddElement(element);
+            }
+            prev = node;
+        }
+        tip = prev;
+        tip->SetForce(ChVector3d(tip_force, 0, 0));
+
+        sys.SetSolver(chrono_types::make_shared<ChSolverSparseLU>());
+        sys.SetTimestepperType(type);
+    }
+
+    double TipDisplacement() const { return tip->GetPos().x() - num_elements * length; }
+
+    ChSystemSMC sys;
+    std::shared_ptr<ChMesh> mesh;
+    std::shared_ptr<ChNodeFEAxyz> tip;
+};
+
+TEST(CentralDifference, critical_step) {
+    BarChain chain(ChTimestepper::Type::CENTRAL_DIFFERENCE);
+    auto integrator = std::dynamic_pointer_cast<ChTimestepperCentralDifference>(chain.sys.GetTimestepper());
+    ASSERT_TRUE(integrator);
+
+    chain.sys.DoStepDynamics(1e-4);
+
+    // Free-free bar with lumped mass: 2/omega_max = L/c
+    double critical_step = length / std::sqrt(E_modulus / density);
+    ASSERT_NEAR(chain.mesh->GetCriticalStepSize(), critical_step, 1e-9 * critical_step);
+    ASSERT_NEAR(integrator->GetCriticalStepSize(), critical_step, 1e-9 * critical_step);
+
+    // With stiffness-proportional damping R = beta*K, the damping of the highest mode is c = beta*omega^2
+    double beta = 1e-4;
+    BarChain damped_chain(ChTimestepper::Type::CENTRAL_DIFFERENCE, beta);
+    damped_chain.sys.DoStepDynamics(1e-4);
+    double omega = 2 / critical_step;
+    double c = beta * omega * omega;
+    double damped_step = 2 / (std::sqrt(omega * omega + c * c / 4) + c / 2);
+    ASSERT_LT(damped_step, 0.95 * critical_step);
+    ASSERT_NEAR(damped_chain.mesh->GetCriticalStepSize(), damped_step, 1e-9 * damped_step);
+}
+
+TEST(CentralDifference, penalty_critical_step) {
+    ChSystemSMC sys;
+    sys.SetGravitationalAcceleration(ChVector3d(0, 0, 0));
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    sys.Add(mesh);
+
+    double mass = 2;
+    auto node = chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(1, 0, 0));
+    node->SetMass(mass);
+    mesh->AddNode(node);
+
+    auto link = chrono_types::make_shared<ChLinkNodeFrame>();
+    link->Initialize(node, ground);
+    sys.Add(link);
+
+    double Ck = 1e6;
+    auto integrator = chrono_types::make_shared<ChTimestepperCentralDifference>(&sys);
+    integrator->SetDiagonalLumpingON(Ck);
+    sys.SetTimestepper(integrator);
+
+    sys.DoStepDynamics(1e-4);
+
+    // The mesh has no elements, the critical step is set by the penalty stiffness of the link
+    double critical_step = 2 * std::sqrt(mass / Ck);
+    ASSERT_FALSE(std::isfinite(mesh->GetCriticalStepSize()));
+    ASSERT_NEAR(integrator->GetCriticalStepSize(), critical_step, 1e-3 * critical_step);
+}
+
+TEST(CentralDifference, stability) {
+    double critical_step = length / std::sqrt(E_modulus / density);
+    double static_displ = tip_force * num_elements * length / (E_modulus * area);
+
+    // Steps 5 times larger than the critical step, with automatic substepping
+    BarChain explicit_chain(ChTimestepper::Type::CENTRAL_DIFFERENCE);
+    auto integrator = std::dynamic_pointer_cast<ChTimestepperCentralDifference>(explicit_chain.sys.GetTimestepper());
+    ASSERT_TRUE(integrator);
+
+    // Reference solution with HHT and a small step
+    BarChain reference(ChTimestepper::Type::HHT);
+
+    double step = 5 * critical_step;
+    int num_steps = 10;
+    int num_substeps = 50;
+    for (int i = 0; i < num_steps; i++) {
+        explicit_chain.sys.DoStepDynamics(step);
+        for (int k = 0; k < num_substeps; k++)
+            reference.sys.DoStepDynamics(step / num_substeps);
+        ASSERT_GE(integrator->GetNumSubsteps(), 6);
+        ASSERT_NEAR(explicit_chain.TipDisplacement(), reference.TipDisplacement(), 0.1 * static_displ)
+            << "step " << i;
+    }
+    ASSERT_GT(explicit_chain.TipDisplacement(), 0.5 * static_displ);
+
+    // Without substepping, steps larger than the critical step diverge
+    BarChain unstable_chain(ChTimestepper::Type::CENTRAL_DIFFERENCE);
+    auto unstable = std::dynamic_pointer_cast<ChTimestepperCentralDifference>(unstable_chain.sys.GetTimestepper());
+    unstable->SetAutomaticSubstepping(false);
+    for (int i = 0; i < 200; i++)
+        unstable_chain.sys.DoStepDynamics(1.5 * critical_step);
+    ASSERT_FALSE(std::abs(unstable_chain.TipDisplacement()) < 10 * static_displ);
+}
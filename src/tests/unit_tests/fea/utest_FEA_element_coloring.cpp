@@ -0,0 +1,137 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the multithreaded evaluation of mesh quantities.
+// - elements with the same color never share a node
+// - internal forces evaluated in parallel over colors match an element-by-element
+//   serial evaluation
+// - KRM matrices loaded in parallel match the serial element matrices
+//
+// =============================================================================
+
+#include <random>
+#include <set>
+
+#include "chrono/fea/ChElementHexaCorot_8.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// ====================================================================================
+
+// Block of nx x ny x nz hexahedra with randomly perturbed nodes.
+class ColoringTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() override {
+        auto material = chrono_types::make_shared<ChContinuumElastic>(2e7, 0.3, 1000);
+        material->SetRayleighDampingBeta(0.01);
+
+        mesh = chrono_types::make_shared<ChMesh>();
+        mesh->SetAutomaticGravity(false);
+        sys.Add(mesh);
+        sys.SetNumThreads(4, 1, 1);
+
+        std::default_random_engine generator(3);
+        std::uniform_real_distribution<double> distribution(-0.01, 0.01);
+
+        const int nx = 5;
+        const int ny = 4;
+        const int nz = 3;
+        double size = 0.1;
+        std::shared_ptr<ChNodeFEAxyz> nodes[nx + 1][ny + 1][nz + 1];
+        for (int i = 0; i <= nx; i++) {
+            for (int j = 0; j <= ny; j++) {
+                for (int k = 0; k <= nz; k++) {
+                    ChVector3d pos(i * size, j * size, k * size);
+                    nodes[i][j][k] = chrono_types::make_shared<ChNodeFEAxyz>(pos);
+                    mesh->AddNode(nodes[i][j][k]);
+                }
+            }
+        }
+
+        for (int i = 0; i < nx; i++) {
+            for (int j = 0; j < ny; j++) {
+                for (int k = 0; k < nz; k++) {
+                    auto element = chrono_types::make_shared<ChElementHexaCorot_8>();
+                    element->SetNodes(nodes[i][j][k], nodes[i + 1][j][k], nodes[i + 1][j][k + 1],
+                                      nodes[i][j][k + 1], nodes[i][j + 1][k], nodes[i + 1][j + 1][k],
+                                      nodes[i + 1][j + 1][k + 1], nodes[i][j + 1][k + 1]);
+                    element->SetMaterial(material);
+                    mesh->AddElement(element);
+                }
+            }
+        }
+
+        sys.Setup();
+
+        // Deform the mesh
+        for (unsigned int in = 0; in < mesh->GetNumNodes(); in++) {
+            auto node = std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(in));
+            node->SetPos(node->GetPos() + ChVector3d(distribution(generator), distribution(generator),
+                                                     distribution(generator)));
+            node->SetPosDt(ChVector3d(distribution(generator), distribution(generator), distribution(generator)));
+        }
+        sys.Update(false);
+    }
+
+    ChSystemSMC sys;
+    std::shared_ptr<ChMesh> mesh;
+};
+
+TEST_F(ColoringTest, colors) {
+    ASSERT_GT(mesh->GetNumElementColors(), 1);
+
+    std::vector<int> element_color(mesh->GetNumElements(), -1);
+    for (unsigned int ic = 0; ic < mesh->GetNumElementColors(); ic++) {
+        std::set<ChNodeFEAbase*> color_nodes;
+        for (auto ie : mesh->GetElementColor(ic)) {
+            // Each element has exactly one color
+            ASSERT_EQ(element_color[ie], -1);
+            element_color[ie] = ic;
+
+            // Elements of the same color do not share nodes
+            auto element = mesh->GetElement(ie);
+            for (unsigned int in = 0; in < element->GetNumNodes(); in++)
+                ASSERT_TRUE(color_nodes.insert(element->GetNode(in).get()).second) << "element " << ie;
+        }
+    }
+    for (unsigned int ie = 0; ie < mesh->GetNumElements(); ie++)
+        ASSERT_GE(element_color[ie], 0);
+}
+
+TEST_F(ColoringTest, internal_forces) {
+    ChVectorDynamic<> R(sys.GetNumCoordsVelLevel());
+    R.setZero();
+    mesh->IntLoadResidual_F(0, R, 0.5);
+
+    ChVectorDynamic<> R_serial(sys.GetNumCoordsVelLevel());
+    R_serial.setZero();
+    for (unsigned int ie = 0; ie < mesh->GetNumElements(); ie++)
+        mesh->GetElement(ie)->EleIntLoadResidual_F(R_serial, 0.5);
+
+    ASSERT_GT(R_serial.norm(), 0);
+    ASSERT_LT((R - R_serial).norm(), 1e-12 * R_serial.norm());
+}
+
+TEST_F(ColoringTest, KRM_matrices) {
+    mesh->LoadKRMMatrices(1.0, 0.1, 0.01);
+
+    for (unsigned int ie = 0; ie < mesh->GetNumElements(); ie++) {
+        auto element = std::dynamic_pointer_cast<ChElementHexaCorot_8>(mesh->GetElement(ie));
+        ChMatrixDynamic<> H(24, 24);
+        element->ComputeKRMmatricesGlobal(H, 1.0, 0.1, 0.01);
+        ASSERT_EQ(element->Kstiffness().GetMatrix(), H) << "element " << ie;
+    }
+}
@@ -0,0 +1,114 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the Jacobian-free Newton-Krylov mode of ChSystem.
+// A column of corotational hexahedra, clamped at its base, is bent by a tip load.
+// The simulation with matrix-free Newton products (GMRES) must match the one
+// with the assembled Newton matrix (sparse LU), for the HHT and the implicit
+// Euler integrators.
+//
+// =============================================================================
+
+#include "chrono/fea/ChElementHexaCorot_8.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChIterativeSolverLS.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// ====================================================================================
+
+// Simulate the column and return the positions of all nodes.
+static std::vector<ChVector3d> Simulate(ChTimestepper::Type type, bool jfnk) {
+    ChSystemSMC sys;
+
+    auto material = chrono_types::make_shared<ChContinuumElastic>(1e6, 0.3, 1000);
+    material->SetRayleighDampingBeta(0.01);
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    mesh->SetAutomaticGravity(false);
+    sys.Add(mesh);
+
+    double size = 0.1;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    std::shared_ptr<ChNodeFEAxyz> lower[4];
+    for (int ilayer = 0; ilayer <= 8; ++ilayer) {
+        double hy = ilayer * size;
+        std::shared_ptr<ChNodeFEAxyz> upper[4] = {chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(0, hy, 0)),
+                                                  chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(0, hy, size)),
+                                                  chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(size, hy, size)),
+                                                  chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(size, hy, 0))};
+        for (int j = 0; j < 4; j++) {
+            upper[j]->SetFixed(ilayer == 0);
+            if (ilayer == 8)
+                upper[j]->SetForce(ChVector3d(5, 0, 2));
+            mesh->AddNode(upper[j]);
+            nodes.push_back(upper[j]);
+        }
+        if (ilayer > 0) {
+            auto element = chrono_types::make_shared<ChElementHexaCorot_8>();
+            element->SetNodes(lower[0], lower[1], lower[2], lower[3], upper[0], upper[1], upper[2], upper[3]);
+            element->SetMaterial(material);
+            mesh->AddElement(element);
+        }
+        for (int j = 0; j < 4; j++)
+            lower[j] = upper[j];
+    }
+
+    if (jfnk) {
+        auto solver = chrono_types::make_shared<ChSolverGMRES>();
+        solver->SetMaxIterations(500);
+        solver->SetTolerance(1e-13);
+        sys.SetSolver(solver);
+        sys.EnableJacobianFreeNewton(true);
+    } else {
+        sys.SetSolver(chrono_types::make_shared<ChSolverSparseLU>());
+    }
+
+    sys.SetTimestepperType(type);
+    auto integrator = std::dynamic_pointer_cast<ChImplicitIterativeTimestepper>(sys.GetTimestepper());
+    integrator->SetMaxIters(50);
+    integrator->SetAbsTolerances(1e-10);
+    integrator->SetRelTolerance(1e-8);
+
+    for (int i = 0; i < 40; i++)
+        sys.DoStepDynamics(5e-3);
+
+    std::vector<ChVector3d> pos;
+    for (const auto& node : nodes)
+        pos.push_back(node->GetPos());
+    return pos;
+}
+
+static void Compare(ChTimestepper::Type type) {
+    auto pos = Simulate(type, false);
+    auto pos_jfnk = Simulate(type, true);
+
+    // Tip displacement
+    double displ = (pos.back() - ChVector3d(0.1, 0.8, 0)).Length();
+    ASSERT_GT(displ, 1e-3);
+
+    for (size_t i = 0; i < pos.size(); i++)
+        ASSERT_LT((pos_jfnk[i] - pos[i]).Length(), 1e-6 * displ) << "node " << i;
+}
+
+TEST(JacobianFreeNewton, HHT) {
+    Compare(ChTimestepper::Type::HHT);
+}
+
+TEST(JacobianFreeNewton, Euler_implicit) {
+    Compare(ChTimestepper::Type::EULER_IMPLICIT);
+}
@@ -0,0 +1,158 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the matrix-free KRM mode of the system descriptor, in which the
+// element stiffness, damping, and mass matrices are applied element by element
+// within the iterative linear solvers.
+// - the corotational hexahedron products match those of the element KRM matrix
+// - a simulation with matrix-free products matches one with stored KRM blocks
+//
+// =============================================================================
+
+#include <random>
+
+#include "chrono/fea/ChElementHexaCorot_8.h"
+#include "chrono/fea/ChElementTetraCorot_4.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChIterativeSolverLS.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// ====================================================================================
+
+// Column of hexahedra, clamped at the base and capped by two tetrahedra, with a lateral load at the tip.
+class ColumnModel {
+  public:
+    ColumnModel(bool matrix_free) {
+        auto material = chrono_types::make_shared<ChContinuumElastic>(2e7, 0.3, 1000);
+        material->SetRayleighDampingBeta(0.01);
+        material->SetRayleighDampingAlpha(0.1);
+
+        mesh = chrono_types::make_shared<ChMesh>();
+        mesh->SetAutomaticGravity(false);
+        sys.Add(mesh);
+
+        double size = 0.1;
+        std::shared_ptr<ChNodeFEAxyz> lower[4];
+        for (int ilayer = 0; ilayer < 6; ++ilayer) {
+            double hy = ilayer * size;
+            std::shared_ptr<ChNodeFEAxyz> upper[4] = {
+                chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(0, hy, 0)),
+                chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(0, hy, size)),
+                chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(size, hy, size)),
+                chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(size, hy, 0))};
+            for (int j = 0; j < 4; j++) {
+                upper[j]->SetFixed(ilayer == 0);
+                mesh->AddNode(upper[j]);
+            }
+
+            if (ilayer > 0) {
+                auto element = chrono_types::make_shared<ChElementHexaCorot_8>();
+                element->SetNodes(lower[0], lower[1], lower[2], lower[3], upper[0], upper[1], upper[2], upper[3]);
+                element->SetMaterial(material);
+                mesh->AddElement(element);
+                hexas.push_back(element);
+            }
+
+            for (int j = 0; j < 4; j++)
+                lower[j] = upper[j];
+        }
+
+        tip = chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(size / 2, 6 * size, size / 2));
+        tip->SetForce(ChVector3d(20, 0, 10));
+        mesh->AddNode(tip);
+
+        auto tetra1 = chrono_types::make_shared<ChElementTetraCorot_4>();
+        tetra1->SetNodes(lower[0], lower[1], lower[2], tip);
+        tetra1->SetMaterial(material);
+        mesh->AddElement(tetra1);
+
+        auto tetra2 = chrono_types::make_shared<ChElementTetraCorot_4>();
+        tetra2->SetNodes(lower[0], lower[2], lower[3], tip);
+        tetra2->SetMaterial(material);
+        mesh->AddElement(tetra2);
+
+        auto solver = chrono_types::make_shared<ChSolverMINRES>();
+        solver->SetMaxIterations(1000);
+        solver->SetTolerance(1e-14);
+        solver->EnableDiagonalPreconditioner(true);
+        sys.SetSolver(solver);
+        sys.GetSystemDescriptor()->EnableMatrixFreeKRM(matrix_free);
+    }
+
+    ChSystemSMC sys;
+    std::shared_ptr<ChMesh> mesh;
+    std::vector<std::shared_ptr<ChElementHexaCorot_8>> hexas;
+    std::shared_ptr<ChNodeFEAxyz> tip;
+};
+
+// Element products match those with the assembled element KRM matrix.
+TEST(MatrixFreeKRM, element_product) {
+    ColumnModel model(false);
+    model.sys.DoStepDynamics(1e-3);
+
+    std::default_random_engine generator(42);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    int n = model.sys.GetNumCoordsVelLevel();
+    ChVectorDynamic<> x(n);
+    for (int i = 0; i < n; i++)
+        x(i) = distribution(generator);
+
+    double Kfactor = -1e-6;
+    double Rfactor = -1e-3;
+    double Mfactor = 1.0;
+
+    for (const auto& element : model.hexas) {
+        ChMatrixDynamic<> H(24, 24);
+        element->ComputeKRMmatricesGlobal(H, Kfactor, Rfactor, Mfactor);
+
+        ChVectorDynamic<> y_ref = ChVectorDynamic<>::Zero(n);
+        ChVectorDynamic<> d_ref = ChVectorDynamic<>::Zero(n);
+        element->Kstiffness().AddMatrixTimesVectorInto(y_ref, x, H);
+        element->Kstiffness().DiagonalAdd(d_ref, H);
+
+        ChVectorDynamic<> y = ChVectorDynamic<>::Zero(n);
+        ChVectorDynamic<> d = ChVectorDynamic<>::Zero(n);
+        element->AddKRMProductInto(y, x, Kfactor, Rfactor, Mfactor);
+        element->AddKRMDiagonalInto(d, Kfactor, Rfactor, Mfactor);
+
+        ASSERT_GT(y_ref.norm(), 0);
+        ASSERT_LT((y - y_ref).norm(), 1e-12 * y_ref.norm());
+        ASSERT_LT((d - d_ref).norm(), 1e-12 * d_ref.norm());
+    }
+}
+
+// Simulations with and without stored KRM blocks give the same results.
+TEST(MatrixFreeKRM, simulation) {
+    ColumnModel assembled(false);
+    ColumnModel matrix_free(true);
+    for (int i = 0; i < 50; i++) {
+        assembled.sys.DoStepDynamics(1e-3);
+        matrix_free.sys.DoStepDynamics(1e-3);
+    }
+
+    ASSERT_EQ(assembled.sys.GetSystemDescriptor()->GetKRMOperators().size(), 0);
+    ASSERT_GT(assembled.sys.GetSystemDescriptor()->GetKRMBlocks().size(), 0);
+    ASSERT_EQ(matrix_free.sys.GetSystemDescriptor()->GetKRMOperators().size(), 1);
+    ASSERT_EQ(matrix_free.sys.GetSystemDescriptor()->GetKRMBlocks().size(), 0);
+
+    double tip_displ = (assembled.tip->GetPos() - assembled.tip->GetX0()).Length();
+    ASSERT_GT(tip_displ, 1e-4);
+    for (unsigned int i = 0; i < assembled.mesh->GetNumNodes(); i++) {
+        auto pos = std::dynamic_pointer_cast<ChNodeFEAxyz>(assembled.mesh->GetNode(i))->GetPos();
+        auto pos_matrix_free = std::dynamic_pointer_cast<ChNodeFEAxyz>(matrix_free.mesh->GetNode(i))->GetPos();
+        ASSERT_LT((pos_matrix_free - pos).Length(), 1e-8 * tip_displ) << "node " << i;
+    }
+}
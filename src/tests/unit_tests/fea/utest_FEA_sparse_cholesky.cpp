@@ -0,0 +1,215 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit tests for the sparse supernodal LDL^T solver.
+// - symmetric positive definite and saddle-point matrices are solved to machine
+//   precision, with the expected number of negative pivots, also with multiple
+//   threads
+// - static and dynamic analyses of a constrained FEA mesh match those obtained
+//   with the sparse LU solver
+//
+// =============================================================================
+
+#include <random>
+
+#include "chrono/fea/ChElementHexaCorot_8.h"
+#include "chrono/fea/ChLinkNodeFrame.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// ====================================================================================
+
+// Random symmetric matrix with a diagonally dominant block of size nq and nc constraint rows with zero diagonal.
+static void RandomMatrix(ChSparseMatrix& A, int nq, int nc) {
+    std::default_random_engine generator(42);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = 0; i < nq; i++) {
+        triplets.push_back({i, i, 1.0});
+        for (int k = 0; k < 4; k++) {
+            int j = (i + 1 + (int)(50 * std::abs(distribution(generator)))) % nq;
+            double v = distribution(generator);
+            triplets.push_back({i, j, v});
+            triplets.push_back({j, i, v});
+            triplets.push_back({i, i, std::abs(v)});
+            triplets.push_back({j, j, std::abs(v)});
+        }
+    }
+    for (int c = 0; c < nc; c++) {
+        for (int k = 0; k < 3; k++) {
+            double v = distribution(generator);
+            triplets.push_back({nq + c, (7 * c + 13 * k) % nq, v});
+            triplets.push_back({(7 * c + 13 * k) % nq, nq + c, v});
+        }
+    }
+
+    A.resize(nq + nc, nq + nc);
+    A.setFromTriplets(triplets.begin(), triplets.end());
+}
+
+// Solve a random system (see RandomMatrix) and return the relative residual.
+static double SolveRandom(ChDirectSolverLS& solver, int nq, int nc) {
+    RandomMatrix(solver.A(), nq, nc);
+    solver.b().resize(nq + nc);
+    for (int i = 0; i < nq + nc; i++)
+        solver.b()(i) = std::sin(0.1 * i) + 1.0 / 3.0;
+
+    EXPECT_TRUE(solver.SetupCurrent());
+    EXPECT_TRUE(solver.SolveCurrent());
+
+    return (solver.b() - solver.A() * solver.x()).norm() / solver.b().norm();
+}
+
+TEST(SparseCholesky, matrix) {
+    // Symmetric positive definite
+    ChSolverSparseCholesky solver_spd;
+    solver_spd.SetMatrixSymmetryType(ChDirectSolverLS::MatrixSymmetryType::SYMMETRIC_POSDEF);
+    ASSERT_LT(SolveRandom(solver_spd, 2000, 0), 1e-13);
+    ASSERT_EQ(solver_spd.GetNumNegativePivots(), 0);
+    ASSERT_GT(solver_spd.GetNumNonZerosFactor(), 0);
+
+    // Saddle point, with the constraint rows identified by their zero diagonal
+    ChSolverSparseCholesky solver_kkt;
+    ASSERT_LT(SolveRandom(solver_kkt, 2000, 150), 1e-12);
+    ASSERT_EQ(solver_kkt.GetNumNegativePivots(), 150);
+    ASSERT_EQ(solver_kkt.GetNumPerturbedPivots(), 0);
+
+    ChSolverSparseLU solver_lu;
+    SolveRandom(solver_lu, 2000, 150);
+    ASSERT_LT((solver_kkt.x() - solver_lu.x()).norm(), 1e-10 * solver_lu.x().norm());
+
+    // Concurrent factorization of independent subtrees gives the same solution
+    ChSolverSparseCholesky solver_mt;
+    solver_mt.SetNumThreads(4);
+    ASSERT_LT(SolveRandom(solver_mt, 2000, 150), 1e-12);
+    ASSERT_EQ(solver_mt.GetNumNegativePivots(), 150);
+    ASSERT_LT((solver_mt.x() - solver_kkt.x()).norm(), 1e-12 * solver_kkt.x().norm());
+
+    // A saddle-point matrix is not positive definite
+    ChSparseMatrix A;
+    RandomMatrix(A, 200, 10);
+    A.makeCompressed();
+    ChSupernodalLDLT ldlt;
+    ldlt.SetPositiveDefinite(true);
+    ldlt.AnalyzePattern(A);
+    ASSERT_FALSE(ldlt.Factorize(A));
+    ASSERT_GE(ldlt.GetFailedRow(), 200);
+}
+
+// ====================================================================================
+
+// Column of hexahedra, attached to the ground through node constraints, with a lateral load at the top.
+class ColumnModel {
+  public:
+    ColumnModel(std::shared_ptr<ChDirectSolverLS> solver) {
+        auto material = chrono_types::make_shared<ChContinuumElastic>(2e7, 0.3, 1000);
+        material->SetRayleighDampingBeta(0.01);
+
+        auto ground = chrono_types::make_shared<ChBody>();
+        ground->SetFixed(true);
+        sys.AddBody(ground);
+
+        auto mesh = chrono_types::make_shared<ChMesh>();
+        mesh->SetAutomaticGravity(false);
+        sys.Add(mesh);
+
+        double size = 0.1;
+        std::shared_ptr<ChNodeFEAxyz> lower[4];
+        for (int ilayer = 0; ilayer <= 8; ++ilayer) {
+            double hy = ilayer * size;
+            std::shared_ptr<ChNodeFEAxyz> upper[4] = {
+                chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(0, hy, 0)),
+                chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(0, hy, size)),
+                chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(size, hy, size)),
+                chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(size, hy, 0))};
+            for (int j = 0; j < 4; j++) {
+                mesh->AddNode(upper[j]);
+                nodes.push_back(upper[j]);
+                if (ilayer == 0) {
+                    auto link = chrono_types::make_shared<ChLinkNodeFrame>();
+                    link->Initialize(upper[j], ground);
+                    sys.Add(link);
+                }
+            }
+
+            if (ilayer > 0) {
+                auto element = chrono_types::make_shared<ChElementHexaCorot_8>();
+                element->SetNodes(lower[0], lower[1], lower[2], lower[3], upper[0], upper[1], upper[2], upper[3]);
+                element->SetMaterial(material);
+                mesh->AddElement(element);
+            }
+
+            for (int j = 0; j < 4; j++)
+                lower[j] = upper[j];
+        }
+
+        for (int j = 0; j < 4; j++)
+            lower[j]->SetForce(ChVector3d(5, 0, 2));
+
+        solver->LockSparsityPattern(true);
+        solver->ReuseSymbolicAnalysis(true);
+        sys.SetSolver(solver);
+    }
+
+    std::vector<ChVector3d> Positions() const {
+        std::vector<ChVector3d> pos;
+        for (const auto& node : nodes)
+            pos.push_back(node->GetPos());
+        return pos;
+    }
+
+    ChSystemSMC sys;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+};
+
+TEST(SparseCholesky, static_analysis) {
+    auto solver = chrono_types::make_shared<ChSolverSparseCholesky>();
+    ColumnModel model(solver);
+    model.sys.DoStaticLinear();
+
+    ColumnModel reference(chrono_types::make_shared<ChSolverSparseLU>());
+    reference.sys.DoStaticLinear();
+
+    auto pos = model.Positions();
+    auto pos_ref = reference.Positions();
+    double tip_displ = (model.nodes.back()->GetPos() - model.nodes.back()->GetX0()).Length();
+    ASSERT_GT(tip_displ, 1e-5);
+    for (size_t i = 0; i < pos.size(); i++)
+        ASSERT_LT((pos[i] - pos_ref[i]).Length(), 1e-9 * tip_displ) << "node " << i;
+}
+
+TEST(SparseCholesky, dynamics) {
+    auto solver = chrono_types::make_shared<ChSolverSparseCholesky>();
+    ColumnModel model(solver);
+    ColumnModel reference(chrono_types::make_shared<ChSolverSparseLU>());
+    for (int i = 0; i < 50; i++) {
+        model.sys.DoStepDynamics(1e-3);
+        reference.sys.DoStepDynamics(1e-3);
+    }
+
+    // The symbolic analysis is performed once; the constraint rows are the only negative pivots
+    ASSERT_EQ(solver->GetNumSymbolicAnalyses(), 1);
+    ASSERT_EQ(solver->GetNumNegativePivots(), 12);
+
+    auto pos = model.Positions();
+    auto pos_ref = reference.Positions();
+    double tip_displ = (model.nodes.back()->GetPos() - model.nodes.back()->GetX0()).Length();
+    ASSERT_GT(tip_displ, 1e-5);
+    for (size_t i = 0; i < pos.size(); i++)
+        ASSERT_LT((pos[i] - pos_ref[i]).Length(), 1e-9 * tip_displ) << "node " << i;
+}
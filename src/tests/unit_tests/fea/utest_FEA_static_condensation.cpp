@@ -0,0 +1,239 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit tests for the static-condensation solver.
+// - partitioned saddle-point matrices are solved to machine precision, and the
+//   factorizations of unchanged substructures are reused
+// - a dynamic simulation of FEA meshes in substructure assemblies matches the
+//   one obtained with the sparse LU solver
+//
+// =============================================================================
+
+#include <random>
+
+#include "chrono/fea/ChElementHexaCorot_8.h"
+#include "chrono/fea/ChLinkNodeFrame.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChSolverStaticCondensation.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// ====================================================================================
+
+// Random symmetric matrix with 'num_sub' substructures of 'size' rows each, chained through their last rows, followed
+// by one constraint row (zero diagonal) in each substructure.
+static void PartitionedMatrix(ChSparseMatrix& A, std::vector<int>& sub, int num_sub, int size) {
+    std::default_random_engine generator(7);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    int nq = num_sub * size;
+    int nc = num_sub;
+    std::vector<Eigen::Triplet<double>> triplets;
+    auto add = [&](int i, int j, double v) {
+        triplets.push_back({i, j, v});
+        triplets.push_back({j, i, v});
+        triplets.push_back({i, i, std::abs(v)});
+        triplets.push_back({j, j, std::abs(v)});
+    };
+
+    for (int s = 0; s < num_sub; s++) {
+        int first = s * size;
+        for (int i = 0; i < size; i++) {
+            triplets.push_back({first + i, first + i, 1.0});
+            for (int k = 0; k < 3; k++)
+                add(first + i, first + (i + 1 + (int)(10 * std::abs(distribution(generator)))) % size,
+                    distribution(generator));
+        }
+        // Coupling with the next substructure
+        if (s < num_sub - 1)
+            add(first + size - 1, first + size, distribution(generator));
+        // Constraint row
+        triplets.push_back({nq + s, first + 1, 1.0});
+        triplets.push_back({first + 1, nq + s, 1.0});
+    }
+
+    A.resize(nq + nc, nq + nc);
+    A.setFromTriplets(triplets.begin(), triplets.end());
+
+    sub.resize(nq + nc);
+    for (int i = 0; i < nq; i++)
+        sub[i] = i / size;
+    for (int s = 0; s < num_sub; s++)
+        sub[nq + s] = s;
+}
+
+TEST(StaticCondensation, matrix) {
+    int num_sub = 6;
+    int size = 300;
+
+    ChSolverStaticCondensation solver;
+    std::vector<int> sub;
+    PartitionedMatrix(solver.A(), sub, num_sub, size);
+    solver.SetRowSubstructures(sub);
+    solver.b().resize(solver.A().rows());
+    for (int i = 0; i < solver.b().size(); i++)
+        solver.b()(i) = std::sin(0.1 * i) + 1.0 / 3.0;
+
+    ASSERT_TRUE(solver.SetupCurrent());
+    ASSERT_TRUE(solver.SolveCurrent());
+
+    // Each substructure has interior rows; the interface contains the coupled rows
+    ASSERT_EQ(solver.GetNumSubstructures(), num_sub);
+    ASSERT_EQ(solver.GetNumInterfaceRows(), 2 * (num_sub - 1));
+    ASSERT_EQ(solver.GetNumSubstructureFactorizations(), num_sub);
+
+    ChSolverSparseLU solver_lu;
+    solver_lu.A() = solver.A();
+    solver_lu.b() = solver.b();
+    ASSERT_TRUE(solver_lu.SetupCurrent());
+    ASSERT_TRUE(solver_lu.SolveCurrent());
+
+    ASSERT_LT((solver.b() - solver.A() * solver.x()).norm(), 1e-12 * solver.b().norm());
+    ASSERT_LT((solver.x() - solver_lu.x()).norm(), 1e-10 * solver_lu.x().norm());
+
+    // Changing the interface block only does not require new factorizations of the substructures
+    solver.A().coeffRef(size - 1, size - 1) += 0.5;
+    ASSERT_TRUE(solver.SetupCurrent());
+    ASSERT_TRUE(solver.SolveCurrent());
+    ASSERT_EQ(solver.GetNumReusedFactorizations(), num_sub);
+    ASSERT_LT((solver.b() - solver.A() * solver.x()).norm(), 1e-12 * solver.b().norm());
+
+    // Changing an interior block requires a new factorization of that substructure only
+    solver.A().coeffRef(size + 1, size + 1) += 0.5;
+    ASSERT_TRUE(solver.SetupCurrent());
+    ASSERT_TRUE(solver.SolveCurrent());
+    ASSERT_EQ(solver.GetNumSubstructureFactorizations(), num_sub + 1);
+    ASSERT_EQ(solver.GetNumReusedFactorizations(), 2 * num_sub - 1);
+    ASSERT_LT((solver.b() - solver.A() * solver.x()).norm(), 1e-12 * solver.b().norm());
+}
+
+// ====================================================================================
+
+// Columns of hexahedra, each in a substructure assembly, attached to the ground at their base and to a common plate at
+// their top, with a lateral load on the plate.
+class ColumnsModel {
+  public:
+    ColumnsModel(std::shared_ptr<ChDirectSolverLS> solver, int num_columns) {
+        auto material = chrono_types::make_shared<ChContinuumElastic>(2e7, 0.3, 1000);
+        material->SetRayleighDampingBeta(0.01);
+
+        auto ground = chrono_types::make_shared<ChBody>();
+        ground->SetFixed(true);
+        sys.AddBody(ground);
+
+        double size = 0.1;
+        double height = 8 * size;
+
+        plate = chrono_types::make_shared<ChBody>();
+        plate->SetMass(2);
+        plate->SetInertiaXX(ChVector3d(0.1, 0.1, 0.1));
+        plate->SetPos(ChVector3d(num_columns * size, height, 0.5 * size));
+        plate->AccumulateForce(ChVector3d(50, 0, 20), plate->GetPos(), false);
+        sys.AddBody(plate);
+
+        for (int icol = 0; icol < num_columns; icol++) {
+            auto assembly = chrono_types::make_shared<ChAssembly>();
+            assembly->SetSubstructure(true);
+            sys.Add(assembly);
+
+            auto mesh = chrono_types::make_shared<ChMesh>();
+            mesh->SetAutomaticGravity(false);
+            assembly->Add(mesh);
+
+            double x = 2 * icol * size;
+            std::shared_ptr<ChNodeFEAxyz> lower[4];
+            for (int ilayer = 0; ilayer <= 8; ++ilayer) {
+                double hy = ilayer * size;
+                std::shared_ptr<ChNodeFEAxyz> upper[4] = {
+                    chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(x, hy, 0)),
+                    chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(x, hy, size)),
+                    chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(x + size, hy, size)),
+                    chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(x + size, hy, 0))};
+                for (int j = 0; j < 4; j++) {
+                    mesh->AddNode(upper[j]);
+                    nodes.push_back(upper[j]);
+                    if (ilayer == 0 || ilayer == 8) {
+                        auto link = chrono_types::make_shared<ChLinkNodeFrame>();
+                        link->Initialize(upper[j], ilayer == 0 ? ground : plate);
+                        sys.Add(link);
+                    }
+                }
+
+                if (ilayer > 0) {
+                    auto element = chrono_types::make_shared<ChElementHexaCorot_8>();
+                    element->SetNodes(lower[0], lower[1], lower[2], lower[3], upper[0], upper[1], upper[2], upper[3]);
+                    element->SetMaterial(material);
+                    mesh->AddElement(element);
+                }
+
+                for (int j = 0; j < 4; j++)
+                    lower[j] = upper[j];
+            }
+        }
+
+        solver->LockSparsityPattern(true);
+        sys.SetSolver(solver);
+    }
+
+    std::vector<ChVector3d> Positions() const {
+        std::vector<ChVector3d> pos;
+        for (const auto& node : nodes)
+            pos.push_back(node->GetPos());
+        pos.push_back(plate->GetPos());
+        return pos;
+    }
+
+    ChSystemSMC sys;
+    std::shared_ptr<ChBody> plate;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+};
+
+TEST(StaticCondensation, dynamics) {
+    int num_columns = 3;
+
+    auto solver = chrono_types::make_shared<ChSolverStaticCondensation>();
+    ColumnsModel model(solver, num_columns);
+
+    auto solver_reuse = chrono_types::make_shared<ChSolverStaticCondensation>();
+    solver_reuse->SetInteriorReuseTolerance(0.01);
+    ColumnsModel model_reuse(solver_reuse, num_columns);
+
+    ColumnsModel reference(chrono_types::make_shared<ChSolverSparseLU>(), num_columns);
+
+    int num_steps = 50;
+    for (int i = 0; i < num_steps; i++) {
+        model.sys.DoStepDynamics(1e-3);
+        model_reuse.sys.DoStepDynamics(1e-3);
+        reference.sys.DoStepDynamics(1e-3);
+    }
+
+    // The nodes between the base and the top of each column are interior
+    ASSERT_EQ(solver->GetNumSubstructures(), num_columns);
+    ASSERT_EQ(solver->GetNumInterfaceRows(), num_columns * (2 * 4 * 3 + 2 * 4 * 3) + 6);
+
+    // Small changes of the Jacobian do not require new factorizations of the substructures
+    ASSERT_GT(solver_reuse->GetNumReusedFactorizations(), 0);
+    ASSERT_LT(solver_reuse->GetNumSubstructureFactorizations(), solver->GetNumSubstructureFactorizations());
+
+    auto pos = model.Positions();
+    auto pos_reuse = model_reuse.Positions();
+    auto pos_ref = reference.Positions();
+    double plate_displ = (pos_ref.back() - ChVector3d(num_columns * 0.1, 0.8, 0.05)).Length();
+    ASSERT_GT(plate_displ, 1e-5);
+    for (size_t i = 0; i < pos.size(); i++) {
+        ASSERT_LT((pos[i] - pos_ref[i]).Length(), 1e-9 * plate_displ) << "node " << i;
+        ASSERT_LT((pos_reuse[i] - pos_ref[i]).Length(), 1e-6 * plate_displ) << "node " << i;
+    }
+}
@@ -0,0 +1,169 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the batch simulation runner (utils::ChBatchRunner).
+// A parameter sweep over spring-mass systems is run serially and concurrently;
+// the results must be identical and must not depend on the number of workers.
+// Shared read-only data is loaded once and can be evicted from the cache.
+//
+// =============================================================================
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChLinkTSDA.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChBatchRunner.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+// ====================================================================================
+
+// Body hanging from a spring, with the spring stiffness selected by the simulation index.
+class SpringSimulation : public ChBatchRunner::Simulation {
+  public:
+    SpringSimulation(int index) : m_step(0) {
+        m_sys.SetGravitationalAcceleration(ChVector3d(0, -9.81, 0));
+
+        auto ground = chrono_types::make_shared<ChBody>();
+        ground->SetFixed(true);
+        m_sys.AddBody(ground);
+
+        m_body = chrono_types::make_shared<ChBody>();
+        m_body->SetMass(1);
+        m_body->SetPos(ChVector3d(0, -1, 0));
+        m_sys.AddBody(m_body);
+
+        auto spring = chrono_types::make_shared<ChLinkTSDA>();
+        spring->Initialize(ground, m_body, false, ChVector3d(0, 0, 0), ChVector3d(0, -1, 0));
+        spring->SetSpringCoefficient(10.0 * (index + 1));
+        spring->SetDampingCoefficient(0.5);
+        m_sys.AddLink(spring);
+
+        if (index == 3)
+            throw std::runtime_error("invalid parameters");
+    }
+
+    virtual ChSystem* GetSystem() override { return &m_sys; }
+
+    virtual bool Advance() override {
+        m_sys.DoStepDynamics(1e-3);
+        return ++m_step < 500;
+    }
+
+    virtual std::vector<double> GetOutput() override {
+        return {m_sys.GetChTime(), m_body->GetPos().y(), m_body->GetPosDt().y()};
+    }
+
+  private:
+    ChSystemNSC m_sys;
+    std::shared_ptr<ChBody> m_body;
+    int m_step;
+};
+
+// ====================================================================================
+
+TEST(BatchRunnerTest, sweep) {
+    int num_sims = 8;
+    auto factory = [](int index) { return std::unique_ptr<ChBatchRunner::Simulation>(new SpringSimulation(index)); };
+
+    ChBatchRunner serial(1);
+    serial.Run(num_sims, factory);
+
+    ChBatchRunner parallel(3);
+    parallel.Run(num_sims, factory);
+
+    ASSERT_EQ(serial.GetNumSimulations(), num_sims);
+    ASSERT_EQ(parallel.GetNumSimulations(), num_sims);
+
+    for (int i = 0; i < num_sims; i++) {
+        if (i == 3) {
+            // Failure in one simulation is reported and does not affect the others
+            ASSERT_FALSE(parallel.Succeeded(i));
+            ASSERT_EQ(parallel.GetError(i), "invalid parameters");
+            continue;
+        }
+        ASSERT_TRUE(parallel.Succeeded(i)) << parallel.GetError(i);
+        ASSERT_EQ(parallel.GetOutput(i).size(), 3);
+        ASSERT_NEAR(parallel.GetOutput(i)[0], 0.5, 1e-9);
+        for (int j = 0; j < 3; j++)
+            ASSERT_EQ(serial.GetOutput(i)[j], parallel.GetOutput(i)[j]);
+    }
+
+    // Different parameters produce different results
+    ASSERT_NE(parallel.GetOutput(0)[1], parallel.GetOutput(1)[1]);
+}
+
+TEST(BatchRunnerTest, shared_cache) {
+    ChSharedCache<std::vector<double>> cache;
+    std::atomic<int> num_loads(0);
+
+    auto loader = [&]() {
+        num_loads++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return std::make_shared<std::vector<double>>(100, 1.0);
+    };
+
+    std::vector<std::shared_ptr<std::vector<double>>> data(6);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 6; i++)
+        threads.emplace_back([&, i]() { data[i] = cache.Get("table", loader); });
+    for (auto& thread : threads)
+        thread.join();
+
+    ASSERT_EQ(num_loads, 1);
+    ASSERT_EQ(cache.Size(), 1);
+    for (int i = 1; i < 6; i++)
+        ASSERT_EQ(data[i], data[0]);
+
+    // Failed loads are reported and not cached
+    ASSERT_THROW(cache.Get("missing", []() -> std::shared_ptr<std::vector<double>> {
+        throw std::runtime_error("not found");
+    }),
+                 std::runtime_error);
+    ASSERT_EQ(cache.Size(), 1);
+
+    // Evicted data is kept alive by its users and loaded again at the next request
+    ASSERT_TRUE(cache.Remove("table"));
+    ASSERT_FALSE(cache.Remove("table"));
+    ASSERT_EQ(cache.Size(), 0);
+    ASSERT_EQ(data[0]->size(), 100);
+    ASSERT_NE(cache.Get("table", loader), data[0]);
+    ASSERT_EQ(num_loads, 2);
+}
+
+TEST(BatchRunnerTest, shared_mesh) {
+    std::string filename = "batch_runner_triangle.obj";
+    {
+        std::ofstream obj(filename);
+        obj << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+    }
+
+    ChBatchRunner::ClearSharedMeshes();
+    auto mesh = ChBatchRunner::GetSharedMesh(filename, false);
+    ASSERT_EQ(mesh->GetNumTriangles(), 1);
+    ASSERT_EQ(ChBatchRunner::GetSharedMesh(filename, false), mesh);
+    ASSERT_EQ(ChBatchRunner::GetNumSharedMeshes(), 1);
+
+    ASSERT_TRUE(ChBatchRunner::ReleaseSharedMesh(filename, false));
+    ASSERT_EQ(ChBatchRunner::GetNumSharedMeshes(), 0);
+    ASSERT_NE(ChBatchRunner::GetSharedMesh(filename, false), mesh);
+
+    ChBatchRunner::ClearSharedMeshes();
+    ASSERT_EQ(ChBatchRunner::GetNumSharedMeshes(), 0);
+    std::remove(filename.c_str());
+}
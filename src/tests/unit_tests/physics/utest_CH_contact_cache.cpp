@@ -0,0 +1,161 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the NSC persistent contact cache (warm starting).
+// A vertical stack of spheres rests on the ground. Contacts are generated through
+// a custom collision callback (and hence have no reaction cache provided by the
+// collision system). With the contact cache enabled, the solver is warm started
+// from the reactions at the previous step and converges in fewer iterations.
+// Cached reactions are identified by the pair of colliding shapes, so that a
+// contact of a different shape of the same body does not reuse them.
+//
+// =============================================================================
+
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverAPGD.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+// Custom collision detection between stacked spheres and the ground plane (z = 0).
+class StackCollision : public ChSystem::CustomCollisionCallback {
+  public:
+    StackCollision(std::shared_ptr<ChBody> ground,
+                   const std::vector<std::shared_ptr<ChBody>>& spheres,
+                   double radius,
+                   std::shared_ptr<ChContactMaterial> mat)
+        : m_ground(ground), m_spheres(spheres), m_radius(radius), m_mat(mat) {}
+
+    virtual void OnCustomCollision(ChSystem* sys) override {
+        ChBody* prev = m_ground.get();
+        ChVector3d prev_pt(m_spheres[0]->GetPos().x(), m_spheres[0]->GetPos().y(), 0);
+        for (const auto& sphere : m_spheres) {
+            ChCollisionInfo cinfo;
+            cinfo.modelA = prev->GetCollisionModel().get();
+            cinfo.modelB = sphere->GetCollisionModel().get();
+            cinfo.shapeA = cinfo.modelA->GetShapeInstance(0).first.get();
+            cinfo.shapeB = cinfo.modelB->GetShapeInstance(0).first.get();
+            cinfo.vN = ChVector3d(0, 0, 1);
+            cinfo.vpA = prev_pt;
+            cinfo.vpB = sphere->GetPos() - ChVector3d(0, 0, m_radius);
+            cinfo.distance = cinfo.vpB.z() - cinfo.vpA.z();
+            sys->GetContactContainer()->AddContact(cinfo, m_mat, m_mat);
+
+            prev = sphere.get();
+            prev_pt = sphere->GetPos() + ChVector3d(0, 0, m_radius);
+        }
+    }
+
+  private:
+    std::shared_ptr<ChBody> m_ground;
+    std::vector<std::shared_ptr<ChBody>> m_spheres;
+    double m_radius;
+    std::shared_ptr<ChContactMaterial> m_mat;
+};
+
+// Simulate the stack and return the number of solver iterations at the last step.
+static int Simulate(bool use_cache, ChSystemNSC& sys) {
+    sys.SetCollisionSystemType(ChCollisionSystem::Type::BULLET);
+    sys.SetGravitationalAcceleration(ChVector3d(0, 0, -9.81));
+
+    // The APGD residual also measures the complementarity of the reactions, while PSOR only stops on penetration and
+    // would accept a warm start with excessive reactions after a single iteration.
+    auto solver = chrono_types::make_shared<ChSolverAPGD>();
+    solver->SetMaxIterations(500);
+    solver->SetTolerance(1e-6);
+    solver->EnableWarmStart(true);
+    sys.SetSolver(solver);
+
+    auto container = std::static_pointer_cast<ChContactContainerNSC>(sys.GetContactContainer());
+    container->EnableWarmStartCache(use_cache);
+
+    auto mat = chrono_types::make_shared<ChContactMaterialNSC>();
+    mat->SetFriction(0.5f);
+
+    double radius = 0.5;
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetFixed(true);
+    ground->AddCollisionShape(chrono_types::make_shared<ChCollisionShapeBox>(mat, 10, 10, 1),
+                              ChFrame<>(ChVector3d(0, 0, -0.5)));
+    ground->AddCollisionShape(chrono_types::make_shared<ChCollisionShapeBox>(mat, 10, 10, 1),
+                              ChFrame<>(ChVector3d(0, 0, -1.5)));
+    ground->EnableCollision(false);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> spheres;
+    for (int i = 0; i < 6; i++) {
+        auto sphere = chrono_types::make_shared<ChBody>();
+        sphere->SetMass(1);
+        sphere->SetInertiaXX(ChVector3d(0.1, 0.1, 0.1));
+        sphere->SetPos(ChVector3d(0, 0, radius + 2 * radius * i));
+        sphere->AddCollisionShape(chrono_types::make_shared<ChCollisionShapeSphere>(mat, radius));
+        sphere->EnableCollision(false);
+        sys.AddBody(sphere);
+        spheres.push_back(sphere);
+    }
+
+    sys.RegisterCustomCollisionCallback(chrono_types::make_shared<StackCollision>(ground, spheres, radius, mat));
+
+    for (int i = 0; i < 100; i++)
+        sys.DoStepDynamics(1e-3);
+
+    // The stack must remain at rest
+    EXPECT_NEAR(spheres.back()->GetPos().z(), radius + 10 * radius, 1e-3);
+
+    return solver->GetIterations();
+}
+
+// ====================================================================================
+
+TEST(ContactCacheTest, warm_start) {
+    ChSystemNSC sys_nocache;
+    ChSystemNSC sys_cache;
+    int iters_nocache = Simulate(false, sys_nocache);
+    int iters_cache = Simulate(true, sys_cache);
+    std::cout << "Solver iterations without cache: " << iters_nocache << "  with cache: " << iters_cache << std::endl;
+
+    ASSERT_LT(iters_cache, iters_nocache);
+}
+
+TEST(ContactCacheTest, shapes) {
+    ChSystemNSC sys;
+    Simulate(true, sys);
+    auto container = std::static_pointer_cast<ChContactContainerNSC>(sys.GetContactContainer());
+
+    auto ground = sys.GetBodies()[0];
+    auto sphere = sys.GetBodies()[1];
+    auto ground_shape = ground->GetCollisionModel()->GetShapeInstance(0).first.get();
+    auto other_shape = ground->GetCollisionModel()->GetShapeInstance(1).first.get();
+    auto sphere_shape = sphere->GetCollisionModel()->GetShapeInstance(0).first.get();
+    ChVector3d point = sphere->GetPos() - ChVector3d(0, 0, 0.5);
+
+    // The ground contact of the bottom sphere is cached for its pair of shapes, in either order
+    ChVector3d force;
+    ChVector3d torque;
+    ASSERT_TRUE(container->FindCachedReactions(ground.get(), sphere.get(), ground_shape, sphere_shape, point, force,
+                                               torque));
+    ASSERT_GT(force.z(), 0);
+    ChVector3d force_swapped;
+    ASSERT_TRUE(container->FindCachedReactions(sphere.get(), ground.get(), sphere_shape, ground_shape, point,
+                                               force_swapped, torque));
+    ASSERT_EQ(force_swapped, -force);
+
+    // No reactions are cached for another shape of the same body, or for unknown shapes
+    ASSERT_FALSE(container->FindCachedReactions(ground.get(), sphere.get(), other_shape, sphere_shape, point, force,
+                                                torque));
+    ASSERT_FALSE(container->FindCachedReactions(ground.get(), sphere.get(), nullptr, nullptr, point, force, torque));
+}
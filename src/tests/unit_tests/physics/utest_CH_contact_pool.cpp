@@ -0,0 +1,95 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the pooled contact storage.
+// - contact objects are recycled across collision passes
+// - inactive contacts drop their references to the contactable objects
+// - pools that grew beyond their high-water mark are trimmed, and keep working
+//
+// =============================================================================
+
+#include <set>
+
+#include "chrono/physics/ChContactPool.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+static int num_alive = 0;
+
+class TestContact {
+  public:
+    TestContact(int* obj) : m_obj(obj) { num_alive++; }
+    ~TestContact() { num_alive--; }
+    void Reset(int* obj) { m_obj = obj; }
+    void Release() { m_obj = nullptr; }
+    int* m_obj;
+};
+
+// Add 'n' contacts to the pool, as done by a contact container in a collision pass.
+static void AddContacts(ChContactPool<TestContact>& pool, int n, int* obj, size_t high_water) {
+    pool.Rewind();
+    for (int i = 0; i < n; i++) {
+        TestContact* contact = pool.Reuse();
+        if (contact)
+            contact->Reset(obj);
+        else
+            pool.Emplace(obj);
+    }
+    pool.Release(high_water);
+}
+
+TEST(ContactPool, release) {
+    int obj = 0;
+    {
+        ChContactPool<TestContact> pool;
+
+        // Grow the pool; a single contact object is constructed for each slot
+        AddContacts(pool, 100, &obj, 1000);
+        ASSERT_EQ(pool.size(), 100);
+        ASSERT_EQ(pool.capacity(), 100);
+        ASSERT_EQ(num_alive, 100);
+
+        // Fewer contacts: objects are kept for reuse, but inactive ones do not reference the contactables
+        AddContacts(pool, 40, &obj, 1000);
+        ASSERT_EQ(pool.size(), 40);
+        ASSERT_EQ(pool.capacity(), 100);
+        ASSERT_EQ(num_alive, 100);
+        for (auto contact : pool)
+            ASSERT_EQ(contact->m_obj, &obj);
+        ASSERT_EQ(pool.Reuse()->m_obj, nullptr);
+
+        // Above the high-water mark, the inactive contacts beyond half of it are destroyed
+        AddContacts(pool, 10, &obj, 60);
+        ASSERT_EQ(pool.size(), 10);
+        ASSERT_EQ(pool.capacity(), 30);
+        ASSERT_EQ(num_alive, 30);
+
+        // The active contacts are never destroyed
+        AddContacts(pool, 25, &obj, 20);
+        ASSERT_EQ(pool.size(), 25);
+        ASSERT_EQ(pool.capacity(), 25);
+        ASSERT_EQ(num_alive, 25);
+
+        // The trimmed pool grows again, with distinct contact objects
+        AddContacts(pool, 500, &obj, 1000);
+        ASSERT_EQ(pool.size(), 500);
+        ASSERT_EQ(num_alive, 500);
+        std::set<TestContact*> contacts(pool.begin(), pool.end());
+        ASSERT_EQ(contacts.size(), 500);
+        for (auto contact : pool)
+            ASSERT_EQ(contact->m_obj, &obj);
+    }
+    ASSERT_EQ(num_alive, 0);
+}
@@ -0,0 +1,116 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the deterministic simulation mode.
+// A pile of spheres and boxes is dropped in a container, using different numbers
+// of threads. With ChSystem::SetDeterministic(true), the resulting trajectories
+// must be bit-identical, regardless of the number of threads.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/utils/ChUtilsCreators.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+// Simulate the falling objects with the given number of threads and return the final states of all bodies.
+static std::vector<double> Simulate(ChContactMethod method, int num_threads) {
+    std::unique_ptr<ChSystem> sys;
+    std::shared_ptr<ChContactMaterial> material;
+
+    switch (method) {
+        case ChContactMethod::SMC: {
+            sys = chrono_types::make_unique<ChSystemSMC>();
+            auto mat = chrono_types::make_shared<ChContactMaterialSMC>();
+            mat->SetYoungModulus(2e5f);
+            mat->SetFriction(0.4f);
+            mat->SetRestitution(0.1f);
+            material = mat;
+            break;
+        }
+        case ChContactMethod::NSC: {
+            sys = chrono_types::make_unique<ChSystemNSC>();
+            auto mat = chrono_types::make_shared<ChContactMaterialNSC>();
+            mat->SetFriction(0.4f);
+            material = mat;
+            // use a solver relying on the (multithreaded) Schur complement products of the system descriptor
+            sys->SetSolverType(ChSolver::Type::APGD);
+            sys->GetSolver()->AsIterative()->SetMaxIterations(50);
+            break;
+        }
+    }
+
+    sys->SetCollisionSystemType(ChCollisionSystem::Type::BULLET);
+    sys->SetGravitationalAcceleration(ChVector3d(0, 0, -9.81));
+    sys->SetNumThreads(num_threads, num_threads, 1);
+    sys->SetParallelTraversal(true, 1);
+    sys->SetDeterministic(true);
+
+    utils::CreateBoxContainer(sys.get(), material, ChVector3d(2, 2, 1), 0.1);
+
+    double radius = 0.1;
+    for (int ix = 0; ix < 4; ix++) {
+        for (int iy = 0; iy < 4; iy++) {
+            for (int iz = 0; iz < 3; iz++) {
+                ChVector3d pos(-0.6 + 0.4 * ix + 0.02 * iz, -0.6 + 0.4 * iy, 0.2 + 0.25 * iz);
+                std::shared_ptr<ChBody> body;
+                if ((ix + iy + iz) % 2 == 0)
+                    body = chrono_types::make_shared<ChBodyEasySphere>(radius, 1000, true, false, material);
+                else
+                    body = chrono_types::make_shared<ChBodyEasyBox>(1.5 * radius, 1.5 * radius, 1.5 * radius, 1000,
+                                                                    true, false, material);
+                body->SetPos(pos);
+                body->SetRot(QuatFromAngleZ(0.1 * (ix - iy)));
+                sys->AddBody(body);
+            }
+        }
+    }
+
+    double time_step = (method == ChContactMethod::SMC) ? 1e-4 : 1e-3;
+    while (sys->GetChTime() < 0.5)
+        sys->DoStepDynamics(time_step);
+
+    std::vector<double> state;
+    for (const auto& body : sys->GetBodies()) {
+        const auto& pos = body->GetPos();
+        const auto& rot = body->GetRot();
+        state.insert(state.end(), {pos.x(), pos.y(), pos.z(), rot.e0(), rot.e1(), rot.e2(), rot.e3()});
+    }
+
+    return state;
+}
+
+// ====================================================================================
+
+class DeterministicTest : public ::testing::TestWithParam<ChContactMethod> {};
+
+TEST_P(DeterministicTest, thread_count) {
+    auto state_1 = Simulate(GetParam(), 1);
+
+    for (int num_threads : {2, 4}) {
+        auto state_n = Simulate(GetParam(), num_threads);
+        ASSERT_EQ(state_1.size(), state_n.size());
+        for (size_t i = 0; i < state_1.size(); i++) {
+            // bit-identical results
+            ASSERT_EQ(state_1[i], state_n[i]) << "num_threads = " << num_threads << "  i = " << i;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Chrono, DeterministicTest, ::testing::Values(ChContactMethod::NSC, ChContactMethod::SMC));
@@ -0,0 +1,108 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the local error control of the HHT and Newmark timesteppers.
+// A body oscillates at the end of a linear spring.
+// - steps too large for the error tolerances are rejected, and the accepted
+//   steps follow the analytical solution
+// - a step cut short to reach the end of the Advance interval does not reduce
+//   the step size proposed for the following steps
+//
+// =============================================================================
+
+#include "chrono/physics/ChLinkTSDA.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+class ErrorControlTest : public ::testing::TestWithParam<ChTimestepper::Type> {
+  protected:
+    ErrorControlTest() {
+        sys.SetGravitationalAcceleration(ChVector3d(0, 0, 0));
+        sys.SetSolver(chrono_types::make_shared<ChSolverSparseLU>());
+
+        auto ground = chrono_types::make_shared<ChBody>();
+        ground->SetFixed(true);
+        sys.AddBody(ground);
+
+        // Spring initially stretched by 'amplitude'
+        body = chrono_types::make_shared<ChBody>();
+        body->SetMass(mass);
+        body->SetInertiaXX(ChVector3d(1, 1, 1));
+        body->SetPos(ChVector3d(0, 0, -1 - amplitude));
+        sys.AddBody(body);
+
+        auto spring = chrono_types::make_shared<ChLinkTSDA>();
+        spring->Initialize(ground, body, false, ground->GetPos(), body->GetPos());
+        spring->SetRestLength(1);
+        spring->SetSpringCoefficient(stiffness);
+        sys.AddLink(spring);
+
+        sys.SetTimestepperType(GetParam());
+        integrator = std::dynamic_pointer_cast<ChErrorControlTimestepper>(sys.GetTimestepper());
+        integrator->SetErrorControl(true);
+        integrator->SetErrorTolerances(1e-4, 1e-6);
+    }
+
+    double Displacement() const { return -1 - body->GetPos().z(); }
+    double Reference() const { return amplitude * std::cos(std::sqrt(stiffness / mass) * sys.GetChTime()); }
+
+    const double mass = 1;
+    const double stiffness = 100;
+    const double amplitude = 0.1;
+
+    ChSystemSMC sys;
+    std::shared_ptr<ChBody> body;
+    std::shared_ptr<ChErrorControlTimestepper> integrator;
+};
+
+TEST_P(ErrorControlTest, accept_reject) {
+    ASSERT_TRUE(integrator);
+
+    // The initial step (the step passed to DoStepDynamics) is too large for the tolerances
+    double max_err = 0;
+    for (int i = 0; i < 20; i++) {
+        sys.DoStepDynamics(0.05);
+        max_err = std::max(max_err, std::abs(Displacement() - Reference()));
+    }
+
+    ASSERT_NEAR(sys.GetChTime(), 1.0, 1e-12);
+    ASSERT_GT(integrator->GetNumRejectedSteps(), 0u);
+    ASSERT_GT(integrator->GetNumAcceptedSteps(), 20u);
+    ASSERT_LE(integrator->GetErrorEstimate(), 1.0);
+    ASSERT_LE(integrator->GetProposedStepSize(), 0.05 * 5);
+    ASSERT_LT(max_err, 1e-2 * amplitude);
+}
+
+TEST_P(ErrorControlTest, truncated_step) {
+    ASSERT_TRUE(integrator);
+
+    for (int i = 0; i < 10; i++)
+        sys.DoStepDynamics(0.05);
+    double h = integrator->GetProposedStepSize();
+    ASSERT_GT(h, 0.0);
+
+    // The last internal step of this Advance is only a small fraction of the proposed step size
+    unsigned int num_accepted = integrator->GetNumAcceptedSteps();
+    sys.DoStepDynamics(1.001 * h);
+    ASSERT_GE(integrator->GetNumAcceptedSteps(), num_accepted + 2);
+    ASSERT_GT(integrator->GetProposedStepSize(), 0.1 * h);
+}
+
+INSTANTIATE_TEST_SUITE_P(ChTimestepper,
+                         ErrorControlTest,
+                         ::testing::Values(ChTimestepper::Type::HHT, ChTimestepper::Type::NEWMARK));
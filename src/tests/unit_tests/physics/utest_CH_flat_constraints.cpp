@@ -0,0 +1,89 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the flattened constraint representation.
+// A stack of boxes with friction is simulated with the PSOR, APGD, and ADMM
+// solvers, with and without flat constraints. Both representations must give
+// the same results.
+//
+// =============================================================================
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverADMM.h"
+#include "chrono/solver/ChSolverAPGD.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+// Drop a stack of boxes on an inclined ground and return their final positions.
+static std::vector<ChVector3d> SimulateStack(std::shared_ptr<ChIterativeSolverVI> solver, bool flat) {
+    ChSystemNSC sys;
+    sys.SetCollisionSystemType(ChCollisionSystem::Type::BULLET);
+    sys.SetGravitationalAcceleration(ChVector3d(1, 0, -9.81));
+
+    solver->SetMaxIterations(100);
+    sys.SetSolver(solver);
+    sys.GetSystemDescriptor()->EnableFlatConstraints(flat);
+
+    auto mat = chrono_types::make_shared<ChContactMaterialNSC>();
+    mat->SetFriction(0.4f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 4, 0.2, 1000, false, true, mat);
+    ground->SetPos(ChVector3d(0, 0, -0.1));
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> boxes;
+    for (int i = 0; i < 3; i++) {
+        auto box = chrono_types::make_shared<ChBodyEasyBox>(0.4, 0.4, 0.2, 1000, false, true, mat);
+        box->SetPos(ChVector3d(0.02 * i, 0, 0.11 + 0.21 * i));
+        sys.AddBody(box);
+        boxes.push_back(box);
+    }
+
+    for (int i = 0; i < 200; i++)
+        sys.DoStepDynamics(2e-3);
+
+    std::vector<ChVector3d> pos;
+    for (const auto& box : boxes)
+        pos.push_back(box->GetPos());
+    return pos;
+}
+
+// The two representations accumulate the constraint products in a different order, so the results can differ by
+// round-off amplified over the simulation (up to 'tol').
+static void CompareFlat(std::function<std::shared_ptr<ChIterativeSolverVI>()> make_solver, double tol) {
+    auto pos = SimulateStack(make_solver(), false);
+    auto pos_flat = SimulateStack(make_solver(), true);
+
+    for (size_t i = 0; i < pos.size(); i++) {
+        // The boxes are in contact with the ground and with each other
+        ASSERT_NEAR(pos[i].z(), 0.1 + 0.2 * i, 1e-2);
+        ASSERT_LT((pos_flat[i] - pos[i]).Length(), tol) << "box " << i;
+    }
+}
+
+TEST(FlatConstraints, PSOR) {
+    CompareFlat([]() { return chrono_types::make_shared<ChSolverPSOR>(); }, 1e-8);
+}
+
+TEST(FlatConstraints, APGD) {
+    CompareFlat([]() { return chrono_types::make_shared<ChSolverAPGD>(); }, 1e-6);
+}
+
+TEST(FlatConstraints, ADMM) {
+    CompareFlat([]() { return chrono_types::make_shared<ChSolverADMM>(); }, 1e-8);
+}
@@ -0,0 +1,206 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit tests for the reduced-precision solver options.
+// - mixed-precision direct solvers (single-precision factorization with
+//   iterative refinement) recover double-precision accuracy, report diverging
+//   refinement, and redo the symbolic analysis when switching precision
+// - iterative VI solvers with single-precision constraint Jacobians give
+//   results close to those in double precision
+//
+// =============================================================================
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+// Solve a 1D Poisson-like problem (tridiagonal, diagonally dominant) and return the relative residual.
+template <typename Solver>
+static double SolveTridiagonal(Solver& solver, int n) {
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = 0; i < n; i++) {
+        triplets.push_back({i, i, 2.5 + 0.01 * i});
+        if (i > 0)
+            triplets.push_back({i, i - 1, -1.0});
+        if (i < n - 1)
+            triplets.push_back({i, i + 1, -1.0 + 0.001 * i});
+    }
+    solver.A().resize(n, n);
+    solver.A().setFromTriplets(triplets.begin(), triplets.end());
+    solver.b().resize(n);
+    for (int i = 0; i < n; i++)
+        solver.b()(i) = std::sin(0.1 * i) + 1.0 / 3.0;
+
+    EXPECT_TRUE(solver.SetupCurrent());
+    EXPECT_TRUE(solver.SolveCurrent());
+
+    return (solver.b() - solver.A() * solver.x()).norm() / solver.b().norm();
+}
+
+TEST(MixedPrecision, sparse_lu) {
+    int n = 500;
+
+    ChSolverSparseLU solver_double;
+    double res_double = SolveTridiagonal(solver_double, n);
+    ASSERT_EQ(solver_double.GetNumRefinementSteps(), 0);
+
+    // Single-precision factorization without refinement is accurate to single precision only
+    ChSolverSparseLU solver_float;
+    solver_float.EnableMixedPrecision(true);
+    solver_float.SetIterativeRefinement(0);
+    double res_float = SolveTridiagonal(solver_float, n);
+    ASSERT_TRUE(solver_float.UsesMixedPrecision());
+    ASSERT_GT(res_float, 1e-10);
+    ASSERT_LT(res_float, 1e-5);
+
+    // Iterative refinement recovers double-precision accuracy
+    ChSolverSparseLU solver_mixed;
+    solver_mixed.EnableMixedPrecision(true);
+    double res_mixed = SolveTridiagonal(solver_mixed, n);
+    ASSERT_GT(solver_mixed.GetNumRefinementSteps(), 0);
+    ASSERT_LT(res_mixed, 1e-12);
+    ASSERT_LT((solver_mixed.x() - solver_double.x()).norm(), 1e-10 * solver_double.x().norm());
+    ASSERT_LT(res_double, 1e-12);
+}
+
+TEST(MixedPrecision, refinement_failure) {
+    // Laplacian of a chain (singular), regularized by a small shift of all diagonal entries, plus one single-precision
+    // ulp on the first diagonal entry. The shift is lost in the single-precision factorization, whose error is then
+    // larger than the smallest eigenvalue of the matrix: the refinement diverges.
+    int n = 100;
+    ChSolverSparseLU solver;
+    solver.EnableMixedPrecision(true);
+    std::vector<Eigen::Triplet<double>> triplets;
+    for (int i = 0; i < n; i++) {
+        double diag = (i == 0 || i == n - 1) ? 1.0 : 2.0;
+        if (i == 0)
+            diag += std::ldexp(1.0, -23);
+        triplets.push_back({i, i, diag + 5e-8});
+        if (i > 0)
+            triplets.push_back({i, i - 1, -1.0});
+        if (i < n - 1)
+            triplets.push_back({i, i + 1, -1.0});
+    }
+    solver.A().resize(n, n);
+    solver.A().setFromTriplets(triplets.begin(), triplets.end());
+    solver.b() = ChVectorDynamic<>::Ones(n);
+    ASSERT_FALSE(solver.SetupCurrent() && solver.SolveCurrent());
+
+    // A tolerance which cannot be reached stops the refinement without failure
+    ChSolverSparseLU solver_tight;
+    solver_tight.EnableMixedPrecision(true);
+    solver_tight.SetIterativeRefinement(20, 1e-30);
+    double res = SolveTridiagonal(solver_tight, 200);
+    ASSERT_LT(solver_tight.GetNumRefinementSteps(), 20);
+    ASSERT_LT(res, 1e-12);
+}
+
+TEST(MixedPrecision, switch_precision) {
+    ChSystemSMC sys;
+    auto solver = chrono_types::make_shared<ChSolverSparseLU>();
+    solver->ReuseSymbolicAnalysis(true);
+    sys.SetSolver(solver);
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+    auto body = chrono_types::make_shared<ChBodyEasySphere>(0.1, 1000, false, false);
+    body->SetPos(ChVector3d(1, 0, 0));
+    sys.AddBody(body);
+    auto joint = chrono_types::make_shared<ChLinkLockSpherical>();
+    joint->Initialize(ground, body, ChFrame<>(ChVector3d(0, 0, 0)));
+    sys.AddLink(joint);
+
+    sys.DoStepDynamics(1e-3);
+    sys.DoStepDynamics(1e-3);
+    unsigned int num_analyses = solver->GetNumSymbolicAnalyses();
+
+    // Switching to a single-precision factorization requires a new symbolic analysis, even with an unchanged pattern
+    solver->EnableMixedPrecision(true);
+    sys.DoStepDynamics(1e-3);
+    ASSERT_TRUE(solver->UsesMixedPrecision());
+    ASSERT_EQ(solver->GetNumSymbolicAnalyses(), num_analyses + 1);
+    sys.DoStepDynamics(1e-3);
+    ASSERT_EQ(solver->GetNumSymbolicAnalyses(), num_analyses + 1);
+
+    solver->EnableMixedPrecision(false);
+    sys.DoStepDynamics(1e-3);
+    ASSERT_EQ(solver->GetNumSymbolicAnalyses(), num_analyses + 2);
+}
+
+TEST(MixedPrecision, sparse_qr) {
+    ChSolverSparseQR solver;
+    solver.EnableMixedPrecision(true);
+    solver.SetIterativeRefinement(20, 1e-13);
+    double res = SolveTridiagonal(solver, 200);
+    ASSERT_GT(solver.GetNumRefinementSteps(), 0);
+    ASSERT_LT(res, 1e-13);
+}
+
+// ====================================================================================
+
+// Drop a stack of boxes on the ground and return their final positions.
+static std::vector<ChVector3d> SimulateStack(bool single_precision) {
+    ChSystemNSC sys;
+    sys.SetCollisionSystemType(ChCollisionSystem::Type::BULLET);
+    sys.SetGravitationalAcceleration(ChVector3d(0, 0, -9.81));
+
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    solver->SetMaxIterations(100);
+    sys.SetSolver(solver);
+    sys.GetSystemDescriptor()->EnableFlatConstraints(true, single_precision);
+
+    auto mat = chrono_types::make_shared<ChContactMaterialNSC>();
+    mat->SetFriction(0.5f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 4, 0.2, 1000, false, true, mat);
+    ground->SetPos(ChVector3d(0, 0, -0.1));
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> boxes;
+    for (int i = 0; i < 4; i++) {
+        auto box = chrono_types::make_shared<ChBodyEasyBox>(0.4, 0.4, 0.2, 1000, false, true, mat);
+        box->SetPos(ChVector3d(0.02 * i, 0, 0.11 + 0.21 * i));
+        sys.AddBody(box);
+        boxes.push_back(box);
+    }
+
+    for (int i = 0; i < 300; i++)
+        sys.DoStepDynamics(2e-3);
+
+    EXPECT_EQ(sys.GetSystemDescriptor()->GetFlatConstraints().IsSinglePrecision(), single_precision);
+
+    std::vector<ChVector3d> pos;
+    for (const auto& box : boxes)
+        pos.push_back(box->GetPos());
+    return pos;
+}
+
+TEST(MixedPrecision, flat_constraints) {
+    auto pos_double = SimulateStack(false);
+    auto pos_single = SimulateStack(true);
+
+    for (size_t i = 0; i < pos_double.size(); i++) {
+        // The stack is at rest
+        ASSERT_NEAR(pos_double[i].z(), 0.1 + 0.2 * i, 1e-2);
+        ASSERT_LT((pos_single[i] - pos_double[i]).Length(), 1e-4) << "box " << i;
+    }
+}
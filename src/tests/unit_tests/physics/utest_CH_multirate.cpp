@@ -0,0 +1,111 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the multirate timestepper.
+// A heavy body hangs from the ground through a soft spring and a light body
+// hangs from the heavy one through a stiff spring; the light body is in the fast
+// partition.
+// - with a single substep, the multirate integrator reproduces the linearized
+//   implicit Euler integrator
+// - with substeps, the fast oscillation follows the one obtained with a
+//   single-rate integrator at the substep size, unlike a single-rate integrator
+//   at the macro step size
+//
+// =============================================================================
+
+#include "chrono/physics/ChLinkTSDA.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/timestepper/ChTimestepperMultirate.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+// Simulate the two-body system and return the stretch of the stiff spring and the position of the heavy body.
+static std::pair<double, double> Simulate(bool multirate, int num_substeps, double step, int num_steps) {
+    ChSystemSMC sys;
+    sys.SetGravitationalAcceleration(ChVector3d(0, 0, -9.81));
+    sys.SetSolver(chrono_types::make_shared<ChSolverSparseLU>());
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    auto slow = chrono_types::make_shared<ChBody>();
+    slow->SetMass(10);
+    slow->SetInertiaXX(ChVector3d(1, 1, 1));
+    slow->SetPos(ChVector3d(0, 0, -1));
+    sys.AddBody(slow);
+
+    auto fast = chrono_types::make_shared<ChBody>();
+    fast->SetMass(0.1);
+    fast->SetInertiaXX(ChVector3d(0.01, 0.01, 0.01));
+    fast->SetPos(ChVector3d(0, 0, -1.6));
+    fast->SetMultirateFast(true);
+    sys.AddBody(fast);
+
+    auto soft = chrono_types::make_shared<ChLinkTSDA>();
+    soft->Initialize(ground, slow, false, ground->GetPos(), slow->GetPos());
+    soft->SetRestLength(1);
+    soft->SetSpringCoefficient(100);
+    soft->IsStiff(true);
+    sys.AddLink(soft);
+
+    // Stiff spring, initially stretched by 0.1
+    auto stiff = chrono_types::make_shared<ChLinkTSDA>();
+    stiff->Initialize(slow, fast, false, slow->GetPos(), fast->GetPos());
+    stiff->SetRestLength(0.5);
+    stiff->SetSpringCoefficient(1e4);
+    stiff->IsStiff(true);
+    sys.AddLink(stiff);
+
+    if (multirate) {
+        auto integrator = chrono_types::make_shared<ChTimestepperMultirate>(&sys);
+        integrator->SetNumSubsteps(num_substeps);
+        sys.SetTimestepper(integrator);
+    } else {
+        sys.SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+    }
+
+    for (int i = 0; i < num_steps; i++)
+        sys.DoStepDynamics(step);
+
+    return std::make_pair(slow->GetPos().z() - fast->GetPos().z() - 0.5, slow->GetPos().z());
+}
+
+TEST(Multirate, single_substep) {
+    auto res_multirate = Simulate(true, 1, 1e-2, 50);
+    auto res_single = Simulate(false, 1, 1e-2, 50);
+    ASSERT_NEAR(res_multirate.first, res_single.first, 1e-12);
+    ASSERT_NEAR(res_multirate.second, res_single.second, 1e-12);
+}
+
+TEST(Multirate, substeps) {
+    // Stiff spring period: ~0.02 s
+    double H = 1e-2;
+    int m = 10;
+    int num_steps = 4;
+    auto res_ref = Simulate(false, 1, H / m, m * num_steps);
+    auto res_coarse = Simulate(false, 1, H, num_steps);
+    auto res_multirate = Simulate(true, m, H, num_steps);
+
+    // The fast oscillation is resolved by the substeps, while it is damped out with the macro step
+    double err_coarse = std::abs(res_coarse.first - res_ref.first);
+    double err_multirate = std::abs(res_multirate.first - res_ref.first);
+    ASSERT_GT(std::abs(res_ref.first), 0.01);
+    ASSERT_LT(err_multirate, 0.25 * err_coarse);
+
+    // The slow body follows the single-rate solution, to the accuracy of the macro step
+    ASSERT_NEAR(res_multirate.second, res_ref.second, 5e-3);
+}
@@ -0,0 +1,170 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the multithreaded products of the system descriptor.
+// - Schur complement products on a stack of boxes with frictional contacts
+// - KKT system products on an FEA mesh with links
+// The products evaluated with several threads must match the serial ones, with
+// both the object-based and the flattened constraint representations, and must
+// not depend on the number of threads.
+//
+// =============================================================================
+
+#include <random>
+
+#include "chrono/fea/ChElementHexaCorot_8.h"
+#include "chrono/fea/ChLinkNodeFrame.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// ====================================================================================
+
+static ChVectorDynamic<> RandomVector(int n) {
+    std::default_random_engine generator(5);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    ChVectorDynamic<> v(n);
+    for (int i = 0; i < n; i++)
+        v(i) = distribution(generator);
+    return v;
+}
+
+TEST(ParallelProducts, schur_complement) {
+    ChSystemNSC sys;
+    sys.SetCollisionSystemType(ChCollisionSystem::Type::BULLET);
+    sys.SetSolver(chrono_types::make_shared<ChSolverPSOR>());
+
+    auto mat = chrono_types::make_shared<ChContactMaterialNSC>();
+    mat->SetFriction(0.5f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 4, 0.2, 1000, false, true, mat);
+    ground->SetPos(ChVector3d(0, 0, -0.1));
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    for (int i = 0; i < 4; i++) {
+        auto box = chrono_types::make_shared<ChBodyEasyBox>(0.4, 0.4, 0.2, 1000, false, true, mat);
+        box->SetPos(ChVector3d(0.02 * i, 0, 0.1 + 0.2 * i));
+        sys.AddBody(box);
+    }
+
+    sys.DoStepDynamics(1e-3);
+
+    auto& sysd = *sys.GetSystemDescriptor();
+    int nc = sysd.CountActiveConstraints();
+    ASSERT_GE(nc, 3 * 4 * 4);
+    ChVectorDynamic<> l = RandomVector(nc);
+
+    for (bool flat : {false, true}) {
+        sysd.EnableFlatConstraints(flat);
+        sysd.UpdateConstraintsAuxiliary();
+
+        ChVectorDynamic<> result_serial;
+        sysd.SetNumThreads(1);
+        sysd.SchurComplementProduct(result_serial, l);
+        ASSERT_GT(result_serial.norm(), 0);
+
+        ChVectorDynamic<> result_2;
+        sysd.SetNumThreads(2);
+        sysd.SchurComplementProduct(result_2, l);
+
+        ChVectorDynamic<> result_4;
+        sysd.SetNumThreads(4);
+        sysd.SchurComplementProduct(result_4, l);
+
+        ASSERT_LT((result_2 - result_serial).norm(), 1e-12 * result_serial.norm()) << "flat: " << flat;
+        ASSERT_LT((result_4 - result_serial).norm(), 1e-12 * result_serial.norm()) << "flat: " << flat;
+    }
+}
+
+TEST(ParallelProducts, system_product) {
+    ChSystemSMC sys;
+
+    auto material = chrono_types::make_shared<ChContinuumElastic>(2e7, 0.3, 1000);
+    material->SetRayleighDampingBeta(0.01);
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    sys.Add(mesh);
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    double size = 0.1;
+    std::shared_ptr<ChNodeFEAxyz> lower[4];
+    for (int ilayer = 0; ilayer < 6; ++ilayer) {
+        double hy = ilayer * size;
+        std::shared_ptr<ChNodeFEAxyz> upper[4] = {
+            chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(0, hy, 0)),
+            chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(0, hy, size)),
+            chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(size, hy, size)),
+            chrono_types::make_shared<ChNodeFEAxyz>(ChVector3d(size, hy, 0))};
+        for (int j = 0; j < 4; j++) {
+            mesh->AddNode(upper[j]);
+            if (ilayer == 0) {
+                auto link = chrono_types::make_shared<ChLinkNodeFrame>();
+                link->Initialize(upper[j], ground);
+                sys.Add(link);
+            }
+        }
+        if (ilayer > 0) {
+            auto element = chrono_types::make_shared<ChElementHexaCorot_8>();
+            element->SetNodes(lower[0], lower[1], lower[2], lower[3], upper[0], upper[1], upper[2], upper[3]);
+            element->SetMaterial(material);
+            mesh->AddElement(element);
+        }
+        for (int j = 0; j < 4; j++)
+            lower[j] = upper[j];
+    }
+
+    sys.SetSolver(chrono_types::make_shared<ChSolverSparseLU>());
+    sys.DoStepDynamics(1e-3);
+
+    auto& sysd = *sys.GetSystemDescriptor();
+    int n = sysd.CountActiveVariables() + sysd.CountActiveConstraints();
+    ASSERT_EQ(sysd.CountActiveConstraints(), 12);
+    ChVectorDynamic<> x = RandomVector(n);
+
+    for (bool flat : {false, true}) {
+        sysd.EnableFlatConstraints(flat);
+        sysd.UpdateFlatConstraints();
+
+        ChVectorDynamic<> result_serial;
+        sysd.SetNumThreads(1);
+        sysd.SystemProduct(result_serial, x);
+        ASSERT_GT(result_serial.norm(), 0);
+
+        ChVectorDynamic<> result_2;
+        sysd.SetNumThreads(2);
+        sysd.SystemProduct(result_2, x);
+
+        ChVectorDynamic<> result_4;
+        sysd.SetNumThreads(4);
+        sysd.SystemProduct(result_4, x);
+
+        ASSERT_LT((result_2 - result_serial).norm(), 1e-12 * result_serial.norm()) << "flat: " << flat;
+        ASSERT_LT((result_4 - result_serial).norm(), 1e-12 * result_serial.norm()) << "flat: " << flat;
+
+        // The assembled matrix gives the same product
+        ChSparseMatrix Z;
+        sysd.BuildSystemMatrix(&Z, nullptr);
+        ChVectorDynamic<> result_matrix = Z * x;
+        ASSERT_LT((result_4 - result_matrix).norm(), 1e-10 * result_matrix.norm()) << "flat: " << flat;
+    }
+}
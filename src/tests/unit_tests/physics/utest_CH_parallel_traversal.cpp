@@ -0,0 +1,118 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the parallel traversal of the assembly item lists.
+// Chains of pendulums connected by revolute joints, with springs between
+// adjacent chains and a speed motor (a link with its own coordinates), are
+// simulated with and without parallel traversal.
+// - with parallel traversal, the trajectories match the sequential ones
+// - in deterministic mode, they are bit-identical for any number of threads
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/functions/ChFunctionConst.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChLinkMotorRotationSpeed.h"
+#include "chrono/physics/ChLinkTSDA.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+// Simulate the pendulum chains and return the final positions and velocities of all bodies.
+static std::vector<double> Simulate(bool parallel, int num_threads, bool deterministic) {
+    ChSystemNSC sys;
+    sys.SetSolver(chrono_types::make_shared<ChSolverSparseLU>());
+    sys.SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+    sys.SetNumThreads(num_threads, 1, 1);
+    sys.SetDeterministic(deterministic);
+    sys.SetParallelTraversal(parallel, 8);
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    int num_chains = 4;
+    int num_links = 8;
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    for (int ic = 0; ic < num_chains; ic++) {
+        double y = 2.0 * ic;
+        std::shared_ptr<ChBody> prev = ground;
+        for (int il = 0; il < num_links; il++) {
+            auto body = chrono_types::make_shared<ChBody>();
+            body->SetMass(1);
+            body->SetInertiaXX(ChVector3d(0.1, 0.1, 0.1));
+            body->SetPos(ChVector3d(il + 0.5, y, 0));
+            sys.AddBody(body);
+            bodies.push_back(body);
+
+            auto rev = chrono_types::make_shared<ChLinkLockRevolute>();
+            rev->Initialize(prev, body, ChFrame<>(ChVector3d(il, y, 0)));
+            sys.AddLink(rev);
+
+            // Spring to the corresponding body of the previous chain
+            if (ic > 0) {
+                auto spring = chrono_types::make_shared<ChLinkTSDA>();
+                spring->Initialize(bodies[bodies.size() - 1 - num_links], body, false, ChVector3d(il + 0.5, y - 2, 0),
+                                   body->GetPos());
+                spring->SetRestLength(1.5);
+                spring->SetSpringCoefficient(50);
+                spring->SetDampingCoefficient(0.5);
+                sys.AddLink(spring);
+            }
+
+            prev = body;
+        }
+
+        if (ic == 0) {
+            auto motor = chrono_types::make_shared<ChLinkMotorRotationSpeed>();
+            motor->Initialize(ground, bodies[0], ChFrame<>(ChVector3d(0, 0, 0)));
+            motor->SetSpeedFunction(chrono_types::make_shared<ChFunctionConst>(1.0));
+            sys.AddLink(motor);
+        }
+    }
+
+    for (int i = 0; i < 100; i++)
+        sys.DoStepDynamics(2e-3);
+
+    std::vector<double> state;
+    for (const auto& body : bodies) {
+        for (int k = 0; k < 3; k++) {
+            state.push_back(body->GetPos()[k]);
+            state.push_back(body->GetPosDt()[k]);
+        }
+    }
+    return state;
+}
+
+TEST(ChAssembly, parallel_traversal) {
+    auto ref = Simulate(false, 1, false);
+    auto par = Simulate(true, 4, false);
+
+    ASSERT_EQ(ref.size(), par.size());
+    for (size_t i = 0; i < ref.size(); i++)
+        ASSERT_NEAR(par[i], ref[i], 1e-10) << "entry " << i;
+}
+
+TEST(ChAssembly, parallel_traversal_deterministic) {
+    auto par2 = Simulate(true, 2, true);
+    auto par4 = Simulate(true, 4, true);
+
+    ASSERT_EQ(par2.size(), par4.size());
+    for (size_t i = 0; i < par2.size(); i++)
+        ASSERT_EQ(par2[i], par4[i]) << "entry " << i;
+}
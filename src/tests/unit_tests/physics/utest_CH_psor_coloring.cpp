@@ -0,0 +1,91 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the graph-colored multithreaded PSOR solver.
+// A stack of boxes is dropped on the ground. The colored variant must converge
+// to the same resting configuration as the serial PSOR solver, with results
+// independent of the number of threads.
+//
+// =============================================================================
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+// Drop a stack of boxes on the ground and return their final positions.
+static std::vector<ChVector3d> SimulateStack(bool coloring, int num_threads, unsigned int& num_colors) {
+    ChSystemNSC sys;
+    sys.SetCollisionSystemType(ChCollisionSystem::Type::BULLET);
+    sys.SetNumThreads(num_threads, 1, 1);
+    sys.SetGravitationalAcceleration(ChVector3d(0, 0, -9.81));
+
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    solver->SetMaxIterations(200);
+    solver->EnableGraphColoring(coloring);
+    sys.SetSolver(solver);
+
+    auto mat = chrono_types::make_shared<ChContactMaterialNSC>();
+    mat->SetFriction(0.5f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 4, 0.2, 1000, false, true, mat);
+    ground->SetPos(ChVector3d(0, 0, -0.1));
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    // Two stacks, so that some constraints can be relaxed concurrently
+    std::vector<std::shared_ptr<ChBody>> boxes;
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 4; i++) {
+            auto box = chrono_types::make_shared<ChBodyEasyBox>(0.4, 0.4, 0.2, 1000, false, true, mat);
+            box->SetPos(ChVector3d(-1 + 2 * j + 0.02 * i, 0, 0.11 + 0.21 * i));
+            sys.AddBody(box);
+            boxes.push_back(box);
+        }
+    }
+
+    for (int i = 0; i < 300; i++)
+        sys.DoStepDynamics(2e-3);
+
+    num_colors = solver->GetNumColors();
+
+    std::vector<ChVector3d> pos;
+    for (const auto& box : boxes)
+        pos.push_back(box->GetPos());
+    return pos;
+}
+
+TEST(PSOR, graph_coloring) {
+    unsigned int num_colors;
+    auto pos_serial = SimulateStack(false, 1, num_colors);
+    ASSERT_EQ(num_colors, 0);
+
+    unsigned int num_colors_1;
+    unsigned int num_colors_n;
+    auto pos_colored_1 = SimulateStack(true, 1, num_colors_1);
+    auto pos_colored_n = SimulateStack(true, 4, num_colors_n);
+    ASSERT_GT(num_colors_1, 1);
+    ASSERT_EQ(num_colors_1, num_colors_n);
+
+    for (size_t i = 0; i < pos_serial.size(); i++) {
+        // The stacks are at rest, at the same configuration as with the serial sweep
+        ASSERT_NEAR(pos_serial[i].z(), 0.1 + 0.2 * (i % 4), 1e-2);
+        ASSERT_LT((pos_colored_1[i] - pos_serial[i]).Length(), 1e-3) << "box " << i;
+
+        // The colored sweep does not depend on the number of threads
+        ASSERT_EQ(pos_colored_1[i], pos_colored_n[i]) << "box " << i;
+    }
+}
@@ -0,0 +1,211 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for in-memory system snapshots (ChSystem::SaveState/RestoreState).
+// A double pendulum with a spring-damper is simulated for some time, its state
+// is saved, and the simulation continued. After rolling back to the saved state,
+// the continued trajectory must be reproduced exactly. Invalid snapshots are
+// rejected and leave the system state unchanged.
+//
+// =============================================================================
+
+#include <limits>
+#include <vector>
+
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChLinkTSDA.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+// Create a double pendulum with a spring-damper between the second pendulum and ground.
+static void CreateModel(ChSystem& sys) {
+    sys.SetGravitationalAcceleration(ChVector3d(0, -9.81, 0));
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    auto pend1 = chrono_types::make_shared<ChBody>();
+    pend1->SetMass(1);
+    pend1->SetInertiaXX(ChVector3d(0.1, 0.1, 0.1));
+    pend1->SetPos(ChVector3d(1, 0, 0));
+    sys.AddBody(pend1);
+
+    auto pend2 = chrono_types::make_shared<ChBody>();
+    pend2->SetMass(1);
+    pend2->SetInertiaXX(ChVector3d(0.1, 0.1, 0.1));
+    pend2->SetPos(ChVector3d(2, 0, 0));
+    sys.AddBody(pend2);
+
+    auto rev1 = chrono_types::make_shared<ChLinkLockRevolute>();
+    rev1->Initialize(ground, pend1, ChFrame<>(ChVector3d(0, 0, 0)));
+    sys.AddLink(rev1);
+
+    auto rev2 = chrono_types::make_shared<ChLinkLockRevolute>();
+    rev2->Initialize(pend1, pend2, ChFrame<>(ChVector3d(1.5, 0, 0)));
+    sys.AddLink(rev2);
+
+    auto spring = chrono_types::make_shared<ChLinkTSDA>();
+    spring->Initialize(ground, pend2, false, ChVector3d(2, 1, 0), ChVector3d(2.5, 0, 0));
+    spring->SetSpringCoefficient(50);
+    spring->SetDampingCoefficient(2);
+    sys.AddLink(spring);
+}
+
+// Set the timestepper, with a direct solver and looser Newton tolerances for the integrators other than the linearized
+// Euler method.
+static void SetTimestepper(ChSystem& sys, ChTimestepper::Type type) {
+    sys.SetTimestepperType(type);
+    if (type == ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED)
+        return;
+
+    sys.SetSolver(chrono_types::make_shared<ChSolverSparseQR>());
+    auto integrator = std::dynamic_pointer_cast<ChImplicitIterativeTimestepper>(sys.GetTimestepper());
+    integrator->SetMaxIters(20);
+    integrator->SetAbsTolerances(1e-6);
+}
+
+// Snapshot callback with a single value.
+class ValueCallback : public ChSystem::StateSnapshotCallback {
+  public:
+    virtual void OnSave(ChStateSnapshot& snapshot) override { snapshot.Write(value); }
+    virtual void OnRestore(ChStateSnapshot::Reader& reader) override { reader.Read(value); }
+    double value = 1;
+};
+
+// Return the positions and velocities of all bodies.
+static std::vector<double> GetState(ChSystem& sys) {
+    std::vector<double> state;
+    for (const auto& body : sys.GetBodies()) {
+        const auto& pos = body->GetPos();
+        const auto& vel = body->GetPosDt();
+        state.insert(state.end(), {pos.x(), pos.y(), pos.z(), vel.x(), vel.y(), vel.z()});
+    }
+    return state;
+}
+
+// Advance the simulation and return the trajectory of all bodies.
+static std::vector<double> Simulate(ChSystem& sys, int num_steps, double step) {
+    std::vector<double> traj;
+    for (int i = 0; i < num_steps; i++) {
+        sys.DoStepDynamics(step);
+        for (const auto& body : sys.GetBodies()) {
+            const auto& pos = body->GetPos();
+            const auto& vel = body->GetPosDt();
+            traj.insert(traj.end(), {pos.x(), pos.y(), pos.z(), vel.x(), vel.y(), vel.z()});
+        }
+    }
+    return traj;
+}
+
+// ====================================================================================
+
+class SnapshotTest : public ::testing::TestWithParam<ChTimestepper::Type> {};
+
+TEST_P(SnapshotTest, rollback) {
+    ChSystemNSC sys;
+    CreateModel(sys);
+
+    SetTimestepper(sys, GetParam());
+
+    double step = 1e-3;
+    Simulate(sys, 200, step);
+
+    ChStateSnapshot snapshot;
+    sys.SaveState(snapshot);
+    ASSERT_FALSE(snapshot.IsEmpty());
+    double time = sys.GetChTime();
+
+    auto traj_1 = Simulate(sys, 300, step);
+
+    sys.RestoreState(snapshot);
+    ASSERT_EQ(sys.GetChTime(), time);
+
+    auto traj_2 = Simulate(sys, 300, step);
+
+    ASSERT_EQ(traj_1.size(), traj_2.size());
+    for (size_t i = 0; i < traj_1.size(); i++) {
+        // bit-identical results
+        ASSERT_EQ(traj_1[i], traj_2[i]) << "i = " << i;
+    }
+}
+
+TEST_P(SnapshotTest, mismatch) {
+    ChSystemNSC sys;
+    CreateModel(sys);
+    SetTimestepper(sys, GetParam());
+    sys.DoStepDynamics(1e-3);
+
+    ChStateSnapshot snapshot;
+    sys.SaveState(snapshot);
+
+    // Restoring in a system with a different topology must fail
+    auto body = chrono_types::make_shared<ChBody>();
+    sys.AddBody(body);
+    sys.DoStepDynamics(1e-3);
+    ASSERT_THROW(sys.RestoreState(snapshot), std::invalid_argument);
+}
+
+TEST_P(SnapshotTest, invalid) {
+    ChSystemNSC sys;
+    CreateModel(sys);
+    SetTimestepper(sys, GetParam());
+    sys.DoStepDynamics(1e-3);
+
+    ChStateSnapshot snapshot;
+    sys.SaveState(snapshot);
+
+    sys.DoStepDynamics(1e-3);
+    double time = sys.GetChTime();
+    auto state = GetState(sys);
+
+    // A vector size larger than the snapshot data is rejected before any allocation
+    ChStateSnapshot forged;
+    forged.Write(0.0);
+    forged.Write(1e-3);
+    forged.Write((size_t)1);
+    forged.Write(false);
+    forged.Write(std::numeric_limits<size_t>::max() / 2);
+    ASSERT_THROW(sys.RestoreState(forged), std::runtime_error);
+    ASSERT_EQ(sys.GetChTime(), time);
+    ASSERT_EQ(GetState(sys), state);
+
+    // The snapshot holds no data for a callback registered after it was taken: the system is rolled back
+    auto callback = chrono_types::make_shared<ValueCallback>();
+    sys.RegisterStateSnapshotCallback(callback);
+    ASSERT_THROW(sys.RestoreState(snapshot), std::runtime_error);
+    ASSERT_EQ(sys.GetChTime(), time);
+    ASSERT_EQ(GetState(sys), state);
+
+    // Valid snapshot
+    ChStateSnapshot snapshot_cb;
+    sys.SaveState(snapshot_cb);
+    callback->value = 2;
+    sys.DoStepDynamics(1e-3);
+    sys.RestoreState(snapshot_cb);
+    ASSERT_EQ(sys.GetChTime(), time);
+    ASSERT_EQ(GetState(sys), state);
+    ASSERT_EQ(callback->value, 1);
+}
+
+INSTANTIATE_TEST_SUITE_P(Chrono,
+                         SnapshotTest,
+                         ::testing::Values(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED,
+                                           ChTimestepper::Type::HHT,
+                                           ChTimestepper::Type::NEWMARK));
@@ -0,0 +1,98 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the decomposition of the solver problem in independent islands.
+// Two disjoint stacks of boxes, resting on a fixed ground, form two islands.
+// Solving the islands concurrently must give the same results as solving the
+// monolithic problem. Solvers that cannot be cloned fall back to the monolithic
+// solve.
+//
+// =============================================================================
+
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverADMM.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+// Drop two stacks of boxes on the ground and return their final positions.
+static std::vector<ChVector3d> SimulateStacks(std::shared_ptr<ChIterativeSolverVI> solver,
+                                              bool islands,
+                                              unsigned int& num_islands) {
+    ChSystemNSC sys;
+    sys.SetCollisionSystemType(ChCollisionSystem::Type::BULLET);
+    sys.SetNumThreads(2, 1, 1);
+    sys.SetGravitationalAcceleration(ChVector3d(0, 0, -9.81));
+    sys.EnableSolverIslands(islands);
+
+    // Fixed number of iterations, so that both islands and the full problem perform the same sweeps
+    solver->SetMaxIterations(50);
+    solver->SetTolerance(0);
+    sys.SetSolver(solver);
+
+    auto mat = chrono_types::make_shared<ChContactMaterialNSC>();
+    mat->SetFriction(0.5f);
+
+    auto ground = chrono_types::make_shared<ChBodyEasyBox>(4, 4, 0.2, 1000, false, true, mat);
+    ground->SetPos(ChVector3d(0, 0, -0.1));
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> boxes;
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < 3; i++) {
+            auto box = chrono_types::make_shared<ChBodyEasyBox>(0.4, 0.4, 0.2, 1000, false, true, mat);
+            box->SetPos(ChVector3d(-1 + 2 * j + 0.02 * i, 0, 0.11 + 0.21 * i));
+            sys.AddBody(box);
+            boxes.push_back(box);
+        }
+    }
+
+    num_islands = 0;
+    for (int i = 0; i < 200; i++) {
+        sys.DoStepDynamics(2e-3);
+        num_islands = std::max(num_islands, sys.GetNumIslands());
+    }
+
+    std::vector<ChVector3d> pos;
+    for (const auto& box : boxes)
+        pos.push_back(box->GetPos());
+    return pos;
+}
+
+TEST(SolverIslands, PSOR) {
+    unsigned int num_islands;
+    auto pos = SimulateStacks(chrono_types::make_shared<ChSolverPSOR>(), false, num_islands);
+    ASSERT_EQ(num_islands, 0);
+
+    auto pos_islands = SimulateStacks(chrono_types::make_shared<ChSolverPSOR>(), true, num_islands);
+    ASSERT_EQ(num_islands, 2);
+
+    for (size_t i = 0; i < pos.size(); i++) {
+        ASSERT_NEAR(pos[i].z(), 0.1 + 0.2 * (i % 3), 1e-2);
+        ASSERT_LT((pos_islands[i] - pos[i]).Length(), 1e-10) << "box " << i;
+    }
+}
+
+TEST(SolverIslands, no_clone) {
+    unsigned int num_islands;
+    auto pos = SimulateStacks(chrono_types::make_shared<ChSolverADMM>(), false, num_islands);
+    auto pos_islands = SimulateStacks(chrono_types::make_shared<ChSolverADMM>(), true, num_islands);
+    ASSERT_EQ(num_islands, 0);
+
+    for (size_t i = 0; i < pos.size(); i++)
+        ASSERT_EQ(pos_islands[i], pos[i]) << "box " << i;
+}
@@ -0,0 +1,110 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the reuse of the symbolic analysis in direct linear solvers.
+// A chain of pendulums is simulated with the sparse LU solver.
+// - the matrix refilled in place matches a freshly assembled one
+// - the symbolic analysis is performed once while the pattern is unchanged
+// - adding a link changes the pattern and triggers a new analysis
+//
+// =============================================================================
+
+#include "chrono/physics/ChLinkDistance.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// ====================================================================================
+
+// Chain of bodies connected by revolute joints, with the first body hinged to the ground.
+static void CreateChain(ChSystem& sys, std::vector<std::shared_ptr<ChBody>>& bodies, int num_bodies) {
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetFixed(true);
+    sys.AddBody(ground);
+
+    std::shared_ptr<ChBody> prev = ground;
+    for (int i = 0; i < num_bodies; i++) {
+        auto body = chrono_types::make_shared<ChBody>();
+        body->SetPos(ChVector3d(i + 0.5, 0, 0));
+        body->SetMass(1);
+        body->SetInertiaXX(ChVector3d(0.1, 0.1, 0.1));
+        sys.AddBody(body);
+        bodies.push_back(body);
+
+        auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+        joint->Initialize(prev, body, ChFrame<>(ChVector3d(i, 0, 0), QUNIT));
+        sys.AddLink(joint);
+        prev = body;
+    }
+}
+
+// Check that the matrix refilled in place by the solver matches a freshly assembled one.
+static void CheckRefill(ChSystem& sys, ChDirectSolverLS& solver) {
+    auto& sysd = *sys.GetSystemDescriptor();
+    ASSERT_TRUE(solver.Setup(sysd));
+
+    ChSparseMatrix Z;
+    sysd.BuildSystemMatrix(&Z, nullptr);
+    Z.makeCompressed();
+
+    ASSERT_EQ(solver.A().rows(), Z.rows());
+    ASSERT_EQ(solver.A().nonZeros(), Z.nonZeros());
+    ASSERT_LT((solver.A() - Z).norm(), 1e-14 * Z.norm());
+}
+
+TEST(SymbolicReuse, refill) {
+    ChSystemSMC sys;
+    std::vector<std::shared_ptr<ChBody>> bodies;
+    CreateChain(sys, bodies, 5);
+
+    auto solver = chrono_types::make_shared<ChSolverSparseLU>();
+    solver->ReuseSymbolicAnalysis(true);
+    sys.SetSolver(solver);
+
+    // Fixed sparsity pattern: a single symbolic analysis
+    for (int i = 0; i < 20; i++)
+        sys.DoStepDynamics(1e-3);
+    ASSERT_EQ(solver->GetNumSymbolicAnalyses(), 1);
+    CheckRefill(sys, *solver);
+    ASSERT_EQ(solver->GetNumSymbolicAnalyses(), 1);
+
+    // Add a link: the pattern changes and a new symbolic analysis is performed
+    auto link = chrono_types::make_shared<ChLinkDistance>();
+    link->Initialize(bodies.front(), bodies.back(), false, bodies.front()->GetPos(), bodies.back()->GetPos());
+    sys.AddLink(link);
+
+    for (int i = 0; i < 20; i++)
+        sys.DoStepDynamics(1e-3);
+    ASSERT_EQ(solver->GetNumSymbolicAnalyses(), 2);
+    CheckRefill(sys, *solver);
+    ASSERT_EQ(solver->GetNumSymbolicAnalyses(), 2);
+
+    // The solution is not affected by the in-place refill
+    ChSystemSMC sys_ref;
+    std::vector<std::shared_ptr<ChBody>> bodies_ref;
+    CreateChain(sys_ref, bodies_ref, 5);
+    sys_ref.SetSolver(chrono_types::make_shared<ChSolverSparseLU>());
+    for (int i = 0; i < 20; i++)
+        sys_ref.DoStepDynamics(1e-3);
+    auto link_ref = chrono_types::make_shared<ChLinkDistance>();
+    link_ref->Initialize(bodies_ref.front(), bodies_ref.back(), false, bodies_ref.front()->GetPos(),
+                         bodies_ref.back()->GetPos());
+    sys_ref.AddLink(link_ref);
+    for (int i = 0; i < 20; i++)
+        sys_ref.DoStepDynamics(1e-3);
+
+    for (size_t i = 0; i < bodies.size(); i++)
+        ASSERT_LT((bodies[i]->GetPos() - bodies_ref[i]->GetPos()).Length(), 1e-12) << "body " << i;
+}
@@ -0,0 +1,118 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2023 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the tiled storage of SCM grid node records.
+// - evicted tiles written to a stream are restored when loaded back
+// - truncated or malformed streams are rejected and leave the terrain unchanged
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include "gtest/gtest.h"
+
+#include "chrono/physics/ChSystemSMC.h"
+
+#include "chrono_vehicle/terrain/SCMTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Modified nodes in 4 tiles, 121 nodes per tile.
+class SCMTilesTest : public ::testing::Test {
+  protected:
+    virtual void SetUp() override {
+        terrain = chrono_types::make_unique<SCMTerrain>(&sys, false);
+        terrain->Initialize(12.8, 12.8, 0.1);
+        terrain->EnableTiledNodeStorage(true);
+
+        for (int i = -40; i <= 20; i++) {
+            for (int j = -40; j <= 20; j++) {
+                if ((i > -30 && i < 10) || (j > -30 && j < 10))
+                    continue;
+                nodes.push_back({ChVector2i(i, j), -0.001 * (i + 2 * j)});
+            }
+        }
+        terrain->SetModifiedNodes(nodes);
+        Sort(nodes);
+    }
+
+    static void Sort(std::vector<SCMTerrain::NodeLevel>& n) {
+        std::sort(n.begin(), n.end(), [](const SCMTerrain::NodeLevel& a, const SCMTerrain::NodeLevel& b) {
+            return a.first.x() < b.first.x() || (a.first.x() == b.first.x() && a.first.y() < b.first.y());
+        });
+    }
+
+    std::vector<SCMTerrain::NodeLevel> GetNodes() const {
+        auto n = terrain->GetModifiedNodes(true);
+        Sort(n);
+        return n;
+    }
+
+    // Evict all tiles, writing them to the returned string.
+    std::string EvictAll() {
+        std::ostringstream os;
+        EXPECT_EQ(terrain->EvictNodeTiles(ChVector3d(0, 0, 0), 0, &os), 4);
+        EXPECT_EQ(terrain->GetNumNodeTiles(), 0);
+        EXPECT_TRUE(terrain->GetModifiedNodes(true).empty());
+        return os.str();
+    }
+
+    ChSystemSMC sys;
+    std::unique_ptr<SCMTerrain> terrain;
+    std::vector<SCMTerrain::NodeLevel> nodes;
+};
+
+TEST_F(SCMTilesTest, round_trip) {
+    ASSERT_EQ(terrain->GetNumNodeTiles(), 4);
+    ASSERT_EQ(GetNodes(), nodes);
+
+    std::istringstream is(EvictAll());
+    ASSERT_EQ(terrain->LoadNodeTiles(is), 4);
+    ASSERT_EQ(terrain->GetNumNodeTiles(), 4);
+    ASSERT_EQ(GetNodes(), nodes);
+}
+
+TEST_F(SCMTilesTest, malformed_stream) {
+    std::string data = EvictAll();
+    size_t tile_size = data.size() / 4;
+    ASSERT_EQ(tile_size * 4, data.size());
+
+    // Truncated stream: only the complete first tile is loaded
+    std::istringstream is_truncated(data.substr(0, tile_size + tile_size / 2));
+    ASSERT_EQ(terrain->LoadNodeTiles(is_truncated), 1);
+    ASSERT_EQ(terrain->GetNumNodeTiles(), 1);
+    ASSERT_EQ(terrain->GetModifiedNodes(true).size(), 121);
+
+    // Invalid record index or record count: nothing is loaded and the existing tile is kept
+    for (int k : {-1, 64 * 64}) {
+        std::string bad = data.substr(tile_size, tile_size);
+        std::memcpy(&bad[3 * sizeof(int)], &k, sizeof(int));
+        std::istringstream is_bad(bad);
+        ASSERT_EQ(terrain->LoadNodeTiles(is_bad), 0);
+    }
+    for (int num_used : {-1, 64 * 64 + 1}) {
+        std::string bad = data.substr(tile_size, tile_size);
+        std::memcpy(&bad[2 * sizeof(int)], &num_used, sizeof(int));
+        std::istringstream is_bad(bad);
+        ASSERT_EQ(terrain->LoadNodeTiles(is_bad), 0);
+    }
+    ASSERT_EQ(terrain->GetNumNodeTiles(), 1);
+    ASSERT_EQ(terrain->GetModifiedNodes(true).size(), 121);
+
+    // The full stream restores all tiles
+    std::istringstream is(data);
+    ASSERT_EQ(terrain->LoadNodeTiles(is), 4);
+    ASSERT_EQ(GetNodes(), nodes);
+}